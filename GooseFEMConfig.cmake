@@ -15,6 +15,13 @@
 #   GooseFEM::compiler_warnings - enable compiler warnings
 #   GooseFEM::assert - enable GooseFEM assertions
 #   GooseFEM::debug - enable all assertions (slow)
+#
+# The following targets select an external sparse solver (see "GooseFEM/LinearSolver.h"),
+# they are only defined if the library is found:
+#
+#   GooseFEM::cholmod - SuiteSparse's CHOLMOD (supernodal Cholesky)
+#   GooseFEM::pardiso - Intel MKL's PARDISO
+#   GooseFEM::pastix - PaStiX
 
 include(CMakeFindDependencyMacro)
 
@@ -71,3 +78,64 @@ if(NOT TARGET GooseFEM::debug)
         PROPERTY INTERFACE_COMPILE_DEFINITIONS
         XTENSOR_ENABLE_ASSERT GOOSEFEM_ENABLE_ASSERT)
 endif()
+
+# Define support target "GooseFEM::cholmod"
+
+if(NOT TARGET GooseFEM::cholmod)
+    find_path(GOOSEFEM_CHOLMOD_INCLUDE_DIR cholmod.h PATH_SUFFIXES suitesparse)
+    find_library(GOOSEFEM_CHOLMOD_LIBRARY cholmod)
+    if(GOOSEFEM_CHOLMOD_INCLUDE_DIR AND GOOSEFEM_CHOLMOD_LIBRARY)
+        add_library(GooseFEM::cholmod INTERFACE IMPORTED)
+        set_property(
+            TARGET GooseFEM::cholmod
+            PROPERTY INTERFACE_INCLUDE_DIRECTORIES
+            ${GOOSEFEM_CHOLMOD_INCLUDE_DIR})
+        set_property(
+            TARGET GooseFEM::cholmod
+            PROPERTY INTERFACE_LINK_LIBRARIES
+            ${GOOSEFEM_CHOLMOD_LIBRARY})
+        set_property(
+            TARGET GooseFEM::cholmod
+            PROPERTY INTERFACE_COMPILE_DEFINITIONS
+            GOOSEFEM_USE_CHOLMOD)
+    endif()
+endif()
+
+# Define support target "GooseFEM::pardiso"
+
+if(NOT TARGET GooseFEM::pardiso)
+    find_package(MKL CONFIG QUIET)
+    if(TARGET MKL::MKL)
+        add_library(GooseFEM::pardiso INTERFACE IMPORTED)
+        set_property(
+            TARGET GooseFEM::pardiso
+            PROPERTY INTERFACE_LINK_LIBRARIES
+            MKL::MKL)
+        set_property(
+            TARGET GooseFEM::pardiso
+            PROPERTY INTERFACE_COMPILE_DEFINITIONS
+            GOOSEFEM_USE_PARDISO)
+    endif()
+endif()
+
+# Define support target "GooseFEM::pastix"
+
+if(NOT TARGET GooseFEM::pastix)
+    find_path(GOOSEFEM_PASTIX_INCLUDE_DIR pastix.h)
+    find_library(GOOSEFEM_PASTIX_LIBRARY pastix)
+    if(GOOSEFEM_PASTIX_INCLUDE_DIR AND GOOSEFEM_PASTIX_LIBRARY)
+        add_library(GooseFEM::pastix INTERFACE IMPORTED)
+        set_property(
+            TARGET GooseFEM::pastix
+            PROPERTY INTERFACE_INCLUDE_DIRECTORIES
+            ${GOOSEFEM_PASTIX_INCLUDE_DIR})
+        set_property(
+            TARGET GooseFEM::pastix
+            PROPERTY INTERFACE_LINK_LIBRARIES
+            ${GOOSEFEM_PASTIX_LIBRARY})
+        set_property(
+            TARGET GooseFEM::pastix
+            PROPERTY INTERFACE_COMPILE_DEFINITIONS
+            GOOSEFEM_USE_PASTIX)
+    endif()
+endif()
@@ -0,0 +1,87 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_AMG_H
+#define GOOSEFEM_AMG_H
+
+#include "config.h"
+#include "Multigrid.h"
+
+/*
+  Algebraic multigrid preconditioner by smoothed aggregation, following Eigen's preconditioner
+  concept (e.g. "Eigen::ConjugateGradient<..., GooseFEM::AMG>", see
+  "LinearSolver::ConjugateGradientAMG").
+
+  The DOFs are aggregated per node (on the graph of strong couplings between nodes), and the
+  near-nullspace (e.g. the rigid body modes of linear elasticity, see "setRigidBodyModes") is
+  interpolated exactly by the tentative prolongator of each aggregate. The prolongator is smoothed
+  by one damped Jacobi iteration, and the hierarchy is applied as the V-cycle of
+  "detail::Multigrid".
+
+  The matrix is read through its upper triangle (it can thus be stored in full or in symmetric
+  mode). Without near-nullspace every DOF is a node, and the constant vector is used.
+*/
+
+namespace GooseFEM {
+
+class AMG : public detail::Multigrid {
+public:
+    // Constructors
+    AMG() = default;
+
+    // Rigid body modes of the rows "iiu" of the system (e.g. "MatrixPartitioned::iiu()"):
+    // row "k" corresponds to DOF "iiu(k)" as numbered by "dofs" [nnode, ndim]
+    // (translations, and rotation(s) around the centre of "coor" [nnode, ndim])
+    void setRigidBodyModes(
+        const xt::xtensor<double, 2>& coor,
+        const xt::xtensor<size_t, 2>& dofs,
+        const xt::xtensor<size_t, 1>& iiu);
+
+    // General near-nullspace [nrow, nmode], and the node of each row [nrow]
+    void setNearNullspace(const xt::xtensor<double, 2>& B, const xt::xtensor<size_t, 1>& node);
+
+    // Parameters
+    void setCoarseSize(size_t n); // stop coarsening at "n" rows (default: 500)
+    void setMaxLevels(size_t n); // maximum number of levels (default: 10)
+    void setThreshold(double theta); // strength of coupling (default: 0.08, halved per level)
+
+    // Eigen's preconditioner concept
+    template <class MatrixType>
+    AMG& analyzePattern(const MatrixType& A);
+
+    template <class MatrixType>
+    AMG& factorize(const MatrixType& A);
+
+    template <class MatrixType>
+    AMG& compute(const MatrixType& A);
+
+private:
+    // Setup the hierarchy from the (full) matrix
+    void setup(Eigen::SparseMatrix<double, Eigen::RowMajor>&& A);
+
+    // Aggregate the nodes of a level: aggregate of each node, returns the number of aggregates
+    size_t aggregate(
+        const Eigen::SparseMatrix<double, Eigen::RowMajor>& A,
+        const std::vector<size_t>& node,
+        size_t nnode,
+        double theta,
+        std::vector<size_t>& agg) const;
+
+    // Near-nullspace [nrow, nmode] and node of each row [nrow]
+    Eigen::MatrixXd m_B;
+    std::vector<size_t> m_node;
+
+    // Parameters
+    size_t m_ncoarse = 500;
+    size_t m_nlevels = 10;
+    double m_theta = 0.08;
+};
+
+} // namespace GooseFEM
+
+#include "AMG.hpp"
+
+#endif
@@ -0,0 +1,366 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_AMG_HPP
+#define GOOSEFEM_AMG_HPP
+
+#include "AMG.h"
+
+namespace GooseFEM {
+
+inline void AMG::setRigidBodyModes(
+    const xt::xtensor<double, 2>& coor,
+    const xt::xtensor<size_t, 2>& dofs,
+    const xt::xtensor<size_t, 1>& iiu)
+{
+    size_t nnode = coor.shape(0);
+    size_t ndim = coor.shape(1);
+    size_t ndof = xt::amax(dofs)() + 1;
+    size_t nmode = ndim == 2 ? 3 : 6;
+
+    GOOSEFEM_ASSERT(ndim == 2 || ndim == 3);
+    GOOSEFEM_ASSERT(xt::has_shape(dofs, coor.shape()));
+    GOOSEFEM_ASSERT(xt::amax(iiu)() < ndof);
+
+    // node and direction of each DOF (the first one, if nodes share DOFs)
+
+    std::vector<size_t> dnode(ndof, nnode);
+    std::vector<size_t> ddir(ndof, 0);
+
+    for (size_t m = 0; m < nnode; ++m) {
+        for (size_t i = 0; i < ndim; ++i) {
+            if (dnode[dofs(m, i)] == nnode) {
+                dnode[dofs(m, i)] = m;
+                ddir[dofs(m, i)] = i;
+            }
+        }
+    }
+
+    xt::xtensor<double, 1> centre = xt::mean(coor, 0);
+    xt::xtensor<double, 2> B = xt::zeros<double>({iiu.size(), nmode});
+    xt::xtensor<size_t, 1> node = xt::empty<size_t>({iiu.size()});
+
+    for (size_t k = 0; k < iiu.size(); ++k) {
+
+        size_t m = dnode[iiu(k)];
+        size_t i = ddir[iiu(k)];
+        node(k) = m;
+
+        double x = coor(m, 0) - centre(0);
+        double y = coor(m, 1) - centre(1);
+
+        // translation
+        B(k, i) = 1.0;
+
+        // rotation around the z-axis
+        if (ndim == 2) {
+            B(k, 2) = i == 0 ? -y : x;
+            continue;
+        }
+
+        double z = coor(m, 2) - centre(2);
+
+        // rotations around the x-, y-, and z-axis
+        B(k, 3) = i == 1 ? -z : (i == 2 ? y : 0.0);
+        B(k, 4) = i == 0 ? z : (i == 2 ? -x : 0.0);
+        B(k, 5) = i == 0 ? -y : (i == 1 ? x : 0.0);
+    }
+
+    this->setNearNullspace(B, node);
+}
+
+inline void
+AMG::setNearNullspace(const xt::xtensor<double, 2>& B, const xt::xtensor<size_t, 1>& node)
+{
+    GOOSEFEM_ASSERT(B.shape(0) == node.size());
+
+    m_B.resize(B.shape(0), B.shape(1));
+    m_node.resize(node.size());
+
+    for (size_t k = 0; k < node.size(); ++k) {
+        m_node[k] = node(k);
+        for (size_t j = 0; j < B.shape(1); ++j) {
+            m_B(k, j) = B(k, j);
+        }
+    }
+}
+
+inline void AMG::setCoarseSize(size_t n)
+{
+    m_ncoarse = n;
+}
+
+inline void AMG::setMaxLevels(size_t n)
+{
+    GOOSEFEM_ASSERT(n > 0);
+    m_nlevels = n;
+}
+
+inline void AMG::setThreshold(double theta)
+{
+    m_theta = theta;
+}
+
+template <class MatrixType>
+inline AMG& AMG::analyzePattern(const MatrixType&)
+{
+    return *this;
+}
+
+template <class MatrixType>
+inline AMG& AMG::factorize(const MatrixType& A)
+{
+    this->setup(this->full(A));
+    return *this;
+}
+
+template <class MatrixType>
+inline AMG& AMG::compute(const MatrixType& A)
+{
+    return this->factorize(A);
+}
+
+inline void AMG::setup(Eigen::SparseMatrix<double, Eigen::RowMajor>&& A)
+{
+    size_t n = static_cast<size_t>(A.rows());
+    const size_t none = std::numeric_limits<size_t>::max();
+
+    // near-nullspace and node of each row (renumbered contiguously) of the finest level
+
+    Eigen::MatrixXd B;
+    std::vector<size_t> node(n);
+    size_t nnode = 0;
+
+    if (m_B.rows() > 0) {
+        GOOSEFEM_CHECK(static_cast<size_t>(m_B.rows()) == n);
+        B = m_B;
+        std::vector<size_t> index(*std::max_element(m_node.begin(), m_node.end()) + 1, none);
+        for (size_t r = 0; r < n; ++r) {
+            if (index[m_node[r]] == none) {
+                index[m_node[r]] = nnode++;
+            }
+            node[r] = index[m_node[r]];
+        }
+    }
+    else {
+        B = Eigen::MatrixXd::Ones(n, 1);
+        std::iota(node.begin(), node.end(), 0);
+        nnode = n;
+    }
+
+    size_t nmode = static_cast<size_t>(B.cols());
+    double theta = m_theta;
+
+    m_levels.clear();
+    m_levels.emplace_back();
+    m_levels.back().A = std::move(A);
+
+    while (true) {
+
+        size_t l = m_levels.size() - 1;
+        n = static_cast<size_t>(m_levels[l].A.rows());
+
+        if (n <= m_ncoarse || m_levels.size() >= m_nlevels) {
+            break;
+        }
+
+        std::vector<size_t> agg;
+        size_t nagg = this->aggregate(m_levels[l].A, node, nnode, theta, agg);
+
+        if (nagg == nnode) {
+            break;
+        }
+
+        // tentative prolongator: orthonormal basis of the near-nullspace on each aggregate
+
+        std::vector<std::vector<size_t>> rows(nagg);
+
+        for (size_t r = 0; r < n; ++r) {
+            rows[agg[node[r]]].push_back(r);
+        }
+
+        std::vector<Eigen::Triplet<double>> T;
+        Eigen::MatrixXd Bc(nagg * nmode, nmode);
+        std::vector<size_t> nodec;
+        size_t nc = 0;
+        T.reserve(n * nmode);
+        nodec.reserve(nagg * nmode);
+
+        for (size_t g = 0; g < nagg; ++g) {
+
+            size_t nr = rows[g].size();
+            size_t k = std::min(nr, nmode);
+            Eigen::MatrixXd Bg(nr, nmode);
+
+            for (size_t a = 0; a < nr; ++a) {
+                Bg.row(a) = B.row(rows[g][a]);
+            }
+
+            Eigen::HouseholderQR<Eigen::MatrixXd> qr(Bg);
+            Eigen::MatrixXd Q = qr.householderQ() * Eigen::MatrixXd::Identity(nr, k);
+            Bc.middleRows(nc, k) = qr.matrixQR().topRows(k).triangularView<Eigen::Upper>();
+
+            for (size_t a = 0; a < nr; ++a) {
+                for (size_t c = 0; c < k; ++c) {
+                    T.push_back(Eigen::Triplet<double>(rows[g][a], nc + c, Q(a, c)));
+                }
+            }
+
+            nodec.insert(nodec.end(), k, g);
+            nc += k;
+        }
+
+        Eigen::SparseMatrix<double, Eigen::RowMajor> P(n, nc);
+        P.setFromTriplets(T.begin(), T.end());
+
+        // smoothed prolongator: P = (I - omega * D^-1 * A) * P_tent,
+        // and Galerkin coarse matrix: A_c = P^T * A * P
+
+        m_levels[l].D = this->jacobi(m_levels[l].A);
+        Eigen::SparseMatrix<double, Eigen::RowMajor> AP = m_levels[l].A * P;
+        m_levels[l].P = P - m_levels[l].D.asDiagonal() * AP;
+        this->coarsen();
+
+        B = Bc.topRows(nc);
+        node = std::move(nodec);
+        nnode = nagg;
+        theta *= 0.5;
+    }
+
+    this->finalize();
+}
+
+inline size_t AMG::aggregate(
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& A,
+    const std::vector<size_t>& node,
+    size_t nnode,
+    double theta,
+    std::vector<size_t>& agg) const
+{
+    using iterator = Eigen::SparseMatrix<double, Eigen::RowMajor>::InnerIterator;
+    const size_t none = std::numeric_limits<size_t>::max();
+
+    // rows of each node
+
+    std::vector<size_t> rptr(nnode + 1, 0);
+    std::vector<size_t> rrow(node.size());
+
+    for (size_t r = 0; r < node.size(); ++r) {
+        rptr[node[r] + 1]++;
+    }
+
+    std::partial_sum(rptr.begin(), rptr.end(), rptr.begin());
+    std::vector<size_t> next(rptr.begin(), rptr.end() - 1);
+
+    for (size_t r = 0; r < node.size(); ++r) {
+        rrow[next[node[r]]++] = r;
+    }
+
+    // graph of the nodes: (squared) Frobenius norm of the coupling blocks
+
+    std::vector<size_t> gptr(nnode + 1, 0);
+    std::vector<size_t> gcol;
+    std::vector<double> gval;
+    std::vector<ptrdiff_t> pos(nnode, -1);
+
+    for (size_t a = 0; a < nnode; ++a) {
+        ptrdiff_t start = static_cast<ptrdiff_t>(gcol.size());
+        for (size_t k = rptr[a]; k < rptr[a + 1]; ++k) {
+            for (iterator it(A, static_cast<Eigen::Index>(rrow[k])); it; ++it) {
+                size_t b = node[it.col()];
+                if (pos[b] < start) {
+                    pos[b] = static_cast<ptrdiff_t>(gcol.size());
+                    gcol.push_back(b);
+                    gval.push_back(0.0);
+                }
+                gval[pos[b]] += it.value() * it.value();
+            }
+        }
+        gptr[a + 1] = gcol.size();
+    }
+
+    std::vector<double> diag(nnode, 0.0);
+
+    for (size_t a = 0; a < nnode; ++a) {
+        for (size_t k = gptr[a]; k < gptr[a + 1]; ++k) {
+            gval[k] = std::sqrt(gval[k]);
+            if (gcol[k] == a) {
+                diag[a] = gval[k];
+            }
+        }
+    }
+
+    // strong couplings: |A_ab| > theta * sqrt(|A_aa| * |A_bb|)
+
+    std::vector<std::vector<size_t>> strong(nnode);
+
+    for (size_t a = 0; a < nnode; ++a) {
+        for (size_t k = gptr[a]; k < gptr[a + 1]; ++k) {
+            size_t b = gcol[k];
+            if (b != a && gval[k] > theta * std::sqrt(diag[a] * diag[b])) {
+                strong[a].push_back(b);
+            }
+        }
+    }
+
+    // aggregate (1): a node and its strong neighbours, if none of them is aggregated yet
+
+    agg.assign(nnode, none);
+    size_t nagg = 0;
+
+    for (size_t a = 0; a < nnode; ++a) {
+        if (agg[a] != none) {
+            continue;
+        }
+        bool free = std::all_of(
+            strong[a].begin(), strong[a].end(), [&](size_t b) { return agg[b] == none; });
+        if (!free) {
+            continue;
+        }
+        agg[a] = nagg;
+        for (size_t b : strong[a]) {
+            agg[b] = nagg;
+        }
+        ++nagg;
+    }
+
+    // aggregate (2): join the aggregate of a strong neighbour
+
+    std::vector<size_t> agg1 = agg;
+
+    for (size_t a = 0; a < nnode; ++a) {
+        if (agg[a] != none) {
+            continue;
+        }
+        for (size_t b : strong[a]) {
+            if (agg1[b] != none) {
+                agg[a] = agg1[b];
+                break;
+            }
+        }
+    }
+
+    // aggregate (3): the remaining nodes and their remaining strong neighbours
+
+    for (size_t a = 0; a < nnode; ++a) {
+        if (agg[a] != none) {
+            continue;
+        }
+        agg[a] = nagg;
+        for (size_t b : strong[a]) {
+            if (agg[b] == none) {
+                agg[b] = nagg;
+            }
+        }
+        ++nagg;
+    }
+
+    return nagg;
+}
+
+} // namespace GooseFEM
+
+#endif
@@ -34,6 +34,20 @@ inline xt::xarray<double> AsTensor(size_t rank, const T& arg, size_t n);
 
 inline xt::xtensor<double, 2> as3d(const xt::xtensor<double, 2>& data);
 
+// "First-touch" initialisation: write an array in parallel over its first axis (elements, nodes),
+// with the same static schedule as the OpenMP loops in GooseFEM. On NUMA systems each memory page
+// is thereby placed on the socket of the thread that later processes it.
+// (Pin threads to cores, e.g. "OMP_PROC_BIND=close" and "OMP_PLACES=cores", to profit.)
+
+template <class T>
+inline void firstTouch(T& arg, typename T::value_type val = 0);
+
+template <class T>
+inline void firstTouchCopy(const T& arg, T& ret);
+
+template <class T>
+inline T FirstTouchCopy(const T& arg);
+
 } // namespace GooseFEM
 
 #include "Allocate.hpp"
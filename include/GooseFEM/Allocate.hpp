@@ -109,6 +109,56 @@ inline xt::xtensor<double, 2> as3d(const xt::xtensor<double, 2>& data)
     return ret;
 }
 
+template <class T>
+inline void firstTouch(T& arg, typename T::value_type val)
+{
+    GOOSEFEM_ASSERT(arg.dimension() > 0);
+
+    size_t n = arg.shape(0);
+
+    if (n == 0) {
+        return;
+    }
+
+    size_t stride = arg.size() / n;
+    auto* data = arg.data();
+
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < n; ++i) {
+        std::fill(data + i * stride, data + (i + 1) * stride, val);
+    }
+}
+
+template <class T>
+inline void firstTouchCopy(const T& arg, T& ret)
+{
+    GOOSEFEM_ASSERT(arg.dimension() > 0);
+    GOOSEFEM_ASSERT(xt::has_shape(ret, arg.shape()));
+
+    size_t n = arg.shape(0);
+
+    if (n == 0) {
+        return;
+    }
+
+    size_t stride = arg.size() / n;
+    const auto* src = arg.data();
+    auto* data = ret.data();
+
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < n; ++i) {
+        std::copy(src + i * stride, src + (i + 1) * stride, data + i * stride);
+    }
+}
+
+template <class T>
+inline T FirstTouchCopy(const T& arg)
+{
+    T ret = xt::empty<typename T::value_type>(arg.shape());
+    GooseFEM::firstTouchCopy(arg, ret);
+    return ret;
+}
+
 } // namespace GooseFEM
 
 #endif
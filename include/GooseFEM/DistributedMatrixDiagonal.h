@@ -0,0 +1,73 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_DISTRIBUTEDMATRIXDIAGONAL_H
+#define GOOSEFEM_DISTRIBUTEDMATRIXDIAGONAL_H
+
+#include "config.h"
+#include "DistributedTopology.h"
+#include "MatrixDiagonal.h"
+
+namespace GooseFEM {
+namespace Distributed {
+
+/*
+  Diagonal matrix (e.g. lumped mass matrix) on the local DOFs of this rank.
+  Assembly is followed by a halo exchange, such that the product and solve are purely local
+  (for "nodevec"/"dofval" that are assembled/exchanged).
+*/
+
+class MatrixDiagonal {
+public:
+    // Constructors
+    MatrixDiagonal() = default;
+    MatrixDiagonal(const Topology& topology);
+
+    // Dimensions
+    size_t nelem() const; // number of local elements
+    size_t nne() const;   // number of nodes per element
+    size_t nnode() const; // number of local nodes
+    size_t ndim() const;  // number of dimensions
+    size_t ndof() const;  // number of local DOFs
+
+    // Domain decomposition, and local matrix
+    const Topology& topology() const;
+    const GooseFEM::MatrixDiagonal& local() const;
+
+    // Assemble from matrices stored per (local) element [nelem, nne*ndim, nne*ndim]
+    void assemble(const xt::xtensor<double, 3>& elemmat);
+
+    // Dot-product:
+    // b_i = A_ij * x_j
+    void dot(const xt::xtensor<double, 2>& x, xt::xtensor<double, 2>& b) const;
+    void dot(const xt::xtensor<double, 1>& x, xt::xtensor<double, 1>& b) const;
+
+    // Solve:
+    // x = A \ b
+    void solve(const xt::xtensor<double, 2>& b, xt::xtensor<double, 2>& x);
+    void solve(const xt::xtensor<double, 1>& b, xt::xtensor<double, 1>& x);
+
+    // Return matrix as diagonal matrix (column, local DOFs)
+    xt::xtensor<double, 1> Todiagonal() const;
+
+    // Auto-allocation of the functions above
+    xt::xtensor<double, 2> Dot(const xt::xtensor<double, 2>& x) const;
+    xt::xtensor<double, 1> Dot(const xt::xtensor<double, 1>& x) const;
+    xt::xtensor<double, 2> Solve(const xt::xtensor<double, 2>& b);
+    xt::xtensor<double, 1> Solve(const xt::xtensor<double, 1>& b);
+
+private:
+    // Domain decomposition, and local matrix
+    Topology m_dist;
+    GooseFEM::MatrixDiagonal m_local;
+};
+
+} // namespace Distributed
+} // namespace GooseFEM
+
+#include "DistributedMatrixDiagonal.hpp"
+
+#endif
@@ -0,0 +1,111 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_DISTRIBUTEDMATRIXDIAGONAL_HPP
+#define GOOSEFEM_DISTRIBUTEDMATRIXDIAGONAL_HPP
+
+#include "DistributedMatrixDiagonal.h"
+
+namespace GooseFEM {
+namespace Distributed {
+
+inline MatrixDiagonal::MatrixDiagonal(const Topology& topology)
+    : m_dist(topology), m_local(topology.local())
+{
+}
+
+inline size_t MatrixDiagonal::nelem() const
+{
+    return m_local.nelem();
+}
+
+inline size_t MatrixDiagonal::nne() const
+{
+    return m_local.nne();
+}
+
+inline size_t MatrixDiagonal::nnode() const
+{
+    return m_local.nnode();
+}
+
+inline size_t MatrixDiagonal::ndim() const
+{
+    return m_local.ndim();
+}
+
+inline size_t MatrixDiagonal::ndof() const
+{
+    return m_local.ndof();
+}
+
+inline const Topology& MatrixDiagonal::topology() const
+{
+    return m_dist;
+}
+
+inline const GooseFEM::MatrixDiagonal& MatrixDiagonal::local() const
+{
+    return m_local;
+}
+
+inline void MatrixDiagonal::assemble(const xt::xtensor<double, 3>& elemmat)
+{
+    m_local.assemble(elemmat);
+    xt::xtensor<double, 1> A = m_local.Todiagonal();
+    m_dist.exchange(A);
+    m_local.set(A);
+}
+
+inline void MatrixDiagonal::dot(const xt::xtensor<double, 2>& x, xt::xtensor<double, 2>& b) const
+{
+    m_local.dot(x, b);
+}
+
+inline void MatrixDiagonal::dot(const xt::xtensor<double, 1>& x, xt::xtensor<double, 1>& b) const
+{
+    m_local.dot(x, b);
+}
+
+inline void MatrixDiagonal::solve(const xt::xtensor<double, 2>& b, xt::xtensor<double, 2>& x)
+{
+    m_local.solve(b, x);
+}
+
+inline void MatrixDiagonal::solve(const xt::xtensor<double, 1>& b, xt::xtensor<double, 1>& x)
+{
+    m_local.solve(b, x);
+}
+
+inline xt::xtensor<double, 1> MatrixDiagonal::Todiagonal() const
+{
+    return m_local.Todiagonal();
+}
+
+inline xt::xtensor<double, 2> MatrixDiagonal::Dot(const xt::xtensor<double, 2>& x) const
+{
+    return m_local.Dot(x);
+}
+
+inline xt::xtensor<double, 1> MatrixDiagonal::Dot(const xt::xtensor<double, 1>& x) const
+{
+    return m_local.Dot(x);
+}
+
+inline xt::xtensor<double, 2> MatrixDiagonal::Solve(const xt::xtensor<double, 2>& b)
+{
+    return m_local.Solve(b);
+}
+
+inline xt::xtensor<double, 1> MatrixDiagonal::Solve(const xt::xtensor<double, 1>& b)
+{
+    return m_local.Solve(b);
+}
+
+} // namespace Distributed
+} // namespace GooseFEM
+
+#endif
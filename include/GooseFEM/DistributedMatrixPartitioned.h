@@ -0,0 +1,137 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_DISTRIBUTEDMATRIXPARTITIONED_H
+#define GOOSEFEM_DISTRIBUTEDMATRIXPARTITIONED_H
+
+#include "config.h"
+#include "DistributedTopology.h"
+#include "MatrixPartitioned.h"
+#include "VectorPartitioned.h"
+
+namespace GooseFEM {
+namespace Distributed {
+
+// forward declaration
+class MatrixPartitionedSolver;
+
+/*
+  Sparse matrix, partitioned in unknown and prescribed DOFs, on the local DOFs of this rank.
+  Every rank stores (only) the contribution of its own elements: the product is completed by a
+  halo exchange. The matrix is never assembled globally, it can only be solved iteratively
+  (see "Distributed::MatrixPartitionedSolver").
+*/
+
+class MatrixPartitioned {
+public:
+    // Constructors
+    MatrixPartitioned() = default;
+    MatrixPartitioned(const Topology& topology);
+
+    // Dimensions
+    size_t nelem() const; // number of local elements
+    size_t nne() const;   // number of nodes per element
+    size_t nnode() const; // number of local nodes
+    size_t ndim() const;  // number of dimensions
+    size_t ndof() const;  // number of local DOFs
+    size_t nnu() const;   // number of local unknown DOFs
+    size_t nnp() const;   // number of local prescribed DOFs
+
+    // Domain decomposition, and local matrix (contribution of the local elements only)
+    const Topology& topology() const;
+    const GooseFEM::MatrixPartitioned& local() const;
+
+    // Assemble from matrices stored per (local) element [nelem, nne*ndim, nne*ndim]
+    void assemble(const xt::xtensor<double, 3>& elemmat);
+
+    // Dot-product for the unknown DOFs (input "x_u", "x_p" are the same on all ranks):
+    // b_u = A_uu * x_u + A_up * x_p
+    void dot_u(
+        const xt::xtensor<double, 1>& x_u,
+        const xt::xtensor<double, 1>& x_p,
+        xt::xtensor<double, 1>& b_u) const;
+
+    // Diagonal of "A_uu" (assembled)
+    const xt::xtensor<double, 1>& diagonal_u() const;
+
+    // Auto-allocation of the functions above
+    xt::xtensor<double, 1> Dot_u(
+        const xt::xtensor<double, 1>& x_u, const xt::xtensor<double, 1>& x_p) const;
+
+private:
+    // Domain decomposition, local matrix, local vector-definition
+    Topology m_dist;
+    GooseFEM::MatrixPartitioned m_local;
+    GooseFEM::VectorPartitioned m_vector;
+
+    // Diagonal of "A_uu" (assembled)
+    xt::xtensor<double, 1> m_diag_u;
+
+    // grant access to solver class
+    friend class MatrixPartitionedSolver;
+};
+
+/*
+  Conjugate gradient solver (with Jacobi preconditioner) for "Distributed::MatrixPartitioned".
+  Convergence is reached when |r_u| <= rtol * |b_u - A_up * x_p|.
+*/
+
+class MatrixPartitionedSolver {
+public:
+    // Constructors
+    MatrixPartitionedSolver() = default;
+    MatrixPartitionedSolver(double rtol, size_t maxiter = 0); // "maxiter = 0": global #DOFs
+
+    // Solve (on input "x_u" is used as initial guess):
+    // x_u = A_uu \ ( b_u - A_up * x_p )
+    void solve(
+        MatrixPartitioned& matrix,
+        const xt::xtensor<double, 2>& b,
+        xt::xtensor<double, 2>& x); // modified with "x_u"
+
+    void solve_u(
+        MatrixPartitioned& matrix,
+        const xt::xtensor<double, 1>& b_u,
+        const xt::xtensor<double, 1>& x_p,
+        xt::xtensor<double, 1>& x_u);
+
+    // Number of iterations of the last solve
+    size_t iterations() const;
+
+    // Auto-allocation of the functions above
+    xt::xtensor<double, 2> Solve(
+        MatrixPartitioned& matrix,
+        const xt::xtensor<double, 2>& b,
+        const xt::xtensor<double, 2>& x);
+
+    xt::xtensor<double, 1> Solve_u(
+        MatrixPartitioned& matrix,
+        const xt::xtensor<double, 1>& b_u,
+        const xt::xtensor<double, 1>& x_p);
+
+private:
+    // Settings
+    double m_rtol = 1e-10;
+    size_t m_maxiter = 0;
+
+    // Number of iterations of the last solve
+    size_t m_iter = 0;
+
+    // Workspace (re-used for each solve)
+    xt::xtensor<double, 1> m_r;
+    xt::xtensor<double, 1> m_z;
+    xt::xtensor<double, 1> m_p;
+    xt::xtensor<double, 1> m_q;
+    xt::xtensor<double, 1> m_zero_u;
+    xt::xtensor<double, 1> m_zero_p;
+};
+
+} // namespace Distributed
+} // namespace GooseFEM
+
+#include "DistributedMatrixPartitioned.hpp"
+
+#endif
@@ -0,0 +1,235 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_DISTRIBUTEDMATRIXPARTITIONED_HPP
+#define GOOSEFEM_DISTRIBUTEDMATRIXPARTITIONED_HPP
+
+#include "DistributedMatrixPartitioned.h"
+
+namespace GooseFEM {
+namespace Distributed {
+
+inline MatrixPartitioned::MatrixPartitioned(const Topology& topology)
+    : m_dist(topology), m_local(topology.local()), m_vector(topology.local())
+{
+    GOOSEFEM_ASSERT(m_dist.isPartitioned());
+    m_diag_u = xt::zeros<double>({m_dist.nnu()});
+}
+
+inline size_t MatrixPartitioned::nelem() const
+{
+    return m_local.nelem();
+}
+
+inline size_t MatrixPartitioned::nne() const
+{
+    return m_local.nne();
+}
+
+inline size_t MatrixPartitioned::nnode() const
+{
+    return m_local.nnode();
+}
+
+inline size_t MatrixPartitioned::ndim() const
+{
+    return m_local.ndim();
+}
+
+inline size_t MatrixPartitioned::ndof() const
+{
+    return m_local.ndof();
+}
+
+inline size_t MatrixPartitioned::nnu() const
+{
+    return m_local.nnu();
+}
+
+inline size_t MatrixPartitioned::nnp() const
+{
+    return m_local.nnp();
+}
+
+inline const Topology& MatrixPartitioned::topology() const
+{
+    return m_dist;
+}
+
+inline const GooseFEM::MatrixPartitioned& MatrixPartitioned::local() const
+{
+    return m_local;
+}
+
+inline void MatrixPartitioned::assemble(const xt::xtensor<double, 3>& elemmat)
+{
+    size_t nelem = m_local.nelem();
+    size_t nne = m_local.nne();
+    size_t ndim = m_local.ndim();
+
+    GOOSEFEM_ASSERT(xt::has_shape(elemmat, {nelem, nne * ndim, nne * ndim}));
+
+    m_local.assemble(elemmat);
+
+    // diagonal (for the preconditioner)
+
+    xt::xtensor<double, 3> elemvec = xt::empty<double>({nelem, nne, ndim});
+
+    #pragma omp parallel for
+    for (size_t e = 0; e < nelem; ++e) {
+        for (size_t m = 0; m < nne; ++m) {
+            for (size_t i = 0; i < ndim; ++i) {
+                elemvec(e, m, i) = elemmat(e, m * ndim + i, m * ndim + i);
+            }
+        }
+    }
+
+    m_vector.assembleDofs_u(elemvec, m_diag_u);
+    m_dist.exchange_u(m_diag_u);
+}
+
+inline void MatrixPartitioned::dot_u(
+    const xt::xtensor<double, 1>& x_u,
+    const xt::xtensor<double, 1>& x_p,
+    xt::xtensor<double, 1>& b_u) const
+{
+    m_local.dot_u(x_u, x_p, b_u);
+    m_dist.exchange_u(b_u);
+}
+
+inline const xt::xtensor<double, 1>& MatrixPartitioned::diagonal_u() const
+{
+    return m_diag_u;
+}
+
+inline xt::xtensor<double, 1> MatrixPartitioned::Dot_u(
+    const xt::xtensor<double, 1>& x_u, const xt::xtensor<double, 1>& x_p) const
+{
+    xt::xtensor<double, 1> b_u = xt::empty<double>({m_local.nnu()});
+    this->dot_u(x_u, x_p, b_u);
+    return b_u;
+}
+
+inline MatrixPartitionedSolver::MatrixPartitionedSolver(double rtol, size_t maxiter)
+    : m_rtol(rtol), m_maxiter(maxiter)
+{
+}
+
+inline size_t MatrixPartitionedSolver::iterations() const
+{
+    return m_iter;
+}
+
+inline void MatrixPartitionedSolver::solve_u(
+    MatrixPartitioned& matrix,
+    const xt::xtensor<double, 1>& b_u,
+    const xt::xtensor<double, 1>& x_p,
+    xt::xtensor<double, 1>& x_u)
+{
+    size_t nnu = matrix.m_dist.nnu();
+    size_t nnp = matrix.m_dist.nnp();
+    size_t maxiter = m_maxiter > 0 ? m_maxiter : matrix.m_dist.ndofGlobal();
+
+    GOOSEFEM_ASSERT(b_u.size() == nnu);
+    GOOSEFEM_ASSERT(x_p.size() == nnp);
+    GOOSEFEM_ASSERT(x_u.size() == nnu);
+
+    const auto& dist = matrix.m_dist;
+    const auto& diag = matrix.m_diag_u;
+
+    if (m_r.size() != nnu || m_zero_p.size() != nnp) {
+        m_r = xt::empty<double>({nnu});
+        m_z = xt::empty<double>({nnu});
+        m_p = xt::empty<double>({nnu});
+        m_q = xt::empty<double>({nnu});
+        m_zero_u = xt::zeros<double>({nnu});
+        m_zero_p = xt::zeros<double>({nnp});
+    }
+
+    // reference: |b_u - A_up * x_p|
+
+    matrix.dot_u(m_zero_u, x_p, m_q);
+    xt::noalias(m_q) = b_u - m_q;
+    double tol = m_rtol * std::sqrt(dist.dot_u(m_q, m_q));
+
+    if (tol == 0.0) {
+        x_u.fill(0.0);
+        m_iter = 0;
+        return;
+    }
+
+    // residual: r_u = b_u - A_uu * x_u - A_up * x_p
+
+    matrix.dot_u(x_u, x_p, m_r);
+    xt::noalias(m_r) = b_u - m_r;
+
+    xt::noalias(m_z) = m_r / diag;
+    xt::noalias(m_p) = m_z;
+    double rz = dist.dot_u(m_r, m_z);
+
+    for (m_iter = 0; m_iter < maxiter; ++m_iter) {
+
+        if (std::sqrt(dist.dot_u(m_r, m_r)) <= tol) {
+            return;
+        }
+
+        matrix.dot_u(m_p, m_zero_p, m_q);
+        double alpha = rz / dist.dot_u(m_p, m_q);
+        xt::noalias(x_u) += alpha * m_p;
+        xt::noalias(m_r) -= alpha * m_q;
+
+        xt::noalias(m_z) = m_r / diag;
+        double rz_new = dist.dot_u(m_r, m_z);
+        xt::noalias(m_p) = m_z + (rz_new / rz) * m_p;
+        rz = rz_new;
+    }
+
+    GOOSEFEM_CHECK(std::sqrt(dist.dot_u(m_r, m_r)) <= tol);
+}
+
+inline void MatrixPartitionedSolver::solve(
+    MatrixPartitioned& matrix,
+    const xt::xtensor<double, 2>& b,
+    xt::xtensor<double, 2>& x)
+{
+    const auto& vector = matrix.m_vector;
+
+    GOOSEFEM_ASSERT(xt::has_shape(b, {vector.nnode(), vector.ndim()}));
+    GOOSEFEM_ASSERT(xt::has_shape(x, {vector.nnode(), vector.ndim()}));
+
+    xt::xtensor<double, 1> b_u = vector.AsDofs_u(b);
+    xt::xtensor<double, 1> x_u = vector.AsDofs_u(x);
+    xt::xtensor<double, 1> x_p = vector.AsDofs_p(x);
+
+    this->solve_u(matrix, b_u, x_p, x_u);
+
+    vector.asNode(x_u, x_p, x);
+}
+
+inline xt::xtensor<double, 2> MatrixPartitionedSolver::Solve(
+    MatrixPartitioned& matrix,
+    const xt::xtensor<double, 2>& b,
+    const xt::xtensor<double, 2>& x)
+{
+    xt::xtensor<double, 2> ret = x;
+    this->solve(matrix, b, ret);
+    return ret;
+}
+
+inline xt::xtensor<double, 1> MatrixPartitionedSolver::Solve_u(
+    MatrixPartitioned& matrix,
+    const xt::xtensor<double, 1>& b_u,
+    const xt::xtensor<double, 1>& x_p)
+{
+    xt::xtensor<double, 1> x_u = xt::zeros<double>({matrix.nnu()});
+    this->solve_u(matrix, b_u, x_p, x_u);
+    return x_u;
+}
+
+} // namespace Distributed
+} // namespace GooseFEM
+
+#endif
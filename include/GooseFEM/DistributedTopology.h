@@ -0,0 +1,172 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_DISTRIBUTEDTOPOLOGY_H
+#define GOOSEFEM_DISTRIBUTEDTOPOLOGY_H
+
+#include "config.h"
+#include "Topology.h"
+
+#include <mpi.h>
+
+namespace GooseFEM {
+namespace Distributed {
+
+/*
+  Domain decomposition of a mesh over the ranks of an MPI communicator.
+
+  Each rank constructs the decomposition from its own part of the mesh: the local elements (with
+  their connectivity in global node numbers), the local nodes (with their global DOFs), and the
+  "halo": the local nodes with a DOF that may be shared with other ranks (a superset is allowed).
+  Note that a DOF can be shared also by nodes that are not (e.g. for periodicity or tyings): all
+  local nodes with such a DOF must be in the halo (as in
+  Mesh::Partition::nodesInterface(rank, dofs)). The neighbours are found by communicating only the
+  halo DOFs, such that memory and setup scale with the local mesh.
+  The nodes and DOFs are numbered locally: "local()" is a GooseFEM::Topology (with local
+  numbering) that can be used to construct any GooseFEM::Vector, GooseFEM::Matrix, ... and
+  GooseFEM::Element::*::Quadrature on the local elements.
+
+  For convenience the decomposition can also be constructed on all ranks from the same (global)
+  mesh and element partition. Note that this costs O(global mesh) memory and setup on each rank.
+
+  DOFs on the interface between ranks are stored on all ranks that share them. A DOF is owned by
+  the lowest rank that shares it. The halo exchange ("exchange") adds the (element) contributions
+  of all ranks to the shared DOFs, after which all copies are identical.
+*/
+
+class Topology {
+public:
+    // Constructors
+    Topology() = default;
+
+    // From the local part of the mesh
+    Topology(
+        const xt::xtensor<size_t, 1>& elem, // global numbers of the local elements [nelem]
+        const xt::xtensor<size_t, 2>& conn, // connectivity (global node numbers) [nelem, nne]
+        const xt::xtensor<size_t, 1>& node, // global numbers of the local nodes (sorted) [nnode]
+        const xt::xtensor<size_t, 2>& dofs, // DOFs per local node (global) [nnode, ndim]
+        const xt::xtensor<size_t, 1>& halo, // local nodes with DOFs shared with other ranks
+        MPI_Comm comm = MPI_COMM_WORLD);
+
+    Topology(
+        const xt::xtensor<size_t, 1>& elem, // global numbers of the local elements [nelem]
+        const xt::xtensor<size_t, 2>& conn, // connectivity (global node numbers) [nelem, nne]
+        const xt::xtensor<size_t, 1>& node, // global numbers of the local nodes (sorted) [nnode]
+        const xt::xtensor<size_t, 2>& dofs, // DOFs per local node (global) [nnode, ndim]
+        const xt::xtensor<size_t, 1>& halo, // local nodes with DOFs shared with other ranks
+        const xt::xtensor<size_t, 1>& iip,  // prescribed DOFs (global, a superset is allowed)
+        MPI_Comm comm = MPI_COMM_WORLD);
+
+    // From the global mesh, available on all ranks
+    Topology(
+        const xt::xtensor<size_t, 2>& conn,      // connectivity (global) [nelem, nne]
+        const xt::xtensor<size_t, 2>& dofs,      // DOFs per node (global) [nnode, ndim]
+        const xt::xtensor<size_t, 1>& elem_part, // rank of each element (global) [nelem]
+        MPI_Comm comm = MPI_COMM_WORLD);
+
+    Topology(
+        const xt::xtensor<size_t, 2>& conn,      // connectivity (global) [nelem, nne]
+        const xt::xtensor<size_t, 2>& dofs,      // DOFs per node (global) [nnode, ndim]
+        const xt::xtensor<size_t, 1>& iip,       // prescribed DOFs (global)
+        const xt::xtensor<size_t, 1>& elem_part, // rank of each element (global) [nelem]
+        MPI_Comm comm = MPI_COMM_WORLD);
+
+    // Communicator
+    MPI_Comm comm() const;
+    int rank() const;
+    int size() const;
+
+    // Local topology (local element, node, and DOF numbers)
+    const GooseFEM::Topology& local() const;
+
+    // Dimensions
+    size_t nelem() const;       // number of local elements
+    size_t nnode() const;       // number of local nodes
+    size_t ndof() const;        // number of local DOFs
+    size_t nnu() const;         // number of local unknown DOFs
+    size_t nnp() const;         // number of local prescribed DOFs
+    size_t ndofGlobal() const;  // number of DOFs of the global mesh
+    bool isPartitioned() const; // check if the DOFs are partitioned
+
+    // Global numbers of the local elements, nodes, and DOFs (nodes and DOFs sorted)
+    const xt::xtensor<size_t, 1>& elem() const; // [nelem]
+    const xt::xtensor<size_t, 1>& node() const; // [nnode]
+    const xt::xtensor<size_t, 1>& dof() const;  // [ndof]
+
+    // Local DOFs owned by this rank
+    const xt::xtensor<size_t, 1>& iio() const;
+
+    // Neighbouring ranks, and the local DOFs shared with each of them
+    const std::vector<int>& neighbours() const;
+    const std::vector<xt::xtensor<size_t, 1>>& shared() const;
+
+    // Halo exchange: add the contributions of all neighbours to the shared DOFs
+    void exchange(xt::xtensor<double, 1>& dofval) const;
+    void exchange_u(xt::xtensor<double, 1>& dofval_u) const;
+
+    // Inner product (of assembled/exchanged DOF values), reduced over all ranks
+    double dot(const xt::xtensor<double, 1>& a, const xt::xtensor<double, 1>& b) const;
+    double dot_u(const xt::xtensor<double, 1>& a_u, const xt::xtensor<double, 1>& b_u) const;
+
+    // Convert between local and global "dofval"
+    void asLocal(const xt::xtensor<double, 1>& global, xt::xtensor<double, 1>& dofval) const;
+    void gather(const xt::xtensor<double, 1>& dofval, xt::xtensor<double, 1>& global) const;
+
+    // Auto-allocation of the functions above
+    xt::xtensor<double, 1> AsLocal(const xt::xtensor<double, 1>& global) const;
+    xt::xtensor<double, 1> Gather(const xt::xtensor<double, 1>& dofval) const; // on all ranks
+
+private:
+    // Communicator
+    MPI_Comm m_comm = MPI_COMM_WORLD;
+    int m_rank = 0;
+    int m_size = 1;
+
+    // Local topology
+    GooseFEM::Topology m_local;
+
+    // Global numbers of local elements, nodes, DOFs
+    xt::xtensor<size_t, 1> m_elem;
+    xt::xtensor<size_t, 1> m_node;
+    xt::xtensor<size_t, 1> m_dof;
+    size_t m_ndof_global = 0;
+
+    // Owned DOFs (local DOF-numbers, and their position in "iiu" of the local topology)
+    xt::xtensor<size_t, 1> m_iio;
+    xt::xtensor<size_t, 1> m_iio_u;
+
+    // Halo: neighbouring ranks, shared DOFs (local DOF-numbers, and their position in "iiu")
+    std::vector<int> m_neighbours;
+    std::vector<xt::xtensor<size_t, 1>> m_shared;
+    std::vector<xt::xtensor<size_t, 1>> m_shared_u;
+
+    // Communication buffers (re-used for each exchange)
+    mutable std::vector<std::vector<double>> m_send;
+    mutable std::vector<std::vector<double>> m_recv;
+    mutable std::vector<MPI_Request> m_req;
+
+    // Construct from the local part of the mesh
+    void init(
+        const xt::xtensor<size_t, 1>& elem,
+        const xt::xtensor<size_t, 2>& conn,
+        const xt::xtensor<size_t, 1>& node,
+        const xt::xtensor<size_t, 2>& dofs,
+        const xt::xtensor<size_t, 1>& halo);
+
+    // Partition the local DOFs in unknown and prescribed DOFs (given the global "iip")
+    void init_u(const xt::xtensor<size_t, 1>& iip);
+
+    // Halo exchange of a vector, given the shared entries
+    void exchange_impl(xt::xtensor<double, 1>& x, const std::vector<xt::xtensor<size_t, 1>>& shared)
+        const;
+};
+
+} // namespace Distributed
+} // namespace GooseFEM
+
+#include "DistributedTopology.hpp"
+
+#endif
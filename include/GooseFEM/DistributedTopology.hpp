@@ -0,0 +1,592 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_DISTRIBUTEDTOPOLOGY_HPP
+#define GOOSEFEM_DISTRIBUTEDTOPOLOGY_HPP
+
+#include "DistributedTopology.h"
+
+namespace GooseFEM {
+namespace Distributed {
+
+inline Topology::Topology(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<size_t, 2>& conn,
+    const xt::xtensor<size_t, 1>& node,
+    const xt::xtensor<size_t, 2>& dofs,
+    const xt::xtensor<size_t, 1>& halo,
+    MPI_Comm comm)
+    : m_comm(comm)
+{
+    this->init(elem, conn, node, dofs, halo);
+}
+
+inline Topology::Topology(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<size_t, 2>& conn,
+    const xt::xtensor<size_t, 1>& node,
+    const xt::xtensor<size_t, 2>& dofs,
+    const xt::xtensor<size_t, 1>& halo,
+    const xt::xtensor<size_t, 1>& iip,
+    MPI_Comm comm)
+    : m_comm(comm)
+{
+    this->init(elem, conn, node, dofs, halo);
+    this->init_u(iip);
+}
+
+inline Topology::Topology(
+    const xt::xtensor<size_t, 2>& conn,
+    const xt::xtensor<size_t, 2>& dofs,
+    const xt::xtensor<size_t, 1>& elem_part,
+    MPI_Comm comm)
+    : m_comm(comm)
+{
+    GOOSEFEM_ASSERT(elem_part.size() == conn.shape(0));
+    GOOSEFEM_ASSERT(xt::amax(conn)() < dofs.shape(0));
+
+    int size;
+    int r;
+    MPI_Comm_rank(m_comm, &r);
+    MPI_Comm_size(m_comm, &size);
+
+    GOOSEFEM_ASSERT(xt::amax(elem_part)() < static_cast<size_t>(size));
+
+    size_t rank = static_cast<size_t>(r);
+    size_t nelem = conn.shape(0);
+    size_t nne = conn.shape(1);
+
+    // extract the local part of the mesh
+
+    std::vector<size_t> elem;
+    std::vector<size_t> node;
+
+    for (size_t e = 0; e < nelem; ++e) {
+        if (elem_part(e) == rank) {
+            elem.push_back(e);
+            for (size_t m = 0; m < nne; ++m) {
+                node.push_back(conn(e, m));
+            }
+        }
+    }
+
+    std::sort(node.begin(), node.end());
+    node.erase(std::unique(node.begin(), node.end()), node.end());
+
+    // halo: local nodes with a DOF of an element of another rank
+    // (not only the nodes shared with other ranks: DOFs can be shared by different nodes,
+    // e.g. for periodicity or tyings)
+
+    size_t ndim = dofs.shape(1);
+    std::vector<char> remote(xt::amax(dofs)() + 1, 0);
+
+    for (size_t e = 0; e < nelem; ++e) {
+        if (elem_part(e) != rank) {
+            for (size_t m = 0; m < nne; ++m) {
+                for (size_t i = 0; i < ndim; ++i) {
+                    remote[dofs(conn(e, m), i)] = 1;
+                }
+            }
+        }
+    }
+
+    std::vector<size_t> halo;
+
+    for (auto& n : node) {
+        for (size_t i = 0; i < ndim; ++i) {
+            if (remote[dofs(n, i)]) {
+                halo.push_back(n);
+                break;
+            }
+        }
+    }
+
+    xt::xtensor<size_t, 1> lelem = xt::adapt(elem);
+    xt::xtensor<size_t, 1> lnode = xt::adapt(node);
+    xt::xtensor<size_t, 1> lhalo = xt::adapt(halo);
+    xt::xtensor<size_t, 2> lconn = xt::view(conn, xt::keep(lelem), xt::all());
+    xt::xtensor<size_t, 2> ldofs = xt::view(dofs, xt::keep(lnode), xt::all());
+
+    // all (possibly periodic) DOFs of the global mesh are counted, also if not connected to the
+    // local elements
+
+    this->init(lelem, lconn, lnode, ldofs, lhalo);
+    m_ndof_global = xt::amax(dofs)() + 1;
+}
+
+inline Topology::Topology(
+    const xt::xtensor<size_t, 2>& conn,
+    const xt::xtensor<size_t, 2>& dofs,
+    const xt::xtensor<size_t, 1>& iip,
+    const xt::xtensor<size_t, 1>& elem_part,
+    MPI_Comm comm)
+    : Topology(conn, dofs, elem_part, comm)
+{
+    this->init_u(iip);
+}
+
+inline void Topology::init(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<size_t, 2>& conn,
+    const xt::xtensor<size_t, 1>& node,
+    const xt::xtensor<size_t, 2>& dofs,
+    const xt::xtensor<size_t, 1>& halo)
+{
+    GOOSEFEM_ASSERT(elem.size() > 0);
+    GOOSEFEM_ASSERT(elem.size() == conn.shape(0));
+    GOOSEFEM_ASSERT(node.size() == dofs.shape(0));
+    GOOSEFEM_ASSERT(std::is_sorted(node.begin(), node.end()));
+
+    MPI_Comm_rank(m_comm, &m_rank);
+    MPI_Comm_size(m_comm, &m_size);
+
+    size_t rank = static_cast<size_t>(m_rank);
+    size_t nelem = conn.shape(0);
+    size_t nne = conn.shape(1);
+    size_t nnode = dofs.shape(0);
+    size_t ndim = dofs.shape(1);
+
+    m_elem = elem;
+    m_node = node;
+
+    // number of DOFs of the global mesh
+
+    unsigned long long ndof_global = xt::amax(dofs)() + 1;
+    MPI_Allreduce(MPI_IN_PLACE, &ndof_global, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX, m_comm);
+    m_ndof_global = static_cast<size_t>(ndof_global);
+
+    // local DOFs: the DOFs of the local nodes, numbered in the order of their global number
+
+    std::vector<size_t> dof(dofs.begin(), dofs.end());
+    std::sort(dof.begin(), dof.end());
+    dof.erase(std::unique(dof.begin(), dof.end()), dof.end());
+
+    m_dof = xt::adapt(dof);
+
+    auto local_node = [&](size_t n) -> size_t {
+        auto it = std::lower_bound(node.begin(), node.end(), n);
+        GOOSEFEM_ASSERT(it != node.end() && *it == n);
+        return static_cast<size_t>(it - node.begin());
+    };
+
+    auto local_dof = [&](size_t d) -> size_t {
+        return static_cast<size_t>(std::lower_bound(dof.begin(), dof.end(), d) - dof.begin());
+    };
+
+    // local topology
+
+    xt::xtensor<size_t, 2> lconn = xt::empty<size_t>({nelem, nne});
+    xt::xtensor<size_t, 2> ldofs = xt::empty<size_t>({nnode, ndim});
+
+    for (size_t e = 0; e < nelem; ++e) {
+        for (size_t m = 0; m < nne; ++m) {
+            lconn(e, m) = local_node(conn(e, m));
+        }
+    }
+
+    for (size_t n = 0; n < nnode; ++n) {
+        for (size_t i = 0; i < ndim; ++i) {
+            ldofs(n, i) = local_dof(dofs(n, i));
+        }
+    }
+
+    m_local = GooseFEM::Topology(lconn, ldofs);
+
+    // halo DOFs (global numbers, sorted)
+
+    std::vector<unsigned long long> hdof;
+
+    for (auto& n : halo) {
+        size_t l = local_node(n);
+        for (size_t i = 0; i < ndim; ++i) {
+            hdof.push_back(dofs(l, i));
+        }
+    }
+
+    std::sort(hdof.begin(), hdof.end());
+    hdof.erase(std::unique(hdof.begin(), hdof.end()), hdof.end());
+
+    // find the ranks sharing each halo DOF: each DOF has a "home" rank (by contiguous blocks of
+    // global DOF numbers), that collects the ranks with the DOF in their halo and sends back to
+    // each of them the list of the other ranks
+
+    size_t block = (m_ndof_global + static_cast<size_t>(m_size) - 1) / static_cast<size_t>(m_size);
+    std::vector<int> scount(m_size, 0);
+    std::vector<int> sdispl(m_size, 0);
+    std::vector<int> rcount(m_size);
+    std::vector<int> rdispl(m_size, 0);
+
+    for (auto& d : hdof) {
+        scount[static_cast<size_t>(d) / block]++;
+    }
+
+    MPI_Alltoall(scount.data(), 1, MPI_INT, rcount.data(), 1, MPI_INT, m_comm);
+
+    for (int r = 1; r < m_size; ++r) {
+        sdispl[r] = sdispl[r - 1] + scount[r - 1];
+        rdispl[r] = rdispl[r - 1] + rcount[r - 1];
+    }
+
+    std::vector<unsigned long long> recv(rdispl[m_size - 1] + rcount[m_size - 1]);
+
+    MPI_Alltoallv(
+        hdof.data(), scount.data(), sdispl.data(), MPI_UNSIGNED_LONG_LONG,
+        recv.data(), rcount.data(), rdispl.data(), MPI_UNSIGNED_LONG_LONG, m_comm);
+
+    // home: (DOF, rank) sorted by DOF, reply (DOF, other rank) for each DOF shared by >= 2 ranks
+
+    std::vector<std::pair<unsigned long long, int>> entries;
+
+    for (int r = 0; r < m_size; ++r) {
+        for (int i = rdispl[r]; i < rdispl[r] + rcount[r]; ++i) {
+            entries.emplace_back(recv[i], r);
+        }
+    }
+
+    std::sort(entries.begin(), entries.end());
+
+    std::vector<std::vector<unsigned long long>> reply(m_size);
+
+    for (size_t a = 0; a < entries.size();) {
+        size_t b = a + 1;
+        while (b < entries.size() && entries[b].first == entries[a].first) {
+            ++b;
+        }
+        for (size_t i = a; i < b; ++i) {
+            for (size_t j = a; j < b; ++j) {
+                if (i != j) {
+                    reply[entries[i].second].push_back(entries[i].first);
+                    reply[entries[i].second].push_back(entries[j].second);
+                }
+            }
+        }
+        a = b;
+    }
+
+    std::vector<unsigned long long> send;
+
+    for (int r = 0; r < m_size; ++r) {
+        scount[r] = static_cast<int>(reply[r].size());
+        sdispl[r] = static_cast<int>(send.size());
+        send.insert(send.end(), reply[r].begin(), reply[r].end());
+    }
+
+    MPI_Alltoall(scount.data(), 1, MPI_INT, rcount.data(), 1, MPI_INT, m_comm);
+
+    for (int r = 1; r < m_size; ++r) {
+        rdispl[r] = rdispl[r - 1] + rcount[r - 1];
+    }
+
+    recv.resize(rdispl[m_size - 1] + rcount[m_size - 1]);
+
+    MPI_Alltoallv(
+        send.data(), scount.data(), sdispl.data(), MPI_UNSIGNED_LONG_LONG,
+        recv.data(), rcount.data(), rdispl.data(), MPI_UNSIGNED_LONG_LONG, m_comm);
+
+    // shared DOFs per neighbour (local numbers), and their owner (the lowest rank)
+
+    std::vector<std::vector<size_t>> shared(m_size);
+    std::vector<size_t> owner(dof.size(), rank);
+
+    for (size_t i = 0; i < recv.size(); i += 2) {
+        size_t d = local_dof(static_cast<size_t>(recv[i]));
+        size_t r = static_cast<size_t>(recv[i + 1]);
+        shared[r].push_back(d);
+        owner[d] = std::min(owner[d], r);
+    }
+
+    for (int r = 0; r < m_size; ++r) {
+        auto& list = shared[r];
+        if (list.size() == 0) {
+            continue;
+        }
+        std::sort(list.begin(), list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+        xt::xtensor<size_t, 1> s = xt::adapt(list);
+        m_neighbours.push_back(r);
+        m_shared.push_back(s);
+    }
+
+    std::vector<size_t> iio;
+
+    for (size_t d = 0; d < dof.size(); ++d) {
+        if (owner[d] == rank) {
+            iio.push_back(d);
+        }
+    }
+
+    m_iio = xt::adapt(iio);
+
+    m_send.resize(m_neighbours.size());
+    m_recv.resize(m_neighbours.size());
+    m_req.resize(2 * m_neighbours.size());
+}
+
+inline void Topology::init_u(const xt::xtensor<size_t, 1>& iip)
+{
+    GOOSEFEM_ASSERT(iip.size() == 0 || xt::amax(iip)() < m_ndof_global);
+
+    // prescribed DOFs present on this rank (local numbering)
+
+    std::vector<size_t> liip;
+
+    for (auto& d : iip) {
+        auto it = std::lower_bound(m_dof.begin(), m_dof.end(), d);
+        if (it != m_dof.end() && *it == d) {
+            liip.push_back(static_cast<size_t>(it - m_dof.begin()));
+        }
+    }
+
+    std::sort(liip.begin(), liip.end());
+    xt::xtensor<size_t, 1> l = xt::empty<size_t>({liip.size()});
+    std::copy(liip.begin(), liip.end(), l.begin());
+    m_local = m_local.Partition(l);
+
+    // position of each local DOF in "iiu" ("ndof" signals "prescribed")
+
+    size_t ndof = m_dof.size();
+    const auto& iiu = m_local.iiu();
+    std::vector<size_t> index(ndof, ndof);
+
+    for (size_t i = 0; i < iiu.size(); ++i) {
+        index[iiu(i)] = i;
+    }
+
+    // since "iiu" is sorted, the order of the shared DOFs is the same on all ranks
+
+    m_shared_u.clear();
+
+    for (auto& s : m_shared) {
+        std::vector<size_t> list;
+        for (auto& d : s) {
+            if (index[d] < ndof) {
+                list.push_back(index[d]);
+            }
+        }
+        xt::xtensor<size_t, 1> su = xt::empty<size_t>({list.size()});
+        std::copy(list.begin(), list.end(), su.begin());
+        m_shared_u.push_back(su);
+    }
+
+    std::vector<size_t> list;
+
+    for (auto& d : m_iio) {
+        if (index[d] < ndof) {
+            list.push_back(index[d]);
+        }
+    }
+
+    m_iio_u = xt::empty<size_t>({list.size()});
+    std::copy(list.begin(), list.end(), m_iio_u.begin());
+}
+
+inline MPI_Comm Topology::comm() const
+{
+    return m_comm;
+}
+
+inline int Topology::rank() const
+{
+    return m_rank;
+}
+
+inline int Topology::size() const
+{
+    return m_size;
+}
+
+inline const GooseFEM::Topology& Topology::local() const
+{
+    return m_local;
+}
+
+inline size_t Topology::nelem() const
+{
+    return m_local.nelem();
+}
+
+inline size_t Topology::nnode() const
+{
+    return m_local.nnode();
+}
+
+inline size_t Topology::ndof() const
+{
+    return m_local.ndof();
+}
+
+inline size_t Topology::nnu() const
+{
+    return m_local.nnu();
+}
+
+inline size_t Topology::nnp() const
+{
+    return m_local.nnp();
+}
+
+inline size_t Topology::ndofGlobal() const
+{
+    return m_ndof_global;
+}
+
+inline bool Topology::isPartitioned() const
+{
+    return m_local.isPartitioned();
+}
+
+inline const xt::xtensor<size_t, 1>& Topology::elem() const
+{
+    return m_elem;
+}
+
+inline const xt::xtensor<size_t, 1>& Topology::node() const
+{
+    return m_node;
+}
+
+inline const xt::xtensor<size_t, 1>& Topology::dof() const
+{
+    return m_dof;
+}
+
+inline const xt::xtensor<size_t, 1>& Topology::iio() const
+{
+    return m_iio;
+}
+
+inline const std::vector<int>& Topology::neighbours() const
+{
+    return m_neighbours;
+}
+
+inline const std::vector<xt::xtensor<size_t, 1>>& Topology::shared() const
+{
+    return m_shared;
+}
+
+inline void Topology::exchange_impl(
+    xt::xtensor<double, 1>& x, const std::vector<xt::xtensor<size_t, 1>>& shared) const
+{
+    size_t n = m_neighbours.size();
+
+    for (size_t i = 0; i < n; ++i) {
+
+        const auto& s = shared[i];
+        int count = static_cast<int>(s.size());
+        m_send[i].resize(s.size());
+        m_recv[i].resize(s.size());
+
+        for (size_t j = 0; j < s.size(); ++j) {
+            m_send[i][j] = x(s(j));
+        }
+
+        MPI_Irecv(m_recv[i].data(), count, MPI_DOUBLE, m_neighbours[i], 0, m_comm, &m_req[2 * i]);
+        MPI_Isend(m_send[i].data(), count, MPI_DOUBLE, m_neighbours[i], 0, m_comm, &m_req[2 * i + 1]);
+    }
+
+    MPI_Waitall(static_cast<int>(2 * n), m_req.data(), MPI_STATUSES_IGNORE);
+
+    for (size_t i = 0; i < n; ++i) {
+        const auto& s = shared[i];
+        for (size_t j = 0; j < s.size(); ++j) {
+            x(s(j)) += m_recv[i][j];
+        }
+    }
+}
+
+inline void Topology::exchange(xt::xtensor<double, 1>& dofval) const
+{
+    GOOSEFEM_ASSERT(dofval.size() == m_dof.size());
+    this->exchange_impl(dofval, m_shared);
+}
+
+inline void Topology::exchange_u(xt::xtensor<double, 1>& dofval_u) const
+{
+    GOOSEFEM_ASSERT(this->isPartitioned());
+    GOOSEFEM_ASSERT(dofval_u.size() == m_local.nnu());
+    this->exchange_impl(dofval_u, m_shared_u);
+}
+
+inline double Topology::dot(const xt::xtensor<double, 1>& a, const xt::xtensor<double, 1>& b) const
+{
+    GOOSEFEM_ASSERT(a.size() == m_dof.size());
+    GOOSEFEM_ASSERT(b.size() == m_dof.size());
+
+    double ret = 0.0;
+
+    for (auto& d : m_iio) {
+        ret += a(d) * b(d);
+    }
+
+    MPI_Allreduce(MPI_IN_PLACE, &ret, 1, MPI_DOUBLE, MPI_SUM, m_comm);
+
+    return ret;
+}
+
+inline double
+Topology::dot_u(const xt::xtensor<double, 1>& a_u, const xt::xtensor<double, 1>& b_u) const
+{
+    GOOSEFEM_ASSERT(this->isPartitioned());
+    GOOSEFEM_ASSERT(a_u.size() == m_local.nnu());
+    GOOSEFEM_ASSERT(b_u.size() == m_local.nnu());
+
+    double ret = 0.0;
+
+    for (auto& d : m_iio_u) {
+        ret += a_u(d) * b_u(d);
+    }
+
+    MPI_Allreduce(MPI_IN_PLACE, &ret, 1, MPI_DOUBLE, MPI_SUM, m_comm);
+
+    return ret;
+}
+
+inline void
+Topology::asLocal(const xt::xtensor<double, 1>& global, xt::xtensor<double, 1>& dofval) const
+{
+    GOOSEFEM_ASSERT(global.size() == m_ndof_global);
+    GOOSEFEM_ASSERT(dofval.size() == m_dof.size());
+
+    for (size_t d = 0; d < m_dof.size(); ++d) {
+        dofval(d) = global(m_dof(d));
+    }
+}
+
+inline void
+Topology::gather(const xt::xtensor<double, 1>& dofval, xt::xtensor<double, 1>& global) const
+{
+    GOOSEFEM_ASSERT(dofval.size() == m_dof.size());
+    GOOSEFEM_ASSERT(global.size() == m_ndof_global);
+
+    global.fill(0.0);
+
+    for (auto& d : m_iio) {
+        global(m_dof(d)) = dofval(d);
+    }
+
+    MPI_Allreduce(
+        MPI_IN_PLACE, global.data(), static_cast<int>(m_ndof_global), MPI_DOUBLE, MPI_SUM, m_comm);
+}
+
+inline xt::xtensor<double, 1> Topology::AsLocal(const xt::xtensor<double, 1>& global) const
+{
+    xt::xtensor<double, 1> dofval = xt::empty<double>({m_dof.size()});
+    this->asLocal(global, dofval);
+    return dofval;
+}
+
+inline xt::xtensor<double, 1> Topology::Gather(const xt::xtensor<double, 1>& dofval) const
+{
+    xt::xtensor<double, 1> global = xt::empty<double>({m_ndof_global});
+    this->gather(dofval, global);
+    return global;
+}
+
+} // namespace Distributed
+} // namespace GooseFEM
+
+#endif
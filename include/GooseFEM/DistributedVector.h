@@ -0,0 +1,104 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_DISTRIBUTEDVECTOR_H
+#define GOOSEFEM_DISTRIBUTEDVECTOR_H
+
+#include "config.h"
+#include "DistributedTopology.h"
+#include "Vector.h"
+#include "VectorPartitioned.h"
+
+namespace GooseFEM {
+namespace Distributed {
+
+/*
+  "nodevec", "elemvec", "dofval" as in GooseFEM::Vector, but for the local nodes, elements, and
+  DOFs of this rank. Conversions that do not require communication ("asDofs", "asNode",
+  "asElement", ...) are those of "local()". Assembly is followed by a halo exchange, such that
+  the shared DOFs/nodes have the same (fully assembled) value on all ranks.
+*/
+
+class Vector {
+public:
+    // Constructors
+    Vector() = default;
+    Vector(const Topology& topology);
+
+    // Dimensions
+    size_t nelem() const; // number of local elements
+    size_t nne() const;   // number of nodes per element
+    size_t nnode() const; // number of local nodes
+    size_t ndim() const;  // number of dimensions
+    size_t ndof() const;  // number of local DOFs
+
+    // Domain decomposition, and local vector-definition
+    const Topology& topology() const;
+    const GooseFEM::Vector& local() const;
+
+    // Assemble "dofval" (adds entries that occur more than once, on any rank)
+    void assembleDofs(const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 1>& dofval) const;
+
+    // Assemble "nodevec" (adds entries that occur more than once, on any rank)
+    void assembleNode(const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 2>& nodevec) const;
+
+    // Auto-allocation of the functions above
+    xt::xtensor<double, 1> AssembleDofs(const xt::xtensor<double, 3>& elemvec) const;
+    xt::xtensor<double, 2> AssembleNode(const xt::xtensor<double, 3>& elemvec) const;
+
+private:
+    // Domain decomposition, and local vector-definition
+    Topology m_dist;
+    GooseFEM::Vector m_local;
+};
+
+/*
+  As "Distributed::Vector", with the DOFs partitioned in unknown and prescribed DOFs.
+*/
+
+class VectorPartitioned {
+public:
+    // Constructors
+    VectorPartitioned() = default;
+    VectorPartitioned(const Topology& topology);
+
+    // Dimensions
+    size_t nelem() const; // number of local elements
+    size_t nne() const;   // number of nodes per element
+    size_t nnode() const; // number of local nodes
+    size_t ndim() const;  // number of dimensions
+    size_t ndof() const;  // number of local DOFs
+    size_t nnu() const;   // number of local unknown DOFs
+    size_t nnp() const;   // number of local prescribed DOFs
+
+    // Domain decomposition, and local vector-definition
+    const Topology& topology() const;
+    const GooseFEM::VectorPartitioned& local() const;
+
+    // Assemble "dofval" (adds entries that occur more than once, on any rank)
+    void assembleDofs(const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 1>& dofval) const;
+    void assembleDofs_u(const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 1>& dofval_u) const;
+
+    // Assemble "nodevec" (adds entries that occur more than once, on any rank)
+    void assembleNode(const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 2>& nodevec) const;
+
+    // Auto-allocation of the functions above
+    xt::xtensor<double, 1> AssembleDofs(const xt::xtensor<double, 3>& elemvec) const;
+    xt::xtensor<double, 1> AssembleDofs_u(const xt::xtensor<double, 3>& elemvec) const;
+    xt::xtensor<double, 2> AssembleNode(const xt::xtensor<double, 3>& elemvec) const;
+
+private:
+    // Domain decomposition, and local vector-definition
+    Topology m_dist;
+    GooseFEM::VectorPartitioned m_local;
+};
+
+} // namespace Distributed
+} // namespace GooseFEM
+
+#include "DistributedVector.hpp"
+
+#endif
@@ -0,0 +1,181 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_DISTRIBUTEDVECTOR_HPP
+#define GOOSEFEM_DISTRIBUTEDVECTOR_HPP
+
+#include "DistributedVector.h"
+
+namespace GooseFEM {
+namespace Distributed {
+
+inline Vector::Vector(const Topology& topology) : m_dist(topology), m_local(topology.local())
+{
+}
+
+inline size_t Vector::nelem() const
+{
+    return m_local.nelem();
+}
+
+inline size_t Vector::nne() const
+{
+    return m_local.nne();
+}
+
+inline size_t Vector::nnode() const
+{
+    return m_local.nnode();
+}
+
+inline size_t Vector::ndim() const
+{
+    return m_local.ndim();
+}
+
+inline size_t Vector::ndof() const
+{
+    return m_local.ndof();
+}
+
+inline const Topology& Vector::topology() const
+{
+    return m_dist;
+}
+
+inline const GooseFEM::Vector& Vector::local() const
+{
+    return m_local;
+}
+
+inline void
+Vector::assembleDofs(const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 1>& dofval) const
+{
+    m_local.assembleDofs(elemvec, dofval);
+    m_dist.exchange(dofval);
+}
+
+inline void
+Vector::assembleNode(const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 2>& nodevec) const
+{
+    xt::xtensor<double, 1> dofval = this->AssembleDofs(elemvec);
+    m_local.asNode(dofval, nodevec);
+}
+
+inline xt::xtensor<double, 1> Vector::AssembleDofs(const xt::xtensor<double, 3>& elemvec) const
+{
+    xt::xtensor<double, 1> dofval = xt::empty<double>({m_local.ndof()});
+    this->assembleDofs(elemvec, dofval);
+    return dofval;
+}
+
+inline xt::xtensor<double, 2> Vector::AssembleNode(const xt::xtensor<double, 3>& elemvec) const
+{
+    xt::xtensor<double, 2> nodevec = xt::empty<double>({m_local.nnode(), m_local.ndim()});
+    this->assembleNode(elemvec, nodevec);
+    return nodevec;
+}
+
+inline VectorPartitioned::VectorPartitioned(const Topology& topology)
+    : m_dist(topology), m_local(topology.local())
+{
+    GOOSEFEM_ASSERT(m_dist.isPartitioned());
+}
+
+inline size_t VectorPartitioned::nelem() const
+{
+    return m_local.nelem();
+}
+
+inline size_t VectorPartitioned::nne() const
+{
+    return m_local.nne();
+}
+
+inline size_t VectorPartitioned::nnode() const
+{
+    return m_local.nnode();
+}
+
+inline size_t VectorPartitioned::ndim() const
+{
+    return m_local.ndim();
+}
+
+inline size_t VectorPartitioned::ndof() const
+{
+    return m_local.ndof();
+}
+
+inline size_t VectorPartitioned::nnu() const
+{
+    return m_local.nnu();
+}
+
+inline size_t VectorPartitioned::nnp() const
+{
+    return m_local.nnp();
+}
+
+inline const Topology& VectorPartitioned::topology() const
+{
+    return m_dist;
+}
+
+inline const GooseFEM::VectorPartitioned& VectorPartitioned::local() const
+{
+    return m_local;
+}
+
+inline void VectorPartitioned::assembleDofs(
+    const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 1>& dofval) const
+{
+    m_local.assembleDofs(elemvec, dofval);
+    m_dist.exchange(dofval);
+}
+
+inline void VectorPartitioned::assembleDofs_u(
+    const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 1>& dofval_u) const
+{
+    m_local.assembleDofs_u(elemvec, dofval_u);
+    m_dist.exchange_u(dofval_u);
+}
+
+inline void VectorPartitioned::assembleNode(
+    const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 2>& nodevec) const
+{
+    xt::xtensor<double, 1> dofval = this->AssembleDofs(elemvec);
+    m_local.asNode(dofval, nodevec);
+}
+
+inline xt::xtensor<double, 1>
+VectorPartitioned::AssembleDofs(const xt::xtensor<double, 3>& elemvec) const
+{
+    xt::xtensor<double, 1> dofval = xt::empty<double>({m_local.ndof()});
+    this->assembleDofs(elemvec, dofval);
+    return dofval;
+}
+
+inline xt::xtensor<double, 1>
+VectorPartitioned::AssembleDofs_u(const xt::xtensor<double, 3>& elemvec) const
+{
+    xt::xtensor<double, 1> dofval_u = xt::empty<double>({m_local.nnu()});
+    this->assembleDofs_u(elemvec, dofval_u);
+    return dofval_u;
+}
+
+inline xt::xtensor<double, 2>
+VectorPartitioned::AssembleNode(const xt::xtensor<double, 3>& elemvec) const
+{
+    xt::xtensor<double, 2> nodevec = xt::empty<double>({m_local.nnode(), m_local.ndim()});
+    this->assembleNode(elemvec, nodevec);
+    return nodevec;
+}
+
+} // namespace Distributed
+} // namespace GooseFEM
+
+#endif
@@ -27,6 +27,43 @@ inline bool isSequential(const E& dofs);
 // Check structure of the matrices stored per element [nelem, nne*ndim, nne*ndim]
 bool isDiagonal(const xt::xtensor<double, 3>& elemmat);
 
+// Mandel representation of a fourth-order "qtensor" [nelem, nip, d, d, d, d] with minor
+// symmetries: "qmandel" [nelem, nip, n, n], with "n = 3" for "d = 2" (xx, yy, xy), and "n = 6" for
+// "d = 3" (xx, yy, zz, yz, xz, xy). The shear components are scaled by "sqrt(2)" (per index),
+// such that "C : eps" corresponds to the matrix-vector product in this representation.
+inline void asMandel(const xt::xtensor<double, 6>& qtensor, xt::xtensor<double, 4>& qmandel);
+inline xt::xtensor<double, 4> AsMandel(const xt::xtensor<double, 6>& qtensor);
+
+namespace detail {
+
+// K += B^T * D * B * vol, with "B" [nv, ndof], "D" [nv, nv], "K" [ndof, ndof] (row-major),
+// and "DB" [nv, ndof] a workspace
+template <size_t nv, size_t ndof>
+inline void add_BT_D_B(const double* B, const double* D, double vol, double* DB, double* K);
+
+// Inverse "Jinv" [n, nd, nd] and determinant "Jdet" [n] of a batch of "n" Jacobians "J"
+// [n, nd, nd] (row-major, with "nd = 2" or "nd = 3"), in closed form in one flat loop.
+// Returns the number of non-positive determinants (inverted or degenerate elements).
+template <size_t nd>
+inline size_t inv_jacobian(size_t n, const double* J, double* Jinv, double* Jdet);
+
+// Maximum number of integration points of which "compute_dN" inverts the Jacobians in one call
+// (the size of its fixed-size scratch)
+constexpr size_t nip_batch = 128;
+
+// Set "flag[p / nip]" for each point "p" in [p0, p0 + n) with "Jdet[p - p0] <= 0"
+inline void flag_degenerate(
+    size_t p0, size_t n, size_t nip, const double* Jdet, std::vector<char>& flag);
+
+// List of the elements "e" for which "flag[e]" is set
+inline xt::xtensor<size_t, 1> flagged(const std::vector<char>& flag);
+
+// Positions "i" for which "elem(i)" occurs in the sorted list "sorted"
+inline xt::xtensor<size_t, 1>
+positions(const xt::xtensor<size_t, 1>& elem, const xt::xtensor<size_t, 1>& sorted);
+
+} // namespace detail
+
 } // namespace Element
 } // namespace GooseFEM
 
@@ -21,7 +21,7 @@ inline xt::xtensor<double, 3> asElementVector(
 
     xt::xtensor<double, 3> elemvec = xt::empty<double>({nelem, nne, ndim});
 
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (size_t e = 0; e < nelem; ++e) {
         for (size_t m = 0; m < nne; ++m) {
             for (size_t i = 0; i < ndim; ++i) {
@@ -86,7 +86,7 @@ inline bool isDiagonal(const xt::xtensor<double, 3>& elemmat)
 
     double eps = std::numeric_limits<double>::epsilon();
 
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (size_t e = 0; e < nelem; ++e) {
         for (size_t i = 0; i < N; ++i) {
             for (size_t j = 0; j < N; ++j) {
@@ -102,6 +102,171 @@ inline bool isDiagonal(const xt::xtensor<double, 3>& elemmat)
     return true;
 }
 
+inline void asMandel(const xt::xtensor<double, 6>& qtensor, xt::xtensor<double, 4>& qmandel)
+{
+    size_t nelem = qtensor.shape(0);
+    size_t nip = qtensor.shape(1);
+    size_t nd = qtensor.shape(2);
+    size_t nv = nd == 2 ? 3 : 6;
+
+    GOOSEFEM_ASSERT(nd == 2 || nd == 3);
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {nelem, nip, nd, nd, nd, nd}));
+    GOOSEFEM_ASSERT(xt::has_shape(qmandel, {nelem, nip, nv, nv}));
+
+    // tensor indices of each Mandel component
+    static const std::array<size_t, 3> i2 = {0, 1, 0};
+    static const std::array<size_t, 3> j2 = {0, 1, 1};
+    static const std::array<size_t, 6> i3 = {0, 1, 2, 1, 0, 0};
+    static const std::array<size_t, 6> j3 = {0, 1, 2, 2, 2, 1};
+
+    const size_t* ii = nd == 2 ? i2.data() : i3.data();
+    const size_t* jj = nd == 2 ? j2.data() : j3.data();
+
+    #pragma omp parallel for schedule(static)
+    for (size_t e = 0; e < nelem; ++e) {
+        for (size_t q = 0; q < nip; ++q) {
+            for (size_t a = 0; a < nv; ++a) {
+                double wa = a < nd ? 1.0 : std::sqrt(2.0);
+                for (size_t b = 0; b < nv; ++b) {
+                    double wb = b < nd ? 1.0 : std::sqrt(2.0);
+                    qmandel(e, q, a, b) = wa * wb * qtensor(e, q, ii[a], jj[a], ii[b], jj[b]);
+                }
+            }
+        }
+    }
+}
+
+inline xt::xtensor<double, 4> AsMandel(const xt::xtensor<double, 6>& qtensor)
+{
+    size_t nelem = qtensor.shape(0);
+    size_t nip = qtensor.shape(1);
+    size_t nv = qtensor.shape(2) == 2 ? 3 : 6;
+    xt::xtensor<double, 4> qmandel = xt::empty<double>({nelem, nip, nv, nv});
+    asMandel(qtensor, qmandel);
+    return qmandel;
+}
+
+namespace detail {
+
+template <size_t nv, size_t ndof>
+inline void add_BT_D_B(const double* B, const double* D, double vol, double* DB, double* K)
+{
+    // DB = D * B * vol
+    for (size_t a = 0; a < nv; ++a) {
+        for (size_t j = 0; j < ndof; ++j) {
+            double v = 0.0;
+            for (size_t b = 0; b < nv; ++b) {
+                v += D[a * nv + b] * B[b * ndof + j];
+            }
+            DB[a * ndof + j] = v * vol;
+        }
+    }
+
+    // K += B^T * DB
+    for (size_t a = 0; a < nv; ++a) {
+        for (size_t i = 0; i < ndof; ++i) {
+            double b = B[a * ndof + i];
+            if (b == 0.0) {
+                continue;
+            }
+            for (size_t j = 0; j < ndof; ++j) {
+                K[i * ndof + j] += b * DB[a * ndof + j];
+            }
+        }
+    }
+}
+
+template <>
+inline size_t inv_jacobian<2>(size_t n, const double* J, double* Jinv, double* Jdet)
+{
+    size_t nbad = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        const double* A = &J[i * 4];
+        double* B = &Jinv[i * 4];
+        double det = A[0] * A[3] - A[1] * A[2];
+        double idet = 1.0 / det;
+        B[0] = A[3] * idet;
+        B[1] = -A[1] * idet;
+        B[2] = -A[2] * idet;
+        B[3] = A[0] * idet;
+        Jdet[i] = det;
+        nbad += det <= 0.0;
+    }
+
+    return nbad;
+}
+
+template <>
+inline size_t inv_jacobian<3>(size_t n, const double* J, double* Jinv, double* Jdet)
+{
+    size_t nbad = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        const double* A = &J[i * 9];
+        double* B = &Jinv[i * 9];
+        double c00 = A[4] * A[8] - A[5] * A[7];
+        double c01 = A[5] * A[6] - A[3] * A[8];
+        double c02 = A[3] * A[7] - A[4] * A[6];
+        double det = A[0] * c00 + A[1] * c01 + A[2] * c02;
+        double idet = 1.0 / det;
+        B[0] = c00 * idet;
+        B[1] = (A[2] * A[7] - A[1] * A[8]) * idet;
+        B[2] = (A[1] * A[5] - A[2] * A[4]) * idet;
+        B[3] = c01 * idet;
+        B[4] = (A[0] * A[8] - A[2] * A[6]) * idet;
+        B[5] = (A[2] * A[3] - A[0] * A[5]) * idet;
+        B[6] = c02 * idet;
+        B[7] = (A[1] * A[6] - A[0] * A[7]) * idet;
+        B[8] = (A[0] * A[4] - A[1] * A[3]) * idet;
+        Jdet[i] = det;
+        nbad += det <= 0.0;
+    }
+
+    return nbad;
+}
+
+inline void flag_degenerate(
+    size_t p0, size_t n, size_t nip, const double* Jdet, std::vector<char>& flag)
+{
+    for (size_t i = 0; i < n; ++i) {
+        if (Jdet[i] <= 0.0) {
+            flag[(p0 + i) / nip] = 1;
+        }
+    }
+}
+
+inline xt::xtensor<size_t, 1> flagged(const std::vector<char>& flag)
+{
+    size_t n = std::count_if(flag.begin(), flag.end(), [](char f) { return f != 0; });
+    xt::xtensor<size_t, 1> ret = xt::empty<size_t>({n});
+
+    for (size_t e = 0, i = 0; e < flag.size(); ++e) {
+        if (flag[e]) {
+            ret(i) = e;
+            ++i;
+        }
+    }
+
+    return ret;
+}
+
+inline xt::xtensor<size_t, 1>
+positions(const xt::xtensor<size_t, 1>& elem, const xt::xtensor<size_t, 1>& sorted)
+{
+    std::vector<size_t> ret;
+
+    for (size_t i = 0; i < elem.size(); ++i) {
+        if (std::binary_search(sorted.begin(), sorted.end(), elem(i))) {
+            ret.push_back(i);
+        }
+    }
+
+    return xt::adapt(ret);
+}
+
+} // namespace detail
+
 } // namespace Element
 } // namespace GooseFEM
 
@@ -0,0 +1,41 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_ELEMENTHEX27_H
+#define GOOSEFEM_ELEMENTHEX27_H
+
+#include "config.h"
+#include "ElementTensorProduct.h"
+
+namespace GooseFEM {
+namespace Element {
+namespace Hex27 {
+
+// Hexahedron, quadratic Lagrange (27 nodes, on a tensor-product grid: see
+// "detail::TensorProductQuadrature")
+
+namespace Gauss {
+inline size_t nip();                // number of integration points
+inline xt::xtensor<double, 2> xi(); // integration point coordinates (local coordinates)
+inline xt::xtensor<double, 1> w();  // integration point weights
+} // namespace Gauss
+
+namespace Nodal {
+inline size_t nip();                // number of integration points
+inline xt::xtensor<double, 2> xi(); // integration point coordinates (local coordinates)
+inline xt::xtensor<double, 1> w();  // integration point weights
+} // namespace Nodal
+
+// Constructor: integration point coordinates and weights are optional (default: Gauss)
+using Quadrature = detail::TensorProductQuadrature<3>;
+
+} // namespace Hex27
+} // namespace Element
+} // namespace GooseFEM
+
+#include "ElementHex27.hpp"
+
+#endif
@@ -0,0 +1,58 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_ELEMENTHEX27_HPP
+#define GOOSEFEM_ELEMENTHEX27_HPP
+
+#include "ElementHex27.h"
+
+namespace GooseFEM {
+namespace Element {
+namespace Hex27 {
+
+namespace Gauss {
+
+inline size_t nip()
+{
+    return 27;
+}
+
+inline xt::xtensor<double, 2> xi()
+{
+    return detail::tensor_xi(detail::gauss_xi(), 3);
+}
+
+inline xt::xtensor<double, 1> w()
+{
+    return detail::tensor_w(detail::gauss_w(), 3);
+}
+
+} // namespace Gauss
+
+namespace Nodal {
+
+inline size_t nip()
+{
+    return 27;
+}
+
+inline xt::xtensor<double, 2> xi()
+{
+    return detail::tensor_xi(detail::lobatto_xi(), 3);
+}
+
+inline xt::xtensor<double, 1> w()
+{
+    return detail::tensor_w(detail::lobatto_w(), 3);
+}
+
+} // namespace Nodal
+
+} // namespace Hex27
+} // namespace Element
+} // namespace GooseFEM
+
+#endif
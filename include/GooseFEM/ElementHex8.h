@@ -28,6 +28,12 @@ inline xt::xtensor<double, 2> xi(); // integration point coordinates (local coor
 inline xt::xtensor<double, 1> w();  // integration point weights
 } // namespace Nodal
 
+namespace MidPoint {
+inline size_t nip();                // number of integration points
+inline xt::xtensor<double, 2> xi(); // integration point coordinates (local coordinates)
+inline xt::xtensor<double, 1> w();  // integration point weights
+} // namespace MidPoint
+
 class Quadrature {
 public:
     // Fixed dimensions:
@@ -53,6 +59,12 @@ public:
     // Update the nodal positions (shape of "x" should match the earlier definition)
     void update_x(const xt::xtensor<double, 3>& x);
 
+    // Restrict to a subset of elements, sharing (not copying) the nodal positions,
+    // shape function gradients, and integration volumes.
+    // All "elemvec", "elemmat", "qtensor", and "qscalar" of the subset are of size "elem.size()".
+    // Note: "update_x" can only be called on the full object, subsets have to be recreated after.
+    Quadrature Subset(const xt::xtensor<size_t, 1>& elem) const;
+
     // Return dimensions
     size_t nelem() const; // number of elements
     size_t nne() const;   // number of nodes per element
@@ -69,6 +81,11 @@ public:
     // Return integration volume
     xt::xtensor<double, 2> dV() const;
 
+    // Elements with a non-positive Jacobian determinant in at least one integration point
+    // (inverted or degenerate elements; their "dV" and "GradN" are meaningless), as detected
+    // while computing the shape function gradients (upon construction, and in "update_x")
+    xt::xtensor<size_t, 1> degenerate() const;
+
     // Dyadic product (and its transpose and symmetric part)
     // qtensor(i,j) += dNdx(m,i) * elemvec(m,j)
     void gradN_vector(const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const;
@@ -85,11 +102,88 @@ public:
     void int_gradN_dot_tensor2_dV(
         const xt::xtensor<double, 4>& qtensor, xt::xtensor<double, 3>& elemvec) const;
 
+    // Functions above, for the elements "elem" only: "elemvec" and "qtensor" are of full size
+    // (all elements), only their rows "elem" are read or (over)written, e.g. to update only the
+    // elements that changed in an event (see "Vector::assembleNode(elem, ..., alpha)")
+    void gradN_vector(
+        const xt::xtensor<size_t, 1>& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 4>& qtensor) const;
+
+    void gradN_vector_T(
+        const xt::xtensor<size_t, 1>& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 4>& qtensor) const;
+
+    void symGradN_vector(
+        const xt::xtensor<size_t, 1>& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 4>& qtensor) const;
+
+    void int_gradN_dot_tensor2_dV(
+        const xt::xtensor<size_t, 1>& elem,
+        const xt::xtensor<double, 4>& qtensor,
+        xt::xtensor<double, 3>& elemvec) const;
+
     // Integral of the dot product
     // elemmat(m*2+j, n*2+k) += dNdx(m,i) * qtensor(i,j,k,l) * dNdx(n,l) * dV
     void int_gradN_dot_tensor4_dot_gradNT_dV(
         const xt::xtensor<double, 6>& qtensor, xt::xtensor<double, 3>& elemmat) const;
 
+    // Integral of the dot product, with the tangent in Mandel representation
+    // (see "Element::AsMandel"): "qmandel" [nelem, nip, 6, 6]
+    // elemmat = B^T * qmandel * B * dV (with "eps = B * u" in Mandel representation)
+    void int_gradN_dot_mandel_dot_gradNT_dV(
+        const xt::xtensor<double, 4>& qmandel, xt::xtensor<double, 3>& elemmat) const;
+
+    // Integral of the dot product (see "int_gradN_dot_tensor2_dV"), with hourglass control for
+    // one-point (reduced) integration, e.g. "MidPoint" (Flanagan-Belytschko):
+    // elemvec(m,i) += k * gamma(a,m) * gamma(a,n) * elemvec_u(n,i)
+    // with "gamma" the hourglass base vectors (orthogonal to linear fields), and
+    // "k = stiffness * dNdx(n,j) * dNdx(n,j) * dV", "stiffness" [nelem] e.g. a fraction of the
+    // shear modulus (typically 0.05 - 0.1)
+    void int_gradN_dot_tensor2_dV_hourglass(
+        const xt::xtensor<double, 4>& qtensor,
+        const xt::xtensor<double, 3>& elemvec_u,
+        const xt::xtensor<double, 1>& stiffness,
+        xt::xtensor<double, 3>& elemvec) const;
+
+    // Accumulate variants of the integrals above: "elemvec += alpha * ..." and
+    // "elemmat += alpha * ..." (without zeroing the output), to combine contributions (e.g. mass,
+    // damping, and stiffness, or several material subsets) without intermediate temporaries
+    void int_N_scalar_NT_dV(
+        const xt::xtensor<double, 2>& qscalar,
+        xt::xtensor<double, 3>& elemmat,
+        double alpha) const;
+
+    void int_gradN_dot_tensor2_dV(
+        const xt::xtensor<double, 4>& qtensor,
+        xt::xtensor<double, 3>& elemvec,
+        double alpha) const;
+
+    void int_gradN_dot_tensor2_dV(
+        const xt::xtensor<size_t, 1>& elem,
+        const xt::xtensor<double, 4>& qtensor,
+        xt::xtensor<double, 3>& elemvec,
+        double alpha) const;
+
+    void int_gradN_dot_tensor4_dot_gradNT_dV(
+        const xt::xtensor<double, 6>& qtensor,
+        xt::xtensor<double, 3>& elemmat,
+        double alpha) const;
+
+    void int_gradN_dot_mandel_dot_gradNT_dV(
+        const xt::xtensor<double, 4>& qmandel,
+        xt::xtensor<double, 3>& elemmat,
+        double alpha) const;
+
+    void int_gradN_dot_tensor2_dV_hourglass(
+        const xt::xtensor<double, 4>& qtensor,
+        const xt::xtensor<double, 3>& elemvec_u,
+        const xt::xtensor<double, 1>& stiffness,
+        xt::xtensor<double, 3>& elemvec,
+        double alpha) const;
+
     // Auto-allocation of the functions above
     xt::xtensor<double, 4> GradN_vector(const xt::xtensor<double, 3>& elemvec) const;
     xt::xtensor<double, 4> GradN_vector_T(const xt::xtensor<double, 3>& elemvec) const;
@@ -97,6 +191,11 @@ public:
     xt::xtensor<double, 3> Int_N_scalar_NT_dV(const xt::xtensor<double, 2>& qscalar) const;
     xt::xtensor<double, 3> Int_gradN_dot_tensor2_dV(const xt::xtensor<double, 4>& qtensor) const;
     xt::xtensor<double, 3> Int_gradN_dot_tensor4_dot_gradNT_dV(const xt::xtensor<double, 6>& qtensor) const;
+    xt::xtensor<double, 3> Int_gradN_dot_mandel_dot_gradNT_dV(const xt::xtensor<double, 4>& qmandel) const;
+    xt::xtensor<double, 3> Int_gradN_dot_tensor2_dV_hourglass(
+        const xt::xtensor<double, 4>& qtensor,
+        const xt::xtensor<double, 3>& elemvec_u,
+        const xt::xtensor<double, 1>& stiffness) const;
 
     // Convert "qscalar" to "qtensor" of certain rank
     template <size_t rank = 0>
@@ -120,6 +219,33 @@ private:
     // Compute "vol" and "dNdx" based on current "x"
     void compute_dN();
 
+    // Implementation of the functions above, on the list of elements "elem" (e.g. "xt::arange")
+    template <class E>
+    void gradN_vector_impl(
+        const E& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 4>& qtensor) const;
+
+    template <class E>
+    void gradN_vector_T_impl(
+        const E& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 4>& qtensor) const;
+
+    template <class E>
+    void symGradN_vector_impl(
+        const E& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 4>& qtensor) const;
+
+    template <class E>
+    void int_gradN_dot_tensor2_dV_impl(
+        const E& elem,
+        const xt::xtensor<double, 4>& qtensor,
+        xt::xtensor<double, 3>& elemvec,
+        double alpha,
+        bool accumulate) const;
+
 private:
     // Dimensions (flexible)
     size_t m_nelem; // number of elements
@@ -130,13 +256,18 @@ private:
     static const size_t m_ndim = 3; // number of dimensions
 
     // Data arrays
-    xt::xtensor<double, 3> m_x;    // nodal positions stored per element [nelem, nne, ndim]
+    std::shared_ptr<xt::xtensor<double, 3>> m_x; // nodal positions stored per element [nelem, nne, ndim]
     xt::xtensor<double, 1> m_w;    // weight of each integration point [nip]
     xt::xtensor<double, 2> m_xi;   // local coordinate of each integration point [nip, ndim]
     xt::xtensor<double, 2> m_N;    // shape functions [nip, nne]
     xt::xtensor<double, 3> m_dNxi; // shape function grad. wrt local  coor. [nip, nne, ndim]
-    xt::xtensor<double, 4> m_dNx;  // shape function grad. wrt global coor. [nelem, nip, nne, ndim]
-    xt::xtensor<double, 2> m_vol;  // integration point volume [nelem, nip]
+    std::shared_ptr<xt::xtensor<double, 4>> m_dNx; // shape function grad. wrt global coor. [nelem, nip, nne, ndim]
+    std::shared_ptr<xt::xtensor<double, 2>> m_vol; // integration point volume [nelem, nip]
+    xt::xtensor<size_t, 1> m_degenerate; // elements with non-positive Jacobian determinant
+
+    // Element-numbers of the subset: row in "m_x", "m_dNx", "m_vol" [nelem]
+    xt::xtensor<size_t, 1> m_elem;
+    bool m_subset = false;
 };
 
 } // namespace Hex8
@@ -173,6 +173,40 @@ inline xt::xtensor<double, 1> w()
 
 } // namespace Nodal
 
+namespace MidPoint {
+
+inline size_t nip()
+{
+    return 1;
+}
+
+inline xt::xtensor<double, 2> xi()
+{
+    size_t nip = 1;
+    size_t ndim = 3;
+
+    xt::xtensor<double, 2> xi = xt::empty<double>({nip, ndim});
+
+    xi(0, 0) = 0.0;
+    xi(0, 1) = 0.0;
+    xi(0, 2) = 0.0;
+
+    return xi;
+}
+
+inline xt::xtensor<double, 1> w()
+{
+    size_t nip = 1;
+
+    xt::xtensor<double, 1> w = xt::empty<double>({nip});
+
+    w(0) = 8.0;
+
+    return w;
+}
+
+} // namespace MidPoint
+
 inline Quadrature::Quadrature(const xt::xtensor<double, 3>& x)
     : Quadrature(x, Gauss::xi(), Gauss::w())
 {
@@ -182,12 +216,15 @@ inline Quadrature::Quadrature(
     const xt::xtensor<double, 3>& x,
     const xt::xtensor<double, 2>& xi,
     const xt::xtensor<double, 1>& w)
-    : m_x(x), m_w(w), m_xi(xi)
+    : m_x(std::make_shared<xt::xtensor<double, 3>>(GooseFEM::FirstTouchCopy(x))),
+      m_w(w),
+      m_xi(xi)
 {
-    GOOSEFEM_ASSERT(m_x.shape(1) == m_nne);
-    GOOSEFEM_ASSERT(m_x.shape(2) == m_ndim);
+    GOOSEFEM_ASSERT(x.shape(1) == m_nne);
+    GOOSEFEM_ASSERT(x.shape(2) == m_ndim);
 
-    m_nelem = m_x.shape(0);
+    m_nelem = x.shape(0);
+    m_elem = xt::arange<size_t>(m_nelem);
     m_nip = m_w.size();
 
     GOOSEFEM_ASSERT(m_xi.shape(0) == m_nip);
@@ -196,8 +233,11 @@ inline Quadrature::Quadrature(
 
     m_N = xt::empty<double>({m_nip, m_nne});
     m_dNxi = xt::empty<double>({m_nip, m_nne, m_ndim});
-    m_dNx = xt::empty<double>({m_nelem, m_nip, m_nne, m_ndim});
-    m_vol = xt::empty<double>({m_nelem, m_nip});
+
+    // not initialised: first written (in parallel, "first-touch") by "compute_dN"
+    m_dNx = std::make_shared<xt::xtensor<double, 4>>(
+        xt::empty<double>({m_nelem, m_nip, m_nne, m_ndim}));
+    m_vol = std::make_shared<xt::xtensor<double, 2>>(xt::empty<double>({m_nelem, m_nip}));
 
     // shape functions
     for (size_t q = 0; q < m_nip; ++q) {
@@ -268,7 +308,11 @@ inline size_t Quadrature::nip() const
 
 inline xt::xtensor<double, 4> Quadrature::GradN() const
 {
-    return m_dNx;
+    if (m_subset) {
+        return xt::view(*m_dNx, xt::keep(m_elem));
+    }
+
+    return *m_dNx;
 }
 
 template <size_t rank>
@@ -281,59 +325,135 @@ Quadrature::asTensor(const xt::xtensor<double, 2>& arg, xt::xtensor<double, 2 +
 
 inline xt::xtensor<double, 2> Quadrature::dV() const
 {
-    return m_vol;
+    if (m_subset) {
+        return xt::view(*m_vol, xt::keep(m_elem));
+    }
+
+    return *m_vol;
+}
+
+inline xt::xtensor<size_t, 1> Quadrature::degenerate() const
+{
+    if (m_subset) {
+        return detail::positions(m_elem, m_degenerate);
+    }
+
+    return m_degenerate;
 }
 
 inline void Quadrature::update_x(const xt::xtensor<double, 3>& x)
 {
-    GOOSEFEM_ASSERT(x.shape() == m_x.shape());
-    xt::noalias(m_x) = x;
+    GOOSEFEM_ASSERT(!m_subset);
+    GOOSEFEM_ASSERT(x.shape() == m_x->shape());
+
+    // data shared with copies or subsets is not overwritten
+    if (m_x.use_count() > 1) {
+        m_x = std::make_shared<xt::xtensor<double, 3>>(GooseFEM::FirstTouchCopy(x));
+    }
+    else {
+        xt::noalias(*m_x) = x;
+    }
+
+    if (m_dNx.use_count() > 1) {
+        m_dNx = std::make_shared<xt::xtensor<double, 4>>(
+            xt::empty<double>({m_nelem, m_nip, m_nne, m_ndim}));
+    }
+
+    if (m_vol.use_count() > 1) {
+        m_vol = std::make_shared<xt::xtensor<double, 2>>(xt::empty<double>({m_nelem, m_nip}));
+    }
+
     compute_dN();
 }
 
+inline Quadrature Quadrature::Subset(const xt::xtensor<size_t, 1>& elem) const
+{
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+
+    Quadrature ret = *this;
+    ret.m_elem = xt::view(m_elem, xt::keep(elem));
+    ret.m_nelem = elem.size();
+    ret.m_subset = true;
+    return ret;
+}
+
 inline void Quadrature::compute_dN()
 {
+    auto& x_all = *m_x;
+    auto& dNdx = *m_dNx;
+    auto& dVol = *m_vol;
+
+    std::vector<char> isdegenerate(m_nelem, 0);
+
+    // batches of whole elements (such that each element is flagged by one thread only),
+    // of which the Jacobians are inverted in chunks of at most "nip_batch" integration points
+    size_t nblk = std::max(size_t(1), detail::nip_batch / m_nip);
+    size_t nbatch = (m_nelem + nblk - 1) / nblk;
+
     #pragma omp parallel
     {
-        xt::xtensor<double, 2> J = xt::empty<double>({3, 3});
-        xt::xtensor<double, 2> Jinv = xt::empty<double>({3, 3});
+        std::array<double, detail::nip_batch * m_ndim * m_ndim> J;
+        std::array<double, detail::nip_batch * m_ndim * m_ndim> Jinv;
+        std::array<double, detail::nip_batch> Jdet;
 
-        #pragma omp for
-        for (size_t e = 0; e < m_nelem; ++e) {
+        #pragma omp for schedule(static)
+        for (size_t b = 0; b < nbatch; ++b) {
 
-            auto x = xt::adapt(&m_x(e, 0, 0), xt::xshape<m_nne, m_ndim>());
+            size_t end = std::min(m_nelem, (b + 1) * nblk) * m_nip;
 
-            for (size_t q = 0; q < m_nip; ++q) {
+            for (size_t p0 = b * nblk * m_nip; p0 < end; p0 += detail::nip_batch) {
 
-                auto dNxi = xt::adapt(&m_dNxi(q, 0, 0), xt::xshape<m_nne, m_ndim>());
-                auto dNx = xt::adapt(&m_dNx(e, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+                size_t n = std::min(detail::nip_batch, end - p0);
 
-                J.fill(0.0);
+                for (size_t i = 0; i < n; ++i) {
 
-                for (size_t m = 0; m < m_nne; ++m) {
-                    for (size_t i = 0; i < m_ndim; ++i) {
+                    size_t e = (p0 + i) / m_nip;
+                    size_t q = (p0 + i) % m_nip;
+                    auto x = xt::adapt(&x_all(e, 0, 0), xt::xshape<m_nne, m_ndim>());
+                    auto dNxi = xt::adapt(&m_dNxi(q, 0, 0), xt::xshape<m_nne, m_ndim>());
+                    double* Jq = &J[i * 9];
+
+                    // J(i,j) += dNxi(m,i) * x(m,j);
+                    for (size_t k = 0; k < m_ndim; ++k) {
                         for (size_t j = 0; j < m_ndim; ++j) {
-                            J(i, j) += dNxi(m, i) * x(m, j);
+                            double v = 0.0;
+                            for (size_t m = 0; m < m_nne; ++m) {
+                                v += dNxi(m, k) * x(m, j);
+                            }
+                            Jq[k * 3 + j] = v;
                         }
                     }
                 }
 
-                double Jdet = inv(J, Jinv);
+                // inverse and determinant, of all integration points of the chunk at once
+                size_t nbad = detail::inv_jacobian<m_ndim>(n, J.data(), Jinv.data(), Jdet.data());
 
-                // dNx(m,i) += Jinv(i,j) * dNxi(m,j);
-                for (size_t m = 0; m < m_nne; ++m) {
-                    dNx(m, 0) =
-                        Jinv(0, 0) * dNxi(m, 0) + Jinv(0, 1) * dNxi(m, 1) + Jinv(0, 2) * dNxi(m, 2);
-                    dNx(m, 1) =
-                        Jinv(1, 0) * dNxi(m, 0) + Jinv(1, 1) * dNxi(m, 1) + Jinv(1, 2) * dNxi(m, 2);
-                    dNx(m, 2) =
-                        Jinv(2, 0) * dNxi(m, 0) + Jinv(2, 1) * dNxi(m, 1) + Jinv(2, 2) * dNxi(m, 2);
+                if (nbad > 0) {
+                    detail::flag_degenerate(p0, n, m_nip, Jdet.data(), isdegenerate);
                 }
 
-                m_vol(e, q) = m_w(q) * Jdet;
+                for (size_t i = 0; i < n; ++i) {
+
+                    size_t e = (p0 + i) / m_nip;
+                    size_t q = (p0 + i) % m_nip;
+                    auto dNxi = xt::adapt(&m_dNxi(q, 0, 0), xt::xshape<m_nne, m_ndim>());
+                    auto dNx = xt::adapt(&dNdx(e, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+                    const double* Ji = &Jinv[i * 9];
+
+                    // dNx(m,i) += Jinv(i,j) * dNxi(m,j);
+                    for (size_t m = 0; m < m_nne; ++m) {
+                        dNx(m, 0) = Ji[0] * dNxi(m, 0) + Ji[1] * dNxi(m, 1) + Ji[2] * dNxi(m, 2);
+                        dNx(m, 1) = Ji[3] * dNxi(m, 0) + Ji[4] * dNxi(m, 1) + Ji[5] * dNxi(m, 2);
+                        dNx(m, 2) = Ji[6] * dNxi(m, 0) + Ji[7] * dNxi(m, 1) + Ji[8] * dNxi(m, 2);
+                    }
+
+                    dVol(e, q) = m_w(q) * Jdet[i];
+                }
             }
         }
     }
+
+    m_degenerate = detail::flagged(isdegenerate);
 }
 
 inline void Quadrature::gradN_vector(
@@ -341,17 +461,38 @@ inline void Quadrature::gradN_vector(
 {
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    this->gradN_vector_impl(xt::arange<size_t>(m_nelem), elemvec, qtensor);
+}
+
+inline void Quadrature::gradN_vector(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 3>& elemvec,
+    xt::xtensor<double, 4>& qtensor) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+    this->gradN_vector_impl(elem, elemvec, qtensor);
+}
 
-    qtensor.fill(0.0);
+template <class E>
+inline void Quadrature::gradN_vector_impl(
+    const E& elem, const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const
+{
+    const auto& dNdx = *m_dNx;
 
-    #pragma omp parallel for
-    for (size_t e = 0; e < m_nelem; ++e) {
+    #pragma omp parallel for schedule(static)
+    for (size_t ie = 0; ie < elem.size(); ++ie) {
+
+        size_t e = elem(ie);
+        size_t row = m_subset ? m_elem(e) : e;
+        std::fill_n(&qtensor(e, 0, 0, 0), m_nip * m_ndim * m_ndim, 0.0);
 
         auto u = xt::adapt(&elemvec(e, 0, 0), xt::xshape<m_nne, m_ndim>());
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto dNx = xt::adapt(&m_dNx(e, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+            auto dNx = xt::adapt(&dNdx(row, q, 0, 0), xt::xshape<m_nne, m_ndim>());
             auto gradu = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_ndim, m_ndim>());
 
             for (size_t m = 0; m < m_nne; ++m) {
@@ -370,17 +511,38 @@ inline void Quadrature::gradN_vector_T(
 {
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    this->gradN_vector_T_impl(xt::arange<size_t>(m_nelem), elemvec, qtensor);
+}
+
+inline void Quadrature::gradN_vector_T(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 3>& elemvec,
+    xt::xtensor<double, 4>& qtensor) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+    this->gradN_vector_T_impl(elem, elemvec, qtensor);
+}
 
-    qtensor.fill(0.0);
+template <class E>
+inline void Quadrature::gradN_vector_T_impl(
+    const E& elem, const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const
+{
+    const auto& dNdx = *m_dNx;
 
-    #pragma omp parallel for
-    for (size_t e = 0; e < m_nelem; ++e) {
+    #pragma omp parallel for schedule(static)
+    for (size_t ie = 0; ie < elem.size(); ++ie) {
+
+        size_t e = elem(ie);
+        size_t row = m_subset ? m_elem(e) : e;
+        std::fill_n(&qtensor(e, 0, 0, 0), m_nip * m_ndim * m_ndim, 0.0);
 
         auto u = xt::adapt(&elemvec(e, 0, 0), xt::xshape<m_nne, m_ndim>());
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto dNx = xt::adapt(&m_dNx(e, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+            auto dNx = xt::adapt(&dNdx(row, q, 0, 0), xt::xshape<m_nne, m_ndim>());
             auto gradu = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_ndim, m_ndim>());
 
             for (size_t m = 0; m < m_nne; ++m) {
@@ -399,17 +561,38 @@ inline void Quadrature::symGradN_vector(
 {
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    this->symGradN_vector_impl(xt::arange<size_t>(m_nelem), elemvec, qtensor);
+}
+
+inline void Quadrature::symGradN_vector(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 3>& elemvec,
+    xt::xtensor<double, 4>& qtensor) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+    this->symGradN_vector_impl(elem, elemvec, qtensor);
+}
+
+template <class E>
+inline void Quadrature::symGradN_vector_impl(
+    const E& elem, const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const
+{
+    const auto& dNdx = *m_dNx;
 
-    qtensor.fill(0.0);
+    #pragma omp parallel for schedule(static)
+    for (size_t ie = 0; ie < elem.size(); ++ie) {
 
-    #pragma omp parallel for
-    for (size_t e = 0; e < m_nelem; ++e) {
+        size_t e = elem(ie);
+        size_t row = m_subset ? m_elem(e) : e;
+        std::fill_n(&qtensor(e, 0, 0, 0), m_nip * m_ndim * m_ndim, 0.0);
 
         auto u = xt::adapt(&elemvec(e, 0, 0), xt::xshape<m_nne, m_ndim>());
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto dNx = xt::adapt(&m_dNx(e, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+            auto dNx = xt::adapt(&dNdx(row, q, 0, 0), xt::xshape<m_nne, m_ndim>());
             auto eps = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_ndim, m_ndim>());
 
             for (size_t m = 0; m < m_nne; ++m) {
@@ -426,21 +609,32 @@ inline void Quadrature::symGradN_vector(
 
 inline void Quadrature::int_N_scalar_NT_dV(
     const xt::xtensor<double, 2>& qscalar, xt::xtensor<double, 3>& elemmat) const
+{
+    GooseFEM::firstTouch(elemmat, 0.0);
+    this->int_N_scalar_NT_dV(qscalar, elemmat, 1.0);
+}
+
+inline void Quadrature::int_N_scalar_NT_dV(
+    const xt::xtensor<double, 2>& qscalar,
+    xt::xtensor<double, 3>& elemmat,
+    double alpha) const
 {
     GOOSEFEM_ASSERT(xt::has_shape(qscalar, {m_nelem, m_nip}));
     GOOSEFEM_ASSERT(xt::has_shape(elemmat, {m_nelem, m_nne * m_ndim, m_nne * m_ndim}));
 
-    elemmat.fill(0.0);
+    const auto& dVol = *m_vol;
 
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (size_t e = 0; e < m_nelem; ++e) {
 
+        size_t row = m_subset ? m_elem(e) : e;
+
         auto M = xt::adapt(&elemmat(e, 0, 0), xt::xshape<m_nne * m_ndim, m_nne * m_ndim>());
 
         for (size_t q = 0; q < m_nip; ++q) {
 
             auto N = xt::adapt(&m_N(q, 0), xt::xshape<m_nne>());
-            auto& vol = m_vol(e, q);
+            double vol = alpha * dVol(row, q);
             auto& rho = qscalar(e, q);
 
             // M(m * ndim + i, n * ndim + i) += N(m) * scalar * N(n) * dV
@@ -460,19 +654,69 @@ inline void Quadrature::int_gradN_dot_tensor2_dV(
 {
     GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    this->int_gradN_dot_tensor2_dV_impl(xt::arange<size_t>(m_nelem), qtensor, elemvec, 1.0, false);
+}
 
-    elemvec.fill(0.0);
+inline void Quadrature::int_gradN_dot_tensor2_dV(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 4>& qtensor,
+    xt::xtensor<double, 3>& elemvec) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+    this->int_gradN_dot_tensor2_dV_impl(elem, qtensor, elemvec, 1.0, false);
+}
 
-    #pragma omp parallel for
-    for (size_t e = 0; e < m_nelem; ++e) {
+inline void Quadrature::int_gradN_dot_tensor2_dV(
+    const xt::xtensor<double, 4>& qtensor,
+    xt::xtensor<double, 3>& elemvec,
+    double alpha) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    this->int_gradN_dot_tensor2_dV_impl(xt::arange<size_t>(m_nelem), qtensor, elemvec, alpha, true);
+}
+
+inline void Quadrature::int_gradN_dot_tensor2_dV(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 4>& qtensor,
+    xt::xtensor<double, 3>& elemvec,
+    double alpha) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+    this->int_gradN_dot_tensor2_dV_impl(elem, qtensor, elemvec, alpha, true);
+}
+
+template <class E>
+inline void Quadrature::int_gradN_dot_tensor2_dV_impl(
+    const E& elem,
+    const xt::xtensor<double, 4>& qtensor,
+    xt::xtensor<double, 3>& elemvec,
+    double alpha,
+    bool accumulate) const
+{
+    const auto& dNdx = *m_dNx;
+    const auto& dVol = *m_vol;
+
+    #pragma omp parallel for schedule(static)
+    for (size_t ie = 0; ie < elem.size(); ++ie) {
+
+        size_t e = elem(ie);
+        size_t row = m_subset ? m_elem(e) : e;
+        if (!accumulate) {
+            std::fill_n(&elemvec(e, 0, 0), m_nne * m_ndim, 0.0);
+        }
 
         auto f = xt::adapt(&elemvec(e, 0, 0), xt::xshape<m_nne, m_ndim>());
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto dNx = xt::adapt(&m_dNx(e, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+            auto dNx = xt::adapt(&dNdx(row, q, 0, 0), xt::xshape<m_nne, m_ndim>());
             auto sig = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_ndim, m_ndim>());
-            auto& vol = m_vol(e, q);
+            double vol = alpha * dVol(row, q);
 
             for (size_t m = 0; m < m_nne; ++m) {
                 f(m, 0) +=
@@ -488,22 +732,34 @@ inline void Quadrature::int_gradN_dot_tensor2_dV(
 
 inline void Quadrature::int_gradN_dot_tensor4_dot_gradNT_dV(
     const xt::xtensor<double, 6>& qtensor, xt::xtensor<double, 3>& elemmat) const
+{
+    GooseFEM::firstTouch(elemmat, 0.0);
+    this->int_gradN_dot_tensor4_dot_gradNT_dV(qtensor, elemmat, 1.0);
+}
+
+inline void Quadrature::int_gradN_dot_tensor4_dot_gradNT_dV(
+    const xt::xtensor<double, 6>& qtensor,
+    xt::xtensor<double, 3>& elemmat,
+    double alpha) const
 {
     GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim, m_ndim, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(elemmat, {m_nelem, m_nne * m_ndim, m_nne * m_ndim}));
 
-    elemmat.fill(0.0);
+    const auto& dNdx = *m_dNx;
+    const auto& dVol = *m_vol;
 
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (size_t e = 0; e < m_nelem; ++e) {
 
+        size_t row = m_subset ? m_elem(e) : e;
+
         auto K = xt::adapt(&elemmat(e, 0, 0), xt::xshape<m_nne * m_ndim, m_nne * m_ndim>());
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto dNx = xt::adapt(&m_dNx(e, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+            auto dNx = xt::adapt(&dNdx(row, q, 0, 0), xt::xshape<m_nne, m_ndim>());
             auto C = xt::adapt(&qtensor(e, q, 0, 0, 0, 0), xt::xshape<m_ndim, m_ndim, m_ndim, m_ndim>());
-            auto& vol = m_vol(e, q);
+            double vol = alpha * dVol(row, q);
 
             for (size_t m = 0; m < m_nne; ++m) {
                 for (size_t n = 0; n < m_nne; ++n) {
@@ -523,6 +779,170 @@ inline void Quadrature::int_gradN_dot_tensor4_dot_gradNT_dV(
     }
 }
 
+inline void Quadrature::int_gradN_dot_mandel_dot_gradNT_dV(
+    const xt::xtensor<double, 4>& qmandel, xt::xtensor<double, 3>& elemmat) const
+{
+    GooseFEM::firstTouch(elemmat, 0.0);
+    this->int_gradN_dot_mandel_dot_gradNT_dV(qmandel, elemmat, 1.0);
+}
+
+inline void Quadrature::int_gradN_dot_mandel_dot_gradNT_dV(
+    const xt::xtensor<double, 4>& qmandel,
+    xt::xtensor<double, 3>& elemmat,
+    double alpha) const
+{
+    constexpr size_t nv = 6; // number of Mandel components: xx, yy, zz, yz, xz, xy
+    constexpr size_t ndof = m_nne * m_ndim;
+
+    GOOSEFEM_ASSERT(xt::has_shape(qmandel, {m_nelem, m_nip, nv, nv}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemmat, {m_nelem, ndof, ndof}));
+
+    const auto& dNdx = *m_dNx;
+    const auto& dVol = *m_vol;
+    const double s = 1.0 / std::sqrt(2.0);
+
+    #pragma omp parallel
+    {
+        // B-matrix [nv, ndof] (zero entries are never written), and workspace "D * B"
+        std::array<double, nv * ndof> B;
+        std::array<double, nv * ndof> DB;
+        B.fill(0.0);
+
+        #pragma omp for schedule(static)
+        for (size_t e = 0; e < m_nelem; ++e) {
+
+            size_t row = m_subset ? m_elem(e) : e;
+
+            for (size_t q = 0; q < m_nip; ++q) {
+
+                auto dNx = xt::adapt(&dNdx(row, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+
+                for (size_t m = 0; m < m_nne; ++m) {
+                    B[0 * ndof + m * m_ndim + 0] = dNx(m, 0);
+                    B[1 * ndof + m * m_ndim + 1] = dNx(m, 1);
+                    B[2 * ndof + m * m_ndim + 2] = dNx(m, 2);
+                    B[3 * ndof + m * m_ndim + 1] = s * dNx(m, 2);
+                    B[3 * ndof + m * m_ndim + 2] = s * dNx(m, 1);
+                    B[4 * ndof + m * m_ndim + 0] = s * dNx(m, 2);
+                    B[4 * ndof + m * m_ndim + 2] = s * dNx(m, 0);
+                    B[5 * ndof + m * m_ndim + 0] = s * dNx(m, 1);
+                    B[5 * ndof + m * m_ndim + 1] = s * dNx(m, 0);
+                }
+
+                const double* D = &qmandel(e, q, 0, 0);
+                double* K = &elemmat(e, 0, 0);
+
+                GooseFEM::Element::detail::add_BT_D_B<nv, ndof>(
+                    B.data(), D, alpha * dVol(row, q), DB.data(), K);
+            }
+        }
+    }
+}
+
+inline void Quadrature::int_gradN_dot_tensor2_dV_hourglass(
+    const xt::xtensor<double, 4>& qtensor,
+    const xt::xtensor<double, 3>& elemvec_u,
+    const xt::xtensor<double, 1>& stiffness,
+    xt::xtensor<double, 3>& elemvec) const
+{
+    GooseFEM::firstTouch(elemvec, 0.0);
+    this->int_gradN_dot_tensor2_dV_hourglass(qtensor, elemvec_u, stiffness, elemvec, 1.0);
+}
+
+inline void Quadrature::int_gradN_dot_tensor2_dV_hourglass(
+    const xt::xtensor<double, 4>& qtensor,
+    const xt::xtensor<double, 3>& elemvec_u,
+    const xt::xtensor<double, 1>& stiffness,
+    xt::xtensor<double, 3>& elemvec,
+    double alpha) const
+{
+    constexpr size_t nmode = 4; // number of hourglass modes
+
+    GOOSEFEM_ASSERT(m_nip == 1);
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec_u, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(stiffness.size() == m_nelem);
+
+    const auto& coor = *m_x;
+    const auto& dNdx = *m_dNx;
+    const auto& dVol = *m_vol;
+
+    // hourglass base vectors (h = eta * zeta, xi * zeta, xi * eta, xi * eta * zeta at the nodes)
+    const std::array<std::array<double, m_nne>, nmode> H = {{
+        {1.0, 1.0, -1.0, -1.0, -1.0, -1.0, 1.0, 1.0},
+        {1.0, -1.0, -1.0, 1.0, -1.0, 1.0, 1.0, -1.0},
+        {1.0, -1.0, 1.0, -1.0, 1.0, -1.0, 1.0, -1.0},
+        {-1.0, 1.0, -1.0, 1.0, 1.0, -1.0, 1.0, -1.0},
+    }};
+
+    #pragma omp parallel for schedule(static)
+    for (size_t e = 0; e < m_nelem; ++e) {
+
+        size_t row = m_subset ? m_elem(e) : e;
+
+        auto f = xt::adapt(&elemvec(e, 0, 0), xt::xshape<m_nne, m_ndim>());
+        auto u = xt::adapt(&elemvec_u(e, 0, 0), xt::xshape<m_nne, m_ndim>());
+        auto x = xt::adapt(&coor(row, 0, 0), xt::xshape<m_nne, m_ndim>());
+        auto dNx = xt::adapt(&dNdx(row, 0, 0, 0), xt::xshape<m_nne, m_ndim>());
+        auto sig = xt::adapt(&qtensor(e, 0, 0, 0), xt::xshape<m_ndim, m_ndim>());
+        double vol = alpha * dVol(row, 0);
+
+        // stress contribution (one integration point)
+
+        double k = 0.0;
+
+        for (size_t m = 0; m < m_nne; ++m) {
+            f(m, 0) +=
+                (dNx(m, 0) * sig(0, 0) + dNx(m, 1) * sig(1, 0) + dNx(m, 2) * sig(2, 0)) * vol;
+            f(m, 1) +=
+                (dNx(m, 0) * sig(0, 1) + dNx(m, 1) * sig(1, 1) + dNx(m, 2) * sig(2, 1)) * vol;
+            f(m, 2) +=
+                (dNx(m, 0) * sig(0, 2) + dNx(m, 1) * sig(1, 2) + dNx(m, 2) * sig(2, 2)) * vol;
+            for (size_t i = 0; i < m_ndim; ++i) {
+                k += dNx(m, i) * dNx(m, i);
+            }
+        }
+
+        k *= stiffness(e) * vol;
+
+        // hourglass base vectors: "gamma = (h - (h . x_i) dNdx_i) / 8", and their amplitudes "q"
+
+        for (size_t a = 0; a < nmode; ++a) {
+
+            const auto& h = H[a];
+            std::array<double, m_ndim> hx;
+            std::array<double, m_nne> gamma;
+            std::array<double, m_ndim> q;
+
+            for (size_t i = 0; i < m_ndim; ++i) {
+                hx[i] = 0.0;
+                for (size_t n = 0; n < m_nne; ++n) {
+                    hx[i] += h[n] * x(n, i);
+                }
+            }
+
+            for (size_t m = 0; m < m_nne; ++m) {
+                gamma[m] =
+                    0.125 * (h[m] - hx[0] * dNx(m, 0) - hx[1] * dNx(m, 1) - hx[2] * dNx(m, 2));
+            }
+
+            for (size_t i = 0; i < m_ndim; ++i) {
+                q[i] = 0.0;
+                for (size_t n = 0; n < m_nne; ++n) {
+                    q[i] += gamma[n] * u(n, i);
+                }
+            }
+
+            for (size_t m = 0; m < m_nne; ++m) {
+                for (size_t i = 0; i < m_ndim; ++i) {
+                    f(m, i) += k * gamma[m] * q[i];
+                }
+            }
+        }
+    }
+}
+
 template <size_t rank>
 inline xt::xtensor<double, 2 + rank>
 Quadrature::AsTensor(const xt::xtensor<double, 2>& qscalar) const
@@ -583,8 +1003,32 @@ Quadrature::Int_gradN_dot_tensor4_dot_gradNT_dV(const xt::xtensor<double, 6>& qt
     return elemmat;
 }
 
+inline xt::xtensor<double, 3>
+Quadrature::Int_gradN_dot_mandel_dot_gradNT_dV(const xt::xtensor<double, 4>& qmandel) const
+{
+    xt::xtensor<double, 3> elemmat = xt::empty<double>({m_nelem, m_ndim * m_nne, m_ndim * m_nne});
+    this->int_gradN_dot_mandel_dot_gradNT_dV(qmandel, elemmat);
+    return elemmat;
+}
+
+inline xt::xtensor<double, 3> Quadrature::Int_gradN_dot_tensor2_dV_hourglass(
+    const xt::xtensor<double, 4>& qtensor,
+    const xt::xtensor<double, 3>& elemvec_u,
+    const xt::xtensor<double, 1>& stiffness) const
+{
+    xt::xtensor<double, 3> elemvec = xt::empty<double>({m_nelem, m_nne, m_ndim});
+    this->int_gradN_dot_tensor2_dV_hourglass(qtensor, elemvec_u, stiffness, elemvec);
+    return elemvec;
+}
+
 template <size_t rank>
 inline xt::xtensor<double, rank + 2> Quadrature::AllocateQtensor() const
+{
+    return this->AllocateQtensor<rank>(0.0);
+}
+
+template <size_t rank>
+inline xt::xtensor<double, rank + 2> Quadrature::AllocateQtensor(double val) const
 {
     std::array<size_t, rank + 2> shape;
     shape[0] = m_nelem;
@@ -592,18 +1036,16 @@ inline xt::xtensor<double, rank + 2> Quadrature::AllocateQtensor() const
     size_t n = m_ndim;
     std::fill(shape.begin() + 2, shape.end(), n);
     xt::xtensor<double, rank + 2> ret = xt::empty<double>(shape);
+    GooseFEM::firstTouch(ret, val);
     return ret;
 }
 
-template <size_t rank>
-inline xt::xtensor<double, rank + 2> Quadrature::AllocateQtensor(double val) const
+inline xt::xarray<double> Quadrature::AllocateQtensor(size_t rank) const
 {
-    xt::xtensor<double, rank + 2> ret = this->AllocateQtensor<rank>();
-    ret.fill(val);
-    return ret;
+    return this->AllocateQtensor(rank, 0.0);
 }
 
-inline xt::xarray<double> Quadrature::AllocateQtensor(size_t rank) const
+inline xt::xarray<double> Quadrature::AllocateQtensor(size_t rank, double val) const
 {
     std::vector<size_t> shape(rank + 2);
     shape[0] = m_nelem;
@@ -611,13 +1053,7 @@ inline xt::xarray<double> Quadrature::AllocateQtensor(size_t rank) const
     size_t n = m_ndim;
     std::fill(shape.begin() + 2, shape.end(), n);
     xt::xarray<double> ret = xt::empty<double>(shape);
-    return ret;
-}
-
-inline xt::xarray<double> Quadrature::AllocateQtensor(size_t rank, double val) const
-{
-    xt::xarray<double> ret = this->AllocateQtensor(rank);
-    ret.fill(val);
+    GooseFEM::firstTouch(ret, val);
     return ret;
 }
 
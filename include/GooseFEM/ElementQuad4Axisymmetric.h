@@ -39,12 +39,19 @@ public:
     // Update the nodal positions (shape of "x" should match the earlier definition)
     void update_x(const xt::xtensor<double, 3>& x);
 
+    // Restrict to a subset of elements, sharing (not copying) the nodal positions,
+    // shape function gradients, and integration volumes.
+    // All "elemvec", "elemmat", "qtensor", and "qscalar" of the subset are of size "elem.size()".
+    // Note: "update_x" can only be called on the full object, subsets have to be recreated after.
+    QuadratureAxisymmetric Subset(const xt::xtensor<size_t, 1>& elem) const;
+
     // Return dimensions
     size_t nelem() const; // number of elements
     size_t nne() const;   // number of nodes per element
     size_t ndim() const;  // number of dimension
     size_t nip() const;   // number of integration points
 
+    // Shape function gradients (wrt global coordinates: "x(m,0) = z", "x(m,1) = r")
     xt::xtensor<double, 4> GradN() const;
 
     // Convert "qscalar" to "qtensor" of certain rank
@@ -54,6 +61,11 @@ public:
     // Return integration volume
     xt::xtensor<double, 2> dV() const;
 
+    // Elements with a non-positive Jacobian determinant in at least one integration point
+    // (inverted or degenerate elements; their "dV" and "GradN" are meaningless), as detected
+    // while computing the shape function gradients (upon construction, and in "update_x")
+    xt::xtensor<size_t, 1> degenerate() const;
+
     // Dyadic product (and its transpose and symmetric part)
     // qtensor(i,j) += B(m,i,j,k) * elemvec(m,k)
     void gradN_vector(const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const;
@@ -70,11 +82,58 @@ public:
     void int_gradN_dot_tensor2_dV(
         const xt::xtensor<double, 4>& qtensor, xt::xtensor<double, 3>& elemvec) const;
 
+    // Functions above, for the elements "elem" only: "elemvec" and "qtensor" are of full size
+    // (all elements), only their rows "elem" are read or (over)written, e.g. to update only the
+    // elements that changed in an event (see "Vector::assembleNode(elem, ..., alpha)")
+    void gradN_vector(
+        const xt::xtensor<size_t, 1>& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 4>& qtensor) const;
+
+    void gradN_vector_T(
+        const xt::xtensor<size_t, 1>& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 4>& qtensor) const;
+
+    void symGradN_vector(
+        const xt::xtensor<size_t, 1>& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 4>& qtensor) const;
+
+    void int_gradN_dot_tensor2_dV(
+        const xt::xtensor<size_t, 1>& elem,
+        const xt::xtensor<double, 4>& qtensor,
+        xt::xtensor<double, 3>& elemvec) const;
+
     // Integral of the assembled product
     // Kmn = ( Bm^T : qtensor : Bn ) dV
     void int_gradN_dot_tensor4_dot_gradNT_dV(
         const xt::xtensor<double, 6>& qtensor, xt::xtensor<double, 3>& elemmat) const;
 
+    // Accumulate variants of the integrals above: "elemvec += alpha * ..." and
+    // "elemmat += alpha * ..." (without zeroing the output), to combine contributions (e.g. mass,
+    // damping, and stiffness, or several material subsets) without intermediate temporaries
+    void int_N_scalar_NT_dV(
+        const xt::xtensor<double, 2>& qscalar,
+        xt::xtensor<double, 3>& elemmat,
+        double alpha) const;
+
+    void int_gradN_dot_tensor2_dV(
+        const xt::xtensor<double, 4>& qtensor,
+        xt::xtensor<double, 3>& elemvec,
+        double alpha) const;
+
+    void int_gradN_dot_tensor2_dV(
+        const xt::xtensor<size_t, 1>& elem,
+        const xt::xtensor<double, 4>& qtensor,
+        xt::xtensor<double, 3>& elemvec,
+        double alpha) const;
+
+    void int_gradN_dot_tensor4_dot_gradNT_dV(
+        const xt::xtensor<double, 6>& qtensor,
+        xt::xtensor<double, 3>& elemmat,
+        double alpha) const;
+
     // Auto-allocation of the functions above
     xt::xtensor<double, 4> GradN_vector(const xt::xtensor<double, 3>& elemvec) const;
     xt::xtensor<double, 4> GradN_vector_T(const xt::xtensor<double, 3>& elemvec) const;
@@ -102,9 +161,40 @@ public:
     xt::xtensor<double, 2> AllocateQscalar(double val) const;
 
 private:
-    // Compute "vol" and "B" based on current "x"
+    // Compute "vol", "dNx", and "Nr" based on current "x"
+    // The nonzero components of "B(m,i,j,k)" (with "r = 0", "t = 1", "z = 2") are:
+    //    B(m,r,r,r) = B(m,r,z,z) = dNx(m,1)
+    //    B(m,t,t,r) = Nr(m)
+    //    B(m,z,r,r) = B(m,z,z,z) = dNx(m,0)
     void compute_dN();
 
+    // Implementation of the functions above, on the list of elements "elem" (e.g. "xt::arange")
+    template <class E>
+    void gradN_vector_impl(
+        const E& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 4>& qtensor) const;
+
+    template <class E>
+    void gradN_vector_T_impl(
+        const E& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 4>& qtensor) const;
+
+    template <class E>
+    void symGradN_vector_impl(
+        const E& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 4>& qtensor) const;
+
+    template <class E>
+    void int_gradN_dot_tensor2_dV_impl(
+        const E& elem,
+        const xt::xtensor<double, 4>& qtensor,
+        xt::xtensor<double, 3>& elemvec,
+        double alpha,
+        bool accumulate) const;
+
 private:
     // Dimensions (flexible)
     size_t m_nelem; // number of elements
@@ -116,13 +206,19 @@ private:
     static const size_t m_tdim = 3; // number of dimensions of tensors
 
     // Data arrays
-    xt::xtensor<double, 3> m_x;    // nodal positions stored per element [nelem, nne, ndim]
+    std::shared_ptr<xt::xtensor<double, 3>> m_x; // nodal positions stored per element [nelem, nne, ndim]
     xt::xtensor<double, 1> m_w;    // weight of each integration point [nip]
     xt::xtensor<double, 2> m_xi;   // local coordinate of each integration point [nip, ndim]
     xt::xtensor<double, 2> m_N;    // shape functions [nip, nne]
     xt::xtensor<double, 3> m_dNxi; // shape function grad. wrt local  coor. [nip, nne, ndim]
-    xt::xtensor<double, 6> m_B;    // B-matrix [nelem, nne, tdim, tdim, tdim]
-    xt::xtensor<double, 2> m_vol;  // integration point volume [nelem, nip]
+    std::shared_ptr<xt::xtensor<double, 4>> m_dNx; // shape function grad. wrt global coor. [nelem, nip, nne, ndim]
+    std::shared_ptr<xt::xtensor<double, 3>> m_Nr; // shape function divided by the radius [nelem, nip, nne]
+    std::shared_ptr<xt::xtensor<double, 2>> m_vol; // integration point volume [nelem, nip]
+    xt::xtensor<size_t, 1> m_degenerate; // elements with non-positive Jacobian determinant
+
+    // Element-numbers of the subset: row in "m_x", "m_dNx", "m_Nr", "m_vol" [nelem]
+    xt::xtensor<size_t, 1> m_elem;
+    bool m_subset = false;
 };
 
 } // namespace Quad4
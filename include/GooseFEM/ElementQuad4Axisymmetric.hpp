@@ -22,12 +22,15 @@ inline QuadratureAxisymmetric::QuadratureAxisymmetric(
     const xt::xtensor<double, 3>& x,
     const xt::xtensor<double, 2>& xi,
     const xt::xtensor<double, 1>& w)
-    : m_x(x), m_w(w), m_xi(xi)
+    : m_x(std::make_shared<xt::xtensor<double, 3>>(GooseFEM::FirstTouchCopy(x))),
+      m_w(w),
+      m_xi(xi)
 {
-    GOOSEFEM_ASSERT(m_x.shape(1) == m_nne);
-    GOOSEFEM_ASSERT(m_x.shape(2) == m_ndim);
+    GOOSEFEM_ASSERT(x.shape(1) == m_nne);
+    GOOSEFEM_ASSERT(x.shape(2) == m_ndim);
 
-    m_nelem = m_x.shape(0);
+    m_nelem = x.shape(0);
+    m_elem = xt::arange<size_t>(m_nelem);
     m_nip = m_w.size();
 
     GOOSEFEM_ASSERT(m_xi.shape(0) == m_nip);
@@ -36,8 +39,12 @@ inline QuadratureAxisymmetric::QuadratureAxisymmetric(
 
     m_N = xt::empty<double>({m_nip, m_nne});
     m_dNxi = xt::empty<double>({m_nip, m_nne, m_ndim});
-    m_B = xt::empty<double>({m_nelem, m_nip, m_nne, m_tdim, m_tdim, m_tdim});
-    m_vol = xt::empty<double>({m_nelem, m_nip});
+
+    // not initialised: first written (in parallel, "first-touch") by "compute_dN"
+    m_dNx = std::make_shared<xt::xtensor<double, 4>>(
+        xt::empty<double>({m_nelem, m_nip, m_nne, m_ndim}));
+    m_Nr = std::make_shared<xt::xtensor<double, 3>>(xt::empty<double>({m_nelem, m_nip, m_nne}));
+    m_vol = std::make_shared<xt::xtensor<double, 2>>(xt::empty<double>({m_nelem, m_nip}));
 
     for (size_t q = 0; q < m_nip; ++q) {
         m_N(q, 0) = 0.25 * (1.0 - m_xi(q, 0)) * (1.0 - m_xi(q, 1));
@@ -82,6 +89,15 @@ inline size_t QuadratureAxisymmetric::nip() const
     return m_nip;
 }
 
+inline xt::xtensor<double, 4> QuadratureAxisymmetric::GradN() const
+{
+    if (m_subset) {
+        return xt::view(*m_dNx, xt::keep(m_elem));
+    }
+
+    return *m_dNx;
+}
+
 template <size_t rank>
 inline void
 QuadratureAxisymmetric::asTensor(const xt::xtensor<double, 2>& arg, xt::xtensor<double, 2 + rank>& ret) const
@@ -92,70 +108,146 @@ QuadratureAxisymmetric::asTensor(const xt::xtensor<double, 2>& arg, xt::xtensor<
 
 inline xt::xtensor<double, 2> QuadratureAxisymmetric::dV() const
 {
-    return m_vol;
+    if (m_subset) {
+        return xt::view(*m_vol, xt::keep(m_elem));
+    }
+
+    return *m_vol;
+}
+
+inline xt::xtensor<size_t, 1> QuadratureAxisymmetric::degenerate() const
+{
+    if (m_subset) {
+        return detail::positions(m_elem, m_degenerate);
+    }
+
+    return m_degenerate;
 }
 
 inline void QuadratureAxisymmetric::update_x(const xt::xtensor<double, 3>& x)
 {
-    GOOSEFEM_ASSERT(x.shape() == m_x.shape());
-    xt::noalias(m_x) = x;
+    GOOSEFEM_ASSERT(!m_subset);
+    GOOSEFEM_ASSERT(x.shape() == m_x->shape());
+
+    // data shared with copies or subsets is not overwritten
+    if (m_x.use_count() > 1) {
+        m_x = std::make_shared<xt::xtensor<double, 3>>(GooseFEM::FirstTouchCopy(x));
+    }
+    else {
+        xt::noalias(*m_x) = x;
+    }
+
+    if (m_dNx.use_count() > 1) {
+        m_dNx = std::make_shared<xt::xtensor<double, 4>>(
+            xt::empty<double>({m_nelem, m_nip, m_nne, m_ndim}));
+    }
+
+    if (m_Nr.use_count() > 1) {
+        m_Nr = std::make_shared<xt::xtensor<double, 3>>(xt::empty<double>({m_nelem, m_nip, m_nne}));
+    }
+
+    if (m_vol.use_count() > 1) {
+        m_vol = std::make_shared<xt::xtensor<double, 2>>(xt::empty<double>({m_nelem, m_nip}));
+    }
+
     compute_dN();
 }
 
+inline QuadratureAxisymmetric
+QuadratureAxisymmetric::Subset(const xt::xtensor<size_t, 1>& elem) const
+{
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+
+    QuadratureAxisymmetric ret = *this;
+    ret.m_elem = xt::view(m_elem, xt::keep(elem));
+    ret.m_nelem = elem.size();
+    ret.m_subset = true;
+    return ret;
+}
+
 inline void QuadratureAxisymmetric::compute_dN()
 {
-    // most components remain zero, and are not written
-    m_B.fill(0.0);
+    auto& x_all = *m_x;
+    auto& dNdx = *m_dNx;
+    auto& Ndivr = *m_Nr;
+    auto& dVol = *m_vol;
+
+    std::vector<char> isdegenerate(m_nelem, 0);
+
+    // batches of whole elements (such that each element is flagged by one thread only),
+    // of which the Jacobians are inverted in chunks of at most "nip_batch" integration points
+    size_t nblk = std::max(size_t(1), detail::nip_batch / m_nip);
+    size_t nbatch = (m_nelem + nblk - 1) / nblk;
 
     #pragma omp parallel
     {
-        xt::xtensor<double, 2> J = xt::empty<double>({2, 2});
-        xt::xtensor<double, 2> Jinv = xt::empty<double>({2, 2});
-
-        #pragma omp for
-        for (size_t e = 0; e < m_nelem; ++e) {
-
-            auto x = xt::adapt(&m_x(e, 0, 0), xt::xshape<m_nne, m_ndim>());
-
-            for (size_t q = 0; q < m_nip; ++q) {
-
-                auto dNxi = xt::adapt(&m_dNxi(q, 0, 0), xt::xshape<m_nne, m_ndim>());
-                auto B = xt::adapt(&m_B(e, q, 0, 0, 0, 0), xt::xshape<m_nne, m_tdim, m_tdim, m_tdim>());
-                auto N = xt::adapt(&m_N(q, 0), xt::xshape<m_nne>());
-
-                // J(i,j) += dNxi(m,i) * x(m,j);
-                J(0, 0) = dNxi(0, 0) * x(0, 0) + dNxi(1, 0) * x(1, 0) + dNxi(2, 0) * x(2, 0) +
-                          dNxi(3, 0) * x(3, 0);
-                J(0, 1) = dNxi(0, 0) * x(0, 1) + dNxi(1, 0) * x(1, 1) + dNxi(2, 0) * x(2, 1) +
-                          dNxi(3, 0) * x(3, 1);
-                J(1, 0) = dNxi(0, 1) * x(0, 0) + dNxi(1, 1) * x(1, 0) + dNxi(2, 1) * x(2, 0) +
-                          dNxi(3, 1) * x(3, 0);
-                J(1, 1) = dNxi(0, 1) * x(0, 1) + dNxi(1, 1) * x(1, 1) + dNxi(2, 1) * x(2, 1) +
-                          dNxi(3, 1) * x(3, 1);
-
-                double Jdet = inv(J, Jinv);
-
-                // radius for computation of volume
-                double rq = N(0) * x(0, 1) + N(1) * x(1, 1) + N(2) * x(2, 1) + N(3) * x(3, 1);
-
-                // dNx(m,i) += Jinv(i,j) * dNxi(m,j)
-                for (size_t m = 0; m < m_nne; ++m) {
-                    // B(m, r, r, r) = dNdx(m,1)
-                    B(m, 0, 0, 0) = Jinv(1, 0) * dNxi(m, 0) + Jinv(1, 1) * dNxi(m, 1);
-                    // B(m, r, z, z) = dNdx(m,1)
-                    B(m, 0, 2, 2) = Jinv(1, 0) * dNxi(m, 0) + Jinv(1, 1) * dNxi(m, 1);
-                    // B(m, t, t, r)
-                    B(m, 1, 1, 0) = 1.0 / rq * N(m);
-                    // B(m, z, r, r) = dNdx(m,0)
-                    B(m, 2, 0, 0) = Jinv(0, 0) * dNxi(m, 0) + Jinv(0, 1) * dNxi(m, 1);
-                    // B(m, z, z, z) = dNdx(m,0)
-                    B(m, 2, 2, 2) = Jinv(0, 0) * dNxi(m, 0) + Jinv(0, 1) * dNxi(m, 1);
+        std::array<double, detail::nip_batch * m_ndim * m_ndim> J;
+        std::array<double, detail::nip_batch * m_ndim * m_ndim> Jinv;
+        std::array<double, detail::nip_batch> Jdet;
+
+        #pragma omp for schedule(static)
+        for (size_t b = 0; b < nbatch; ++b) {
+
+            size_t end = std::min(m_nelem, (b + 1) * nblk) * m_nip;
+
+            for (size_t p0 = b * nblk * m_nip; p0 < end; p0 += detail::nip_batch) {
+
+                size_t n = std::min(detail::nip_batch, end - p0);
+
+                for (size_t i = 0; i < n; ++i) {
+
+                    size_t e = (p0 + i) / m_nip;
+                    size_t q = (p0 + i) % m_nip;
+                    auto x = xt::adapt(&x_all(e, 0, 0), xt::xshape<m_nne, m_ndim>());
+                    auto dNxi = xt::adapt(&m_dNxi(q, 0, 0), xt::xshape<m_nne, m_ndim>());
+                    double* Jq = &J[i * 4];
+
+                    // J(i,j) += dNxi(m,i) * x(m,j);
+                    Jq[0] = dNxi(0, 0) * x(0, 0) + dNxi(1, 0) * x(1, 0) + dNxi(2, 0) * x(2, 0) +
+                            dNxi(3, 0) * x(3, 0);
+                    Jq[1] = dNxi(0, 0) * x(0, 1) + dNxi(1, 0) * x(1, 1) + dNxi(2, 0) * x(2, 1) +
+                            dNxi(3, 0) * x(3, 1);
+                    Jq[2] = dNxi(0, 1) * x(0, 0) + dNxi(1, 1) * x(1, 0) + dNxi(2, 1) * x(2, 0) +
+                            dNxi(3, 1) * x(3, 0);
+                    Jq[3] = dNxi(0, 1) * x(0, 1) + dNxi(1, 1) * x(1, 1) + dNxi(2, 1) * x(2, 1) +
+                            dNxi(3, 1) * x(3, 1);
+                }
+
+                // inverse and determinant, of all integration points of the chunk at once
+                size_t nbad = detail::inv_jacobian<m_ndim>(n, J.data(), Jinv.data(), Jdet.data());
+
+                if (nbad > 0) {
+                    detail::flag_degenerate(p0, n, m_nip, Jdet.data(), isdegenerate);
                 }
 
-                m_vol(e, q) = m_w(q) * Jdet * 2.0 * M_PI * rq;
+                for (size_t i = 0; i < n; ++i) {
+
+                    size_t e = (p0 + i) / m_nip;
+                    size_t q = (p0 + i) % m_nip;
+                    auto x = xt::adapt(&x_all(e, 0, 0), xt::xshape<m_nne, m_ndim>());
+                    auto dNxi = xt::adapt(&m_dNxi(q, 0, 0), xt::xshape<m_nne, m_ndim>());
+                    auto dNx = xt::adapt(&dNdx(e, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+                    auto Nr = xt::adapt(&Ndivr(e, q, 0), xt::xshape<m_nne>());
+                    auto N = xt::adapt(&m_N(q, 0), xt::xshape<m_nne>());
+                    const double* Ji = &Jinv[i * 4];
+
+                    // radius for computation of volume
+                    double rq = N(0) * x(0, 1) + N(1) * x(1, 1) + N(2) * x(2, 1) + N(3) * x(3, 1);
+
+                    // dNx(m,i) += Jinv(i,j) * dNxi(m,j)
+                    for (size_t m = 0; m < m_nne; ++m) {
+                        dNx(m, 0) = Ji[0] * dNxi(m, 0) + Ji[1] * dNxi(m, 1);
+                        dNx(m, 1) = Ji[2] * dNxi(m, 0) + Ji[3] * dNxi(m, 1);
+                        Nr(m) = N(m) / rq;
+                    }
+
+                    dVol(e, q) = m_w(q) * Jdet[i] * 2.0 * M_PI * rq;
+                }
             }
         }
     }
+
+    m_degenerate = detail::flagged(isdegenerate);
 }
 
 inline void QuadratureAxisymmetric::gradN_vector(
@@ -163,31 +255,51 @@ inline void QuadratureAxisymmetric::gradN_vector(
 {
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_tdim, m_tdim}));
+    this->gradN_vector_impl(xt::arange<size_t>(m_nelem), elemvec, qtensor);
+}
+
+inline void QuadratureAxisymmetric::gradN_vector(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 3>& elemvec,
+    xt::xtensor<double, 4>& qtensor) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_tdim, m_tdim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+    this->gradN_vector_impl(elem, elemvec, qtensor);
+}
 
-    qtensor.fill(0.0);
+template <class E>
+inline void QuadratureAxisymmetric::gradN_vector_impl(
+    const E& elem, const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const
+{
+    const auto& dNdx = *m_dNx;
+    const auto& Ndivr = *m_Nr;
 
-    #pragma omp parallel for
-    for (size_t e = 0; e < m_nelem; ++e) {
+    #pragma omp parallel for schedule(static)
+    for (size_t ie = 0; ie < elem.size(); ++ie) {
+
+        size_t e = elem(ie);
+        size_t row = m_subset ? m_elem(e) : e;
+        std::fill_n(&qtensor(e, 0, 0, 0), m_nip * m_tdim * m_tdim, 0.0);
 
         auto u = xt::adapt(&elemvec(e, 0, 0), xt::xshape<m_nne, m_ndim>());
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto B = xt::adapt(&m_B(e, q, 0, 0, 0, 0), xt::xshape<m_nne, m_tdim, m_tdim, m_tdim>());
+            auto dNx = xt::adapt(&dNdx(row, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+            auto Nr = xt::adapt(&Ndivr(row, q, 0), xt::xshape<m_nne>());
             auto gradu = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_tdim, m_tdim>());
 
             // gradu(i,j) += B(m,i,j,k) * u(m,perm(k))
             // (where perm(0) = 1, perm(2) = 0)
-            gradu(0, 0) = B(0, 0, 0, 0) * u(0, 1) + B(1, 0, 0, 0) * u(1, 1) +
-                          B(2, 0, 0, 0) * u(2, 1) + B(3, 0, 0, 0) * u(3, 1);
-            gradu(1, 1) = B(0, 1, 1, 0) * u(0, 1) + B(1, 1, 1, 0) * u(1, 1) +
-                          B(2, 1, 1, 0) * u(2, 1) + B(3, 1, 1, 0) * u(3, 1);
-            gradu(2, 2) = B(0, 2, 2, 2) * u(0, 0) + B(1, 2, 2, 2) * u(1, 0) +
-                          B(2, 2, 2, 2) * u(2, 0) + B(3, 2, 2, 2) * u(3, 0);
-            gradu(0, 2) = B(0, 0, 2, 2) * u(0, 0) + B(1, 0, 2, 2) * u(1, 0) +
-                          B(2, 0, 2, 2) * u(2, 0) + B(3, 0, 2, 2) * u(3, 0);
-            gradu(2, 0) = B(0, 2, 0, 0) * u(0, 1) + B(1, 2, 0, 0) * u(1, 1) +
-                          B(2, 2, 0, 0) * u(2, 1) + B(3, 2, 0, 0) * u(3, 1);
+            for (size_t m = 0; m < m_nne; ++m) {
+                gradu(0, 0) += dNx(m, 1) * u(m, 1);
+                gradu(1, 1) += Nr(m) * u(m, 1);
+                gradu(2, 2) += dNx(m, 0) * u(m, 0);
+                gradu(0, 2) += dNx(m, 1) * u(m, 0);
+                gradu(2, 0) += dNx(m, 0) * u(m, 1);
+            }
         }
     }
 }
@@ -197,31 +309,51 @@ inline void QuadratureAxisymmetric::gradN_vector_T(
 {
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_tdim, m_tdim}));
+    this->gradN_vector_T_impl(xt::arange<size_t>(m_nelem), elemvec, qtensor);
+}
 
-    qtensor.fill(0.0);
+inline void QuadratureAxisymmetric::gradN_vector_T(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 3>& elemvec,
+    xt::xtensor<double, 4>& qtensor) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_tdim, m_tdim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+    this->gradN_vector_T_impl(elem, elemvec, qtensor);
+}
 
-    #pragma omp parallel for
-    for (size_t e = 0; e < m_nelem; ++e) {
+template <class E>
+inline void QuadratureAxisymmetric::gradN_vector_T_impl(
+    const E& elem, const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const
+{
+    const auto& dNdx = *m_dNx;
+    const auto& Ndivr = *m_Nr;
+
+    #pragma omp parallel for schedule(static)
+    for (size_t ie = 0; ie < elem.size(); ++ie) {
+
+        size_t e = elem(ie);
+        size_t row = m_subset ? m_elem(e) : e;
+        std::fill_n(&qtensor(e, 0, 0, 0), m_nip * m_tdim * m_tdim, 0.0);
 
         auto u = xt::adapt(&elemvec(e, 0, 0), xt::xshape<m_nne, m_ndim>());
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto B = xt::adapt(&m_B(e, q, 0, 0, 0, 0), xt::xshape<m_nne, m_tdim, m_tdim, m_tdim>());
+            auto dNx = xt::adapt(&dNdx(row, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+            auto Nr = xt::adapt(&Ndivr(row, q, 0), xt::xshape<m_nne>());
             auto gradu = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_tdim, m_tdim>());
 
             // gradu(j,i) += B(m,i,j,k) * u(m,perm(k))
             // (where perm(0) = 1, perm(2) = 0)
-            gradu(0, 0) = B(0, 0, 0, 0) * u(0, 1) + B(1, 0, 0, 0) * u(1, 1) +
-                          B(2, 0, 0, 0) * u(2, 1) + B(3, 0, 0, 0) * u(3, 1);
-            gradu(1, 1) = B(0, 1, 1, 0) * u(0, 1) + B(1, 1, 1, 0) * u(1, 1) +
-                          B(2, 1, 1, 0) * u(2, 1) + B(3, 1, 1, 0) * u(3, 1);
-            gradu(2, 2) = B(0, 2, 2, 2) * u(0, 0) + B(1, 2, 2, 2) * u(1, 0) +
-                          B(2, 2, 2, 2) * u(2, 0) + B(3, 2, 2, 2) * u(3, 0);
-            gradu(2, 0) = B(0, 0, 2, 2) * u(0, 0) + B(1, 0, 2, 2) * u(1, 0) +
-                          B(2, 0, 2, 2) * u(2, 0) + B(3, 0, 2, 2) * u(3, 0);
-            gradu(0, 2) = B(0, 2, 0, 0) * u(0, 1) + B(1, 2, 0, 0) * u(1, 1) +
-                          B(2, 2, 0, 0) * u(2, 1) + B(3, 2, 0, 0) * u(3, 1);
+            for (size_t m = 0; m < m_nne; ++m) {
+                gradu(0, 0) += dNx(m, 1) * u(m, 1);
+                gradu(1, 1) += Nr(m) * u(m, 1);
+                gradu(2, 2) += dNx(m, 0) * u(m, 0);
+                gradu(2, 0) += dNx(m, 1) * u(m, 0);
+                gradu(0, 2) += dNx(m, 0) * u(m, 1);
+            }
         }
     }
 }
@@ -231,32 +363,52 @@ inline void QuadratureAxisymmetric::symGradN_vector(
 {
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_tdim, m_tdim}));
+    this->symGradN_vector_impl(xt::arange<size_t>(m_nelem), elemvec, qtensor);
+}
 
-    qtensor.fill(0.0);
+inline void QuadratureAxisymmetric::symGradN_vector(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 3>& elemvec,
+    xt::xtensor<double, 4>& qtensor) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_tdim, m_tdim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+    this->symGradN_vector_impl(elem, elemvec, qtensor);
+}
 
-    #pragma omp parallel for
-    for (size_t e = 0; e < m_nelem; ++e) {
+template <class E>
+inline void QuadratureAxisymmetric::symGradN_vector_impl(
+    const E& elem, const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const
+{
+    const auto& dNdx = *m_dNx;
+    const auto& Ndivr = *m_Nr;
+
+    #pragma omp parallel for schedule(static)
+    for (size_t ie = 0; ie < elem.size(); ++ie) {
+
+        size_t e = elem(ie);
+        size_t row = m_subset ? m_elem(e) : e;
+        std::fill_n(&qtensor(e, 0, 0, 0), m_nip * m_tdim * m_tdim, 0.0);
 
         auto u = xt::adapt(&elemvec(e, 0, 0), xt::xshape<m_nne, m_ndim>());
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto B = xt::adapt(&m_B(e, q, 0, 0, 0, 0), xt::xshape<m_nne, m_tdim, m_tdim, m_tdim>());
+            auto dNx = xt::adapt(&dNdx(row, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+            auto Nr = xt::adapt(&Ndivr(row, q, 0), xt::xshape<m_nne>());
             auto eps = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_tdim, m_tdim>());
 
             // gradu(j,i) += B(m,i,j,k) * u(m,perm(k))
             // eps(j,i) = 0.5 * (gradu(i,j) + gradu(j,i))
             // (where perm(0) = 1, perm(2) = 0)
-            eps(0, 0) = B(0, 0, 0, 0) * u(0, 1) + B(1, 0, 0, 0) * u(1, 1) +
-                        B(2, 0, 0, 0) * u(2, 1) + B(3, 0, 0, 0) * u(3, 1);
-            eps(1, 1) = B(0, 1, 1, 0) * u(0, 1) + B(1, 1, 1, 0) * u(1, 1) +
-                        B(2, 1, 1, 0) * u(2, 1) + B(3, 1, 1, 0) * u(3, 1);
-            eps(2, 2) = B(0, 2, 2, 2) * u(0, 0) + B(1, 2, 2, 2) * u(1, 0) +
-                        B(2, 2, 2, 2) * u(2, 0) + B(3, 2, 2, 2) * u(3, 0);
-            eps(2, 0) =
-                0.5 * (B(0, 0, 2, 2) * u(0, 0) + B(1, 0, 2, 2) * u(1, 0) + B(2, 0, 2, 2) * u(2, 0) +
-                       B(3, 0, 2, 2) * u(3, 0) + B(0, 2, 0, 0) * u(0, 1) + B(1, 2, 0, 0) * u(1, 1) +
-                       B(2, 2, 0, 0) * u(2, 1) + B(3, 2, 0, 0) * u(3, 1));
+            for (size_t m = 0; m < m_nne; ++m) {
+                eps(0, 0) += dNx(m, 1) * u(m, 1);
+                eps(1, 1) += Nr(m) * u(m, 1);
+                eps(2, 2) += dNx(m, 0) * u(m, 0);
+                eps(2, 0) += 0.5 * (dNx(m, 1) * u(m, 0) + dNx(m, 0) * u(m, 1));
+            }
+
             eps(0, 2) = eps(2, 0);
         }
     }
@@ -264,21 +416,32 @@ inline void QuadratureAxisymmetric::symGradN_vector(
 
 inline void QuadratureAxisymmetric::int_N_scalar_NT_dV(
     const xt::xtensor<double, 2>& qscalar, xt::xtensor<double, 3>& elemmat) const
+{
+    GooseFEM::firstTouch(elemmat, 0.0);
+    this->int_N_scalar_NT_dV(qscalar, elemmat, 1.0);
+}
+
+inline void QuadratureAxisymmetric::int_N_scalar_NT_dV(
+    const xt::xtensor<double, 2>& qscalar,
+    xt::xtensor<double, 3>& elemmat,
+    double alpha) const
 {
     GOOSEFEM_ASSERT(xt::has_shape(qscalar, {m_nelem, m_nip}));
     GOOSEFEM_ASSERT(xt::has_shape(elemmat, {m_nelem, m_nne * m_ndim, m_nne * m_ndim}));
 
-    elemmat.fill(0.0);
+    const auto& dVol = *m_vol;
 
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (size_t e = 0; e < m_nelem; ++e) {
 
+        size_t row = m_subset ? m_elem(e) : e;
+
         auto M = xt::adapt(&elemmat(e, 0, 0), xt::xshape<m_nne * m_ndim, m_nne * m_ndim>());
 
         for (size_t q = 0; q < m_nip; ++q) {
 
             auto N = xt::adapt(&m_N(q, 0), xt::xshape<m_nne>());
-            auto& vol = m_vol(e, q);
+            double vol = alpha * dVol(row, q);
             auto& rho = qscalar(e, q);
 
             // M(m*ndim+i,n*ndim+i) += N(m) * scalar * N(n) * dV
@@ -297,26 +460,78 @@ inline void QuadratureAxisymmetric::int_gradN_dot_tensor2_dV(
 {
     GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_tdim, m_tdim}));
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    this->int_gradN_dot_tensor2_dV_impl(xt::arange<size_t>(m_nelem), qtensor, elemvec, 1.0, false);
+}
 
-    elemvec.fill(0.0);
+inline void QuadratureAxisymmetric::int_gradN_dot_tensor2_dV(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 4>& qtensor,
+    xt::xtensor<double, 3>& elemvec) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_tdim, m_tdim}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+    this->int_gradN_dot_tensor2_dV_impl(elem, qtensor, elemvec, 1.0, false);
+}
 
-    #pragma omp parallel for
-    for (size_t e = 0; e < m_nelem; ++e) {
+inline void QuadratureAxisymmetric::int_gradN_dot_tensor2_dV(
+    const xt::xtensor<double, 4>& qtensor,
+    xt::xtensor<double, 3>& elemvec,
+    double alpha) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_tdim, m_tdim}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    this->int_gradN_dot_tensor2_dV_impl(xt::arange<size_t>(m_nelem), qtensor, elemvec, alpha, true);
+}
+
+inline void QuadratureAxisymmetric::int_gradN_dot_tensor2_dV(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 4>& qtensor,
+    xt::xtensor<double, 3>& elemvec,
+    double alpha) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_tdim, m_tdim}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+    this->int_gradN_dot_tensor2_dV_impl(elem, qtensor, elemvec, alpha, true);
+}
+
+template <class E>
+inline void QuadratureAxisymmetric::int_gradN_dot_tensor2_dV_impl(
+    const E& elem,
+    const xt::xtensor<double, 4>& qtensor,
+    xt::xtensor<double, 3>& elemvec,
+    double alpha,
+    bool accumulate) const
+{
+    const auto& dNdx = *m_dNx;
+    const auto& Ndivr = *m_Nr;
+    const auto& dVol = *m_vol;
+
+    #pragma omp parallel for schedule(static)
+    for (size_t ie = 0; ie < elem.size(); ++ie) {
+
+        size_t e = elem(ie);
+        size_t row = m_subset ? m_elem(e) : e;
+        if (!accumulate) {
+            std::fill_n(&elemvec(e, 0, 0), m_nne * m_ndim, 0.0);
+        }
 
         auto f = xt::adapt(&elemvec(e, 0, 0), xt::xshape<m_nne, m_ndim>());
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto B = xt::adapt(&m_B(e, q, 0, 0, 0, 0), xt::xshape<m_nne, m_tdim, m_tdim, m_tdim>());
+            auto dNx = xt::adapt(&dNdx(row, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+            auto Nr = xt::adapt(&Ndivr(row, q, 0), xt::xshape<m_nne>());
             auto sig = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_tdim, m_tdim>());
-            auto& vol = m_vol(e, q);
+            double vol = alpha * dVol(row, q);
 
             // f(m,i) += B(m,i,j,perm(k)) * sig(i,j) * dV
             // (where perm(0) = 1, perm(2) = 0)
             for (size_t m = 0; m < m_nne; ++m) {
-                f(m, 0) += vol * (B(m, 2, 2, 2) * sig(2, 2) + B(m, 0, 2, 2) * sig(0, 2));
-                f(m, 1) += vol * (B(m, 0, 0, 0) * sig(0, 0) + B(m, 1, 1, 0) * sig(1, 1) +
-                                  B(m, 2, 0, 0) * sig(2, 0));
+                f(m, 0) += vol * (dNx(m, 0) * sig(2, 2) + dNx(m, 1) * sig(0, 2));
+                f(m, 1) +=
+                    vol * (dNx(m, 1) * sig(0, 0) + Nr(m) * sig(1, 1) + dNx(m, 0) * sig(2, 0));
             }
         }
     }
@@ -324,81 +539,68 @@ inline void QuadratureAxisymmetric::int_gradN_dot_tensor2_dV(
 
 inline void QuadratureAxisymmetric::int_gradN_dot_tensor4_dot_gradNT_dV(
     const xt::xtensor<double, 6>& qtensor, xt::xtensor<double, 3>& elemmat) const
+{
+    GooseFEM::firstTouch(elemmat, 0.0);
+    this->int_gradN_dot_tensor4_dot_gradNT_dV(qtensor, elemmat, 1.0);
+}
+
+inline void QuadratureAxisymmetric::int_gradN_dot_tensor4_dot_gradNT_dV(
+    const xt::xtensor<double, 6>& qtensor,
+    xt::xtensor<double, 3>& elemmat,
+    double alpha) const
 {
     GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_tdim, m_tdim, m_tdim, m_tdim}));
     GOOSEFEM_ASSERT(xt::has_shape(elemmat, {m_nelem, m_nne * m_ndim, m_nne * m_ndim}));
 
-    elemmat.fill(0.0);
+    const auto& dNdx = *m_dNx;
+    const auto& Ndivr = *m_Nr;
+    const auto& dVol = *m_vol;
 
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (size_t e = 0; e < m_nelem; ++e) {
 
+        size_t row = m_subset ? m_elem(e) : e;
+
         auto K = xt::adapt(&elemmat(e, 0, 0), xt::xshape<m_nne * m_ndim, m_nne * m_ndim>());
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto B = xt::adapt(&m_B(e, q, 0, 0, 0, 0), xt::xshape<m_nne, m_tdim, m_tdim, m_tdim>());
+            auto dNx = xt::adapt(&dNdx(row, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+            auto Nr = xt::adapt(&Ndivr(row, q, 0), xt::xshape<m_nne>());
             auto C = xt::adapt(&qtensor(e, q, 0, 0, 0, 0), xt::xshape<m_tdim, m_tdim, m_tdim, m_tdim>());
-            auto& vol = m_vol(e, q);
+            double vol = alpha * dVol(row, q);
 
             // K(m*m_ndim+perm(c), n*m_ndim+perm(f)) = B(m,a,b,c) * C(a,b,d,e) * B(n,e,d,f) * vol;
             // (where perm(0) = 1, perm(2) = 0)
             for (size_t m = 0; m < m_nne; ++m) {
+
+                double rm = dNx(m, 1) * vol;
+                double tm = Nr(m) * vol;
+                double zm = dNx(m, 0) * vol;
+
                 for (size_t n = 0; n < m_nne; ++n) {
-                    K(m * m_ndim + 1, n * m_ndim + 1) +=
-                        B(m, 0, 0, 0) * C(0, 0, 0, 0) * B(n, 0, 0, 0) * vol;
-                    K(m * m_ndim + 1, n * m_ndim + 1) +=
-                        B(m, 0, 0, 0) * C(0, 0, 1, 1) * B(n, 1, 1, 0) * vol;
-                    K(m * m_ndim + 1, n * m_ndim + 0) +=
-                        B(m, 0, 0, 0) * C(0, 0, 2, 2) * B(n, 2, 2, 2) * vol;
-                    K(m * m_ndim + 1, n * m_ndim + 0) +=
-                        B(m, 0, 0, 0) * C(0, 0, 2, 0) * B(n, 0, 2, 2) * vol;
-                    K(m * m_ndim + 1, n * m_ndim + 1) +=
-                        B(m, 0, 0, 0) * C(0, 0, 0, 2) * B(n, 2, 0, 0) * vol;
+
+                    double rn = dNx(n, 1);
+                    double tn = Nr(n);
+                    double zn = dNx(n, 0);
 
                     K(m * m_ndim + 1, n * m_ndim + 1) +=
-                        B(m, 1, 1, 0) * C(1, 1, 0, 0) * B(n, 0, 0, 0) * vol;
-                    K(m * m_ndim + 1, n * m_ndim + 1) +=
-                        B(m, 1, 1, 0) * C(1, 1, 1, 1) * B(n, 1, 1, 0) * vol;
-                    K(m * m_ndim + 1, n * m_ndim + 0) +=
-                        B(m, 1, 1, 0) * C(1, 1, 2, 2) * B(n, 2, 2, 2) * vol;
+                        rm * (C(0, 0, 0, 0) * rn + C(0, 0, 1, 1) * tn + C(0, 0, 0, 2) * zn) +
+                        tm * (C(1, 1, 0, 0) * rn + C(1, 1, 1, 1) * tn + C(1, 1, 0, 2) * zn) +
+                        zm * (C(2, 0, 0, 0) * rn + C(2, 0, 1, 1) * tn + C(2, 0, 0, 2) * zn);
+
                     K(m * m_ndim + 1, n * m_ndim + 0) +=
-                        B(m, 1, 1, 0) * C(1, 1, 2, 0) * B(n, 0, 2, 2) * vol;
-                    K(m * m_ndim + 1, n * m_ndim + 1) +=
-                        B(m, 1, 1, 0) * C(1, 1, 0, 2) * B(n, 2, 0, 0) * vol;
+                        rm * (C(0, 0, 2, 2) * zn + C(0, 0, 2, 0) * rn) +
+                        tm * (C(1, 1, 2, 2) * zn + C(1, 1, 2, 0) * rn) +
+                        zm * (C(2, 0, 2, 2) * zn + C(2, 0, 2, 0) * rn);
 
                     K(m * m_ndim + 0, n * m_ndim + 1) +=
-                        B(m, 2, 2, 2) * C(2, 2, 0, 0) * B(n, 0, 0, 0) * vol;
-                    K(m * m_ndim + 0, n * m_ndim + 1) +=
-                        B(m, 2, 2, 2) * C(2, 2, 1, 1) * B(n, 1, 1, 0) * vol;
-                    K(m * m_ndim + 0, n * m_ndim + 0) +=
-                        B(m, 2, 2, 2) * C(2, 2, 2, 2) * B(n, 2, 2, 2) * vol;
-                    K(m * m_ndim + 0, n * m_ndim + 0) +=
-                        B(m, 2, 2, 2) * C(2, 2, 2, 0) * B(n, 0, 2, 2) * vol;
-                    K(m * m_ndim + 0, n * m_ndim + 1) +=
-                        B(m, 2, 2, 2) * C(2, 2, 0, 2) * B(n, 2, 0, 0) * vol;
+                        zm * (C(2, 2, 0, 0) * rn + C(2, 2, 1, 1) * tn + C(2, 2, 0, 2) * zn) +
+                        rm * (C(0, 2, 0, 0) * rn + C(0, 2, 1, 1) * tn + C(0, 2, 0, 2) * zn);
 
-                    K(m * m_ndim + 0, n * m_ndim + 1) +=
-                        B(m, 0, 2, 2) * C(0, 2, 0, 0) * B(n, 0, 0, 0) * vol;
-                    K(m * m_ndim + 0, n * m_ndim + 1) +=
-                        B(m, 0, 2, 2) * C(0, 2, 1, 1) * B(n, 1, 1, 0) * vol;
                     K(m * m_ndim + 0, n * m_ndim + 0) +=
-                        B(m, 0, 2, 2) * C(0, 2, 2, 2) * B(n, 2, 2, 2) * vol;
-                    K(m * m_ndim + 0, n * m_ndim + 0) +=
-                        B(m, 0, 2, 2) * C(0, 2, 2, 0) * B(n, 0, 2, 2) * vol;
-                    K(m * m_ndim + 0, n * m_ndim + 1) +=
-                        B(m, 0, 2, 2) * C(0, 2, 0, 2) * B(n, 2, 0, 0) * vol;
-
-                    K(m * m_ndim + 1, n * m_ndim + 1) +=
-                        B(m, 2, 0, 0) * C(2, 0, 0, 0) * B(n, 0, 0, 0) * vol;
-                    K(m * m_ndim + 1, n * m_ndim + 1) +=
-                        B(m, 2, 0, 0) * C(2, 0, 1, 1) * B(n, 1, 1, 0) * vol;
-                    K(m * m_ndim + 1, n * m_ndim + 0) +=
-                        B(m, 2, 0, 0) * C(2, 0, 2, 2) * B(n, 2, 2, 2) * vol;
-                    K(m * m_ndim + 1, n * m_ndim + 0) +=
-                        B(m, 2, 0, 0) * C(2, 0, 2, 0) * B(n, 0, 2, 2) * vol;
-                    K(m * m_ndim + 1, n * m_ndim + 1) +=
-                        B(m, 2, 0, 0) * C(2, 0, 0, 2) * B(n, 2, 0, 0) * vol;
+                        zm * (C(2, 2, 2, 2) * zn + C(2, 2, 2, 0) * rn) +
+                        rm * (C(0, 2, 2, 2) * zn + C(0, 2, 2, 0) * rn);
                 }
             }
         }
@@ -468,6 +670,12 @@ QuadratureAxisymmetric::Int_gradN_dot_tensor4_dot_gradNT_dV(const xt::xtensor<do
 
 template <size_t rank>
 inline xt::xtensor<double, rank + 2> QuadratureAxisymmetric::AllocateQtensor() const
+{
+    return this->AllocateQtensor<rank>(0.0);
+}
+
+template <size_t rank>
+inline xt::xtensor<double, rank + 2> QuadratureAxisymmetric::AllocateQtensor(double val) const
 {
     std::array<size_t, rank + 2> shape;
     shape[0] = m_nelem;
@@ -475,18 +683,16 @@ inline xt::xtensor<double, rank + 2> QuadratureAxisymmetric::AllocateQtensor() c
     size_t n = m_tdim;
     std::fill(shape.begin() + 2, shape.end(), n);
     xt::xtensor<double, rank + 2> ret = xt::empty<double>(shape);
+    GooseFEM::firstTouch(ret, val);
     return ret;
 }
 
-template <size_t rank>
-inline xt::xtensor<double, rank + 2> QuadratureAxisymmetric::AllocateQtensor(double val) const
+inline xt::xarray<double> QuadratureAxisymmetric::AllocateQtensor(size_t rank) const
 {
-    xt::xtensor<double, rank + 2> ret = this->AllocateQtensor<rank>();
-    ret.fill(val);
-    return ret;
+    return this->AllocateQtensor(rank, 0.0);
 }
 
-inline xt::xarray<double> QuadratureAxisymmetric::AllocateQtensor(size_t rank) const
+inline xt::xarray<double> QuadratureAxisymmetric::AllocateQtensor(size_t rank, double val) const
 {
     std::vector<size_t> shape(rank + 2);
     shape[0] = m_nelem;
@@ -494,13 +700,7 @@ inline xt::xarray<double> QuadratureAxisymmetric::AllocateQtensor(size_t rank) c
     size_t n = m_tdim;
     std::fill(shape.begin() + 2, shape.end(), n);
     xt::xarray<double> ret = xt::empty<double>(shape);
-    return ret;
-}
-
-inline xt::xarray<double> QuadratureAxisymmetric::AllocateQtensor(size_t rank, double val) const
-{
-    xt::xarray<double> ret = this->AllocateQtensor(rank);
-    ret.fill(val);
+    GooseFEM::firstTouch(ret, val);
     return ret;
 }
 
@@ -23,12 +23,16 @@ inline QuadraturePlanar::QuadraturePlanar(
     const xt::xtensor<double, 2>& xi,
     const xt::xtensor<double, 1>& w,
     double thick)
-    : m_x(x), m_w(w), m_xi(xi), m_thick(thick)
+    : m_x(std::make_shared<xt::xtensor<double, 3>>(GooseFEM::FirstTouchCopy(x))),
+      m_w(w),
+      m_xi(xi),
+      m_thick(thick)
 {
-    GOOSEFEM_ASSERT(m_x.shape(1) == m_nne);
-    GOOSEFEM_ASSERT(m_x.shape(2) == m_ndim);
+    GOOSEFEM_ASSERT(x.shape(1) == m_nne);
+    GOOSEFEM_ASSERT(x.shape(2) == m_ndim);
 
-    m_nelem = m_x.shape(0);
+    m_nelem = x.shape(0);
+    m_elem = xt::arange<size_t>(m_nelem);
     m_nip = m_w.size();
 
     GOOSEFEM_ASSERT(m_xi.shape(0) == m_nip);
@@ -37,8 +41,11 @@ inline QuadraturePlanar::QuadraturePlanar(
 
     m_N = xt::empty<double>({m_nip, m_nne});
     m_dNxi = xt::empty<double>({m_nip, m_nne, m_ndim});
-    m_dNx = xt::empty<double>({m_nelem, m_nip, m_nne, m_ndim});
-    m_vol = xt::empty<double>({m_nelem, m_nip});
+
+    // not initialised: first written (in parallel, "first-touch") by "compute_dN"
+    m_dNx = std::make_shared<xt::xtensor<double, 4>>(
+        xt::empty<double>({m_nelem, m_nip, m_nne, m_ndim}));
+    m_vol = std::make_shared<xt::xtensor<double, 2>>(xt::empty<double>({m_nelem, m_nip}));
 
     for (size_t q = 0; q < m_nip; ++q) {
         m_N(q, 0) = 0.25 * (1.0 - m_xi(q, 0)) * (1.0 - m_xi(q, 1));
@@ -85,7 +92,11 @@ inline size_t QuadraturePlanar::nip() const
 
 inline xt::xtensor<double, 4> QuadraturePlanar::GradN() const
 {
-    return m_dNx;
+    if (m_subset) {
+        return xt::view(*m_dNx, xt::keep(m_elem));
+    }
+
+    return *m_dNx;
 }
 
 template <size_t rank>
@@ -98,55 +109,133 @@ QuadraturePlanar::asTensor(const xt::xtensor<double, 2>& arg, xt::xtensor<double
 
 inline xt::xtensor<double, 2> QuadraturePlanar::dV() const
 {
-    return m_vol;
+    if (m_subset) {
+        return xt::view(*m_vol, xt::keep(m_elem));
+    }
+
+    return *m_vol;
+}
+
+inline xt::xtensor<size_t, 1> QuadraturePlanar::degenerate() const
+{
+    if (m_subset) {
+        return detail::positions(m_elem, m_degenerate);
+    }
+
+    return m_degenerate;
 }
 
 inline void QuadraturePlanar::update_x(const xt::xtensor<double, 3>& x)
 {
-    GOOSEFEM_ASSERT(x.shape() == m_x.shape());
-    xt::noalias(m_x) = x;
+    GOOSEFEM_ASSERT(!m_subset);
+    GOOSEFEM_ASSERT(x.shape() == m_x->shape());
+
+    // data shared with copies or subsets is not overwritten
+    if (m_x.use_count() > 1) {
+        m_x = std::make_shared<xt::xtensor<double, 3>>(GooseFEM::FirstTouchCopy(x));
+    }
+    else {
+        xt::noalias(*m_x) = x;
+    }
+
+    if (m_dNx.use_count() > 1) {
+        m_dNx = std::make_shared<xt::xtensor<double, 4>>(
+            xt::empty<double>({m_nelem, m_nip, m_nne, m_ndim}));
+    }
+
+    if (m_vol.use_count() > 1) {
+        m_vol = std::make_shared<xt::xtensor<double, 2>>(xt::empty<double>({m_nelem, m_nip}));
+    }
+
     compute_dN();
 }
 
+inline QuadraturePlanar QuadraturePlanar::Subset(const xt::xtensor<size_t, 1>& elem) const
+{
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+
+    QuadraturePlanar ret = *this;
+    ret.m_elem = xt::view(m_elem, xt::keep(elem));
+    ret.m_nelem = elem.size();
+    ret.m_subset = true;
+    return ret;
+}
+
 inline void QuadraturePlanar::compute_dN()
 {
+    auto& x_all = *m_x;
+    auto& dNdx = *m_dNx;
+    auto& dVol = *m_vol;
+
+    std::vector<char> isdegenerate(m_nelem, 0);
+
+    // batches of whole elements (such that each element is flagged by one thread only),
+    // of which the Jacobians are inverted in chunks of at most "nip_batch" integration points
+    size_t nblk = std::max(size_t(1), detail::nip_batch / m_nip);
+    size_t nbatch = (m_nelem + nblk - 1) / nblk;
+
     #pragma omp parallel
     {
-        xt::xtensor<double, 2> J = xt::empty<double>({2, 2});
-        xt::xtensor<double, 2> Jinv = xt::empty<double>({2, 2});
+        std::array<double, detail::nip_batch * m_ndim * m_ndim> J;
+        std::array<double, detail::nip_batch * m_ndim * m_ndim> Jinv;
+        std::array<double, detail::nip_batch> Jdet;
 
-        #pragma omp for
-        for (size_t e = 0; e < m_nelem; ++e) {
+        #pragma omp for schedule(static)
+        for (size_t b = 0; b < nbatch; ++b) {
 
-            auto x = xt::adapt(&m_x(e, 0, 0), xt::xshape<m_nne, m_ndim>());
+            size_t end = std::min(m_nelem, (b + 1) * nblk) * m_nip;
 
-            for (size_t q = 0; q < m_nip; ++q) {
+            for (size_t p0 = b * nblk * m_nip; p0 < end; p0 += detail::nip_batch) {
 
-                auto dNxi = xt::adapt(&m_dNxi(q, 0, 0), xt::xshape<m_nne, m_ndim>());
-                auto dNx = xt::adapt(&m_dNx(e, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+                size_t n = std::min(detail::nip_batch, end - p0);
 
-                // J(i,j) += dNxi(m,i) * x(m,j);
-                J(0, 0) = dNxi(0, 0) * x(0, 0) + dNxi(1, 0) * x(1, 0) + dNxi(2, 0) * x(2, 0) +
-                          dNxi(3, 0) * x(3, 0);
-                J(0, 1) = dNxi(0, 0) * x(0, 1) + dNxi(1, 0) * x(1, 1) + dNxi(2, 0) * x(2, 1) +
-                          dNxi(3, 0) * x(3, 1);
-                J(1, 0) = dNxi(0, 1) * x(0, 0) + dNxi(1, 1) * x(1, 0) + dNxi(2, 1) * x(2, 0) +
-                          dNxi(3, 1) * x(3, 0);
-                J(1, 1) = dNxi(0, 1) * x(0, 1) + dNxi(1, 1) * x(1, 1) + dNxi(2, 1) * x(2, 1) +
-                          dNxi(3, 1) * x(3, 1);
+                for (size_t i = 0; i < n; ++i) {
 
-                double Jdet = inv(J, Jinv);
+                    size_t e = (p0 + i) / m_nip;
+                    size_t q = (p0 + i) % m_nip;
+                    auto x = xt::adapt(&x_all(e, 0, 0), xt::xshape<m_nne, m_ndim>());
+                    auto dNxi = xt::adapt(&m_dNxi(q, 0, 0), xt::xshape<m_nne, m_ndim>());
+                    double* Jq = &J[i * 4];
 
-                // dNx(m,i) += Jinv(i,j) * dNxi(m,j);
-                for (size_t m = 0; m < m_nne; ++m) {
-                    dNx(m, 0) = Jinv(0, 0) * dNxi(m, 0) + Jinv(0, 1) * dNxi(m, 1);
-                    dNx(m, 1) = Jinv(1, 0) * dNxi(m, 0) + Jinv(1, 1) * dNxi(m, 1);
+                    // J(i,j) += dNxi(m,i) * x(m,j);
+                    Jq[0] = dNxi(0, 0) * x(0, 0) + dNxi(1, 0) * x(1, 0) + dNxi(2, 0) * x(2, 0) +
+                            dNxi(3, 0) * x(3, 0);
+                    Jq[1] = dNxi(0, 0) * x(0, 1) + dNxi(1, 0) * x(1, 1) + dNxi(2, 0) * x(2, 1) +
+                            dNxi(3, 0) * x(3, 1);
+                    Jq[2] = dNxi(0, 1) * x(0, 0) + dNxi(1, 1) * x(1, 0) + dNxi(2, 1) * x(2, 0) +
+                            dNxi(3, 1) * x(3, 0);
+                    Jq[3] = dNxi(0, 1) * x(0, 1) + dNxi(1, 1) * x(1, 1) + dNxi(2, 1) * x(2, 1) +
+                            dNxi(3, 1) * x(3, 1);
                 }
 
-                m_vol(e, q) = m_w(q) * Jdet * m_thick;
+                // inverse and determinant, of all integration points of the chunk at once
+                size_t nbad = detail::inv_jacobian<m_ndim>(n, J.data(), Jinv.data(), Jdet.data());
+
+                if (nbad > 0) {
+                    detail::flag_degenerate(p0, n, m_nip, Jdet.data(), isdegenerate);
+                }
+
+                for (size_t i = 0; i < n; ++i) {
+
+                    size_t e = (p0 + i) / m_nip;
+                    size_t q = (p0 + i) % m_nip;
+                    auto dNxi = xt::adapt(&m_dNxi(q, 0, 0), xt::xshape<m_nne, m_ndim>());
+                    auto dNx = xt::adapt(&dNdx(e, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+                    const double* Ji = &Jinv[i * 4];
+
+                    // dNx(m,i) += Jinv(i,j) * dNxi(m,j);
+                    for (size_t m = 0; m < m_nne; ++m) {
+                        dNx(m, 0) = Ji[0] * dNxi(m, 0) + Ji[1] * dNxi(m, 1);
+                        dNx(m, 1) = Ji[2] * dNxi(m, 0) + Ji[3] * dNxi(m, 1);
+                    }
+
+                    dVol(e, q) = m_w(q) * Jdet[i] * m_thick;
+                }
             }
         }
     }
+
+    m_degenerate = detail::flagged(isdegenerate);
 }
 
 inline void QuadraturePlanar::gradN_vector(
@@ -154,17 +243,38 @@ inline void QuadraturePlanar::gradN_vector(
 {
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_tdim, m_tdim}));
+    this->gradN_vector_impl(xt::arange<size_t>(m_nelem), elemvec, qtensor);
+}
+
+inline void QuadraturePlanar::gradN_vector(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 3>& elemvec,
+    xt::xtensor<double, 4>& qtensor) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_tdim, m_tdim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+    this->gradN_vector_impl(elem, elemvec, qtensor);
+}
 
-    qtensor.fill(0.0);
+template <class E>
+inline void QuadraturePlanar::gradN_vector_impl(
+    const E& elem, const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const
+{
+    const auto& dNdx = *m_dNx;
 
-    #pragma omp parallel for
-    for (size_t e = 0; e < m_nelem; ++e) {
+    #pragma omp parallel for schedule(static)
+    for (size_t ie = 0; ie < elem.size(); ++ie) {
+
+        size_t e = elem(ie);
+        size_t row = m_subset ? m_elem(e) : e;
+        std::fill_n(&qtensor(e, 0, 0, 0), m_nip * m_tdim * m_tdim, 0.0);
 
         auto u = xt::adapt(&elemvec(e, 0, 0), xt::xshape<m_nne, m_ndim>());
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto dNx = xt::adapt(&m_dNx(e, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+            auto dNx = xt::adapt(&dNdx(row, q, 0, 0), xt::xshape<m_nne, m_ndim>());
             auto gradu = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_tdim, m_tdim>());
 
             // gradu(i,j) += dNx(m,i) * u(m,j)
@@ -185,17 +295,38 @@ inline void QuadraturePlanar::gradN_vector_T(
 {
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_tdim, m_tdim}));
+    this->gradN_vector_T_impl(xt::arange<size_t>(m_nelem), elemvec, qtensor);
+}
 
-    qtensor.fill(0.0);
+inline void QuadraturePlanar::gradN_vector_T(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 3>& elemvec,
+    xt::xtensor<double, 4>& qtensor) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_tdim, m_tdim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+    this->gradN_vector_T_impl(elem, elemvec, qtensor);
+}
 
-    #pragma omp parallel for
-    for (size_t e = 0; e < m_nelem; ++e) {
+template <class E>
+inline void QuadraturePlanar::gradN_vector_T_impl(
+    const E& elem, const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const
+{
+    const auto& dNdx = *m_dNx;
+
+    #pragma omp parallel for schedule(static)
+    for (size_t ie = 0; ie < elem.size(); ++ie) {
+
+        size_t e = elem(ie);
+        size_t row = m_subset ? m_elem(e) : e;
+        std::fill_n(&qtensor(e, 0, 0, 0), m_nip * m_tdim * m_tdim, 0.0);
 
         auto u = xt::adapt(&elemvec(e, 0, 0), xt::xshape<m_nne, m_ndim>());
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto dNx = xt::adapt(&m_dNx(e, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+            auto dNx = xt::adapt(&dNdx(row, q, 0, 0), xt::xshape<m_nne, m_ndim>());
             auto gradu = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_tdim, m_tdim>());
 
             // gradu(j,i) += dNx(m,i) * u(m,j)
@@ -216,17 +347,38 @@ inline void QuadraturePlanar::symGradN_vector(
 {
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_tdim, m_tdim}));
+    this->symGradN_vector_impl(xt::arange<size_t>(m_nelem), elemvec, qtensor);
+}
 
-    qtensor.fill(0.0);
+inline void QuadraturePlanar::symGradN_vector(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 3>& elemvec,
+    xt::xtensor<double, 4>& qtensor) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_tdim, m_tdim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+    this->symGradN_vector_impl(elem, elemvec, qtensor);
+}
 
-    #pragma omp parallel for
-    for (size_t e = 0; e < m_nelem; ++e) {
+template <class E>
+inline void QuadraturePlanar::symGradN_vector_impl(
+    const E& elem, const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const
+{
+    const auto& dNdx = *m_dNx;
+
+    #pragma omp parallel for schedule(static)
+    for (size_t ie = 0; ie < elem.size(); ++ie) {
+
+        size_t e = elem(ie);
+        size_t row = m_subset ? m_elem(e) : e;
+        std::fill_n(&qtensor(e, 0, 0, 0), m_nip * m_tdim * m_tdim, 0.0);
 
         auto u = xt::adapt(&elemvec(e, 0, 0), xt::xshape<m_nne, m_ndim>());
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto dNx = xt::adapt(&m_dNx(e, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+            auto dNx = xt::adapt(&dNdx(row, q, 0, 0), xt::xshape<m_nne, m_ndim>());
             auto eps = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_tdim, m_tdim>());
 
             // gradu(i,j) += dNx(m,i) * u(m,j)
@@ -245,21 +397,32 @@ inline void QuadraturePlanar::symGradN_vector(
 
 inline void QuadraturePlanar::int_N_scalar_NT_dV(
     const xt::xtensor<double, 2>& qscalar, xt::xtensor<double, 3>& elemmat) const
+{
+    GooseFEM::firstTouch(elemmat, 0.0);
+    this->int_N_scalar_NT_dV(qscalar, elemmat, 1.0);
+}
+
+inline void QuadraturePlanar::int_N_scalar_NT_dV(
+    const xt::xtensor<double, 2>& qscalar,
+    xt::xtensor<double, 3>& elemmat,
+    double alpha) const
 {
     GOOSEFEM_ASSERT(xt::has_shape(qscalar, {m_nelem, m_nip}));
     GOOSEFEM_ASSERT(xt::has_shape(elemmat, {m_nelem, m_nne * m_ndim, m_nne * m_ndim}));
 
-    elemmat.fill(0.0);
+    const auto& dVol = *m_vol;
 
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (size_t e = 0; e < m_nelem; ++e) {
 
+        size_t row = m_subset ? m_elem(e) : e;
+
         auto M = xt::adapt(&elemmat(e, 0, 0), xt::xshape<m_nne * m_ndim, m_nne * m_ndim>());
 
         for (size_t q = 0; q < m_nip; ++q) {
 
             auto N = xt::adapt(&m_N(q, 0), xt::xshape<m_nne>());
-            auto& vol = m_vol(e, q);
+            double vol = alpha * dVol(row, q);
             auto& rho = qscalar(e, q);
 
             // M(m*ndim+i,n*ndim+i) += N(m) * scalar * N(n) * dV
@@ -278,19 +441,69 @@ inline void QuadraturePlanar::int_gradN_dot_tensor2_dV(
 {
     GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_tdim, m_tdim}));
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    this->int_gradN_dot_tensor2_dV_impl(xt::arange<size_t>(m_nelem), qtensor, elemvec, 1.0, false);
+}
 
-    elemvec.fill(0.0);
+inline void QuadraturePlanar::int_gradN_dot_tensor2_dV(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 4>& qtensor,
+    xt::xtensor<double, 3>& elemvec) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_tdim, m_tdim}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+    this->int_gradN_dot_tensor2_dV_impl(elem, qtensor, elemvec, 1.0, false);
+}
 
-    #pragma omp parallel for
-    for (size_t e = 0; e < m_nelem; ++e) {
+inline void QuadraturePlanar::int_gradN_dot_tensor2_dV(
+    const xt::xtensor<double, 4>& qtensor,
+    xt::xtensor<double, 3>& elemvec,
+    double alpha) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_tdim, m_tdim}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    this->int_gradN_dot_tensor2_dV_impl(xt::arange<size_t>(m_nelem), qtensor, elemvec, alpha, true);
+}
+
+inline void QuadraturePlanar::int_gradN_dot_tensor2_dV(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 4>& qtensor,
+    xt::xtensor<double, 3>& elemvec,
+    double alpha) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_tdim, m_tdim}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+    this->int_gradN_dot_tensor2_dV_impl(elem, qtensor, elemvec, alpha, true);
+}
+
+template <class E>
+inline void QuadraturePlanar::int_gradN_dot_tensor2_dV_impl(
+    const E& elem,
+    const xt::xtensor<double, 4>& qtensor,
+    xt::xtensor<double, 3>& elemvec,
+    double alpha,
+    bool accumulate) const
+{
+    const auto& dNdx = *m_dNx;
+    const auto& dVol = *m_vol;
+
+    #pragma omp parallel for schedule(static)
+    for (size_t ie = 0; ie < elem.size(); ++ie) {
+
+        size_t e = elem(ie);
+        size_t row = m_subset ? m_elem(e) : e;
+        if (!accumulate) {
+            std::fill_n(&elemvec(e, 0, 0), m_nne * m_ndim, 0.0);
+        }
 
         auto f = xt::adapt(&elemvec(e, 0, 0), xt::xshape<m_nne, m_ndim>());
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto dNx = xt::adapt(&m_dNx(e, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+            auto dNx = xt::adapt(&dNdx(row, q, 0, 0), xt::xshape<m_nne, m_ndim>());
             auto sig = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_tdim, m_tdim>());
-            auto& vol = m_vol(e, q);
+            double vol = alpha * dVol(row, q);
 
             for (size_t m = 0; m < m_nne; ++m) {
                 f(m, 0) += (dNx(m, 0) * sig(0, 0) + dNx(m, 1) * sig(1, 0)) * vol;
@@ -302,22 +515,34 @@ inline void QuadraturePlanar::int_gradN_dot_tensor2_dV(
 
 inline void QuadraturePlanar::int_gradN_dot_tensor4_dot_gradNT_dV(
     const xt::xtensor<double, 6>& qtensor, xt::xtensor<double, 3>& elemmat) const
+{
+    GooseFEM::firstTouch(elemmat, 0.0);
+    this->int_gradN_dot_tensor4_dot_gradNT_dV(qtensor, elemmat, 1.0);
+}
+
+inline void QuadraturePlanar::int_gradN_dot_tensor4_dot_gradNT_dV(
+    const xt::xtensor<double, 6>& qtensor,
+    xt::xtensor<double, 3>& elemmat,
+    double alpha) const
 {
     GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_tdim, m_tdim, m_tdim, m_tdim}));
     GOOSEFEM_ASSERT(xt::has_shape(elemmat, {m_nelem, m_nne * m_ndim, m_nne * m_ndim}));
 
-    elemmat.fill(0.0);
+    const auto& dNdx = *m_dNx;
+    const auto& dVol = *m_vol;
 
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (size_t e = 0; e < m_nelem; ++e) {
 
+        size_t row = m_subset ? m_elem(e) : e;
+
         auto K = xt::adapt(&elemmat(e, 0, 0), xt::xshape<m_nne * m_ndim, m_nne * m_ndim>());
 
         for (size_t q = 0; q < m_nip; ++q) {
 
-            auto dNx = xt::adapt(&m_dNx(e, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+            auto dNx = xt::adapt(&dNdx(row, q, 0, 0), xt::xshape<m_nne, m_ndim>());
             auto C = xt::adapt(&qtensor(e, q, 0, 0, 0, 0), xt::xshape<m_tdim, m_tdim, m_tdim, m_tdim>());
-            auto& vol = m_vol(e, q);
+            double vol = alpha * dVol(row, q);
 
             for (size_t m = 0; m < m_nne; ++m) {
                 for (size_t n = 0; n < m_nne; ++n) {
@@ -337,6 +562,68 @@ inline void QuadraturePlanar::int_gradN_dot_tensor4_dot_gradNT_dV(
     }
 }
 
+inline void QuadraturePlanar::int_gradN_dot_mandel_dot_gradNT_dV(
+    const xt::xtensor<double, 4>& qmandel, xt::xtensor<double, 3>& elemmat) const
+{
+    GooseFEM::firstTouch(elemmat, 0.0);
+    this->int_gradN_dot_mandel_dot_gradNT_dV(qmandel, elemmat, 1.0);
+}
+
+inline void QuadraturePlanar::int_gradN_dot_mandel_dot_gradNT_dV(
+    const xt::xtensor<double, 4>& qmandel,
+    xt::xtensor<double, 3>& elemmat,
+    double alpha) const
+{
+    constexpr size_t nm = 6; // number of Mandel components (of the three-dimensional tensor)
+    constexpr size_t nv = 3; // number of in-plane Mandel components: xx, yy, xy
+    constexpr size_t ndof = m_nne * m_ndim;
+    const std::array<size_t, nv> index = {0, 1, 5}; // in-plane components in "qmandel"
+
+    GOOSEFEM_ASSERT(xt::has_shape(qmandel, {m_nelem, m_nip, nm, nm}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemmat, {m_nelem, ndof, ndof}));
+
+    const double s = 1.0 / std::sqrt(2.0);
+
+    const auto& dNdx = *m_dNx;
+    const auto& dVol = *m_vol;
+
+    #pragma omp parallel
+    {
+        // B-matrix [nv, ndof] (zero entries are never written), in-plane tangent [nv, nv],
+        // and workspace "D * B"
+        std::array<double, nv * ndof> B;
+        std::array<double, nv * nv> D;
+        std::array<double, nv * ndof> DB;
+        B.fill(0.0);
+
+        #pragma omp for schedule(static)
+        for (size_t e = 0; e < m_nelem; ++e) {
+            size_t row = m_subset ? m_elem(e) : e;
+
+            for (size_t q = 0; q < m_nip; ++q) {
+
+                auto dNx = xt::adapt(&dNdx(row, q, 0, 0), xt::xshape<m_nne, m_ndim>());
+
+                for (size_t m = 0; m < m_nne; ++m) {
+                    B[0 * ndof + m * m_ndim + 0] = dNx(m, 0);
+                    B[1 * ndof + m * m_ndim + 1] = dNx(m, 1);
+                    B[2 * ndof + m * m_ndim + 0] = s * dNx(m, 1);
+                    B[2 * ndof + m * m_ndim + 1] = s * dNx(m, 0);
+                }
+
+                for (size_t a = 0; a < nv; ++a) {
+                    for (size_t b = 0; b < nv; ++b) {
+                        D[a * nv + b] = qmandel(e, q, index[a], index[b]);
+                    }
+                }
+
+                GooseFEM::Element::detail::add_BT_D_B<nv, ndof>(
+                    B.data(), D.data(), alpha * dVol(row, q), DB.data(), &elemmat(e, 0, 0));
+            }
+        }
+    }
+}
+
 template <size_t rank>
 inline xt::xtensor<double, 2 + rank>
 QuadraturePlanar::AsTensor(const xt::xtensor<double, 2>& qscalar) const
@@ -398,8 +685,22 @@ QuadraturePlanar::Int_gradN_dot_tensor4_dot_gradNT_dV(const xt::xtensor<double,
     return elemmat;
 }
 
+inline xt::xtensor<double, 3>
+QuadraturePlanar::Int_gradN_dot_mandel_dot_gradNT_dV(const xt::xtensor<double, 4>& qmandel) const
+{
+    xt::xtensor<double, 3> elemmat = xt::empty<double>({m_nelem, m_ndim * m_nne, m_ndim * m_nne});
+    this->int_gradN_dot_mandel_dot_gradNT_dV(qmandel, elemmat);
+    return elemmat;
+}
+
 template <size_t rank>
 inline xt::xtensor<double, rank + 2> QuadraturePlanar::AllocateQtensor() const
+{
+    return this->AllocateQtensor<rank>(0.0);
+}
+
+template <size_t rank>
+inline xt::xtensor<double, rank + 2> QuadraturePlanar::AllocateQtensor(double val) const
 {
     std::array<size_t, rank + 2> shape;
     shape[0] = m_nelem;
@@ -407,18 +708,16 @@ inline xt::xtensor<double, rank + 2> QuadraturePlanar::AllocateQtensor() const
     size_t n = m_tdim;
     std::fill(shape.begin() + 2, shape.end(), n);
     xt::xtensor<double, rank + 2> ret = xt::empty<double>(shape);
+    GooseFEM::firstTouch(ret, val);
     return ret;
 }
 
-template <size_t rank>
-inline xt::xtensor<double, rank + 2> QuadraturePlanar::AllocateQtensor(double val) const
+inline xt::xarray<double> QuadraturePlanar::AllocateQtensor(size_t rank) const
 {
-    xt::xtensor<double, rank + 2> ret = this->AllocateQtensor<rank>();
-    ret.fill(val);
-    return ret;
+    return this->AllocateQtensor(rank, 0.0);
 }
 
-inline xt::xarray<double> QuadraturePlanar::AllocateQtensor(size_t rank) const
+inline xt::xarray<double> QuadraturePlanar::AllocateQtensor(size_t rank, double val) const
 {
     std::vector<size_t> shape(rank + 2);
     shape[0] = m_nelem;
@@ -426,13 +725,7 @@ inline xt::xarray<double> QuadraturePlanar::AllocateQtensor(size_t rank) const
     size_t n = m_tdim;
     std::fill(shape.begin() + 2, shape.end(), n);
     xt::xarray<double> ret = xt::empty<double>(shape);
-    return ret;
-}
-
-inline xt::xarray<double> QuadraturePlanar::AllocateQtensor(size_t rank, double val) const
-{
-    xt::xarray<double> ret = this->AllocateQtensor(rank);
-    ret.fill(val);
+    GooseFEM::firstTouch(ret, val);
     return ret;
 }
 
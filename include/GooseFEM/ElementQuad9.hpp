@@ -0,0 +1,58 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_ELEMENTQUAD9_HPP
+#define GOOSEFEM_ELEMENTQUAD9_HPP
+
+#include "ElementQuad9.h"
+
+namespace GooseFEM {
+namespace Element {
+namespace Quad9 {
+
+namespace Gauss {
+
+inline size_t nip()
+{
+    return 9;
+}
+
+inline xt::xtensor<double, 2> xi()
+{
+    return detail::tensor_xi(detail::gauss_xi(), 2);
+}
+
+inline xt::xtensor<double, 1> w()
+{
+    return detail::tensor_w(detail::gauss_w(), 2);
+}
+
+} // namespace Gauss
+
+namespace Nodal {
+
+inline size_t nip()
+{
+    return 9;
+}
+
+inline xt::xtensor<double, 2> xi()
+{
+    return detail::tensor_xi(detail::lobatto_xi(), 2);
+}
+
+inline xt::xtensor<double, 1> w()
+{
+    return detail::tensor_w(detail::lobatto_w(), 2);
+}
+
+} // namespace Nodal
+
+} // namespace Quad9
+} // namespace Element
+} // namespace GooseFEM
+
+#endif
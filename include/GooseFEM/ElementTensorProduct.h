@@ -0,0 +1,275 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_ELEMENTTENSORPRODUCT_H
+#define GOOSEFEM_ELEMENTTENSORPRODUCT_H
+
+#include "config.h"
+
+namespace GooseFEM {
+namespace Element {
+namespace detail {
+
+/*
+  Quadratic Lagrange element on a tensor-product grid of 3 nodes per direction (Quad9: ndim = 2,
+  Hex27: ndim = 3), with integration points on a tensor-product grid.
+
+  Node and integration point numbering is lexicographic (first direction fastest), e.g. for 2-d:
+  node "m = a0 + 3 * a1" has local coordinates "(a0 - 1, a1 - 1)".
+
+  The interpolation to, and the integration from, the integration points is done by sum
+  factorisation: one small 1-d contraction per direction, instead of a dense [nip, nne] product.
+  Per integration point only the inverse Jacobian and the volume are stored (not the shape
+  function gradients).
+*/
+
+template <size_t nd>
+class TensorProductQuadrature {
+public:
+    // Fixed dimensions:
+    //    ndim              -  number of dimensions (template parameter)
+    //    nne  = 3 ^ ndim   -  number of nodes per element
+    //
+    // Naming convention:
+    //    "elemmat"  -  matrices stored per element       -  [nelem, nne*ndim, nne*ndim]
+    //    "elemvec"  -  nodal vectors stored per element  -  [nelem, nne, ndim]
+    //    "qtensor"  -  integration point tensor          -  [nelem, nip, ndim, ndim]
+    //    "qscalar"  -  integration point scalar          -  [nelem, nip]
+
+    // Constructor: integration point coordinates [nip, ndim] (on a tensor-product grid, in
+    // lexicographic order) and weights [nip] are optional (default: 3 x ... x 3 Gauss points)
+    TensorProductQuadrature() = default;
+
+    TensorProductQuadrature(const xt::xtensor<double, 3>& x);
+
+    TensorProductQuadrature(
+        const xt::xtensor<double, 3>& x,
+        const xt::xtensor<double, 2>& xi,
+        const xt::xtensor<double, 1>& w);
+
+    // Update the nodal positions (shape of "x" should match the earlier definition)
+    void update_x(const xt::xtensor<double, 3>& x);
+
+    // Restrict to a subset of elements, sharing (not copying) the nodal positions,
+    // inverse Jacobians, and integration volumes (see "Quad4::Quadrature::Subset")
+    TensorProductQuadrature Subset(const xt::xtensor<size_t, 1>& elem) const;
+
+    // Return dimensions
+    size_t nelem() const; // number of elements
+    size_t nne() const;   // number of nodes per element
+    size_t ndim() const;  // number of dimension
+    size_t nip() const;   // number of integration points
+
+    // Return shape function gradients [nelem, nip, nne, ndim] (computed)
+    xt::xtensor<double, 4> GradN() const;
+
+    // Return integration volume
+    xt::xtensor<double, 2> dV() const;
+
+    // Elements with a non-positive Jacobian determinant in at least one integration point
+    // (inverted or degenerate elements; their "dV" and "GradN" are meaningless), as detected
+    // while computing the shape function gradients (upon construction, and in "update_x")
+    xt::xtensor<size_t, 1> degenerate() const;
+
+    // Dyadic product (and its transpose and symmetric part)
+    // qtensor(i,j) += dNdx(m,i) * elemvec(m,j)
+    void gradN_vector(const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const;
+    void gradN_vector_T(const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const;
+    void symGradN_vector(const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const;
+
+    // Integral of the scalar product
+    // elemmat(m*ndim+i,n*ndim+i) += N(m) * qscalar * N(n) * dV
+    void int_N_scalar_NT_dV(
+        const xt::xtensor<double, 2>& qscalar, xt::xtensor<double, 3>& elemmat) const;
+
+    // Integral of the dot product
+    // elemvec(m,j) += dNdx(m,i) * qtensor(i,j) * dV
+    void int_gradN_dot_tensor2_dV(
+        const xt::xtensor<double, 4>& qtensor, xt::xtensor<double, 3>& elemvec) const;
+
+    // Functions above, for the elements "elem" only: "elemvec" and "qtensor" are of full size
+    // (all elements), only their rows "elem" are read or (over)written, e.g. to update only the
+    // elements that changed in an event (see "Vector::assembleNode(elem, ..., alpha)")
+    void gradN_vector(
+        const xt::xtensor<size_t, 1>& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 4>& qtensor) const;
+
+    void gradN_vector_T(
+        const xt::xtensor<size_t, 1>& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 4>& qtensor) const;
+
+    void symGradN_vector(
+        const xt::xtensor<size_t, 1>& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 4>& qtensor) const;
+
+    void int_gradN_dot_tensor2_dV(
+        const xt::xtensor<size_t, 1>& elem,
+        const xt::xtensor<double, 4>& qtensor,
+        xt::xtensor<double, 3>& elemvec) const;
+
+    // Integral of the dot product
+    // elemmat(m*ndim+j, n*ndim+k) += dNdx(m,i) * qtensor(i,j,k,l) * dNdx(n,l) * dV
+    void int_gradN_dot_tensor4_dot_gradNT_dV(
+        const xt::xtensor<double, 6>& qtensor, xt::xtensor<double, 3>& elemmat) const;
+
+    // Accumulate variants of the integrals above: "elemvec += alpha * ..." and
+    // "elemmat += alpha * ..." (without zeroing the output), to combine contributions (e.g. mass,
+    // damping, and stiffness, or several material subsets) without intermediate temporaries
+    void int_N_scalar_NT_dV(
+        const xt::xtensor<double, 2>& qscalar,
+        xt::xtensor<double, 3>& elemmat,
+        double alpha) const;
+
+    void int_gradN_dot_tensor2_dV(
+        const xt::xtensor<double, 4>& qtensor,
+        xt::xtensor<double, 3>& elemvec,
+        double alpha) const;
+
+    void int_gradN_dot_tensor2_dV(
+        const xt::xtensor<size_t, 1>& elem,
+        const xt::xtensor<double, 4>& qtensor,
+        xt::xtensor<double, 3>& elemvec,
+        double alpha) const;
+
+    void int_gradN_dot_tensor4_dot_gradNT_dV(
+        const xt::xtensor<double, 6>& qtensor,
+        xt::xtensor<double, 3>& elemmat,
+        double alpha) const;
+
+    // Auto-allocation of the functions above
+    xt::xtensor<double, 4> GradN_vector(const xt::xtensor<double, 3>& elemvec) const;
+    xt::xtensor<double, 4> GradN_vector_T(const xt::xtensor<double, 3>& elemvec) const;
+    xt::xtensor<double, 4> SymGradN_vector(const xt::xtensor<double, 3>& elemvec) const;
+    xt::xtensor<double, 3> Int_N_scalar_NT_dV(const xt::xtensor<double, 2>& qscalar) const;
+    xt::xtensor<double, 3> Int_gradN_dot_tensor2_dV(const xt::xtensor<double, 4>& qtensor) const;
+    xt::xtensor<double, 3> Int_gradN_dot_tensor4_dot_gradNT_dV(const xt::xtensor<double, 6>& qtensor) const;
+
+    // Convert "qscalar" to "qtensor" of certain rank
+    template <size_t rank = 0>
+    xt::xtensor<double, 2 + rank> AsTensor(const xt::xtensor<double, 2>& qscalar) const;
+
+    xt::xarray<double> AsTensor(size_t rank, const xt::xtensor<double, 2>& qscalar) const;
+
+    // Return allocated integration point tensor of a certain rank (zero, or "val", initialised
+    // in parallel: "first-touch")
+    template <size_t rank = 0>
+    xt::xtensor<double, rank + 2> AllocateQtensor() const;
+
+    template <size_t rank = 0>
+    xt::xtensor<double, rank + 2> AllocateQtensor(double val) const;
+
+    xt::xarray<double> AllocateQtensor(size_t rank) const;
+    xt::xarray<double> AllocateQtensor(size_t rank, double val) const;
+
+    xt::xtensor<double, 2> AllocateQscalar() const;
+    xt::xtensor<double, 2> AllocateQscalar(double val) const;
+
+private:
+    // Compute "Jinv" and "vol" based on current "x"
+    void compute_dN();
+
+    // Implementation of the functions above, on the list of elements "elem" (e.g. "xt::arange")
+    template <class E>
+    void gradN_vector_impl(
+        const E& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 4>& qtensor) const;
+
+    template <class E>
+    void gradN_vector_T_impl(
+        const E& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 4>& qtensor) const;
+
+    template <class E>
+    void symGradN_vector_impl(
+        const E& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 4>& qtensor) const;
+
+    template <class E>
+    void int_gradN_dot_tensor2_dV_impl(
+        const E& elem,
+        const xt::xtensor<double, 4>& qtensor,
+        xt::xtensor<double, 3>& elemvec,
+        double alpha,
+        bool accumulate) const;
+
+    // Gradient w.r.t. the local coordinates of a nodal field "u" [nne, ndim] at all integration
+    // points, by sum factorisation: "G" [ndim (derivative), nip, ndim (component)],
+    // "work" a workspace of size "workspace()"
+    void grad_local(const double* u, double* G, double* work) const;
+
+    // Transpose of "grad_local": "f(m,k) += dNdxi(q,m,j) * S(j,q,k)", "S" [ndim, nip, ndim]
+    void int_grad_local(const double* S, double* f, double* work) const;
+
+    // Size of the workspace of "grad_local" and "int_grad_local"
+    size_t workspace() const;
+
+    // Contract one axis of the array "in" (extents "ext", and "ncomp" components per entry,
+    // components fastest) with the matrix "M" [nout, ext[axis]] (row-major)
+    static void contract(
+        const double* M,
+        size_t nout,
+        size_t axis,
+        const std::array<size_t, nd>& ext,
+        const double* in,
+        double* out);
+
+private:
+    // Dimensions (flexible)
+    size_t m_nelem; // number of elements
+    size_t m_nip;   // number of integration points
+    size_t m_nq;    // number of integration points per direction
+
+    // Dimensions (fixed for this element type)
+    static const size_t m_n = 3; // number of nodes per direction
+    static const size_t m_nne = nd == 2 ? 9 : 27; // number of nodes per element
+    static const size_t m_ndim = nd; // number of dimensions
+
+    // Data arrays
+    std::shared_ptr<xt::xtensor<double, 3>> m_x; // nodal positions stored per element [nelem, nne, ndim]
+    xt::xtensor<double, 1> m_w;    // weight of each integration point [nip]
+    xt::xtensor<double, 2> m_xi;   // local coordinate of each integration point [nip, ndim]
+    xt::xtensor<double, 2> m_B;    // 1-d shape functions [nq, n]
+    xt::xtensor<double, 2> m_D;    // 1-d shape function derivatives [nq, n]
+    xt::xtensor<double, 2> m_BT;   // transpose of "m_B" [n, nq]
+    xt::xtensor<double, 2> m_DT;   // transpose of "m_D" [n, nq]
+    xt::xtensor<double, 2> m_N;    // shape functions [nip, nne]
+    xt::xtensor<double, 3> m_dNxi; // shape function grad. wrt local coor. [nip, nne, ndim]
+    std::shared_ptr<xt::xtensor<double, 4>> m_Jinv; // inverse Jacobian [nelem, nip, ndim, ndim]
+    std::shared_ptr<xt::xtensor<double, 2>> m_vol;  // integration point volume [nelem, nip]
+    xt::xtensor<size_t, 1> m_degenerate; // elements with non-positive Jacobian determinant
+
+    // Element-numbers of the subset: row in "m_x", "m_Jinv", "m_vol" [nelem]
+    xt::xtensor<size_t, 1> m_elem;
+    bool m_subset = false;
+};
+
+// 1-d quadratic Lagrange shape functions (nodes at -1, 0, +1) and their derivatives
+inline std::array<double, 3> lagrange2(double xi);
+inline std::array<double, 3> lagrange2_grad(double xi);
+
+// 1-d rules: 3-point Gauss, and Gauss-Lobatto (coinciding with the nodes)
+inline xt::xtensor<double, 1> gauss_xi();
+inline xt::xtensor<double, 1> gauss_w();
+inline xt::xtensor<double, 1> lobatto_xi();
+inline xt::xtensor<double, 1> lobatto_w();
+
+// Tensor-product of a 1-d rule: coordinates [nip, ndim] and weights [nip] (lexicographic)
+inline xt::xtensor<double, 2> tensor_xi(const xt::xtensor<double, 1>& xi, size_t ndim);
+inline xt::xtensor<double, 1> tensor_w(const xt::xtensor<double, 1>& w, size_t ndim);
+
+} // namespace detail
+} // namespace Element
+} // namespace GooseFEM
+
+#include "ElementTensorProduct.hpp"
+
+#endif
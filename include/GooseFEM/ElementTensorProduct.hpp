@@ -0,0 +1,961 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_ELEMENTTENSORPRODUCT_HPP
+#define GOOSEFEM_ELEMENTTENSORPRODUCT_HPP
+
+#include "ElementTensorProduct.h"
+
+namespace GooseFEM {
+namespace Element {
+namespace detail {
+
+inline std::array<double, 3> lagrange2(double xi)
+{
+    return {0.5 * xi * (xi - 1.0), 1.0 - xi * xi, 0.5 * xi * (xi + 1.0)};
+}
+
+inline std::array<double, 3> lagrange2_grad(double xi)
+{
+    return {xi - 0.5, -2.0 * xi, xi + 0.5};
+}
+
+inline xt::xtensor<double, 1> gauss_xi()
+{
+    return {-std::sqrt(0.6), 0.0, +std::sqrt(0.6)};
+}
+
+inline xt::xtensor<double, 1> gauss_w()
+{
+    return {5.0 / 9.0, 8.0 / 9.0, 5.0 / 9.0};
+}
+
+inline xt::xtensor<double, 1> lobatto_xi()
+{
+    return {-1.0, 0.0, +1.0};
+}
+
+inline xt::xtensor<double, 1> lobatto_w()
+{
+    return {1.0 / 3.0, 4.0 / 3.0, 1.0 / 3.0};
+}
+
+inline xt::xtensor<double, 2> tensor_xi(const xt::xtensor<double, 1>& xi, size_t ndim)
+{
+    size_t n = xi.size();
+    size_t nip = static_cast<size_t>(std::pow(n, ndim));
+    xt::xtensor<double, 2> ret = xt::empty<double>({nip, ndim});
+
+    for (size_t q = 0; q < nip; ++q) {
+        size_t idx = q;
+        for (size_t d = 0; d < ndim; ++d) {
+            ret(q, d) = xi(idx % n);
+            idx /= n;
+        }
+    }
+
+    return ret;
+}
+
+inline xt::xtensor<double, 1> tensor_w(const xt::xtensor<double, 1>& w, size_t ndim)
+{
+    size_t n = w.size();
+    size_t nip = static_cast<size_t>(std::pow(n, ndim));
+    xt::xtensor<double, 1> ret = xt::ones<double>({nip});
+
+    for (size_t q = 0; q < nip; ++q) {
+        size_t idx = q;
+        for (size_t d = 0; d < ndim; ++d) {
+            ret(q) *= w(idx % n);
+            idx /= n;
+        }
+    }
+
+    return ret;
+}
+
+template <size_t nd>
+inline TensorProductQuadrature<nd>::TensorProductQuadrature(const xt::xtensor<double, 3>& x)
+    : TensorProductQuadrature(x, tensor_xi(gauss_xi(), nd), tensor_w(gauss_w(), nd))
+{
+}
+
+template <size_t nd>
+inline TensorProductQuadrature<nd>::TensorProductQuadrature(
+    const xt::xtensor<double, 3>& x,
+    const xt::xtensor<double, 2>& xi,
+    const xt::xtensor<double, 1>& w)
+    : m_x(std::make_shared<xt::xtensor<double, 3>>(GooseFEM::FirstTouchCopy(x))),
+      m_w(w),
+      m_xi(xi)
+{
+    GOOSEFEM_ASSERT(x.shape(1) == m_nne);
+    GOOSEFEM_ASSERT(x.shape(2) == m_ndim);
+
+    m_nelem = x.shape(0);
+    m_elem = xt::arange<size_t>(m_nelem);
+    m_nip = m_w.size();
+    m_nq = static_cast<size_t>(std::round(std::pow(m_nip, 1.0 / static_cast<double>(m_ndim))));
+
+    GOOSEFEM_ASSERT(m_xi.shape(0) == m_nip);
+    GOOSEFEM_ASSERT(m_xi.shape(1) == m_ndim);
+    GOOSEFEM_CHECK(static_cast<size_t>(std::pow(m_nq, m_ndim)) == m_nip);
+
+    // 1-d rule: the first "nq" points (the integration points have to form a tensor-product grid)
+
+    m_B = xt::empty<double>({m_nq, m_n});
+    m_D = xt::empty<double>({m_nq, m_n});
+
+    for (size_t q = 0; q < m_nip; ++q) {
+        size_t idx = q;
+        for (size_t d = 0; d < m_ndim; ++d) {
+            GOOSEFEM_CHECK(std::abs(m_xi(q, d) - m_xi(idx % m_nq, 0)) < 1e-12);
+            idx /= m_nq;
+        }
+    }
+
+    for (size_t k = 0; k < m_nq; ++k) {
+        auto B = lagrange2(m_xi(k, 0));
+        auto D = lagrange2_grad(m_xi(k, 0));
+        for (size_t a = 0; a < m_n; ++a) {
+            m_B(k, a) = B[a];
+            m_D(k, a) = D[a];
+        }
+    }
+
+    m_BT = xt::transpose(m_B);
+    m_DT = xt::transpose(m_D);
+
+    // full shape functions and local gradients (used for assembly of matrices)
+
+    m_N = xt::empty<double>({m_nip, m_nne});
+    m_dNxi = xt::empty<double>({m_nip, m_nne, m_ndim});
+
+    for (size_t q = 0; q < m_nip; ++q) {
+        for (size_t m = 0; m < m_nne; ++m) {
+
+            m_N(q, m) = 1.0;
+
+            for (size_t j = 0; j < m_ndim; ++j) {
+                m_dNxi(q, m, j) = 1.0;
+            }
+
+            size_t iq = q;
+            size_t im = m;
+
+            for (size_t d = 0; d < m_ndim; ++d) {
+                size_t k = iq % m_nq;
+                size_t a = im % m_n;
+                m_N(q, m) *= m_B(k, a);
+                for (size_t j = 0; j < m_ndim; ++j) {
+                    m_dNxi(q, m, j) *= j == d ? m_D(k, a) : m_B(k, a);
+                }
+                iq /= m_nq;
+                im /= m_n;
+            }
+        }
+    }
+
+    // not initialised: first written (in parallel, "first-touch") by "compute_dN"
+    m_Jinv = std::make_shared<xt::xtensor<double, 4>>(
+        xt::empty<double>({m_nelem, m_nip, m_ndim, m_ndim}));
+    m_vol = std::make_shared<xt::xtensor<double, 2>>(xt::empty<double>({m_nelem, m_nip}));
+
+    compute_dN();
+}
+
+template <size_t nd>
+inline size_t TensorProductQuadrature<nd>::nelem() const
+{
+    return m_nelem;
+}
+
+template <size_t nd>
+inline size_t TensorProductQuadrature<nd>::nne() const
+{
+    return m_nne;
+}
+
+template <size_t nd>
+inline size_t TensorProductQuadrature<nd>::ndim() const
+{
+    return m_ndim;
+}
+
+template <size_t nd>
+inline size_t TensorProductQuadrature<nd>::nip() const
+{
+    return m_nip;
+}
+
+template <size_t nd>
+inline xt::xtensor<double, 4> TensorProductQuadrature<nd>::GradN() const
+{
+    const auto& Jinv = *m_Jinv;
+    xt::xtensor<double, 4> ret = xt::zeros<double>({m_nelem, m_nip, m_nne, m_ndim});
+
+    for (size_t e = 0; e < m_nelem; ++e) {
+        for (size_t q = 0; q < m_nip; ++q) {
+            for (size_t m = 0; m < m_nne; ++m) {
+                for (size_t i = 0; i < m_ndim; ++i) {
+                    for (size_t j = 0; j < m_ndim; ++j) {
+                        ret(e, q, m, i) += Jinv(m_elem(e), q, i, j) * m_dNxi(q, m, j);
+                    }
+                }
+            }
+        }
+    }
+
+    return ret;
+}
+
+template <size_t nd>
+inline xt::xtensor<double, 2> TensorProductQuadrature<nd>::dV() const
+{
+    if (m_subset) {
+        return xt::view(*m_vol, xt::keep(m_elem));
+    }
+
+    return *m_vol;
+}
+
+template <size_t nd>
+inline xt::xtensor<size_t, 1> TensorProductQuadrature<nd>::degenerate() const
+{
+    if (m_subset) {
+        return positions(m_elem, m_degenerate);
+    }
+
+    return m_degenerate;
+}
+
+template <size_t nd>
+inline void TensorProductQuadrature<nd>::update_x(const xt::xtensor<double, 3>& x)
+{
+    GOOSEFEM_ASSERT(!m_subset);
+    GOOSEFEM_ASSERT(x.shape() == m_x->shape());
+
+    // data shared with copies or subsets is not overwritten
+    if (m_x.use_count() > 1) {
+        m_x = std::make_shared<xt::xtensor<double, 3>>(GooseFEM::FirstTouchCopy(x));
+    }
+    else {
+        xt::noalias(*m_x) = x;
+    }
+
+    if (m_Jinv.use_count() > 1) {
+        m_Jinv = std::make_shared<xt::xtensor<double, 4>>(
+            xt::empty<double>({m_nelem, m_nip, m_ndim, m_ndim}));
+    }
+
+    if (m_vol.use_count() > 1) {
+        m_vol = std::make_shared<xt::xtensor<double, 2>>(xt::empty<double>({m_nelem, m_nip}));
+    }
+
+    compute_dN();
+}
+
+template <size_t nd>
+inline TensorProductQuadrature<nd>
+TensorProductQuadrature<nd>::Subset(const xt::xtensor<size_t, 1>& elem) const
+{
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+
+    TensorProductQuadrature ret = *this;
+    ret.m_elem = xt::view(m_elem, xt::keep(elem));
+    ret.m_nelem = elem.size();
+    ret.m_subset = true;
+    return ret;
+}
+
+template <size_t nd>
+inline size_t TensorProductQuadrature<nd>::workspace() const
+{
+    size_t n = std::max(m_n, m_nq);
+    return 2 * static_cast<size_t>(std::pow(n, m_ndim)) * m_ndim;
+}
+
+template <size_t nd>
+inline void TensorProductQuadrature<nd>::contract(
+    const double* M,
+    size_t nout,
+    size_t axis,
+    const std::array<size_t, nd>& ext,
+    const double* in,
+    double* out)
+{
+    size_t nin = ext[axis];
+    size_t inner = m_ndim;
+    size_t outer = 1;
+
+    for (size_t d = 0; d < axis; ++d) {
+        inner *= ext[d];
+    }
+
+    for (size_t d = axis + 1; d < m_ndim; ++d) {
+        outer *= ext[d];
+    }
+
+    for (size_t o = 0; o < outer; ++o) {
+        for (size_t p = 0; p < nout; ++p) {
+
+            double* y = out + (o * nout + p) * inner;
+
+            for (size_t i = 0; i < inner; ++i) {
+                y[i] = 0.0;
+            }
+
+            for (size_t a = 0; a < nin; ++a) {
+                double c = M[p * nin + a];
+                const double* x = in + (o * nin + a) * inner;
+                for (size_t i = 0; i < inner; ++i) {
+                    y[i] += c * x[i];
+                }
+            }
+        }
+    }
+}
+
+template <size_t nd>
+inline void
+TensorProductQuadrature<nd>::grad_local(const double* u, double* G, double* work) const
+{
+    double* A = work;
+    double* B = work + workspace() / 2;
+
+    // derivative "j": contract direction "j" with the derivatives, all others with the values
+    for (size_t j = 0; j < m_ndim; ++j) {
+
+        std::array<size_t, nd> ext;
+        ext.fill(m_n);
+        const double* cur = u;
+
+        for (size_t d = 0; d < m_ndim; ++d) {
+            double* out = d + 1 == m_ndim ? G + j * m_nip * m_ndim : (d % 2 == 0 ? A : B);
+            const double* M = j == d ? m_D.data() : m_B.data();
+            contract(M, m_nq, d, ext, cur, out);
+            ext[d] = m_nq;
+            cur = out;
+        }
+    }
+}
+
+template <size_t nd>
+inline void
+TensorProductQuadrature<nd>::int_grad_local(const double* S, double* f, double* work) const
+{
+    double* A = work;
+    double* B = work + workspace() / 2;
+
+    for (size_t j = 0; j < m_ndim; ++j) {
+
+        std::array<size_t, nd> ext;
+        ext.fill(m_nq);
+        const double* cur = S + j * m_nip * m_ndim;
+
+        for (size_t d = 0; d < m_ndim; ++d) {
+            double* out = d % 2 == 0 ? A : B;
+            const double* M = j == d ? m_DT.data() : m_BT.data();
+            contract(M, m_n, d, ext, cur, out);
+            ext[d] = m_n;
+            cur = out;
+        }
+
+        for (size_t i = 0; i < m_nne * m_ndim; ++i) {
+            f[i] += cur[i];
+        }
+    }
+}
+
+template <size_t nd>
+inline void TensorProductQuadrature<nd>::compute_dN()
+{
+    auto& x_all = *m_x;
+    auto& Jinv_all = *m_Jinv;
+    auto& dVol = *m_vol;
+
+    std::vector<char> isdegenerate(m_nelem, 0);
+
+    // batches of whole elements of which the Jacobians are inverted at once,
+    // writing the inverse to "m_Jinv" and the determinant to "m_vol" directly
+    size_t nblk = std::max(size_t(1), nip_batch / m_nip);
+    size_t nbatch = (m_nelem + nblk - 1) / nblk;
+
+    #pragma omp parallel
+    {
+        std::vector<double> work(workspace());
+        std::vector<double> G(m_ndim * m_nip * m_ndim);
+        std::vector<double> J(nblk * m_nip * m_ndim * m_ndim);
+
+        #pragma omp for schedule(static)
+        for (size_t b = 0; b < nbatch; ++b) {
+
+            size_t e0 = b * nblk;
+            size_t ne = std::min(m_nelem, e0 + nblk) - e0;
+
+            for (size_t e = e0; e < e0 + ne; ++e) {
+
+                // J(i,j) = dNxi(m,i) * x(m,j)
+                this->grad_local(&x_all(e, 0, 0), G.data(), work.data());
+
+                double* Je = &J[(e - e0) * m_nip * m_ndim * m_ndim];
+
+                for (size_t q = 0; q < m_nip; ++q) {
+                    for (size_t i = 0; i < m_ndim; ++i) {
+                        for (size_t j = 0; j < m_ndim; ++j) {
+                            Je[(q * m_ndim + i) * m_ndim + j] = G[(i * m_nip + q) * m_ndim + j];
+                        }
+                    }
+                }
+            }
+
+            // inverse and determinant, of all integration points of the batch at once
+            size_t n = ne * m_nip;
+            double* Jinv = &Jinv_all(e0, 0, 0, 0);
+            double* Jdet = &dVol(e0, 0);
+
+            if (inv_jacobian<m_ndim>(n, J.data(), Jinv, Jdet) > 0) {
+                flag_degenerate(e0 * m_nip, n, m_nip, Jdet, isdegenerate);
+            }
+
+            for (size_t e = e0; e < e0 + ne; ++e) {
+                for (size_t q = 0; q < m_nip; ++q) {
+                    dVol(e, q) *= m_w(q);
+                }
+            }
+        }
+    }
+
+    m_degenerate = flagged(isdegenerate);
+}
+
+template <size_t nd>
+inline void TensorProductQuadrature<nd>::gradN_vector(
+    const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    this->gradN_vector_impl(xt::arange<size_t>(m_nelem), elemvec, qtensor);
+}
+
+template <size_t nd>
+inline void TensorProductQuadrature<nd>::gradN_vector(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 3>& elemvec,
+    xt::xtensor<double, 4>& qtensor) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+    this->gradN_vector_impl(elem, elemvec, qtensor);
+}
+
+template <size_t nd>
+template <class E>
+inline void TensorProductQuadrature<nd>::gradN_vector_impl(
+    const E& elem, const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const
+{
+    const auto& Jinv = *m_Jinv;
+
+    #pragma omp parallel
+    {
+        std::vector<double> work(workspace());
+        std::vector<double> G(m_ndim * m_nip * m_ndim);
+
+        #pragma omp for schedule(static)
+        for (size_t ie = 0; ie < elem.size(); ++ie) {
+
+            size_t e = elem(ie);
+            size_t row = m_subset ? m_elem(e) : e;
+
+            this->grad_local(&elemvec(e, 0, 0), G.data(), work.data());
+
+            for (size_t q = 0; q < m_nip; ++q) {
+                // gradu(i,k) = Jinv(i,j) * dNxi(m,j) * u(m,k)
+                for (size_t i = 0; i < m_ndim; ++i) {
+                    for (size_t k = 0; k < m_ndim; ++k) {
+                        double g = 0.0;
+                        for (size_t j = 0; j < m_ndim; ++j) {
+                            g += Jinv(row, q, i, j) * G[(j * m_nip + q) * m_ndim + k];
+                        }
+                        qtensor(e, q, i, k) = g;
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <size_t nd>
+inline void TensorProductQuadrature<nd>::gradN_vector_T(
+    const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    this->gradN_vector_T_impl(xt::arange<size_t>(m_nelem), elemvec, qtensor);
+}
+
+template <size_t nd>
+inline void TensorProductQuadrature<nd>::gradN_vector_T(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 3>& elemvec,
+    xt::xtensor<double, 4>& qtensor) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+    this->gradN_vector_T_impl(elem, elemvec, qtensor);
+}
+
+template <size_t nd>
+template <class E>
+inline void TensorProductQuadrature<nd>::gradN_vector_T_impl(
+    const E& elem, const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const
+{
+    const auto& Jinv = *m_Jinv;
+
+    #pragma omp parallel
+    {
+        std::vector<double> work(workspace());
+        std::vector<double> G(m_ndim * m_nip * m_ndim);
+
+        #pragma omp for schedule(static)
+        for (size_t ie = 0; ie < elem.size(); ++ie) {
+
+            size_t e = elem(ie);
+            size_t row = m_subset ? m_elem(e) : e;
+
+            this->grad_local(&elemvec(e, 0, 0), G.data(), work.data());
+
+            for (size_t q = 0; q < m_nip; ++q) {
+                // gradu(k,i) = Jinv(i,j) * dNxi(m,j) * u(m,k)
+                for (size_t i = 0; i < m_ndim; ++i) {
+                    for (size_t k = 0; k < m_ndim; ++k) {
+                        double g = 0.0;
+                        for (size_t j = 0; j < m_ndim; ++j) {
+                            g += Jinv(row, q, i, j) * G[(j * m_nip + q) * m_ndim + k];
+                        }
+                        qtensor(e, q, k, i) = g;
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <size_t nd>
+inline void TensorProductQuadrature<nd>::symGradN_vector(
+    const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    this->symGradN_vector_impl(xt::arange<size_t>(m_nelem), elemvec, qtensor);
+}
+
+template <size_t nd>
+inline void TensorProductQuadrature<nd>::symGradN_vector(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 3>& elemvec,
+    xt::xtensor<double, 4>& qtensor) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+    this->symGradN_vector_impl(elem, elemvec, qtensor);
+}
+
+template <size_t nd>
+template <class E>
+inline void TensorProductQuadrature<nd>::symGradN_vector_impl(
+    const E& elem, const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const
+{
+    const auto& Jinv = *m_Jinv;
+
+    #pragma omp parallel
+    {
+        std::vector<double> work(workspace());
+        std::vector<double> G(m_ndim * m_nip * m_ndim);
+        std::array<double, 9> gradu;
+
+        #pragma omp for schedule(static)
+        for (size_t ie = 0; ie < elem.size(); ++ie) {
+
+            size_t e = elem(ie);
+            size_t row = m_subset ? m_elem(e) : e;
+
+            this->grad_local(&elemvec(e, 0, 0), G.data(), work.data());
+
+            for (size_t q = 0; q < m_nip; ++q) {
+                // gradu(i,k) = Jinv(i,j) * dNxi(m,j) * u(m,k)
+                for (size_t i = 0; i < m_ndim; ++i) {
+                    for (size_t k = 0; k < m_ndim; ++k) {
+                        double g = 0.0;
+                        for (size_t j = 0; j < m_ndim; ++j) {
+                            g += Jinv(row, q, i, j) * G[(j * m_nip + q) * m_ndim + k];
+                        }
+                        gradu[i * 3 + k] = g;
+                    }
+                }
+                // eps(i,k) = 0.5 * (gradu(i,k) + gradu(k,i))
+                for (size_t i = 0; i < m_ndim; ++i) {
+                    for (size_t k = 0; k < m_ndim; ++k) {
+                        qtensor(e, q, i, k) = 0.5 * (gradu[i * 3 + k] + gradu[k * 3 + i]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <size_t nd>
+inline void TensorProductQuadrature<nd>::int_N_scalar_NT_dV(
+    const xt::xtensor<double, 2>& qscalar, xt::xtensor<double, 3>& elemmat) const
+{
+    GooseFEM::firstTouch(elemmat, 0.0);
+    this->int_N_scalar_NT_dV(qscalar, elemmat, 1.0);
+}
+
+template <size_t nd>
+inline void TensorProductQuadrature<nd>::int_N_scalar_NT_dV(
+    const xt::xtensor<double, 2>& qscalar,
+    xt::xtensor<double, 3>& elemmat,
+    double alpha) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(qscalar, {m_nelem, m_nip}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemmat, {m_nelem, m_nne * m_ndim, m_nne * m_ndim}));
+
+    const auto& dVol = *m_vol;
+
+    #pragma omp parallel for schedule(static)
+    for (size_t e = 0; e < m_nelem; ++e) {
+
+        size_t row = m_subset ? m_elem(e) : e;
+
+        auto M = xt::adapt(&elemmat(e, 0, 0), xt::xshape<m_nne * m_ndim, m_nne * m_ndim>());
+
+        for (size_t q = 0; q < m_nip; ++q) {
+
+            auto N = xt::adapt(&m_N(q, 0), xt::xshape<m_nne>());
+            double s = alpha * qscalar(e, q) * dVol(row, q);
+
+            // M(m*ndim+i,n*ndim+i) += N(m) * scalar * N(n) * dV
+            for (size_t m = 0; m < m_nne; ++m) {
+                for (size_t n = 0; n < m_nne; ++n) {
+                    for (size_t i = 0; i < m_ndim; ++i) {
+                        M(m * m_ndim + i, n * m_ndim + i) += N(m) * s * N(n);
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <size_t nd>
+inline void TensorProductQuadrature<nd>::int_gradN_dot_tensor2_dV(
+    const xt::xtensor<double, 4>& qtensor, xt::xtensor<double, 3>& elemvec) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    this->int_gradN_dot_tensor2_dV_impl(xt::arange<size_t>(m_nelem), qtensor, elemvec, 1.0, false);
+}
+
+template <size_t nd>
+inline void TensorProductQuadrature<nd>::int_gradN_dot_tensor2_dV(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 4>& qtensor,
+    xt::xtensor<double, 3>& elemvec) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+    this->int_gradN_dot_tensor2_dV_impl(elem, qtensor, elemvec, 1.0, false);
+}
+
+template <size_t nd>
+inline void TensorProductQuadrature<nd>::int_gradN_dot_tensor2_dV(
+    const xt::xtensor<double, 4>& qtensor,
+    xt::xtensor<double, 3>& elemvec,
+    double alpha) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    this->int_gradN_dot_tensor2_dV_impl(xt::arange<size_t>(m_nelem), qtensor, elemvec, alpha, true);
+}
+
+template <size_t nd>
+inline void TensorProductQuadrature<nd>::int_gradN_dot_tensor2_dV(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 4>& qtensor,
+    xt::xtensor<double, 3>& elemvec,
+    double alpha) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+    this->int_gradN_dot_tensor2_dV_impl(elem, qtensor, elemvec, alpha, true);
+}
+
+template <size_t nd>
+template <class E>
+inline void TensorProductQuadrature<nd>::int_gradN_dot_tensor2_dV_impl(
+    const E& elem,
+    const xt::xtensor<double, 4>& qtensor,
+    xt::xtensor<double, 3>& elemvec,
+    double alpha,
+    bool accumulate) const
+{
+    const auto& Jinv = *m_Jinv;
+    const auto& dVol = *m_vol;
+
+    #pragma omp parallel
+    {
+        std::vector<double> work(workspace());
+        std::vector<double> S(m_ndim * m_nip * m_ndim);
+
+        #pragma omp for schedule(static)
+        for (size_t ie = 0; ie < elem.size(); ++ie) {
+
+            size_t e = elem(ie);
+            size_t row = m_subset ? m_elem(e) : e;
+
+            // S(j,q,k) = Jinv(i,j) * qtensor(q,i,k) * dV(q)
+            for (size_t q = 0; q < m_nip; ++q) {
+                double vol = alpha * dVol(row, q);
+                for (size_t j = 0; j < m_ndim; ++j) {
+                    for (size_t k = 0; k < m_ndim; ++k) {
+                        double s = 0.0;
+                        for (size_t i = 0; i < m_ndim; ++i) {
+                            s += Jinv(row, q, i, j) * qtensor(e, q, i, k);
+                        }
+                        S[(j * m_nip + q) * m_ndim + k] = s * vol;
+                    }
+                }
+            }
+
+            // f(m,k) = dNxi(q,m,j) * S(j,q,k)
+            double* f = &elemvec(e, 0, 0);
+
+            if (!accumulate) {
+                std::fill_n(f, m_nne * m_ndim, 0.0);
+            }
+
+            this->int_grad_local(S.data(), f, work.data());
+        }
+    }
+}
+
+template <size_t nd>
+inline void TensorProductQuadrature<nd>::int_gradN_dot_tensor4_dot_gradNT_dV(
+    const xt::xtensor<double, 6>& qtensor, xt::xtensor<double, 3>& elemmat) const
+{
+    GooseFEM::firstTouch(elemmat, 0.0);
+    this->int_gradN_dot_tensor4_dot_gradNT_dV(qtensor, elemmat, 1.0);
+}
+
+template <size_t nd>
+inline void TensorProductQuadrature<nd>::int_gradN_dot_tensor4_dot_gradNT_dV(
+    const xt::xtensor<double, 6>& qtensor,
+    xt::xtensor<double, 3>& elemmat,
+    double alpha) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim, m_ndim, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemmat, {m_nelem, m_nne * m_ndim, m_nne * m_ndim}));
+
+    const auto& Jinv = *m_Jinv;
+    const auto& dVol = *m_vol;
+
+    #pragma omp parallel
+    {
+        // shape function gradients [nne, ndim], and "CN(i,j,k,n) = C(i,j,k,l) * dNx(n,l) * dV"
+        std::array<double, m_nne * m_ndim> dNx;
+        std::array<double, m_ndim * m_ndim * m_ndim * m_nne> CN;
+
+        #pragma omp for schedule(static)
+        for (size_t e = 0; e < m_nelem; ++e) {
+
+            size_t row = m_subset ? m_elem(e) : e;
+
+            auto K = xt::adapt(&elemmat(e, 0, 0), xt::xshape<m_nne * m_ndim, m_nne * m_ndim>());
+
+            for (size_t q = 0; q < m_nip; ++q) {
+
+                auto C = xt::adapt(
+                    &qtensor(e, q, 0, 0, 0, 0), xt::xshape<m_ndim, m_ndim, m_ndim, m_ndim>());
+                double vol = alpha * dVol(row, q);
+
+                // dNx(m,i) = Jinv(i,j) * dNxi(m,j)
+                for (size_t m = 0; m < m_nne; ++m) {
+                    for (size_t i = 0; i < m_ndim; ++i) {
+                        double g = 0.0;
+                        for (size_t j = 0; j < m_ndim; ++j) {
+                            g += Jinv(row, q, i, j) * m_dNxi(q, m, j);
+                        }
+                        dNx[m * m_ndim + i] = g;
+                    }
+                }
+
+                for (size_t i = 0; i < m_ndim; ++i) {
+                    for (size_t j = 0; j < m_ndim; ++j) {
+                        for (size_t k = 0; k < m_ndim; ++k) {
+                            for (size_t n = 0; n < m_nne; ++n) {
+                                double c = 0.0;
+                                for (size_t l = 0; l < m_ndim; ++l) {
+                                    c += C(i, j, k, l) * dNx[n * m_ndim + l];
+                                }
+                                CN[((i * m_ndim + j) * m_ndim + k) * m_nne + n] = c * vol;
+                            }
+                        }
+                    }
+                }
+
+                // K(m*ndim+j, n*ndim+k) += dNx(m,i) * CN(i,j,k,n)
+                for (size_t m = 0; m < m_nne; ++m) {
+                    for (size_t j = 0; j < m_ndim; ++j) {
+                        for (size_t n = 0; n < m_nne; ++n) {
+                            for (size_t k = 0; k < m_ndim; ++k) {
+                                double c = 0.0;
+                                for (size_t i = 0; i < m_ndim; ++i) {
+                                    c += dNx[m * m_ndim + i] *
+                                         CN[((i * m_ndim + j) * m_ndim + k) * m_nne + n];
+                                }
+                                K(m * m_ndim + j, n * m_ndim + k) += c;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <size_t nd>
+template <size_t rank>
+inline xt::xtensor<double, 2 + rank>
+TensorProductQuadrature<nd>::AsTensor(const xt::xtensor<double, 2>& qscalar) const
+{
+    return GooseFEM::AsTensor<2, rank>(qscalar, m_ndim);
+}
+
+template <size_t nd>
+inline xt::xarray<double>
+TensorProductQuadrature<nd>::AsTensor(size_t rank, const xt::xtensor<double, 2>& qscalar) const
+{
+    return GooseFEM::AsTensor(rank, qscalar, m_ndim);
+}
+
+template <size_t nd>
+inline xt::xtensor<double, 4>
+TensorProductQuadrature<nd>::GradN_vector(const xt::xtensor<double, 3>& elemvec) const
+{
+    xt::xtensor<double, 4> qtensor = xt::empty<double>({m_nelem, m_nip, m_ndim, m_ndim});
+    this->gradN_vector(elemvec, qtensor);
+    return qtensor;
+}
+
+template <size_t nd>
+inline xt::xtensor<double, 4>
+TensorProductQuadrature<nd>::GradN_vector_T(const xt::xtensor<double, 3>& elemvec) const
+{
+    xt::xtensor<double, 4> qtensor = xt::empty<double>({m_nelem, m_nip, m_ndim, m_ndim});
+    this->gradN_vector_T(elemvec, qtensor);
+    return qtensor;
+}
+
+template <size_t nd>
+inline xt::xtensor<double, 4>
+TensorProductQuadrature<nd>::SymGradN_vector(const xt::xtensor<double, 3>& elemvec) const
+{
+    xt::xtensor<double, 4> qtensor = xt::empty<double>({m_nelem, m_nip, m_ndim, m_ndim});
+    this->symGradN_vector(elemvec, qtensor);
+    return qtensor;
+}
+
+template <size_t nd>
+inline xt::xtensor<double, 3>
+TensorProductQuadrature<nd>::Int_N_scalar_NT_dV(const xt::xtensor<double, 2>& qscalar) const
+{
+    xt::xtensor<double, 3> elemmat = xt::empty<double>({m_nelem, m_nne * m_ndim, m_nne * m_ndim});
+    this->int_N_scalar_NT_dV(qscalar, elemmat);
+    return elemmat;
+}
+
+template <size_t nd>
+inline xt::xtensor<double, 3>
+TensorProductQuadrature<nd>::Int_gradN_dot_tensor2_dV(const xt::xtensor<double, 4>& qtensor) const
+{
+    xt::xtensor<double, 3> elemvec = xt::empty<double>({m_nelem, m_nne, m_ndim});
+    this->int_gradN_dot_tensor2_dV(qtensor, elemvec);
+    return elemvec;
+}
+
+template <size_t nd>
+inline xt::xtensor<double, 3> TensorProductQuadrature<nd>::Int_gradN_dot_tensor4_dot_gradNT_dV(
+    const xt::xtensor<double, 6>& qtensor) const
+{
+    xt::xtensor<double, 3> elemmat = xt::empty<double>({m_nelem, m_ndim * m_nne, m_ndim * m_nne});
+    this->int_gradN_dot_tensor4_dot_gradNT_dV(qtensor, elemmat);
+    return elemmat;
+}
+
+template <size_t nd>
+template <size_t rank>
+inline xt::xtensor<double, rank + 2> TensorProductQuadrature<nd>::AllocateQtensor() const
+{
+    return this->AllocateQtensor<rank>(0.0);
+}
+
+template <size_t nd>
+template <size_t rank>
+inline xt::xtensor<double, rank + 2>
+TensorProductQuadrature<nd>::AllocateQtensor(double val) const
+{
+    std::array<size_t, rank + 2> shape;
+    shape[0] = m_nelem;
+    shape[1] = m_nip;
+    size_t n = m_ndim;
+    std::fill(shape.begin() + 2, shape.end(), n);
+    xt::xtensor<double, rank + 2> ret = xt::empty<double>(shape);
+    GooseFEM::firstTouch(ret, val);
+    return ret;
+}
+
+template <size_t nd>
+inline xt::xarray<double> TensorProductQuadrature<nd>::AllocateQtensor(size_t rank) const
+{
+    return this->AllocateQtensor(rank, 0.0);
+}
+
+template <size_t nd>
+inline xt::xarray<double>
+TensorProductQuadrature<nd>::AllocateQtensor(size_t rank, double val) const
+{
+    std::vector<size_t> shape(rank + 2);
+    shape[0] = m_nelem;
+    shape[1] = m_nip;
+    size_t n = m_ndim;
+    std::fill(shape.begin() + 2, shape.end(), n);
+    xt::xarray<double> ret = xt::empty<double>(shape);
+    GooseFEM::firstTouch(ret, val);
+    return ret;
+}
+
+template <size_t nd>
+inline xt::xtensor<double, 2> TensorProductQuadrature<nd>::AllocateQscalar() const
+{
+    return this->AllocateQtensor<0>();
+}
+
+template <size_t nd>
+inline xt::xtensor<double, 2> TensorProductQuadrature<nd>::AllocateQscalar(double val) const
+{
+    return this->AllocateQtensor<0>(val);
+}
+
+} // namespace detail
+} // namespace Element
+} // namespace GooseFEM
+
+#endif
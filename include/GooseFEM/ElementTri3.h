@@ -0,0 +1,255 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_ELEMENTTRI3_H
+#define GOOSEFEM_ELEMENTTRI3_H
+
+#include "config.h"
+
+namespace GooseFEM {
+namespace Element {
+namespace Tri3 {
+
+// Local coordinates of the reference triangle: (0, 0), (1, 0), (0, 1)
+
+namespace Gauss {
+inline size_t nip();                // number of integration points
+inline xt::xtensor<double, 2> xi(); // integration point coordinates (local coordinates)
+inline xt::xtensor<double, 1> w();  // integration point weights
+} // namespace Gauss
+
+namespace Nodal {
+inline size_t nip();                // number of integration points
+inline xt::xtensor<double, 2> xi(); // integration point coordinates (local coordinates)
+inline xt::xtensor<double, 1> w();  // integration point weights
+} // namespace Nodal
+
+class Quadrature {
+public:
+    // Fixed dimensions:
+    //    ndim = 2   -  number of dimensions
+    //    nne  = 3   -  number of nodes per element
+    //
+    // Naming convention:
+    //    "elemmat"  -  matrices stored per element       -  [nelem, nne*ndim, nne*ndim]
+    //    "elemvec"  -  nodal vectors stored per element  -  [nelem, nne, ndim]
+    //    "qtensor"  -  integration point tensor          -  [nelem, nip, ndim, ndim]
+    //    "qscalar"  -  integration point scalar          -  [nelem, nip]
+    //
+    // The shape function gradients are constant in the element ("constant strain triangle"):
+    // they are stored once per element, and each kernel evaluates them only once per element.
+
+    // Constructor: integration point coordinates and weights are optional (default: Gauss)
+    Quadrature() = default;
+
+    Quadrature(const xt::xtensor<double, 3>& x);
+
+    Quadrature(
+        const xt::xtensor<double, 3>& x,
+        const xt::xtensor<double, 2>& xi,
+        const xt::xtensor<double, 1>& w);
+
+    // Update the nodal positions (shape of "x" should match the earlier definition)
+    void update_x(const xt::xtensor<double, 3>& x);
+
+    // Restrict to a subset of elements, sharing (not copying) the nodal positions,
+    // shape function gradients, and integration volumes.
+    // All "elemvec", "elemmat", "qtensor", and "qscalar" of the subset are of size "elem.size()".
+    // Note: "update_x" can only be called on the full object, subsets have to be recreated after.
+    Quadrature Subset(const xt::xtensor<size_t, 1>& elem) const;
+
+    // Return dimensions
+    size_t nelem() const; // number of elements
+    size_t nne() const;   // number of nodes per element
+    size_t ndim() const;  // number of dimension
+    size_t nip() const;   // number of integration points
+
+    // Return shape function gradients [nelem, nip, nne, ndim] (equal for all integration points)
+    xt::xtensor<double, 4> GradN() const;
+
+    // Convert "qscalar" to "qtensor" of certain rank
+    template <size_t rank = 0>
+    void asTensor(const xt::xtensor<double, 2>& qscalar, xt::xtensor<double, 2 + rank>& qtensor) const;
+
+    // Return integration volume
+    xt::xtensor<double, 2> dV() const;
+
+    // Elements with a non-positive Jacobian determinant in at least one integration point
+    // (inverted or degenerate elements; their "dV" and "GradN" are meaningless), as detected
+    // while computing the shape function gradients (upon construction, and in "update_x")
+    xt::xtensor<size_t, 1> degenerate() const;
+
+    // Dyadic product (and its transpose and symmetric part)
+    // qtensor(i,j) += dNdx(m,i) * elemvec(m,j)
+    void gradN_vector(const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const;
+    void gradN_vector_T(const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const;
+    void symGradN_vector(const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const;
+
+    // Integral of the scalar product
+    // elemmat(m*ndim+i,n*ndim+i) += N(m) * qscalar * N(n) * dV
+    void int_N_scalar_NT_dV(
+        const xt::xtensor<double, 2>& qscalar, xt::xtensor<double, 3>& elemmat) const;
+
+    // Integral of the dot product
+    // elemvec(m,j) += dNdx(m,i) * qtensor(i,j) * dV
+    void int_gradN_dot_tensor2_dV(
+        const xt::xtensor<double, 4>& qtensor, xt::xtensor<double, 3>& elemvec) const;
+
+    // Functions above, for the elements "elem" only: "elemvec" and "qtensor" are of full size
+    // (all elements), only their rows "elem" are read or (over)written, e.g. to update only the
+    // elements that changed in an event (see "Vector::assembleNode(elem, ..., alpha)")
+    void gradN_vector(
+        const xt::xtensor<size_t, 1>& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 4>& qtensor) const;
+
+    void gradN_vector_T(
+        const xt::xtensor<size_t, 1>& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 4>& qtensor) const;
+
+    void symGradN_vector(
+        const xt::xtensor<size_t, 1>& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 4>& qtensor) const;
+
+    void int_gradN_dot_tensor2_dV(
+        const xt::xtensor<size_t, 1>& elem,
+        const xt::xtensor<double, 4>& qtensor,
+        xt::xtensor<double, 3>& elemvec) const;
+
+    // Integral of the dot product
+    // elemmat(m*2+j, n*2+k) += dNdx(m,i) * qtensor(i,j,k,l) * dNdx(n,l) * dV
+    void int_gradN_dot_tensor4_dot_gradNT_dV(
+        const xt::xtensor<double, 6>& qtensor, xt::xtensor<double, 3>& elemmat) const;
+
+    // Integral of the dot product, with the tangent in Mandel representation
+    // (see "Element::AsMandel"): "qmandel" [nelem, nip, 3, 3]
+    // elemmat = B^T * qmandel * B * dV (with "eps = B * u" in Mandel representation)
+    void int_gradN_dot_mandel_dot_gradNT_dV(
+        const xt::xtensor<double, 4>& qmandel, xt::xtensor<double, 3>& elemmat) const;
+
+    // Accumulate variants of the integrals above: "elemvec += alpha * ..." and
+    // "elemmat += alpha * ..." (without zeroing the output), to combine contributions (e.g. mass,
+    // damping, and stiffness, or several material subsets) without intermediate temporaries
+    void int_N_scalar_NT_dV(
+        const xt::xtensor<double, 2>& qscalar,
+        xt::xtensor<double, 3>& elemmat,
+        double alpha) const;
+
+    void int_gradN_dot_tensor2_dV(
+        const xt::xtensor<double, 4>& qtensor,
+        xt::xtensor<double, 3>& elemvec,
+        double alpha) const;
+
+    void int_gradN_dot_tensor2_dV(
+        const xt::xtensor<size_t, 1>& elem,
+        const xt::xtensor<double, 4>& qtensor,
+        xt::xtensor<double, 3>& elemvec,
+        double alpha) const;
+
+    void int_gradN_dot_tensor4_dot_gradNT_dV(
+        const xt::xtensor<double, 6>& qtensor,
+        xt::xtensor<double, 3>& elemmat,
+        double alpha) const;
+
+    void int_gradN_dot_mandel_dot_gradNT_dV(
+        const xt::xtensor<double, 4>& qmandel,
+        xt::xtensor<double, 3>& elemmat,
+        double alpha) const;
+
+    // Auto-allocation of the functions above
+    xt::xtensor<double, 4> GradN_vector(const xt::xtensor<double, 3>& elemvec) const;
+    xt::xtensor<double, 4> GradN_vector_T(const xt::xtensor<double, 3>& elemvec) const;
+    xt::xtensor<double, 4> SymGradN_vector(const xt::xtensor<double, 3>& elemvec) const;
+    xt::xtensor<double, 3> Int_N_scalar_NT_dV(const xt::xtensor<double, 2>& qscalar) const;
+    xt::xtensor<double, 3> Int_gradN_dot_tensor2_dV(const xt::xtensor<double, 4>& qtensor) const;
+    xt::xtensor<double, 3> Int_gradN_dot_tensor4_dot_gradNT_dV(const xt::xtensor<double, 6>& qtensor) const;
+    xt::xtensor<double, 3> Int_gradN_dot_mandel_dot_gradNT_dV(const xt::xtensor<double, 4>& qmandel) const;
+
+    // Convert "qscalar" to "qtensor" of certain rank
+    template <size_t rank = 0>
+    xt::xtensor<double, 2 + rank> AsTensor(const xt::xtensor<double, 2>& qscalar) const;
+
+    xt::xarray<double> AsTensor(size_t rank, const xt::xtensor<double, 2>& qscalar) const;
+
+    // Return allocated integration point tensor of a certain rank (zero, or "val", initialised
+    // in parallel: "first-touch"), e.g.:
+    // - rank == 0 -> qscalar
+    // - rank == 2 -> qtensor
+    template <size_t rank = 0>
+    xt::xtensor<double, rank + 2> AllocateQtensor() const;
+
+    template <size_t rank = 0>
+    xt::xtensor<double, rank + 2> AllocateQtensor(double val) const;
+
+    xt::xarray<double> AllocateQtensor(size_t rank) const;
+    xt::xarray<double> AllocateQtensor(size_t rank, double val) const;
+
+    xt::xtensor<double, 2> AllocateQscalar() const;
+    xt::xtensor<double, 2> AllocateQscalar(double val) const;
+
+private:
+    // Compute "vol" and "dNdx" based on current "x"
+    void compute_dN();
+
+    // Implementation of the functions above, on the list of elements "elem" (e.g. "xt::arange")
+    template <class E>
+    void gradN_vector_impl(
+        const E& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 4>& qtensor) const;
+
+    template <class E>
+    void gradN_vector_T_impl(
+        const E& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 4>& qtensor) const;
+
+    template <class E>
+    void symGradN_vector_impl(
+        const E& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 4>& qtensor) const;
+
+    template <class E>
+    void int_gradN_dot_tensor2_dV_impl(
+        const E& elem,
+        const xt::xtensor<double, 4>& qtensor,
+        xt::xtensor<double, 3>& elemvec,
+        double alpha,
+        bool accumulate) const;
+
+private:
+    // Dimensions (flexible)
+    size_t m_nelem; // number of elements
+    size_t m_nip;   // number of integration points
+
+    // Dimensions (fixed for this element type)
+    static const size_t m_nne = 3;  // number of nodes per element
+    static const size_t m_ndim = 2; // number of dimensions
+
+    // Data arrays
+    std::shared_ptr<xt::xtensor<double, 3>> m_x; // nodal positions stored per element [nelem, nne, ndim]
+    xt::xtensor<double, 1> m_w;    // weight of each integration point [nip]
+    xt::xtensor<double, 2> m_xi;   // local coordinate of each integration point [nip, ndim]
+    xt::xtensor<double, 2> m_N;    // shape functions [nip, nne]
+    std::shared_ptr<xt::xtensor<double, 3>> m_dNx; // shape function grad. wrt global coor. [nelem, nne, ndim]
+    std::shared_ptr<xt::xtensor<double, 2>> m_vol; // integration point volume [nelem, nip]
+    xt::xtensor<size_t, 1> m_degenerate; // elements with non-positive Jacobian determinant
+
+    // Element-numbers of the subset: row in "m_x", "m_dNx", "m_vol" [nelem]
+    xt::xtensor<size_t, 1> m_elem;
+    bool m_subset = false;
+};
+
+} // namespace Tri3
+} // namespace Element
+} // namespace GooseFEM
+
+#include "ElementTri3.hpp"
+
+#endif
@@ -0,0 +1,785 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_ELEMENTTRI3_HPP
+#define GOOSEFEM_ELEMENTTRI3_HPP
+
+#include "ElementTri3.h"
+
+namespace GooseFEM {
+namespace Element {
+namespace Tri3 {
+
+namespace Gauss {
+
+inline size_t nip()
+{
+    return 1;
+}
+
+inline xt::xtensor<double, 2> xi()
+{
+    size_t nip = 1;
+    size_t ndim = 2;
+
+    xt::xtensor<double, 2> xi = xt::empty<double>({nip, ndim});
+
+    xi(0, 0) = 1.0 / 3.0;
+    xi(0, 1) = 1.0 / 3.0;
+
+    return xi;
+}
+
+inline xt::xtensor<double, 1> w()
+{
+    size_t nip = 1;
+
+    xt::xtensor<double, 1> w = xt::empty<double>({nip});
+
+    w(0) = 0.5;
+
+    return w;
+}
+
+} // namespace Gauss
+
+namespace Nodal {
+
+inline size_t nip()
+{
+    return 3;
+}
+
+inline xt::xtensor<double, 2> xi()
+{
+    size_t nip = 3;
+    size_t ndim = 2;
+
+    xt::xtensor<double, 2> xi = xt::empty<double>({nip, ndim});
+
+    xi(0, 0) = 0.0;
+    xi(0, 1) = 0.0;
+
+    xi(1, 0) = 1.0;
+    xi(1, 1) = 0.0;
+
+    xi(2, 0) = 0.0;
+    xi(2, 1) = 1.0;
+
+    return xi;
+}
+
+inline xt::xtensor<double, 1> w()
+{
+    size_t nip = 3;
+
+    xt::xtensor<double, 1> w = xt::empty<double>({nip});
+
+    w(0) = 1.0 / 6.0;
+    w(1) = 1.0 / 6.0;
+    w(2) = 1.0 / 6.0;
+
+    return w;
+}
+
+} // namespace Nodal
+
+inline Quadrature::Quadrature(const xt::xtensor<double, 3>& x)
+    : Quadrature(x, Gauss::xi(), Gauss::w())
+{
+}
+
+inline Quadrature::Quadrature(
+    const xt::xtensor<double, 3>& x,
+    const xt::xtensor<double, 2>& xi,
+    const xt::xtensor<double, 1>& w)
+    : m_x(std::make_shared<xt::xtensor<double, 3>>(GooseFEM::FirstTouchCopy(x))),
+      m_w(w),
+      m_xi(xi)
+{
+    GOOSEFEM_ASSERT(x.shape(1) == m_nne);
+    GOOSEFEM_ASSERT(x.shape(2) == m_ndim);
+
+    m_nelem = x.shape(0);
+    m_elem = xt::arange<size_t>(m_nelem);
+    m_nip = m_w.size();
+
+    GOOSEFEM_ASSERT(m_xi.shape(0) == m_nip);
+    GOOSEFEM_ASSERT(m_xi.shape(1) == m_ndim);
+    GOOSEFEM_ASSERT(m_w.size() == m_nip);
+
+    m_N = xt::empty<double>({m_nip, m_nne});
+
+    // not initialised: first written (in parallel, "first-touch") by "compute_dN"
+    m_dNx = std::make_shared<xt::xtensor<double, 3>>(xt::empty<double>({m_nelem, m_nne, m_ndim}));
+    m_vol = std::make_shared<xt::xtensor<double, 2>>(xt::empty<double>({m_nelem, m_nip}));
+
+    for (size_t q = 0; q < m_nip; ++q) {
+        m_N(q, 0) = 1.0 - m_xi(q, 0) - m_xi(q, 1);
+        m_N(q, 1) = m_xi(q, 0);
+        m_N(q, 2) = m_xi(q, 1);
+    }
+
+    compute_dN();
+}
+
+inline size_t Quadrature::nelem() const
+{
+    return m_nelem;
+}
+
+inline size_t Quadrature::nne() const
+{
+    return m_nne;
+}
+
+inline size_t Quadrature::ndim() const
+{
+    return m_ndim;
+}
+
+inline size_t Quadrature::nip() const
+{
+    return m_nip;
+}
+
+inline xt::xtensor<double, 4> Quadrature::GradN() const
+{
+    const auto& dNdx = *m_dNx;
+    xt::xtensor<double, 4> ret = xt::empty<double>({m_nelem, m_nip, m_nne, m_ndim});
+
+    for (size_t e = 0; e < m_nelem; ++e) {
+        for (size_t q = 0; q < m_nip; ++q) {
+            for (size_t m = 0; m < m_nne; ++m) {
+                for (size_t i = 0; i < m_ndim; ++i) {
+                    ret(e, q, m, i) = dNdx(m_elem(e), m, i);
+                }
+            }
+        }
+    }
+
+    return ret;
+}
+
+template <size_t rank>
+inline void
+Quadrature::asTensor(const xt::xtensor<double, 2>& arg, xt::xtensor<double, 2 + rank>& ret) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(arg, {m_nelem, m_nip}));
+    GooseFEM::asTensor<2, rank>(arg, ret);
+}
+
+inline xt::xtensor<double, 2> Quadrature::dV() const
+{
+    if (m_subset) {
+        return xt::view(*m_vol, xt::keep(m_elem));
+    }
+
+    return *m_vol;
+}
+
+inline xt::xtensor<size_t, 1> Quadrature::degenerate() const
+{
+    if (m_subset) {
+        return detail::positions(m_elem, m_degenerate);
+    }
+
+    return m_degenerate;
+}
+
+inline void Quadrature::update_x(const xt::xtensor<double, 3>& x)
+{
+    GOOSEFEM_ASSERT(!m_subset);
+    GOOSEFEM_ASSERT(x.shape() == m_x->shape());
+
+    // data shared with copies or subsets is not overwritten
+    if (m_x.use_count() > 1) {
+        m_x = std::make_shared<xt::xtensor<double, 3>>(GooseFEM::FirstTouchCopy(x));
+    }
+    else {
+        xt::noalias(*m_x) = x;
+    }
+
+    if (m_dNx.use_count() > 1) {
+        m_dNx = std::make_shared<xt::xtensor<double, 3>>(
+            xt::empty<double>({m_nelem, m_nne, m_ndim}));
+    }
+
+    if (m_vol.use_count() > 1) {
+        m_vol = std::make_shared<xt::xtensor<double, 2>>(xt::empty<double>({m_nelem, m_nip}));
+    }
+
+    compute_dN();
+}
+
+inline Quadrature Quadrature::Subset(const xt::xtensor<size_t, 1>& elem) const
+{
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+
+    Quadrature ret = *this;
+    ret.m_elem = xt::view(m_elem, xt::keep(elem));
+    ret.m_nelem = elem.size();
+    ret.m_subset = true;
+    return ret;
+}
+
+inline void Quadrature::compute_dN()
+{
+    auto& x_all = *m_x;
+    auto& dNdx = *m_dNx;
+    auto& dVol = *m_vol;
+
+    std::vector<char> isdegenerate(m_nelem, 0);
+
+    #pragma omp parallel for schedule(static)
+    for (size_t e = 0; e < m_nelem; ++e) {
+
+        auto x = xt::adapt(&x_all(e, 0, 0), xt::xshape<m_nne, m_ndim>());
+        auto dNx = xt::adapt(&dNdx(e, 0, 0), xt::xshape<m_nne, m_ndim>());
+
+        // J(i,j) += dNxi(m,i) * x(m,j), with "dNxi = [[-1, -1], [1, 0], [0, 1]]"
+        double J00 = x(1, 0) - x(0, 0);
+        double J01 = x(1, 1) - x(0, 1);
+        double J10 = x(2, 0) - x(0, 0);
+        double J11 = x(2, 1) - x(0, 1);
+        double Jdet = J00 * J11 - J01 * J10;
+        isdegenerate[e] = Jdet <= 0.0;
+
+        // dNx(m,i) += Jinv(i,j) * dNxi(m,j)
+        dNx(1, 0) = J11 / Jdet;
+        dNx(1, 1) = -J10 / Jdet;
+        dNx(2, 0) = -J01 / Jdet;
+        dNx(2, 1) = J00 / Jdet;
+        dNx(0, 0) = -dNx(1, 0) - dNx(2, 0);
+        dNx(0, 1) = -dNx(1, 1) - dNx(2, 1);
+
+        for (size_t q = 0; q < m_nip; ++q) {
+            dVol(e, q) = m_w(q) * Jdet;
+        }
+    }
+
+    m_degenerate = detail::flagged(isdegenerate);
+}
+
+inline void Quadrature::gradN_vector(
+    const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    this->gradN_vector_impl(xt::arange<size_t>(m_nelem), elemvec, qtensor);
+}
+
+inline void Quadrature::gradN_vector(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 3>& elemvec,
+    xt::xtensor<double, 4>& qtensor) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+    this->gradN_vector_impl(elem, elemvec, qtensor);
+}
+
+template <class E>
+inline void Quadrature::gradN_vector_impl(
+    const E& elem, const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const
+{
+    const auto& dNdx = *m_dNx;
+
+    #pragma omp parallel for schedule(static)
+    for (size_t ie = 0; ie < elem.size(); ++ie) {
+
+        size_t e = elem(ie);
+        size_t row = m_subset ? m_elem(e) : e;
+
+        auto u = xt::adapt(&elemvec(e, 0, 0), xt::xshape<m_nne, m_ndim>());
+        auto dNx = xt::adapt(&dNdx(row, 0, 0), xt::xshape<m_nne, m_ndim>());
+
+        // gradu(i,j) += dNx(m,i) * u(m,j)
+        double g00 = dNx(0, 0) * u(0, 0) + dNx(1, 0) * u(1, 0) + dNx(2, 0) * u(2, 0);
+        double g01 = dNx(0, 0) * u(0, 1) + dNx(1, 0) * u(1, 1) + dNx(2, 0) * u(2, 1);
+        double g10 = dNx(0, 1) * u(0, 0) + dNx(1, 1) * u(1, 0) + dNx(2, 1) * u(2, 0);
+        double g11 = dNx(0, 1) * u(0, 1) + dNx(1, 1) * u(1, 1) + dNx(2, 1) * u(2, 1);
+
+        for (size_t q = 0; q < m_nip; ++q) {
+            auto gradu = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_ndim, m_ndim>());
+            gradu(0, 0) = g00;
+            gradu(0, 1) = g01;
+            gradu(1, 0) = g10;
+            gradu(1, 1) = g11;
+        }
+    }
+}
+
+inline void Quadrature::gradN_vector_T(
+    const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    this->gradN_vector_T_impl(xt::arange<size_t>(m_nelem), elemvec, qtensor);
+}
+
+inline void Quadrature::gradN_vector_T(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 3>& elemvec,
+    xt::xtensor<double, 4>& qtensor) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+    this->gradN_vector_T_impl(elem, elemvec, qtensor);
+}
+
+template <class E>
+inline void Quadrature::gradN_vector_T_impl(
+    const E& elem, const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const
+{
+    const auto& dNdx = *m_dNx;
+
+    #pragma omp parallel for schedule(static)
+    for (size_t ie = 0; ie < elem.size(); ++ie) {
+
+        size_t e = elem(ie);
+        size_t row = m_subset ? m_elem(e) : e;
+
+        auto u = xt::adapt(&elemvec(e, 0, 0), xt::xshape<m_nne, m_ndim>());
+        auto dNx = xt::adapt(&dNdx(row, 0, 0), xt::xshape<m_nne, m_ndim>());
+
+        // gradu(j,i) += dNx(m,i) * u(m,j)
+        double g00 = dNx(0, 0) * u(0, 0) + dNx(1, 0) * u(1, 0) + dNx(2, 0) * u(2, 0);
+        double g10 = dNx(0, 0) * u(0, 1) + dNx(1, 0) * u(1, 1) + dNx(2, 0) * u(2, 1);
+        double g01 = dNx(0, 1) * u(0, 0) + dNx(1, 1) * u(1, 0) + dNx(2, 1) * u(2, 0);
+        double g11 = dNx(0, 1) * u(0, 1) + dNx(1, 1) * u(1, 1) + dNx(2, 1) * u(2, 1);
+
+        for (size_t q = 0; q < m_nip; ++q) {
+            auto gradu = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_ndim, m_ndim>());
+            gradu(0, 0) = g00;
+            gradu(0, 1) = g01;
+            gradu(1, 0) = g10;
+            gradu(1, 1) = g11;
+        }
+    }
+}
+
+inline void Quadrature::symGradN_vector(
+    const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    this->symGradN_vector_impl(xt::arange<size_t>(m_nelem), elemvec, qtensor);
+}
+
+inline void Quadrature::symGradN_vector(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 3>& elemvec,
+    xt::xtensor<double, 4>& qtensor) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+    this->symGradN_vector_impl(elem, elemvec, qtensor);
+}
+
+template <class E>
+inline void Quadrature::symGradN_vector_impl(
+    const E& elem, const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 4>& qtensor) const
+{
+    const auto& dNdx = *m_dNx;
+
+    #pragma omp parallel for schedule(static)
+    for (size_t ie = 0; ie < elem.size(); ++ie) {
+
+        size_t e = elem(ie);
+        size_t row = m_subset ? m_elem(e) : e;
+
+        auto u = xt::adapt(&elemvec(e, 0, 0), xt::xshape<m_nne, m_ndim>());
+        auto dNx = xt::adapt(&dNdx(row, 0, 0), xt::xshape<m_nne, m_ndim>());
+
+        // gradu(i,j) += dNx(m,i) * u(m,j)
+        // eps(j,i) = 0.5 * (gradu(i,j) + gradu(j,i))
+        double e00 = dNx(0, 0) * u(0, 0) + dNx(1, 0) * u(1, 0) + dNx(2, 0) * u(2, 0);
+        double e11 = dNx(0, 1) * u(0, 1) + dNx(1, 1) * u(1, 1) + dNx(2, 1) * u(2, 1);
+        double e01 = 0.5 * (dNx(0, 0) * u(0, 1) + dNx(1, 0) * u(1, 1) + dNx(2, 0) * u(2, 1) +
+                            dNx(0, 1) * u(0, 0) + dNx(1, 1) * u(1, 0) + dNx(2, 1) * u(2, 0));
+
+        for (size_t q = 0; q < m_nip; ++q) {
+            auto eps = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_ndim, m_ndim>());
+            eps(0, 0) = e00;
+            eps(0, 1) = e01;
+            eps(1, 0) = e01;
+            eps(1, 1) = e11;
+        }
+    }
+}
+
+inline void Quadrature::int_N_scalar_NT_dV(
+    const xt::xtensor<double, 2>& qscalar, xt::xtensor<double, 3>& elemmat) const
+{
+    GooseFEM::firstTouch(elemmat, 0.0);
+    this->int_N_scalar_NT_dV(qscalar, elemmat, 1.0);
+}
+
+inline void Quadrature::int_N_scalar_NT_dV(
+    const xt::xtensor<double, 2>& qscalar,
+    xt::xtensor<double, 3>& elemmat,
+    double alpha) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(qscalar, {m_nelem, m_nip}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemmat, {m_nelem, m_nne * m_ndim, m_nne * m_ndim}));
+
+    const auto& dVol = *m_vol;
+
+    #pragma omp parallel for schedule(static)
+    for (size_t e = 0; e < m_nelem; ++e) {
+
+        size_t row = m_subset ? m_elem(e) : e;
+
+        auto M = xt::adapt(&elemmat(e, 0, 0), xt::xshape<m_nne * m_ndim, m_nne * m_ndim>());
+
+        for (size_t q = 0; q < m_nip; ++q) {
+
+            auto N = xt::adapt(&m_N(q, 0), xt::xshape<m_nne>());
+            double vol = alpha * dVol(row, q);
+            auto& rho = qscalar(e, q);
+
+            // M(m*ndim+i,n*ndim+i) += N(m) * scalar * N(n) * dV
+            for (size_t m = 0; m < m_nne; ++m) {
+                for (size_t n = 0; n < m_nne; ++n) {
+                    M(m * m_ndim + 0, n * m_ndim + 0) += N(m) * rho * N(n) * vol;
+                    M(m * m_ndim + 1, n * m_ndim + 1) += N(m) * rho * N(n) * vol;
+                }
+            }
+        }
+    }
+}
+
+inline void Quadrature::int_gradN_dot_tensor2_dV(
+    const xt::xtensor<double, 4>& qtensor, xt::xtensor<double, 3>& elemvec) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    this->int_gradN_dot_tensor2_dV_impl(xt::arange<size_t>(m_nelem), qtensor, elemvec, 1.0, false);
+}
+
+inline void Quadrature::int_gradN_dot_tensor2_dV(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 4>& qtensor,
+    xt::xtensor<double, 3>& elemvec) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+    this->int_gradN_dot_tensor2_dV_impl(elem, qtensor, elemvec, 1.0, false);
+}
+
+inline void Quadrature::int_gradN_dot_tensor2_dV(
+    const xt::xtensor<double, 4>& qtensor,
+    xt::xtensor<double, 3>& elemvec,
+    double alpha) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    this->int_gradN_dot_tensor2_dV_impl(xt::arange<size_t>(m_nelem), qtensor, elemvec, alpha, true);
+}
+
+inline void Quadrature::int_gradN_dot_tensor2_dV(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 4>& qtensor,
+    xt::xtensor<double, 3>& elemvec,
+    double alpha) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+    this->int_gradN_dot_tensor2_dV_impl(elem, qtensor, elemvec, alpha, true);
+}
+
+template <class E>
+inline void Quadrature::int_gradN_dot_tensor2_dV_impl(
+    const E& elem,
+    const xt::xtensor<double, 4>& qtensor,
+    xt::xtensor<double, 3>& elemvec,
+    double alpha,
+    bool accumulate) const
+{
+    const auto& dNdx = *m_dNx;
+    const auto& dVol = *m_vol;
+
+    #pragma omp parallel for schedule(static)
+    for (size_t ie = 0; ie < elem.size(); ++ie) {
+
+        size_t e = elem(ie);
+        size_t row = m_subset ? m_elem(e) : e;
+
+        if (!accumulate) {
+            std::fill_n(&elemvec(e, 0, 0), m_nne * m_ndim, 0.0);
+        }
+
+        auto f = xt::adapt(&elemvec(e, 0, 0), xt::xshape<m_nne, m_ndim>());
+        auto dNx = xt::adapt(&dNdx(row, 0, 0), xt::xshape<m_nne, m_ndim>());
+
+        // integrated tensor: sum of "qtensor * dV" over the integration points
+        double s00 = 0.0;
+        double s01 = 0.0;
+        double s10 = 0.0;
+        double s11 = 0.0;
+
+        for (size_t q = 0; q < m_nip; ++q) {
+            auto sig = xt::adapt(&qtensor(e, q, 0, 0), xt::xshape<m_ndim, m_ndim>());
+            double vol = alpha * dVol(row, q);
+            s00 += sig(0, 0) * vol;
+            s01 += sig(0, 1) * vol;
+            s10 += sig(1, 0) * vol;
+            s11 += sig(1, 1) * vol;
+        }
+
+        for (size_t m = 0; m < m_nne; ++m) {
+            f(m, 0) += dNx(m, 0) * s00 + dNx(m, 1) * s10;
+            f(m, 1) += dNx(m, 0) * s01 + dNx(m, 1) * s11;
+        }
+    }
+}
+
+inline void Quadrature::int_gradN_dot_tensor4_dot_gradNT_dV(
+    const xt::xtensor<double, 6>& qtensor, xt::xtensor<double, 3>& elemmat) const
+{
+    GooseFEM::firstTouch(elemmat, 0.0);
+    this->int_gradN_dot_tensor4_dot_gradNT_dV(qtensor, elemmat, 1.0);
+}
+
+inline void Quadrature::int_gradN_dot_tensor4_dot_gradNT_dV(
+    const xt::xtensor<double, 6>& qtensor,
+    xt::xtensor<double, 3>& elemmat,
+    double alpha) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(qtensor, {m_nelem, m_nip, m_ndim, m_ndim, m_ndim, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemmat, {m_nelem, m_nne * m_ndim, m_nne * m_ndim}));
+
+    constexpr size_t nc = m_ndim * m_ndim * m_ndim * m_ndim;
+
+    const auto& dNdx = *m_dNx;
+    const auto& dVol = *m_vol;
+
+    #pragma omp parallel for schedule(static)
+    for (size_t e = 0; e < m_nelem; ++e) {
+
+        size_t row = m_subset ? m_elem(e) : e;
+
+        auto K = xt::adapt(&elemmat(e, 0, 0), xt::xshape<m_nne * m_ndim, m_nne * m_ndim>());
+        auto dNx = xt::adapt(&dNdx(row, 0, 0), xt::xshape<m_nne, m_ndim>());
+
+        // integrated tangent: sum of "qtensor * dV" over the integration points
+        std::array<double, nc> Cbar;
+        Cbar.fill(0.0);
+
+        for (size_t q = 0; q < m_nip; ++q) {
+            const double* C = &qtensor(e, q, 0, 0, 0, 0);
+            double vol = alpha * dVol(row, q);
+            for (size_t c = 0; c < nc; ++c) {
+                Cbar[c] += C[c] * vol;
+            }
+        }
+
+        auto C = xt::adapt(Cbar.data(), xt::xshape<m_ndim, m_ndim, m_ndim, m_ndim>());
+
+        for (size_t m = 0; m < m_nne; ++m) {
+            for (size_t n = 0; n < m_nne; ++n) {
+                for (size_t j = 0; j < m_ndim; ++j) {
+                    for (size_t k = 0; k < m_ndim; ++k) {
+                        double Kmn = 0.0;
+                        for (size_t i = 0; i < m_ndim; ++i) {
+                            for (size_t l = 0; l < m_ndim; ++l) {
+                                Kmn += dNx(m, i) * C(i, j, k, l) * dNx(n, l);
+                            }
+                        }
+                        K(m * m_ndim + j, n * m_ndim + k) += Kmn;
+                    }
+                }
+            }
+        }
+    }
+}
+
+inline void Quadrature::int_gradN_dot_mandel_dot_gradNT_dV(
+    const xt::xtensor<double, 4>& qmandel, xt::xtensor<double, 3>& elemmat) const
+{
+    GooseFEM::firstTouch(elemmat, 0.0);
+    this->int_gradN_dot_mandel_dot_gradNT_dV(qmandel, elemmat, 1.0);
+}
+
+inline void Quadrature::int_gradN_dot_mandel_dot_gradNT_dV(
+    const xt::xtensor<double, 4>& qmandel,
+    xt::xtensor<double, 3>& elemmat,
+    double alpha) const
+{
+    constexpr size_t nv = 3; // number of Mandel components: xx, yy, xy
+    constexpr size_t ndof = m_nne * m_ndim;
+
+    GOOSEFEM_ASSERT(xt::has_shape(qmandel, {m_nelem, m_nip, nv, nv}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemmat, {m_nelem, ndof, ndof}));
+
+    const auto& dNdx = *m_dNx;
+    const auto& dVol = *m_vol;
+    const double s = 1.0 / std::sqrt(2.0);
+
+    #pragma omp parallel
+    {
+        // B-matrix [nv, ndof] (zero entries are never written), workspace "D * B",
+        // and integrated tangent "D" (sum of "qmandel * dV" over the integration points)
+        std::array<double, nv * ndof> B;
+        std::array<double, nv * ndof> DB;
+        std::array<double, nv * nv> D;
+        B.fill(0.0);
+
+        #pragma omp for schedule(static)
+        for (size_t e = 0; e < m_nelem; ++e) {
+
+            size_t row = m_subset ? m_elem(e) : e;
+
+            auto dNx = xt::adapt(&dNdx(row, 0, 0), xt::xshape<m_nne, m_ndim>());
+
+            for (size_t m = 0; m < m_nne; ++m) {
+                B[0 * ndof + m * m_ndim + 0] = dNx(m, 0);
+                B[1 * ndof + m * m_ndim + 1] = dNx(m, 1);
+                B[2 * ndof + m * m_ndim + 0] = s * dNx(m, 1);
+                B[2 * ndof + m * m_ndim + 1] = s * dNx(m, 0);
+            }
+
+            D.fill(0.0);
+
+            for (size_t q = 0; q < m_nip; ++q) {
+                const double* Dq = &qmandel(e, q, 0, 0);
+                double vol = alpha * dVol(row, q);
+                for (size_t c = 0; c < nv * nv; ++c) {
+                    D[c] += Dq[c] * vol;
+                }
+            }
+
+            GooseFEM::Element::detail::add_BT_D_B<nv, ndof>(
+                B.data(), D.data(), 1.0, DB.data(), &elemmat(e, 0, 0));
+        }
+    }
+}
+
+template <size_t rank>
+inline xt::xtensor<double, 2 + rank>
+Quadrature::AsTensor(const xt::xtensor<double, 2>& qscalar) const
+{
+    return GooseFEM::AsTensor<2, rank>(qscalar, m_ndim);
+}
+
+inline xt::xarray<double>
+Quadrature::AsTensor(size_t rank, const xt::xtensor<double, 2>& qscalar) const
+{
+    return GooseFEM::AsTensor(rank, qscalar, m_ndim);
+}
+
+inline xt::xtensor<double, 4> Quadrature::GradN_vector(const xt::xtensor<double, 3>& elemvec) const
+{
+    xt::xtensor<double, 4> qtensor = xt::empty<double>({m_nelem, m_nip, m_ndim, m_ndim});
+    this->gradN_vector(elemvec, qtensor);
+    return qtensor;
+}
+
+inline xt::xtensor<double, 4>
+Quadrature::GradN_vector_T(const xt::xtensor<double, 3>& elemvec) const
+{
+    xt::xtensor<double, 4> qtensor = xt::empty<double>({m_nelem, m_nip, m_ndim, m_ndim});
+    this->gradN_vector_T(elemvec, qtensor);
+    return qtensor;
+}
+
+inline xt::xtensor<double, 4>
+Quadrature::SymGradN_vector(const xt::xtensor<double, 3>& elemvec) const
+{
+    xt::xtensor<double, 4> qtensor = xt::empty<double>({m_nelem, m_nip, m_ndim, m_ndim});
+    this->symGradN_vector(elemvec, qtensor);
+    return qtensor;
+}
+
+inline xt::xtensor<double, 3>
+Quadrature::Int_N_scalar_NT_dV(const xt::xtensor<double, 2>& qscalar) const
+{
+    xt::xtensor<double, 3> elemmat = xt::empty<double>({m_nelem, m_nne * m_ndim, m_nne * m_ndim});
+    this->int_N_scalar_NT_dV(qscalar, elemmat);
+    return elemmat;
+}
+
+inline xt::xtensor<double, 3>
+Quadrature::Int_gradN_dot_tensor2_dV(const xt::xtensor<double, 4>& qtensor) const
+{
+    xt::xtensor<double, 3> elemvec = xt::empty<double>({m_nelem, m_nne, m_ndim});
+    this->int_gradN_dot_tensor2_dV(qtensor, elemvec);
+    return elemvec;
+}
+
+inline xt::xtensor<double, 3>
+Quadrature::Int_gradN_dot_tensor4_dot_gradNT_dV(const xt::xtensor<double, 6>& qtensor) const
+{
+    xt::xtensor<double, 3> elemmat = xt::empty<double>({m_nelem, m_ndim * m_nne, m_ndim * m_nne});
+    this->int_gradN_dot_tensor4_dot_gradNT_dV(qtensor, elemmat);
+    return elemmat;
+}
+
+inline xt::xtensor<double, 3>
+Quadrature::Int_gradN_dot_mandel_dot_gradNT_dV(const xt::xtensor<double, 4>& qmandel) const
+{
+    xt::xtensor<double, 3> elemmat = xt::empty<double>({m_nelem, m_ndim * m_nne, m_ndim * m_nne});
+    this->int_gradN_dot_mandel_dot_gradNT_dV(qmandel, elemmat);
+    return elemmat;
+}
+
+template <size_t rank>
+inline xt::xtensor<double, rank + 2> Quadrature::AllocateQtensor() const
+{
+    return this->AllocateQtensor<rank>(0.0);
+}
+
+template <size_t rank>
+inline xt::xtensor<double, rank + 2> Quadrature::AllocateQtensor(double val) const
+{
+    std::array<size_t, rank + 2> shape;
+    shape[0] = m_nelem;
+    shape[1] = m_nip;
+    size_t n = m_ndim;
+    std::fill(shape.begin() + 2, shape.end(), n);
+    xt::xtensor<double, rank + 2> ret = xt::empty<double>(shape);
+    GooseFEM::firstTouch(ret, val);
+    return ret;
+}
+
+inline xt::xarray<double> Quadrature::AllocateQtensor(size_t rank) const
+{
+    return this->AllocateQtensor(rank, 0.0);
+}
+
+inline xt::xarray<double> Quadrature::AllocateQtensor(size_t rank, double val) const
+{
+    std::vector<size_t> shape(rank + 2);
+    shape[0] = m_nelem;
+    shape[1] = m_nip;
+    size_t n = m_ndim;
+    std::fill(shape.begin() + 2, shape.end(), n);
+    xt::xarray<double> ret = xt::empty<double>(shape);
+    GooseFEM::firstTouch(ret, val);
+    return ret;
+}
+
+inline xt::xtensor<double, 2> Quadrature::AllocateQscalar() const
+{
+    return this->AllocateQtensor<0>();
+}
+
+inline xt::xtensor<double, 2> Quadrature::AllocateQscalar(double val) const
+{
+    return this->AllocateQtensor<0>(val);
+}
+
+} // namespace Tri3
+} // namespace Element
+} // namespace GooseFEM
+
+#endif
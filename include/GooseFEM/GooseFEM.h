@@ -11,28 +11,53 @@
 #define GOOSEFEM_EIGEN
 #endif
 
+#ifdef MPI_VERSION
+#define GOOSEFEM_MPI
+#endif
+
 #include "Allocate.h"
 #include "Element.h"
+#include "ElementHex27.h"
 #include "ElementHex8.h"
 #include "ElementQuad4.h"
 #include "ElementQuad4Axisymmetric.h"
 #include "ElementQuad4Planar.h"
+#include "ElementQuad9.h"
+#include "ElementTri3.h"
 #include "Iterate.h"
+#include "MatrixBlock.h"
 #include "MatrixDiagonal.h"
 #include "MatrixDiagonalPartitioned.h"
 #include "Mesh.h"
+#include "MeshHex27.h"
 #include "MeshHex8.h"
 #include "MeshQuad4.h"
+#include "MeshQuad9.h"
 #include "MeshTri3.h"
+#include "Topology.h"
 #include "Vector.h"
 #include "VectorPartitioned.h"
 
 #ifdef GOOSEFEM_EIGEN
+#include "AMG.h"
+#include "LinearSolver.h"
 #include "Matrix.h"
 #include "MatrixPartitioned.h"
 #include "MatrixPartitionedTyings.h"
+#include "Multigrid.h"
+#include "SparseMatrix.h"
 #include "TyingsPeriodic.h"
 #include "VectorPartitionedTyings.h"
 #endif
 
+#ifdef GOOSEFEM_MPI
+#include "DistributedMatrixDiagonal.h"
+#include "DistributedTopology.h"
+#include "DistributedVector.h"
+#endif
+
+#if defined(GOOSEFEM_EIGEN) && defined(GOOSEFEM_MPI)
+#include "DistributedMatrixPartitioned.h"
+#endif
+
 #endif
@@ -0,0 +1,87 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_LINEARSOLVER_H
+#define GOOSEFEM_LINEARSOLVER_H
+
+#include "config.h"
+#include "AMG.h"
+#include "Multigrid.h"
+
+#include <Eigen/Eigen>
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+
+#ifdef GOOSEFEM_USE_CHOLMOD
+#include <Eigen/CholmodSupport>
+#endif
+
+#ifdef GOOSEFEM_USE_PARDISO
+#include <Eigen/PardisoSupport>
+#endif
+
+#ifdef GOOSEFEM_USE_PASTIX
+#include <Eigen/PaStiXSupport>
+#endif
+
+/*
+  Solver policies for "MatrixSolver", "MatrixPartitionedSolver", and "MatrixPartitionedTyingsSolver"
+  (Eigen's Sparse Solver Concept). The matrices are symmetric: all policies read (and factorise)
+  only the upper triangle, such that the matrices can be stored in full or in symmetric mode.
+
+  The external libraries are enabled by linking to the CMake targets "GooseFEM::cholmod",
+  "GooseFEM::pardiso", and "GooseFEM::pastix" (or by defining "GOOSEFEM_USE_CHOLMOD",
+  "GOOSEFEM_USE_PARDISO", and "GOOSEFEM_USE_PASTIX" and linking manually).
+*/
+
+namespace GooseFEM {
+namespace LinearSolver {
+
+// Eigen's built-in simplicial LDL^T (single-threaded, always available)
+using SimplicialLDLT = Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>, Eigen::Upper>;
+
+// SuiteSparse's supernodal Cholesky (multithreaded through BLAS; positive definite matrices only)
+#ifdef GOOSEFEM_USE_CHOLMOD
+using CholmodSupernodalLLT =
+    Eigen::CholmodSupernodalLLT<Eigen::SparseMatrix<double>, Eigen::Upper>;
+#endif
+
+// Intel MKL's PARDISO, symmetric indefinite (multithreaded through OpenMP)
+#ifdef GOOSEFEM_USE_PARDISO
+using PardisoLDLT = Eigen::PardisoLDLT<Eigen::SparseMatrix<double>, Eigen::Upper>;
+#endif
+
+// PaStiX, symmetric indefinite (multithreaded)
+#ifdef GOOSEFEM_USE_PASTIX
+using PastixLDLT = Eigen::PastixLDLT<Eigen::SparseMatrix<double>, Eigen::Upper>;
+#endif
+
+// Conjugate gradients, preconditioned by algebraic multigrid (iterative: set the tolerance and the
+// near-nullspace before the first solve, through the solver's "solver()" and its
+// "preconditioner()", e.g. "solver.solver().preconditioner().setRigidBodyModes(...)")
+using ConjugateGradientAMG =
+    Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Upper, AMG>;
+
+// Conjugate gradients, preconditioned by geometric multigrid (iterative: set the tolerance and the
+// mesh before the first solve, e.g. "solver.solver().preconditioner().setMesh(...)")
+using ConjugateGradientMultigrid =
+    Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Upper, GeometricMultigrid>;
+
+// Default: the fastest available solver (falls back to "SimplicialLDLT")
+#if defined(GOOSEFEM_USE_PARDISO)
+using Default = PardisoLDLT;
+#elif defined(GOOSEFEM_USE_CHOLMOD)
+using Default = CholmodSupernodalLLT;
+#elif defined(GOOSEFEM_USE_PASTIX)
+using Default = PastixLDLT;
+#else
+using Default = SimplicialLDLT;
+#endif
+
+} // namespace LinearSolver
+} // namespace GooseFEM
+
+#endif
@@ -8,6 +8,9 @@
 #define GOOSEFEM_MATRIX_H
 
 #include "config.h"
+#include "LinearSolver.h"
+#include "SparseMatrix.h"
+#include "Topology.h"
 
 #include <Eigen/Eigen>
 #include <Eigen/Sparse>
@@ -21,8 +24,16 @@ template <class> class MatrixSolver;
 class Matrix {
 public:
     // Constructors
+    // "symmetric = true": store (and assemble) only the upper triangle, requires a symmetric
+    // solver (e.g. any policy in "LinearSolver")
     Matrix() = default;
-    Matrix(const xt::xtensor<size_t, 2>& conn, const xt::xtensor<size_t, 2>& dofs);
+
+    Matrix(
+        const xt::xtensor<size_t, 2>& conn,
+        const xt::xtensor<size_t, 2>& dofs,
+        bool symmetric = false);
+
+    Matrix(const Topology& topology, bool symmetric = false); // shares data (no copy)
 
     // Dimensions
     size_t nelem() const; // number of elements
@@ -31,13 +42,32 @@ public:
     size_t ndim() const;  // number of dimensions
     size_t ndof() const;  // number of DOFs
 
-    // DOF lists
-    xt::xtensor<size_t, 2> dofs() const; // DOFs
+    // Storage
+    bool symmetric() const; // only the upper triangle is stored
+
+    // Connectivity and DOF lists
+    const Topology& topology() const;
+    const xt::xtensor<size_t, 2>& conn() const; // connectivity
+    const xt::xtensor<size_t, 2>& dofs() const; // DOFs
 
     // Assemble from matrices stored per element [nelem, nne*ndim, nne*ndim]
     void assemble(const xt::xtensor<double, 3>& elemmat);
 
+    // Constant ("frozen") part of the matrix, e.g. of linear elastic elements:
+    // - "freeze" adds the matrices of the elements "elem" [n] (rows of "elemmat" of the function
+    //   above), stored per element [n, nne*ndim, nne*ndim], to the frozen part,
+    //   and sets the matrix equal to the frozen part;
+    // - "assemble(elem, elemmat)" sets the matrix to the frozen part plus the matrices of
+    //   the elements "elem" (which should not be part of the frozen part);
+    // - "unfreeze" clears the frozen part.
+    // The sparsity pattern of all elements is computed once (upon the first call), after which
+    // the element matrices are added directly to the stored entries (no sorting of triplets).
+    void freeze(const xt::xtensor<size_t, 1>& elem, const xt::xtensor<double, 3>& elemmat);
+    void assemble(const xt::xtensor<size_t, 1>& elem, const xt::xtensor<double, 3>& elemmat);
+    void unfreeze();
+
     // Overwrite with a dense (sub-) matrix
+    // (in symmetric mode the input is assumed symmetric: its lower triangle is ignored)
     void set(
         const xt::xtensor<size_t, 1>& rows,
         const xt::xtensor<size_t, 1>& cols,
@@ -52,29 +82,48 @@ public:
     // Return as dense matrix
     void todense(xt::xtensor<double, 2>& ret) const;
 
-    // Dot-product:
+    // Dot-product (parallel over rows, except in symmetric mode):
     // b_i = A_ij * x_j
     void dot(const xt::xtensor<double, 2>& x, xt::xtensor<double, 2>& b) const;
     void dot(const xt::xtensor<double, 1>& x, xt::xtensor<double, 1>& b) const;
 
+    // Residual (fused with the dot-product):
+    // r_i = b_i - A_ij * x_j
+    void residual(
+        const xt::xtensor<double, 1>& x,
+        const xt::xtensor<double, 1>& b,
+        xt::xtensor<double, 1>& r) const;
+
     // Auto-allocation of the functions above
     xt::xtensor<double, 2> Todense() const;
     xt::xtensor<double, 2> Dot(const xt::xtensor<double, 2>& x) const;
     xt::xtensor<double, 1> Dot(const xt::xtensor<double, 1>& x) const;
+    xt::xtensor<double, 1> Residual(
+        const xt::xtensor<double, 1>& x, const xt::xtensor<double, 1>& b) const;
 
 private:
-    // The matrix
-    Eigen::SparseMatrix<double> m_A;
+    // The matrix (row-major, converted by the solver on factorisation)
+    Eigen::SparseMatrix<double, Eigen::RowMajor> m_A;
+    bool m_symmetric = false; // only the upper triangle is stored
 
     // Matrix entries
     std::vector<Eigen::Triplet<double>> m_T;
 
+    // Frozen part (see "freeze"), with the sparsity pattern of all elements, and the position
+    // of each (stored) entry of "elemmat" in its values, element by element
+    // (symmetric mode: only the upper triangle, element "e" starts at "m_offset[e]")
+    using StorageIndex = Eigen::SparseMatrix<double, Eigen::RowMajor>::StorageIndex;
+    Eigen::SparseMatrix<double, Eigen::RowMajor> m_A0;
+    std::vector<StorageIndex> m_index;
+    std::vector<size_t> m_offset;
+    bool m_pattern = false; // signal that "m_A0" and "m_index" are computed
+    bool m_shared = false; // signal that "m_A" has the sparsity pattern of "m_A0"
+
     // Signal changes to data
     bool m_changed = true;
 
-    // Bookkeeping
-    xt::xtensor<size_t, 2> m_conn; // connectivity [nelem, nne]
-    xt::xtensor<size_t, 2> m_dofs; // DOF-numbers per node [nnode, ndim]
+    // Bookkeeping: connectivity [nelem, nne] and DOF-numbers per node [nnode, ndim]
+    Topology m_topo;
 
     // Dimensions
     size_t m_nelem; // number of elements
@@ -90,10 +139,20 @@ private:
     Eigen::VectorXd AsDofs(const xt::xtensor<double, 2>& nodevec) const;
 
     void asNode(const Eigen::VectorXd& dofval, xt::xtensor<double, 2>& nodevec) const;
+
+    // Compute the sparsity pattern of all elements: "m_A0" (zero-initialised) and "m_index"
+    void pattern();
+
+    // Set "m_A" to the frozen part "m_A0"
+    void reset();
+
+    // Add the matrices of the elements "elem" to the values "A" of a matrix with pattern "m_A0"
+    void scatter(
+        const xt::xtensor<size_t, 1>& elem, const xt::xtensor<double, 3>& elemmat, double* A) const;
 };
 
 
-template <class Solver = Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>>>
+template <class Solver = LinearSolver::Default>
 class MatrixSolver {
 public:
     // Constructors
@@ -104,12 +163,21 @@ public:
     void solve(Matrix& matrix, const xt::xtensor<double, 2>& b, xt::xtensor<double, 2>& x);
     void solve(Matrix& matrix, const xt::xtensor<double, 1>& b, xt::xtensor<double, 1>& x);
 
+    // Solve for a batch of right-hand-sides [nrhs, nnode, ndim],
+    // using one blocked forward/backward substitution
+    void solve(Matrix& matrix, const xt::xtensor<double, 3>& b, xt::xtensor<double, 3>& x);
+
+    // Underlying solver, e.g. to set the parameters of an iterative solver (before the first solve)
+    Solver& solver();
+
     // Auto-allocation of the functions above
     xt::xtensor<double, 2> Solve(Matrix& matrix, const xt::xtensor<double, 2>& b);
     xt::xtensor<double, 1> Solve(Matrix& matrix, const xt::xtensor<double, 1>& b);
+    xt::xtensor<double, 3> Solve(Matrix& matrix, const xt::xtensor<double, 3>& b);
 
 private:
     Solver m_solver; // solver
+    detail::ColumnMajor m_colmajor; // column-major copy of the matrix, input of "m_solver"
     bool m_factor = true; // signal to force factorization
     void factorize(Matrix& matrix); // compute inverse (evaluated by "solve")
 };
@@ -11,19 +11,23 @@
 
 namespace GooseFEM {
 
-inline Matrix::Matrix(const xt::xtensor<size_t, 2>& conn, const xt::xtensor<size_t, 2>& dofs)
-    : m_conn(conn), m_dofs(dofs)
-{
-    m_nelem = m_conn.shape(0);
-    m_nne = m_conn.shape(1);
-    m_nnode = m_dofs.shape(0);
-    m_ndim = m_dofs.shape(1);
-    m_ndof = xt::amax(m_dofs)() + 1;
-    m_T.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
-    m_A.resize(m_ndof, m_ndof);
+inline Matrix::Matrix(
+    const xt::xtensor<size_t, 2>& conn, const xt::xtensor<size_t, 2>& dofs, bool symmetric)
+    : Matrix(Topology(conn, dofs), symmetric)
+{
+}
 
-    GOOSEFEM_ASSERT(xt::amax(m_conn)() + 1 <= m_nnode);
-    GOOSEFEM_ASSERT(m_ndof <= m_nnode * m_ndim);
+inline Matrix::Matrix(const Topology& topology, bool symmetric)
+    : m_symmetric(symmetric), m_topo(topology)
+{
+    m_nelem = m_topo.nelem();
+    m_nne = m_topo.nne();
+    m_nnode = m_topo.nnode();
+    m_ndim = m_topo.ndim();
+    m_ndof = m_topo.ndof();
+    size_t n = m_nne * m_ndim;
+    m_T.reserve(m_nelem * (m_symmetric ? n * (n + 1) / 2 : n * n));
+    m_A.resize(m_ndof, m_ndof);
 }
 
 inline size_t Matrix::nelem() const
@@ -51,26 +55,49 @@ inline size_t Matrix::ndof() const
     return m_ndof;
 }
 
-inline xt::xtensor<size_t, 2> Matrix::dofs() const
+inline bool Matrix::symmetric() const
 {
-    return m_dofs;
+    return m_symmetric;
+}
+
+inline const Topology& Matrix::topology() const
+{
+    return m_topo;
+}
+
+inline const xt::xtensor<size_t, 2>& Matrix::conn() const
+{
+    return m_topo.conn();
+}
+
+inline const xt::xtensor<size_t, 2>& Matrix::dofs() const
+{
+    return m_topo.dofs();
 }
 
 inline void Matrix::assemble(const xt::xtensor<double, 3>& elemmat)
 {
     GOOSEFEM_ASSERT(xt::has_shape(elemmat, {m_nelem, m_nne * m_ndim, m_nne * m_ndim}));
 
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+    const auto& dofs = m_topo.dofs();
+
     m_T.clear();
 
     for (size_t e = 0; e < m_nelem; ++e) {
+        size_t r = rows ? rows[e] : e;
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
+                size_t di = dofs(conn(r, m), i);
                 for (size_t n = 0; n < m_nne; ++n) {
                     for (size_t j = 0; j < m_ndim; ++j) {
+                        size_t dj = dofs(conn(r, n), j);
+                        if (m_symmetric && di > dj) {
+                            continue;
+                        }
                         m_T.push_back(Eigen::Triplet<double>(
-                            m_dofs(m_conn(e, m), i),
-                            m_dofs(m_conn(e, n), j),
-                            elemmat(e, m * m_ndim + i, n * m_ndim + j)));
+                            di, dj, elemmat(e, m * m_ndim + i, n * m_ndim + j)));
                     }
                 }
             }
@@ -78,9 +105,177 @@ inline void Matrix::assemble(const xt::xtensor<double, 3>& elemmat)
     }
 
     m_A.setFromTriplets(m_T.begin(), m_T.end());
+    m_shared = false;
     m_changed = true;
 }
 
+inline void Matrix::freeze(
+    const xt::xtensor<size_t, 1>& elem, const xt::xtensor<double, 3>& elemmat)
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemmat, {elem.size(), m_nne * m_ndim, m_nne * m_ndim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+
+    if (!m_pattern) {
+        this->pattern();
+    }
+
+    this->scatter(elem, elemmat, m_A0.valuePtr());
+    this->reset();
+    m_changed = true;
+}
+
+inline void Matrix::assemble(
+    const xt::xtensor<size_t, 1>& elem, const xt::xtensor<double, 3>& elemmat)
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemmat, {elem.size(), m_nne * m_ndim, m_nne * m_ndim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+
+    if (!m_pattern) {
+        this->pattern();
+    }
+
+    this->reset();
+    this->scatter(elem, elemmat, m_A.valuePtr());
+    m_changed = true;
+}
+
+inline void Matrix::reset()
+{
+    // the pattern is fixed: copy only the values
+    if (m_shared) {
+        std::copy(m_A0.valuePtr(), m_A0.valuePtr() + m_A0.nonZeros(), m_A.valuePtr());
+        return;
+    }
+
+    m_A = m_A0;
+    m_shared = true;
+}
+
+inline void Matrix::unfreeze()
+{
+    if (m_pattern) {
+        std::fill(m_A0.valuePtr(), m_A0.valuePtr() + m_A0.nonZeros(), 0.0);
+    }
+}
+
+inline void Matrix::pattern()
+{
+    using StorageIndex = Eigen::SparseMatrix<double, Eigen::RowMajor>::StorageIndex;
+
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+    const auto& dofs = m_topo.dofs();
+
+    m_T.clear();
+
+    for (size_t e = 0; e < m_nelem; ++e) {
+        size_t r = rows ? rows[e] : e;
+        for (size_t m = 0; m < m_nne; ++m) {
+            for (size_t i = 0; i < m_ndim; ++i) {
+                size_t di = dofs(conn(r, m), i);
+                for (size_t n = 0; n < m_nne; ++n) {
+                    for (size_t j = 0; j < m_ndim; ++j) {
+                        size_t dj = dofs(conn(r, n), j);
+                        if (m_symmetric && di > dj) {
+                            continue;
+                        }
+                        m_T.push_back(Eigen::Triplet<double>(di, dj, 0.0));
+                    }
+                }
+            }
+        }
+    }
+
+    m_A0.resize(m_ndof, m_ndof);
+    m_A0.setFromTriplets(m_T.begin(), m_T.end());
+    m_A0.makeCompressed();
+
+    m_T.clear();
+    m_T.shrink_to_fit();
+
+    const StorageIndex* outer = m_A0.outerIndexPtr();
+    const StorageIndex* inner = m_A0.innerIndexPtr();
+    size_t nn = m_nne * m_ndim * m_nne * m_ndim;
+
+    m_index.clear();
+    m_index.reserve(m_nelem * (m_symmetric ? (nn + m_nne * m_ndim) / 2 : nn));
+    m_offset.clear();
+
+    if (m_symmetric) {
+        m_offset.reserve(m_nelem + 1);
+        m_offset.push_back(0);
+    }
+
+    for (size_t e = 0; e < m_nelem; ++e) {
+        size_t r = rows ? rows[e] : e;
+        for (size_t m = 0; m < m_nne; ++m) {
+            for (size_t i = 0; i < m_ndim; ++i) {
+                size_t di = dofs(conn(r, m), i);
+                for (size_t n = 0; n < m_nne; ++n) {
+                    for (size_t j = 0; j < m_ndim; ++j) {
+                        size_t dj = dofs(conn(r, n), j);
+                        if (m_symmetric && di > dj) {
+                            continue;
+                        }
+                        const StorageIndex* col = std::lower_bound(
+                            inner + outer[di],
+                            inner + outer[di + 1],
+                            static_cast<StorageIndex>(dj));
+                        m_index.push_back(static_cast<StorageIndex>(col - inner));
+                    }
+                }
+            }
+        }
+        if (m_symmetric) {
+            m_offset.push_back(m_index.size());
+        }
+    }
+
+    m_pattern = true;
+}
+
+inline void Matrix::scatter(
+    const xt::xtensor<size_t, 1>& elem, const xt::xtensor<double, 3>& elemmat, double* A) const
+{
+    size_t nn = m_nne * m_ndim * m_nne * m_ndim;
+
+    if (!m_symmetric) {
+        for (size_t e = 0; e < elem.size(); ++e) {
+            const StorageIndex* index = &m_index[elem(e) * nn];
+            const double* ke = &elemmat(e, 0, 0);
+            for (size_t k = 0; k < nn; ++k) {
+                A[index[k]] += ke[k];
+            }
+        }
+        return;
+    }
+
+    // skip the lower triangle the same way as "pattern"
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+    const auto& dofs = m_topo.dofs();
+    std::vector<size_t> edofs(m_nne * m_ndim);
+
+    for (size_t e = 0; e < elem.size(); ++e) {
+        size_t r = rows ? rows[elem(e)] : elem(e);
+        for (size_t m = 0; m < m_nne; ++m) {
+            for (size_t i = 0; i < m_ndim; ++i) {
+                edofs[m * m_ndim + i] = dofs(conn(r, m), i);
+            }
+        }
+        const StorageIndex* index = &m_index[m_offset[elem(e)]];
+        const double* ke = &elemmat(e, 0, 0);
+        for (size_t a = 0; a < edofs.size(); ++a) {
+            for (size_t b = 0; b < edofs.size(); ++b) {
+                if (edofs[a] > edofs[b]) {
+                    continue;
+                }
+                A[*index++] += ke[a * edofs.size() + b];
+            }
+        }
+    }
+}
+
 inline void Matrix::set(
     const xt::xtensor<size_t, 1>& rows,
     const xt::xtensor<size_t, 1>& cols,
@@ -95,11 +290,15 @@ inline void Matrix::set(
 
     for (size_t i = 0; i < rows.size(); ++i) {
         for (size_t j = 0; j < cols.size(); ++j) {
+            if (m_symmetric && rows(i) > cols(j)) {
+                continue;
+            }
             T.push_back(Eigen::Triplet<double>(rows(i), cols(j), matrix(i, j)));
         }
     }
 
     m_A.setFromTriplets(T.begin(), T.end());
+    m_shared = false;
     m_changed = true;
 }
 
@@ -115,16 +314,20 @@ inline void Matrix::add(
 
     std::vector<Eigen::Triplet<double>> T;
 
-    Eigen::SparseMatrix<double> A(m_ndof, m_ndof);
+    Eigen::SparseMatrix<double, Eigen::RowMajor> A(m_ndof, m_ndof);
 
     for (size_t i = 0; i < rows.size(); ++i) {
         for (size_t j = 0; j < cols.size(); ++j) {
+            if (m_symmetric && rows(i) > cols(j)) {
+                continue;
+            }
             T.push_back(Eigen::Triplet<double>(rows(i), cols(j), matrix(i, j)));
         }
     }
 
     A.setFromTriplets(T.begin(), T.end());
     m_A += A;
+    m_shared = false;
     m_changed = true;
 }
 
@@ -135,8 +338,11 @@ inline void Matrix::todense(xt::xtensor<double, 2>& ret) const
     ret.fill(0.0);
 
     for (int k = 0; k < m_A.outerSize(); ++k) {
-        for (Eigen::SparseMatrix<double>::InnerIterator it(m_A, k); it; ++it) {
+        for (Eigen::SparseMatrix<double, Eigen::RowMajor>::InnerIterator it(m_A, k); it; ++it) {
             ret(it.row(), it.col()) = it.value();
+            if (m_symmetric) {
+                ret(it.col(), it.row()) = it.value();
+            }
         }
     }
 }
@@ -152,7 +358,18 @@ inline void Matrix::dot(const xt::xtensor<double, 2>& x, xt::xtensor<double, 2>&
 {
     GOOSEFEM_ASSERT(xt::has_shape(b, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(x, {m_nnode, m_ndim}));
-    this->asNode(m_A * this->AsDofs(x), b);
+
+    Eigen::VectorXd X = this->AsDofs(x);
+    Eigen::VectorXd B(m_ndof);
+
+    if (m_symmetric) {
+        B.noalias() = m_A.selfadjointView<Eigen::Upper>() * X;
+    }
+    else {
+        detail::spmv(m_A, X.data(), B.data());
+    }
+
+    this->asNode(B, b);
 }
 
 inline void Matrix::dot(const xt::xtensor<double, 1>& x, xt::xtensor<double, 1>& b) const
@@ -160,8 +377,35 @@ inline void Matrix::dot(const xt::xtensor<double, 1>& x, xt::xtensor<double, 1>&
     GOOSEFEM_ASSERT(b.size() == m_ndof);
     GOOSEFEM_ASSERT(x.size() == m_ndof);
 
-    Eigen::Map<Eigen::VectorXd>(b.data(), b.size()).noalias() =
-        m_A * Eigen::Map<const Eigen::VectorXd>(x.data(), x.size());
+    if (m_symmetric) {
+        Eigen::Map<const Eigen::VectorXd> X(x.data(), x.size());
+        Eigen::Map<Eigen::VectorXd> B(b.data(), b.size());
+        B.noalias() = m_A.selfadjointView<Eigen::Upper>() * X;
+    }
+    else {
+        detail::spmv(m_A, x.data(), b.data());
+    }
+}
+
+inline void Matrix::residual(
+    const xt::xtensor<double, 1>& x,
+    const xt::xtensor<double, 1>& b,
+    xt::xtensor<double, 1>& r) const
+{
+    GOOSEFEM_ASSERT(x.size() == m_ndof);
+    GOOSEFEM_ASSERT(b.size() == m_ndof);
+    GOOSEFEM_ASSERT(r.size() == m_ndof);
+
+    if (m_symmetric) {
+        Eigen::Map<const Eigen::VectorXd> X(x.data(), x.size());
+        Eigen::Map<const Eigen::VectorXd> B(b.data(), b.size());
+        Eigen::Map<Eigen::VectorXd> R(r.data(), r.size());
+        R = B;
+        R.noalias() -= m_A.selfadjointView<Eigen::Upper>() * X;
+    }
+    else {
+        detail::residual(m_A, x.data(), b.data(), r.data());
+    }
 }
 
 inline xt::xtensor<double, 2> Matrix::Dot(const xt::xtensor<double, 2>& x) const
@@ -178,16 +422,26 @@ inline xt::xtensor<double, 1> Matrix::Dot(const xt::xtensor<double, 1>& x) const
     return b;
 }
 
+inline xt::xtensor<double, 1>
+Matrix::Residual(const xt::xtensor<double, 1>& x, const xt::xtensor<double, 1>& b) const
+{
+    xt::xtensor<double, 1> r = xt::empty<double>({m_ndof});
+    this->residual(x, b, r);
+    return r;
+}
+
 inline Eigen::VectorXd Matrix::AsDofs(const xt::xtensor<double, 2>& nodevec) const
 {
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
+    const auto& dofs = m_topo.dofs();
+
     Eigen::VectorXd dofval = Eigen::VectorXd::Zero(m_ndof, 1);
 
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            dofval(m_dofs(m, i)) = nodevec(m, i);
+            dofval(dofs(m, i)) = nodevec(m, i);
         }
     }
 
@@ -199,21 +453,29 @@ inline void Matrix::asNode(const Eigen::VectorXd& dofval, xt::xtensor<double, 2>
     GOOSEFEM_ASSERT(static_cast<size_t>(dofval.size()) == m_ndof);
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
+    const auto& dofs = m_topo.dofs();
+
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            nodevec(m, i) = dofval(m_dofs(m, i));
+            nodevec(m, i) = dofval(dofs(m, i));
         }
     }
 }
 
+template <class Solver>
+inline Solver& MatrixSolver<Solver>::solver()
+{
+    return m_solver;
+}
+
 template <class Solver>
 inline void MatrixSolver<Solver>::factorize(Matrix& matrix)
 {
     if (!matrix.m_changed && !m_factor) {
         return;
     }
-    m_solver.compute(matrix.m_A);
+    m_solver.compute(m_colmajor.update(matrix.m_A));
     m_factor = false;
     matrix.m_changed = false;
 }
@@ -240,6 +502,40 @@ inline void MatrixSolver<Solver>::solve(
         Eigen::Map<const Eigen::VectorXd>(b.data(), matrix.m_ndof));
 }
 
+template <class Solver>
+inline void MatrixSolver<Solver>::solve(
+    Matrix& matrix, const xt::xtensor<double, 3>& b, xt::xtensor<double, 3>& x)
+{
+    size_t nrhs = b.shape(0);
+
+    GOOSEFEM_ASSERT(xt::has_shape(b, {nrhs, matrix.m_nnode, matrix.m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(x, {nrhs, matrix.m_nnode, matrix.m_ndim}));
+
+    const auto& dofs = matrix.m_topo.dofs();
+
+    this->factorize(matrix);
+
+    Eigen::MatrixXd B = Eigen::MatrixXd::Zero(matrix.m_ndof, nrhs);
+
+    for (size_t r = 0; r < nrhs; ++r) {
+        for (size_t m = 0; m < matrix.m_nnode; ++m) {
+            for (size_t i = 0; i < matrix.m_ndim; ++i) {
+                B(dofs(m, i), r) = b(r, m, i);
+            }
+        }
+    }
+
+    Eigen::MatrixXd X = m_solver.solve(B);
+
+    for (size_t r = 0; r < nrhs; ++r) {
+        for (size_t m = 0; m < matrix.m_nnode; ++m) {
+            for (size_t i = 0; i < matrix.m_ndim; ++i) {
+                x(r, m, i) = X(dofs(m, i), r);
+            }
+        }
+    }
+}
+
 template <class Solver>
 inline xt::xtensor<double, 2>
 MatrixSolver<Solver>::Solve(Matrix& matrix, const xt::xtensor<double, 2>& b)
@@ -258,6 +554,15 @@ MatrixSolver<Solver>::Solve(Matrix& matrix, const xt::xtensor<double, 1>& b)
     return x;
 }
 
+template <class Solver>
+inline xt::xtensor<double, 3>
+MatrixSolver<Solver>::Solve(Matrix& matrix, const xt::xtensor<double, 3>& b)
+{
+    xt::xtensor<double, 3> x = xt::empty<double>({b.shape(0), matrix.m_nnode, matrix.m_ndim});
+    this->solve(matrix, b, x);
+    return x;
+}
+
 } // namespace GooseFEM
 
 #endif
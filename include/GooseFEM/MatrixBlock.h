@@ -0,0 +1,90 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_MATRIXBLOCK_H
+#define GOOSEFEM_MATRIXBLOCK_H
+
+#include "config.h"
+#include "Allocate.h"
+#include "Topology.h"
+
+namespace GooseFEM {
+
+/*
+  Sparse matrix in block-CSR storage by node: one dense [N, N] block (N = ndim) is stored for each
+  pair of nodes that share an element, with one column index per block. The sparsity pattern is
+  fixed at construction, such that assembly is a scatter without any sorting or searching.
+  Requires one DOF per node and direction (i.e. no DOFs shared between nodes).
+*/
+
+template <size_t N>
+class MatrixBlock {
+public:
+    // Constructors
+    MatrixBlock() = default;
+    MatrixBlock(const xt::xtensor<size_t, 2>& conn, const xt::xtensor<size_t, 2>& dofs);
+    MatrixBlock(const Topology& topology); // shares data (no copy)
+
+    // Dimensions
+    size_t nelem() const; // number of elements
+    size_t nne() const;   // number of nodes per element
+    size_t nnode() const; // number of nodes
+    size_t ndim() const;  // number of dimensions (== N)
+    size_t ndof() const;  // number of DOFs
+    size_t nblock() const; // number of stored blocks
+
+    // Connectivity and DOF lists
+    const Topology& topology() const;
+    const xt::xtensor<size_t, 2>& conn() const; // connectivity
+    const xt::xtensor<size_t, 2>& dofs() const; // DOFs
+
+    // Assemble from matrices stored per element [nelem, nne*ndim, nne*ndim]
+    void assemble(const xt::xtensor<double, 3>& elemmat);
+
+    // Return as dense matrix
+    void todense(xt::xtensor<double, 2>& ret) const;
+
+    // Return the diagonal blocks [nnode, N, N] (e.g. for a block-Jacobi preconditioner)
+    void todiagonal(xt::xtensor<double, 3>& ret) const;
+
+    // Dot-product:
+    // b_i = A_ij * x_j
+    void dot(const xt::xtensor<double, 2>& x, xt::xtensor<double, 2>& b) const;
+    void dot(const xt::xtensor<double, 1>& x, xt::xtensor<double, 1>& b) const;
+
+    // Auto-allocation of the functions above
+    xt::xtensor<double, 2> Todense() const;
+    xt::xtensor<double, 3> Todiagonal() const;
+    xt::xtensor<double, 2> Dot(const xt::xtensor<double, 2>& x) const;
+    xt::xtensor<double, 1> Dot(const xt::xtensor<double, 1>& x) const;
+
+private:
+    // The matrix: blocks of row-node "m" are "m_A(k)" with column-node "m_col(k)",
+    // for "m_ptr(m) <= k < m_ptr(m + 1)"
+    xt::xtensor<size_t, 1> m_ptr;  // [nnode + 1]
+    xt::xtensor<size_t, 1> m_col;  // [nblock]
+    xt::xtensor<size_t, 1> m_diag; // diagonal block per node [nnode]
+    xt::xtensor<double, 3> m_A;    // [nblock, N, N]
+
+    // Block of each pair of nodes of each element [nelem, nne, nne]
+    xt::xtensor<size_t, 3> m_elem_block;
+
+    // Bookkeeping: connectivity [nelem, nne] and DOF-numbers per node [nnode, ndim]
+    Topology m_topo;
+
+    // Dimensions
+    size_t m_nelem; // number of elements
+    size_t m_nne;   // number of nodes per element
+    size_t m_nnode; // number of nodes
+    size_t m_ndof;  // number of DOFs
+    size_t m_nblock; // number of stored blocks
+};
+
+} // namespace GooseFEM
+
+#include "MatrixBlock.hpp"
+
+#endif
@@ -0,0 +1,298 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_MATRIXBLOCK_HPP
+#define GOOSEFEM_MATRIXBLOCK_HPP
+
+#include "MatrixBlock.h"
+
+namespace GooseFEM {
+
+template <size_t N>
+inline MatrixBlock<N>::MatrixBlock(
+    const xt::xtensor<size_t, 2>& conn, const xt::xtensor<size_t, 2>& dofs)
+    : MatrixBlock(Topology(conn, dofs))
+{
+}
+
+template <size_t N>
+inline MatrixBlock<N>::MatrixBlock(const Topology& topology) : m_topo(topology)
+{
+    m_nelem = m_topo.nelem();
+    m_nne = m_topo.nne();
+    m_nnode = m_topo.nnode();
+    m_ndof = m_topo.ndof();
+
+    GOOSEFEM_ASSERT(m_topo.ndim() == N);
+    GOOSEFEM_ASSERT(m_ndof == m_nnode * N);
+
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+
+    // sparsity pattern: nodes that share an element (the diagonal is always stored)
+
+    std::vector<std::vector<size_t>> nodes(m_nnode);
+
+    for (size_t m = 0; m < m_nnode; ++m) {
+        nodes[m].push_back(m);
+    }
+
+    for (size_t e = 0; e < m_nelem; ++e) {
+        size_t r = rows ? rows[e] : e;
+        for (size_t m = 0; m < m_nne; ++m) {
+            for (size_t n = 0; n < m_nne; ++n) {
+                nodes[conn(r, m)].push_back(conn(r, n));
+            }
+        }
+    }
+
+    m_ptr = xt::empty<size_t>({m_nnode + 1});
+    m_ptr(0) = 0;
+
+    for (size_t m = 0; m < m_nnode; ++m) {
+        std::sort(nodes[m].begin(), nodes[m].end());
+        nodes[m].erase(std::unique(nodes[m].begin(), nodes[m].end()), nodes[m].end());
+        m_ptr(m + 1) = m_ptr(m) + nodes[m].size();
+    }
+
+    m_nblock = m_ptr(m_nnode);
+    m_col = xt::empty<size_t>({m_nblock});
+    m_diag = xt::empty<size_t>({m_nnode});
+
+    for (size_t m = 0; m < m_nnode; ++m) {
+        std::copy(nodes[m].begin(), nodes[m].end(), m_col.begin() + m_ptr(m));
+        m_diag(m) = m_ptr(m) + static_cast<size_t>(
+            std::lower_bound(nodes[m].begin(), nodes[m].end(), m) - nodes[m].begin());
+    }
+
+    // position of the blocks of each element
+
+    m_elem_block = xt::empty<size_t>({m_nelem, m_nne, m_nne});
+
+    for (size_t e = 0; e < m_nelem; ++e) {
+        size_t re = rows ? rows[e] : e;
+        for (size_t m = 0; m < m_nne; ++m) {
+            size_t r = conn(re, m);
+            auto first = m_col.begin() + m_ptr(r);
+            auto last = m_col.begin() + m_ptr(r + 1);
+            for (size_t n = 0; n < m_nne; ++n) {
+                auto k = std::lower_bound(first, last, conn(re, n)) - m_col.begin();
+                m_elem_block(e, m, n) = static_cast<size_t>(k);
+            }
+        }
+    }
+
+    m_A = xt::empty<double>({m_nblock, N, N});
+    GooseFEM::firstTouch(m_A, 0.0);
+}
+
+template <size_t N>
+inline size_t MatrixBlock<N>::nelem() const
+{
+    return m_nelem;
+}
+
+template <size_t N>
+inline size_t MatrixBlock<N>::nne() const
+{
+    return m_nne;
+}
+
+template <size_t N>
+inline size_t MatrixBlock<N>::nnode() const
+{
+    return m_nnode;
+}
+
+template <size_t N>
+inline size_t MatrixBlock<N>::ndim() const
+{
+    return N;
+}
+
+template <size_t N>
+inline size_t MatrixBlock<N>::ndof() const
+{
+    return m_ndof;
+}
+
+template <size_t N>
+inline size_t MatrixBlock<N>::nblock() const
+{
+    return m_nblock;
+}
+
+template <size_t N>
+inline const Topology& MatrixBlock<N>::topology() const
+{
+    return m_topo;
+}
+
+template <size_t N>
+inline const xt::xtensor<size_t, 2>& MatrixBlock<N>::conn() const
+{
+    return m_topo.conn();
+}
+
+template <size_t N>
+inline const xt::xtensor<size_t, 2>& MatrixBlock<N>::dofs() const
+{
+    return m_topo.dofs();
+}
+
+template <size_t N>
+inline void MatrixBlock<N>::assemble(const xt::xtensor<double, 3>& elemmat)
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemmat, {m_nelem, m_nne * N, m_nne * N}));
+
+    m_A.fill(0.0);
+
+    for (size_t e = 0; e < m_nelem; ++e) {
+        for (size_t m = 0; m < m_nne; ++m) {
+            for (size_t n = 0; n < m_nne; ++n) {
+                size_t k = m_elem_block(e, m, n);
+                for (size_t i = 0; i < N; ++i) {
+                    for (size_t j = 0; j < N; ++j) {
+                        m_A(k, i, j) += elemmat(e, m * N + i, n * N + j);
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <size_t N>
+inline void MatrixBlock<N>::todense(xt::xtensor<double, 2>& ret) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(ret, {m_ndof, m_ndof}));
+
+    const auto& dofs = m_topo.dofs();
+
+    ret.fill(0.0);
+
+    for (size_t m = 0; m < m_nnode; ++m) {
+        for (size_t k = m_ptr(m); k < m_ptr(m + 1); ++k) {
+            for (size_t i = 0; i < N; ++i) {
+                for (size_t j = 0; j < N; ++j) {
+                    ret(dofs(m, i), dofs(m_col(k), j)) = m_A(k, i, j);
+                }
+            }
+        }
+    }
+}
+
+template <size_t N>
+inline void MatrixBlock<N>::todiagonal(xt::xtensor<double, 3>& ret) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(ret, {m_nnode, N, N}));
+
+    #pragma omp parallel for schedule(static)
+    for (size_t m = 0; m < m_nnode; ++m) {
+        for (size_t i = 0; i < N; ++i) {
+            for (size_t j = 0; j < N; ++j) {
+                ret(m, i, j) = m_A(m_diag(m), i, j);
+            }
+        }
+    }
+}
+
+template <size_t N>
+inline void MatrixBlock<N>::dot(const xt::xtensor<double, 2>& x, xt::xtensor<double, 2>& b) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(b, {m_nnode, N}));
+    GOOSEFEM_ASSERT(xt::has_shape(x, {m_nnode, N}));
+
+    const double* A = m_A.data();
+    const double* X = x.data();
+
+    #pragma omp parallel for schedule(static)
+    for (size_t m = 0; m < m_nnode; ++m) {
+
+        std::array<double, N> bm;
+        bm.fill(0.0);
+
+        for (size_t k = m_ptr(m); k < m_ptr(m + 1); ++k) {
+            const double* a = A + k * N * N;
+            const double* xn = X + m_col(k) * N;
+            for (size_t i = 0; i < N; ++i) {
+                for (size_t j = 0; j < N; ++j) {
+                    bm[i] += a[i * N + j] * xn[j];
+                }
+            }
+        }
+
+        for (size_t i = 0; i < N; ++i) {
+            b(m, i) = bm[i];
+        }
+    }
+}
+
+template <size_t N>
+inline void MatrixBlock<N>::dot(const xt::xtensor<double, 1>& x, xt::xtensor<double, 1>& b) const
+{
+    GOOSEFEM_ASSERT(b.size() == m_ndof);
+    GOOSEFEM_ASSERT(x.size() == m_ndof);
+
+    const auto& dofs = m_topo.dofs();
+    const double* A = m_A.data();
+
+    #pragma omp parallel for schedule(static)
+    for (size_t m = 0; m < m_nnode; ++m) {
+
+        std::array<double, N> bm;
+        bm.fill(0.0);
+
+        for (size_t k = m_ptr(m); k < m_ptr(m + 1); ++k) {
+            const double* a = A + k * N * N;
+            size_t n = m_col(k);
+            for (size_t i = 0; i < N; ++i) {
+                for (size_t j = 0; j < N; ++j) {
+                    bm[i] += a[i * N + j] * x(dofs(n, j));
+                }
+            }
+        }
+
+        for (size_t i = 0; i < N; ++i) {
+            b(dofs(m, i)) = bm[i];
+        }
+    }
+}
+
+template <size_t N>
+inline xt::xtensor<double, 2> MatrixBlock<N>::Todense() const
+{
+    xt::xtensor<double, 2> ret = xt::empty<double>({m_ndof, m_ndof});
+    this->todense(ret);
+    return ret;
+}
+
+template <size_t N>
+inline xt::xtensor<double, 3> MatrixBlock<N>::Todiagonal() const
+{
+    xt::xtensor<double, 3> ret = xt::empty<double>({m_nnode, N, N});
+    this->todiagonal(ret);
+    return ret;
+}
+
+template <size_t N>
+inline xt::xtensor<double, 2> MatrixBlock<N>::Dot(const xt::xtensor<double, 2>& x) const
+{
+    xt::xtensor<double, 2> b = xt::empty<double>({m_nnode, N});
+    this->dot(x, b);
+    return b;
+}
+
+template <size_t N>
+inline xt::xtensor<double, 1> MatrixBlock<N>::Dot(const xt::xtensor<double, 1>& x) const
+{
+    xt::xtensor<double, 1> b = xt::empty<double>({m_ndof});
+    this->dot(x, b);
+    return b;
+}
+
+} // namespace GooseFEM
+
+#endif
@@ -8,6 +8,7 @@
 #define GOOSEFEM_MATRIXDIAGONAL_H
 
 #include "config.h"
+#include "Topology.h"
 
 namespace GooseFEM {
 
@@ -16,6 +17,7 @@ public:
     // Constructors
     MatrixDiagonal() = default;
     MatrixDiagonal(const xt::xtensor<size_t, 2>& conn, const xt::xtensor<size_t, 2>& dofs);
+    MatrixDiagonal(const Topology& topology); // shares data (no copy)
 
     // Dimensions
     size_t nelem() const; // number of elements
@@ -24,8 +26,10 @@ public:
     size_t ndim() const;  // number of dimensions
     size_t ndof() const;  // number of DOFs
 
-    // DOF lists
-    xt::xtensor<size_t, 2> dofs() const; // DOFs
+    // Connectivity and DOF lists
+    const Topology& topology() const;
+    const xt::xtensor<size_t, 2>& conn() const; // connectivity
+    const xt::xtensor<size_t, 2>& dofs() const; // DOFs
 
     // Set matrix components
     void set(const xt::xtensor<double, 1>& A);
@@ -61,9 +65,8 @@ private:
     // Signal changes to data compare to the last inverse
     bool m_factor = true;
 
-    // Bookkeeping
-    xt::xtensor<size_t, 2> m_conn; // connectivity [nelem, nne]
-    xt::xtensor<size_t, 2> m_dofs; // DOF-numbers per node [nnode, ndim]
+    // Bookkeeping: connectivity [nelem, nne] and DOF-numbers per node [nnode, ndim]
+    Topology m_topo;
 
     // Dimensions
     size_t m_nelem; // number of elements
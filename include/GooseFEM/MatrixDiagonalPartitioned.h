@@ -8,6 +8,7 @@
 #define GOOSEFEM_MATRIXDIAGONALPARTITIONED_H
 
 #include "config.h"
+#include "Topology.h"
 
 namespace GooseFEM {
 
@@ -21,6 +22,8 @@ public:
         const xt::xtensor<size_t, 2>& dofs,
         const xt::xtensor<size_t, 1>& iip);
 
+    MatrixDiagonalPartitioned(const Topology& topology); // shares data (no copy)
+
     // Dimensions
     size_t nelem() const; // number of elements
     size_t nne() const;   // number of nodes per element
@@ -30,10 +33,12 @@ public:
     size_t nnu() const;   // number of unknown DOFs
     size_t nnp() const;   // number of prescribed DOFs
 
-    // DOF lists
-    xt::xtensor<size_t, 2> dofs() const; // DOFs
-    xt::xtensor<size_t, 1> iiu() const;  // unknown DOFs
-    xt::xtensor<size_t, 1> iip() const;  // prescribed DOFs
+    // Connectivity and DOF lists
+    const Topology& topology() const;
+    const xt::xtensor<size_t, 2>& conn() const; // connectivity
+    const xt::xtensor<size_t, 2>& dofs() const; // DOFs
+    const xt::xtensor<size_t, 1>& iiu() const; // unknown DOFs
+    const xt::xtensor<size_t, 1>& iip() const; // prescribed DOFs
 
     // Assemble from matrices stored per element [nelem, nne*ndim, nne*ndim]
     // WARNING: ignores any off-diagonal terms
@@ -115,12 +120,8 @@ private:
     // Signal changes to data compare to the last inverse
     bool m_factor = true;
 
-    // Bookkeeping
-    xt::xtensor<size_t, 2> m_conn; // connectivity                      [nelem, nne ]
-    xt::xtensor<size_t, 2> m_dofs; // DOF-numbers per node              [nnode, ndim]
-    xt::xtensor<size_t, 2> m_part; // DOF-numbers per node, renumbered  [nnode, ndim]
-    xt::xtensor<size_t, 1> m_iiu;  // DOF-numbers that are unknown      [nnu]
-    xt::xtensor<size_t, 1> m_iip;  // DOF-numbers that are prescribed   [nnp]
+    // Bookkeeping: connectivity, DOF-numbers per node, partitioning in unknown/prescribed DOFs
+    Topology m_topo;
 
     // Dimensions
     size_t m_nelem; // number of elements
@@ -8,7 +8,6 @@
 #define GOOSEFEM_MATRIXDIAGONALPARTITIONED_HPP
 
 #include "MatrixDiagonalPartitioned.h"
-#include "Mesh.h"
 
 namespace GooseFEM {
 
@@ -16,24 +15,24 @@ inline MatrixDiagonalPartitioned::MatrixDiagonalPartitioned(
     const xt::xtensor<size_t, 2>& conn,
     const xt::xtensor<size_t, 2>& dofs,
     const xt::xtensor<size_t, 1>& iip)
-    : m_conn(conn), m_dofs(dofs), m_iip(iip)
-{
-    m_nelem = m_conn.shape(0);
-    m_nne = m_conn.shape(1);
-    m_nnode = m_dofs.shape(0);
-    m_ndim = m_dofs.shape(1);
-    m_iiu = xt::setdiff1d(dofs, iip);
-    m_ndof = xt::amax(m_dofs)() + 1;
-    m_nnp = m_iip.size();
-    m_nnu = m_iiu.size();
-    m_part = Mesh::Reorder({m_iiu, m_iip}).get(m_dofs);
+    : MatrixDiagonalPartitioned(Topology(conn, dofs, iip))
+{
+}
+
+inline MatrixDiagonalPartitioned::MatrixDiagonalPartitioned(const Topology& topology) : m_topo(topology)
+{
+    GOOSEFEM_ASSERT(m_topo.isPartitioned());
+
+    m_nelem = m_topo.nelem();
+    m_nne = m_topo.nne();
+    m_nnode = m_topo.nnode();
+    m_ndim = m_topo.ndim();
+    m_ndof = m_topo.ndof();
+    m_nnu = m_topo.nnu();
+    m_nnp = m_topo.nnp();
     m_Auu = xt::empty<double>({m_nnu});
     m_App = xt::empty<double>({m_nnp});
     m_inv_uu = xt::empty<double>({m_nnu});
-
-    GOOSEFEM_ASSERT(xt::amax(m_conn)() + 1 <= m_nnode);
-    GOOSEFEM_ASSERT(xt::amax(m_iip)() <= xt::amax(m_dofs)());
-    GOOSEFEM_ASSERT(m_ndof <= m_nnode * m_ndim);
 }
 
 inline size_t MatrixDiagonalPartitioned::nelem() const
@@ -71,19 +70,29 @@ inline size_t MatrixDiagonalPartitioned::nnp() const
     return m_nnp;
 }
 
-inline xt::xtensor<size_t, 2> MatrixDiagonalPartitioned::dofs() const
+inline const Topology& MatrixDiagonalPartitioned::topology() const
+{
+    return m_topo;
+}
+
+inline const xt::xtensor<size_t, 2>& MatrixDiagonalPartitioned::conn() const
+{
+    return m_topo.conn();
+}
+
+inline const xt::xtensor<size_t, 2>& MatrixDiagonalPartitioned::dofs() const
 {
-    return m_dofs;
+    return m_topo.dofs();
 }
 
-inline xt::xtensor<size_t, 1> MatrixDiagonalPartitioned::iiu() const
+inline const xt::xtensor<size_t, 1>& MatrixDiagonalPartitioned::iiu() const
 {
-    return m_iiu;
+    return m_topo.iiu();
 }
 
-inline xt::xtensor<size_t, 1> MatrixDiagonalPartitioned::iip() const
+inline const xt::xtensor<size_t, 1>& MatrixDiagonalPartitioned::iip() const
 {
-    return m_iip;
+    return m_topo.iip();
 }
 
 inline void MatrixDiagonalPartitioned::factorize()
@@ -105,14 +114,19 @@ inline void MatrixDiagonalPartitioned::assemble(const xt::xtensor<double, 3>& el
     GOOSEFEM_ASSERT(xt::has_shape(elemmat, {m_nelem, m_nne * m_ndim, m_nne * m_ndim}));
     GOOSEFEM_ASSERT(Element::isDiagonal(elemmat));
 
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+    const auto& part = m_topo.part();
+
     m_Auu.fill(0.0);
     m_App.fill(0.0);
 
     for (size_t e = 0; e < m_nelem; ++e) {
+        size_t r = rows ? rows[e] : e;
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
 
-                size_t d = m_part(m_conn(e, m), i);
+                size_t d = part(conn(r, m), i);
 
                 if (d < m_nnu) {
                     m_Auu(d) += elemmat(e, m * m_ndim + i, m * m_ndim + i);
@@ -133,11 +147,13 @@ MatrixDiagonalPartitioned::dot(const xt::xtensor<double, 2>& x, xt::xtensor<doub
     GOOSEFEM_ASSERT(xt::has_shape(x, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(b, {m_nnode, m_ndim}));
 
+    const auto& part = m_topo.part();
+
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
 
-            size_t d = m_part(m, i);
+            size_t d = part(m, i);
 
             if (d < m_nnu) {
                 b(m, i) = m_Auu(d) * x(m, i);
@@ -155,14 +171,17 @@ MatrixDiagonalPartitioned::dot(const xt::xtensor<double, 1>& x, xt::xtensor<doub
     GOOSEFEM_ASSERT(x.size() == m_ndof);
     GOOSEFEM_ASSERT(b.size() == m_ndof);
 
+    const auto& iiu = m_topo.iiu();
+    const auto& iip = m_topo.iip();
+
     #pragma omp parallel for
     for (size_t d = 0; d < m_nnu; ++d) {
-        b(m_iiu(d)) = m_Auu(d) * x(m_iiu(d));
+        b(iiu(d)) = m_Auu(d) * x(iiu(d));
     }
 
     #pragma omp parallel for
     for (size_t d = 0; d < m_nnp; ++d) {
-        b(m_iip(d)) = m_App(d) * x(m_iip(d));
+        b(iip(d)) = m_App(d) * x(iip(d));
     }
 }
 
@@ -206,13 +225,15 @@ MatrixDiagonalPartitioned::solve(const xt::xtensor<double, 2>& b, xt::xtensor<do
     GOOSEFEM_ASSERT(xt::has_shape(b, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(x, {m_nnode, m_ndim}));
 
+    const auto& part = m_topo.part();
+
     this->factorize();
 
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_part(m, i) < m_nnu) {
-                x(m, i) = m_inv_uu(m_part(m, i)) * b(m, i);
+            if (part(m, i) < m_nnu) {
+                x(m, i) = m_inv_uu(part(m, i)) * b(m, i);
             }
         }
     }
@@ -224,11 +245,13 @@ MatrixDiagonalPartitioned::solve(const xt::xtensor<double, 1>& b, xt::xtensor<do
     GOOSEFEM_ASSERT(b.size() == m_ndof);
     GOOSEFEM_ASSERT(x.size() == m_ndof);
 
+    const auto& iiu = m_topo.iiu();
+
     this->factorize();
 
     #pragma omp parallel for
     for (size_t d = 0; d < m_nnu; ++d) {
-        x(m_iiu(d)) = m_inv_uu(d) * b(m_iiu(d));
+        x(iiu(d)) = m_inv_uu(d) * b(iiu(d));
     }
 }
 
@@ -257,11 +280,13 @@ inline void MatrixDiagonalPartitioned::reaction(
     GOOSEFEM_ASSERT(xt::has_shape(x, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(b, {m_nnode, m_ndim}));
 
+    const auto& part = m_topo.part();
+
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_part(m, i) >= m_nnu) {
-                b(m, i) = m_App(m_part(m, i) - m_nnu) * x(m, i);
+            if (part(m, i) >= m_nnu) {
+                b(m, i) = m_App(part(m, i) - m_nnu) * x(m, i);
             }
         }
     }
@@ -273,9 +298,11 @@ inline void MatrixDiagonalPartitioned::reaction(
     GOOSEFEM_ASSERT(x.size() == m_ndof);
     GOOSEFEM_ASSERT(b.size() == m_ndof);
 
+    const auto& iip = m_topo.iip();
+
     #pragma omp parallel for
     for (size_t d = 0; d < m_nnp; ++d) {
-        b(m_iip(d)) = m_App(d) * x(m_iip(d));
+        b(iip(d)) = m_App(d) * x(iip(d));
     }
 }
 
@@ -298,16 +325,19 @@ inline void MatrixDiagonalPartitioned::reaction_p(
 
 inline xt::xtensor<double, 1> MatrixDiagonalPartitioned::Todiagonal() const
 {
+    const auto& iiu = m_topo.iiu();
+    const auto& iip = m_topo.iip();
+
     xt::xtensor<double, 1> ret = xt::zeros<double>({m_ndof});
 
     #pragma omp parallel for
     for (size_t d = 0; d < m_nnu; ++d) {
-        ret(m_iiu(d)) = m_Auu(d);
+        ret(iiu(d)) = m_Auu(d);
     }
 
     #pragma omp parallel for
     for (size_t d = 0; d < m_nnp; ++d) {
-        ret(m_iip(d)) = m_App(d);
+        ret(iip(d)) = m_App(d);
     }
 
     return ret;
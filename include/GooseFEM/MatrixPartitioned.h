@@ -8,6 +8,9 @@
 #define GOOSEFEM_MATRIXPARTITIONED_H
 
 #include "config.h"
+#include "LinearSolver.h"
+#include "SparseMatrix.h"
+#include "Topology.h"
 
 #include <Eigen/Eigen>
 #include <Eigen/Sparse>
@@ -21,12 +24,17 @@ template <class> class MatrixPartitionedSolver;
 class MatrixPartitioned {
 public:
     // Constructors
+    // "symmetric = true": store (and assemble) only the upper triangles of "A_uu" and "A_pp",
+    // and "A_up" (not "A_pu"), requires a symmetric solver (e.g. any policy in "LinearSolver")
     MatrixPartitioned() = default;
 
     MatrixPartitioned(
         const xt::xtensor<size_t, 2>& conn,
         const xt::xtensor<size_t, 2>& dofs,
-        const xt::xtensor<size_t, 1>& iip);
+        const xt::xtensor<size_t, 1>& iip,
+        bool symmetric = false);
+
+    MatrixPartitioned(const Topology& topology, bool symmetric = false); // shares data (no copy)
 
     // Dimensions
     size_t nelem() const; // number of elements
@@ -37,15 +45,21 @@ public:
     size_t nnu() const;   // number of unknown DOFs
     size_t nnp() const;   // number of prescribed DOFs
 
-    // DOF lists
-    xt::xtensor<size_t, 2> dofs() const; // DOFs
-    xt::xtensor<size_t, 1> iiu() const;  // unknown DOFs
-    xt::xtensor<size_t, 1> iip() const;  // prescribed DOFs
+    // Storage
+    bool symmetric() const; // only one triangle is stored
+
+    // Connectivity and DOF lists
+    const Topology& topology() const;
+    const xt::xtensor<size_t, 2>& conn() const; // connectivity
+    const xt::xtensor<size_t, 2>& dofs() const; // DOFs
+    const xt::xtensor<size_t, 1>& iiu() const; // unknown DOFs
+    const xt::xtensor<size_t, 1>& iip() const; // prescribed DOFs
 
     // Assemble from matrices stored per element [nelem, nne*ndim, nne*ndim]
     void assemble(const xt::xtensor<double, 3>& elemmat);
 
     // Overwrite with a dense (sub-) matrix
+    // (in symmetric mode the input is assumed symmetric: its lower triangle is ignored)
     void set(
         const xt::xtensor<size_t, 1>& rows,
         const xt::xtensor<size_t, 1>& cols,
@@ -65,6 +79,21 @@ public:
     void dot(const xt::xtensor<double, 2>& x, xt::xtensor<double, 2>& b) const;
     void dot(const xt::xtensor<double, 1>& x, xt::xtensor<double, 1>& b) const;
 
+    // Dot-product for the unknown DOFs:
+    // b_u = A_uu * x_u + A_up * x_p
+    void dot_u(
+        const xt::xtensor<double, 1>& x_u,
+        const xt::xtensor<double, 1>& x_p,
+        xt::xtensor<double, 1>& b_u) const;
+
+    // Residual for the unknown DOFs (fused with the dot-product):
+    // r_u = b_u - A_uu * x_u - A_up * x_p
+    void residual_u(
+        const xt::xtensor<double, 1>& x_u,
+        const xt::xtensor<double, 1>& x_p,
+        const xt::xtensor<double, 1>& b_u,
+        xt::xtensor<double, 1>& r_u) const;
+
     // Get right-hand-size for corresponding to the prescribed DOFs:
     // b_p = A_pu * x_u + A_pp * x_p = A_pp * x_p
     void reaction(
@@ -84,6 +113,12 @@ public:
     xt::xtensor<double, 2> Todense() const;
     xt::xtensor<double, 2> Dot(const xt::xtensor<double, 2>& x) const;
     xt::xtensor<double, 1> Dot(const xt::xtensor<double, 1>& x) const;
+    xt::xtensor<double, 1> Dot_u(
+        const xt::xtensor<double, 1>& x_u, const xt::xtensor<double, 1>& x_p) const;
+    xt::xtensor<double, 1> Residual_u(
+        const xt::xtensor<double, 1>& x_u,
+        const xt::xtensor<double, 1>& x_p,
+        const xt::xtensor<double, 1>& b_u) const;
     xt::xtensor<double, 2> Reaction(
         const xt::xtensor<double, 2>& x, const xt::xtensor<double, 2>& b) const;
     xt::xtensor<double, 1> Reaction(
@@ -92,11 +127,12 @@ public:
         const xt::xtensor<double, 1>& x_u, const xt::xtensor<double, 1>& x_p) const;
 
 private:
-    // The matrix
-    Eigen::SparseMatrix<double> m_Auu;
-    Eigen::SparseMatrix<double> m_Aup;
-    Eigen::SparseMatrix<double> m_Apu;
-    Eigen::SparseMatrix<double> m_App;
+    // The matrix (row-major, converted by the solver on factorisation)
+    Eigen::SparseMatrix<double, Eigen::RowMajor> m_Auu;
+    Eigen::SparseMatrix<double, Eigen::RowMajor> m_Aup;
+    Eigen::SparseMatrix<double, Eigen::RowMajor> m_Apu;
+    Eigen::SparseMatrix<double, Eigen::RowMajor> m_App;
+    bool m_symmetric = false; // "m_Auu", "m_App": upper triangle only, "m_Apu": not stored
 
     // Matrix entries
     std::vector<Eigen::Triplet<double>> m_Tuu;
@@ -107,12 +143,8 @@ private:
     // Signal changes to data compare to the last inverse
     bool m_changed = true;
 
-    // Bookkeeping
-    xt::xtensor<size_t, 2> m_conn; // connectivity                      [nelem, nne ]
-    xt::xtensor<size_t, 2> m_dofs; // DOF-numbers per node              [nnode, ndim]
-    xt::xtensor<size_t, 2> m_part; // DOF-numbers per node, renumbered  [nnode, ndim]
-    xt::xtensor<size_t, 1> m_iiu;  // unknown    DOFs                   [nnu]
-    xt::xtensor<size_t, 1> m_iip;  // prescribed DOFs                   [nnp]
+    // Bookkeeping: connectivity, DOF-numbers per node, partitioning in unknown/prescribed DOFs
+    Topology m_topo;
 
     // Dimensions
     size_t m_nelem; // number of elements
@@ -126,6 +158,30 @@ private:
     // grant access to solver class
     template <class> friend class MatrixPartitionedSolver;
 
+    // Sort an entry (in partitioned DOF-numbers) in the triplets of the relevant block,
+    // skipping the entries that are not stored in symmetric mode
+    void push_back(
+        size_t di,
+        size_t dj,
+        double v,
+        std::vector<Eigen::Triplet<double>>& Tuu,
+        std::vector<Eigen::Triplet<double>>& Tup,
+        std::vector<Eigen::Triplet<double>>& Tpu,
+        std::vector<Eigen::Triplet<double>>& Tpp) const;
+
+    // Products per block (parallel over rows, except in symmetric mode):
+    // b_u = A_uu * x_u + A_up * x_p
+    // b_p = A_pu * x_u + A_pp * x_p
+    void prod_u(
+        Eigen::Ref<const Eigen::VectorXd> x_u,
+        Eigen::Ref<const Eigen::VectorXd> x_p,
+        Eigen::Ref<Eigen::VectorXd> b_u) const;
+
+    void prod_p(
+        Eigen::Ref<const Eigen::VectorXd> x_u,
+        Eigen::Ref<const Eigen::VectorXd> x_p,
+        Eigen::Ref<Eigen::VectorXd> b_p) const;
+
     // Convert arrays (Eigen version of VectorPartitioned, which contains public functions)
     Eigen::VectorXd AsDofs_u(const xt::xtensor<double, 1>& dofval) const;
     Eigen::VectorXd AsDofs_u(const xt::xtensor<double, 2>& nodevec) const;
@@ -133,7 +189,7 @@ private:
     Eigen::VectorXd AsDofs_p(const xt::xtensor<double, 2>& nodevec) const;
 };
 
-template <class Solver = Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>>>
+template <class Solver = LinearSolver::Default>
 class MatrixPartitionedSolver {
 public:
     // Constructors
@@ -157,6 +213,27 @@ public:
         const xt::xtensor<double, 1>& x_p,
         xt::xtensor<double, 1>& x_u);
 
+    // Solve for a batch of right-hand-sides, using one blocked forward/backward substitution:
+    // "b", "x": [nrhs, nnode, ndim]; "b_u", "x_p", "x_u": [nrhs, nnu], [nrhs, nnp], [nrhs, nnu]
+    void solve(
+        MatrixPartitioned& matrix,
+        const xt::xtensor<double, 3>& b,
+        xt::xtensor<double, 3>& x); // modified with "x_u"
+
+    void solve_u(
+        MatrixPartitioned& matrix,
+        const xt::xtensor<double, 2>& b_u,
+        const xt::xtensor<double, 2>& x_p,
+        xt::xtensor<double, 2>& x_u);
+
+    // Effective (condensed) stiffness of the prescribed DOFs [nnp, nnp]:
+    // K_pp = A_pp - A_pu * A_uu^-1 * A_up
+    // (solves only for the prescribed DOFs coupled to unknown DOFs: the nonzero columns of A_up)
+    void effective_pp(MatrixPartitioned& matrix, xt::xtensor<double, 2>& K_pp);
+
+    // Underlying solver, e.g. to set the parameters of an iterative solver (before the first solve)
+    Solver& solver();
+
     // Auto-allocation of the functions above
     xt::xtensor<double, 2> Solve(
         MatrixPartitioned& matrix,
@@ -172,10 +249,28 @@ public:
         const xt::xtensor<double, 1>& b_u,
         const xt::xtensor<double, 1>& x_p);
 
+    xt::xtensor<double, 3> Solve(
+        MatrixPartitioned& matrix,
+        const xt::xtensor<double, 3>& b,
+        const xt::xtensor<double, 3>& x);
+
+    xt::xtensor<double, 2> Solve_u(
+        MatrixPartitioned& matrix,
+        const xt::xtensor<double, 2>& b_u,
+        const xt::xtensor<double, 2>& x_p);
+
+    xt::xtensor<double, 2> Effective_pp(MatrixPartitioned& matrix);
+
 private:
     Solver m_solver; // solver
+    detail::ColumnMajor m_colmajor; // column-major copy of the matrix, input of "m_solver"
     bool m_factor = true; // signal to force factorization
     void factorize(MatrixPartitioned& matrix); // compute inverse (evaluated by "solve")
+
+    // Workspace (re-used for each solve)
+    Eigen::VectorXd m_B_u; // [nnu]
+    Eigen::VectorXd m_X_u; // [nnu]
+    Eigen::VectorXd m_X_p; // [nnp]
 };
 
 } // namespace GooseFEM
@@ -8,37 +8,40 @@
 #define GOOSEFEM_MATRIXPARTITIONED_HPP
 
 #include "MatrixPartitioned.h"
-#include "Mesh.h"
 
 namespace GooseFEM {
 
 inline MatrixPartitioned::MatrixPartitioned(
     const xt::xtensor<size_t, 2>& conn,
     const xt::xtensor<size_t, 2>& dofs,
-    const xt::xtensor<size_t, 1>& iip)
-    : m_conn(conn), m_dofs(dofs), m_iip(iip)
-{
-    m_nelem = m_conn.shape(0);
-    m_nne = m_conn.shape(1);
-    m_nnode = m_dofs.shape(0);
-    m_ndim = m_dofs.shape(1);
-    m_iiu = xt::setdiff1d(dofs, iip);
-    m_ndof = xt::amax(m_dofs)() + 1;
-    m_nnp = m_iip.size();
-    m_nnu = m_iiu.size();
-    m_part = Mesh::Reorder({m_iiu, m_iip}).get(m_dofs);
+    const xt::xtensor<size_t, 1>& iip,
+    bool symmetric)
+    : MatrixPartitioned(Topology(conn, dofs, iip), symmetric)
+{
+}
+
+inline MatrixPartitioned::MatrixPartitioned(const Topology& topology, bool symmetric)
+    : m_symmetric(symmetric), m_topo(topology)
+{
+    GOOSEFEM_ASSERT(m_topo.isPartitioned());
+
+    m_nelem = m_topo.nelem();
+    m_nne = m_topo.nne();
+    m_nnode = m_topo.nnode();
+    m_ndim = m_topo.ndim();
+    m_ndof = m_topo.ndof();
+    m_nnu = m_topo.nnu();
+    m_nnp = m_topo.nnp();
     m_Tuu.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
     m_Tup.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
-    m_Tpu.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
     m_Tpp.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
+    if (!m_symmetric) {
+        m_Tpu.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
+    }
     m_Auu.resize(m_nnu, m_nnu);
     m_Aup.resize(m_nnu, m_nnp);
     m_Apu.resize(m_nnp, m_nnu);
     m_App.resize(m_nnp, m_nnp);
-
-    GOOSEFEM_ASSERT(xt::amax(m_conn)() + 1 <= m_nnode);
-    GOOSEFEM_ASSERT(xt::amax(m_iip)() <= xt::amax(m_dofs)());
-    GOOSEFEM_ASSERT(m_ndof <= m_nnode * m_ndim);
 }
 
 inline size_t MatrixPartitioned::nelem() const
@@ -76,59 +79,69 @@ inline size_t MatrixPartitioned::nnp() const
     return m_nnp;
 }
 
-inline xt::xtensor<size_t, 2> MatrixPartitioned::dofs() const
+inline bool MatrixPartitioned::symmetric() const
+{
+    return m_symmetric;
+}
+
+inline const Topology& MatrixPartitioned::topology() const
+{
+    return m_topo;
+}
+
+inline const xt::xtensor<size_t, 2>& MatrixPartitioned::conn() const
 {
-    return m_dofs;
+    return m_topo.conn();
 }
 
-inline xt::xtensor<size_t, 1> MatrixPartitioned::iiu() const
+inline const xt::xtensor<size_t, 2>& MatrixPartitioned::dofs() const
 {
-    return m_iiu;
+    return m_topo.dofs();
 }
 
-inline xt::xtensor<size_t, 1> MatrixPartitioned::iip() const
+inline const xt::xtensor<size_t, 1>& MatrixPartitioned::iiu() const
 {
-    return m_iip;
+    return m_topo.iiu();
+}
+
+inline const xt::xtensor<size_t, 1>& MatrixPartitioned::iip() const
+{
+    return m_topo.iip();
 }
 
 inline void MatrixPartitioned::assemble(const xt::xtensor<double, 3>& elemmat)
 {
     GOOSEFEM_ASSERT(xt::has_shape(elemmat, {m_nelem, m_nne * m_ndim, m_nne * m_ndim}));
 
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+    const auto& part = m_topo.part();
+
     m_Tuu.clear();
     m_Tup.clear();
     m_Tpu.clear();
     m_Tpp.clear();
 
     for (size_t e = 0; e < m_nelem; ++e) {
+        size_t r = rows ? rows[e] : e;
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
 
-                size_t di = m_part(m_conn(e, m), i);
+                size_t di = part(conn(r, m), i);
 
                 for (size_t n = 0; n < m_nne; ++n) {
                     for (size_t j = 0; j < m_ndim; ++j) {
 
-                        size_t dj = m_part(m_conn(e, n), j);
-
-                        if (di < m_nnu && dj < m_nnu) {
-                            m_Tuu.push_back(Eigen::Triplet<double>(
-                                di, dj, elemmat(e, m * m_ndim + i, n * m_ndim + j)));
-                        }
-                        else if (di < m_nnu) {
-                            m_Tup.push_back(Eigen::Triplet<double>(
-                                di, dj - m_nnu, elemmat(e, m * m_ndim + i, n * m_ndim + j)));
-                        }
-                        else if (dj < m_nnu) {
-                            m_Tpu.push_back(Eigen::Triplet<double>(
-                                di - m_nnu, dj, elemmat(e, m * m_ndim + i, n * m_ndim + j)));
-                        }
-                        else {
-                            m_Tpp.push_back(Eigen::Triplet<double>(
-                                di - m_nnu,
-                                dj - m_nnu,
-                                elemmat(e, m * m_ndim + i, n * m_ndim + j)));
-                        }
+                        size_t dj = part(conn(r, n), j);
+
+                        this->push_back(
+                            di,
+                            dj,
+                            elemmat(e, m * m_ndim + i, n * m_ndim + j),
+                            m_Tuu,
+                            m_Tup,
+                            m_Tpu,
+                            m_Tpp);
                     }
                 }
             }
@@ -159,22 +172,7 @@ inline void MatrixPartitioned::set(
 
     for (size_t i = 0; i < rows.size(); ++i) {
         for (size_t j = 0; j < cols.size(); ++j) {
-            size_t di = rows(i);
-            size_t dj = cols(j);
-            double v = matrix(i, j);
-
-            if (di < m_nnu && dj < m_nnu) {
-                Tuu.push_back(Eigen::Triplet<double>(di, dj, v));
-            }
-            else if (di < m_nnu) {
-                Tup.push_back(Eigen::Triplet<double>(di, dj - m_nnu, v));
-            }
-            else if (dj < m_nnu) {
-                Tpu.push_back(Eigen::Triplet<double>(di - m_nnu, dj, v));
-            }
-            else {
-                Tpp.push_back(Eigen::Triplet<double>(di - m_nnu, dj - m_nnu, v));
-            }
+            this->push_back(rows(i), cols(j), matrix(i, j), Tuu, Tup, Tpu, Tpp);
         }
     }
 
@@ -200,29 +198,14 @@ inline void MatrixPartitioned::add(
     std::vector<Eigen::Triplet<double>> Tpu;
     std::vector<Eigen::Triplet<double>> Tpp;
 
-    Eigen::SparseMatrix<double> Auu(m_nnu, m_nnu);
-    Eigen::SparseMatrix<double> Aup(m_nnu, m_nnp);
-    Eigen::SparseMatrix<double> Apu(m_nnp, m_nnu);
-    Eigen::SparseMatrix<double> App(m_nnp, m_nnp);
+    Eigen::SparseMatrix<double, Eigen::RowMajor> Auu(m_nnu, m_nnu);
+    Eigen::SparseMatrix<double, Eigen::RowMajor> Aup(m_nnu, m_nnp);
+    Eigen::SparseMatrix<double, Eigen::RowMajor> Apu(m_nnp, m_nnu);
+    Eigen::SparseMatrix<double, Eigen::RowMajor> App(m_nnp, m_nnp);
 
     for (size_t i = 0; i < rows.size(); ++i) {
         for (size_t j = 0; j < cols.size(); ++j) {
-            size_t di = rows(i);
-            size_t dj = cols(j);
-            double v = matrix(i, j);
-
-            if (di < m_nnu && dj < m_nnu) {
-                Tuu.push_back(Eigen::Triplet<double>(di, dj, v));
-            }
-            else if (di < m_nnu) {
-                Tup.push_back(Eigen::Triplet<double>(di, dj - m_nnu, v));
-            }
-            else if (dj < m_nnu) {
-                Tpu.push_back(Eigen::Triplet<double>(di - m_nnu, dj, v));
-            }
-            else {
-                Tpp.push_back(Eigen::Triplet<double>(di - m_nnu, dj - m_nnu, v));
-            }
+            this->push_back(rows(i), cols(j), matrix(i, j), Tuu, Tup, Tpu, Tpp);
         }
     }
 
@@ -244,26 +227,35 @@ inline void MatrixPartitioned::todense(xt::xtensor<double, 2>& ret) const
     ret.fill(0.0);
 
     for (int k = 0; k < m_Auu.outerSize(); ++k) {
-        for (Eigen::SparseMatrix<double>::InnerIterator it(m_Auu, k); it; ++it) {
+        for (Eigen::SparseMatrix<double, Eigen::RowMajor>::InnerIterator it(m_Auu, k); it; ++it) {
             ret(it.row(), it.col()) = it.value();
+            if (m_symmetric) {
+                ret(it.col(), it.row()) = it.value();
+            }
         }
     }
 
     for (int k = 0; k < m_Aup.outerSize(); ++k) {
-        for (Eigen::SparseMatrix<double>::InnerIterator it(m_Aup, k); it; ++it) {
+        for (Eigen::SparseMatrix<double, Eigen::RowMajor>::InnerIterator it(m_Aup, k); it; ++it) {
             ret(it.row(), it.col() + m_nnu) = it.value();
+            if (m_symmetric) {
+                ret(it.col() + m_nnu, it.row()) = it.value();
+            }
         }
     }
 
     for (int k = 0; k < m_Apu.outerSize(); ++k) {
-        for (Eigen::SparseMatrix<double>::InnerIterator it(m_Apu, k); it; ++it) {
+        for (Eigen::SparseMatrix<double, Eigen::RowMajor>::InnerIterator it(m_Apu, k); it; ++it) {
             ret(it.row() + m_nnu, it.col()) = it.value();
         }
     }
 
     for (int k = 0; k < m_App.outerSize(); ++k) {
-        for (Eigen::SparseMatrix<double>::InnerIterator it(m_App, k); it; ++it) {
+        for (Eigen::SparseMatrix<double, Eigen::RowMajor>::InnerIterator it(m_App, k); it; ++it) {
             ret(it.row() + m_nnu, it.col() + m_nnu) = it.value();
+            if (m_symmetric) {
+                ret(it.col() + m_nnu, it.row() + m_nnu) = it.value();
+            }
         }
     }
 }
@@ -280,19 +272,23 @@ inline void MatrixPartitioned::dot(const xt::xtensor<double, 2>& x, xt::xtensor<
     GOOSEFEM_ASSERT(xt::has_shape(b, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(x, {m_nnode, m_ndim}));
 
+    const auto& part = m_topo.part();
+
     Eigen::VectorXd X_u = this->AsDofs_u(x);
     Eigen::VectorXd X_p = this->AsDofs_p(x);
-    Eigen::VectorXd B_u = m_Auu * X_u + m_Aup * X_p;
-    Eigen::VectorXd B_p = m_Apu * X_u + m_App * X_p;
+    Eigen::VectorXd B_u(m_nnu);
+    Eigen::VectorXd B_p(m_nnp);
+    this->prod_u(X_u, X_p, B_u);
+    this->prod_p(X_u, X_p, B_p);
 
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_part(m, i) < m_nnu) {
-                b(m, i) = B_u(m_part(m, i));
+            if (part(m, i) < m_nnu) {
+                b(m, i) = B_u(part(m, i));
             }
             else{
-                b(m, i) = B_p(m_part(m, i) - m_nnu);
+                b(m, i) = B_p(part(m, i) - m_nnu);
             }
         }
     }
@@ -303,11 +299,68 @@ inline void MatrixPartitioned::dot(const xt::xtensor<double, 1>& x, xt::xtensor<
     GOOSEFEM_ASSERT(b.size() == m_ndof);
     GOOSEFEM_ASSERT(x.size() == m_ndof);
 
+    const auto& iiu = m_topo.iiu();
+    const auto& iip = m_topo.iip();
+
     Eigen::VectorXd X_u = this->AsDofs_u(x);
     Eigen::VectorXd X_p = this->AsDofs_p(x);
+    Eigen::VectorXd B_u(m_nnu);
+    Eigen::VectorXd B_p(m_nnp);
+    this->prod_u(X_u, X_p, B_u);
+    this->prod_p(X_u, X_p, B_p);
+
+    #pragma omp parallel for
+    for (size_t d = 0; d < m_nnu; ++d) {
+        b(iiu(d)) = B_u(d);
+    }
 
-    Eigen::Map<Eigen::VectorXd>(b.data(), m_nnu).noalias() = m_Auu * X_u + m_Aup * X_p;
-    Eigen::Map<Eigen::VectorXd>(b.data() + m_nnu, m_ndof).noalias() = m_Auu * X_u + m_Aup * X_p;
+    #pragma omp parallel for
+    for (size_t d = 0; d < m_nnp; ++d) {
+        b(iip(d)) = B_p(d);
+    }
+}
+
+inline void MatrixPartitioned::dot_u(
+    const xt::xtensor<double, 1>& x_u,
+    const xt::xtensor<double, 1>& x_p,
+    xt::xtensor<double, 1>& b_u) const
+{
+    GOOSEFEM_ASSERT(x_u.size() == m_nnu);
+    GOOSEFEM_ASSERT(x_p.size() == m_nnp);
+    GOOSEFEM_ASSERT(b_u.size() == m_nnu);
+
+    Eigen::Map<Eigen::VectorXd> B_u(b_u.data(), b_u.size());
+
+    this->prod_u(
+        Eigen::Map<const Eigen::VectorXd>(x_u.data(), x_u.size()),
+        Eigen::Map<const Eigen::VectorXd>(x_p.data(), x_p.size()),
+        B_u);
+}
+
+inline void MatrixPartitioned::residual_u(
+    const xt::xtensor<double, 1>& x_u,
+    const xt::xtensor<double, 1>& x_p,
+    const xt::xtensor<double, 1>& b_u,
+    xt::xtensor<double, 1>& r_u) const
+{
+    GOOSEFEM_ASSERT(x_u.size() == m_nnu);
+    GOOSEFEM_ASSERT(x_p.size() == m_nnp);
+    GOOSEFEM_ASSERT(b_u.size() == m_nnu);
+    GOOSEFEM_ASSERT(r_u.size() == m_nnu);
+
+    if (!m_symmetric) {
+        detail::residual(m_Auu, x_u.data(), m_Aup, x_p.data(), b_u.data(), r_u.data());
+        return;
+    }
+
+    Eigen::Map<Eigen::VectorXd> R_u(r_u.data(), r_u.size());
+
+    this->prod_u(
+        Eigen::Map<const Eigen::VectorXd>(x_u.data(), x_u.size()),
+        Eigen::Map<const Eigen::VectorXd>(x_p.data(), x_p.size()),
+        R_u);
+
+    R_u = Eigen::Map<const Eigen::VectorXd>(b_u.data(), b_u.size()) - R_u;
 }
 
 inline xt::xtensor<double, 2> MatrixPartitioned::Dot(const xt::xtensor<double, 2>& x) const
@@ -324,21 +377,42 @@ inline xt::xtensor<double, 1> MatrixPartitioned::Dot(const xt::xtensor<double, 1
     return b;
 }
 
+inline xt::xtensor<double, 1> MatrixPartitioned::Dot_u(
+    const xt::xtensor<double, 1>& x_u, const xt::xtensor<double, 1>& x_p) const
+{
+    xt::xtensor<double, 1> b_u = xt::empty<double>({m_nnu});
+    this->dot_u(x_u, x_p, b_u);
+    return b_u;
+}
+
+inline xt::xtensor<double, 1> MatrixPartitioned::Residual_u(
+    const xt::xtensor<double, 1>& x_u,
+    const xt::xtensor<double, 1>& x_p,
+    const xt::xtensor<double, 1>& b_u) const
+{
+    xt::xtensor<double, 1> r_u = xt::empty<double>({m_nnu});
+    this->residual_u(x_u, x_p, b_u, r_u);
+    return r_u;
+}
+
 inline void
 MatrixPartitioned::reaction(const xt::xtensor<double, 2>& x, xt::xtensor<double, 2>& b) const
 {
     GOOSEFEM_ASSERT(xt::has_shape(x, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(b, {m_nnode, m_ndim}));
 
+    const auto& part = m_topo.part();
+
     Eigen::VectorXd X_u = this->AsDofs_u(x);
     Eigen::VectorXd X_p = this->AsDofs_p(x);
-    Eigen::VectorXd B_p = m_Apu * X_u + m_App * X_p;
+    Eigen::VectorXd B_p(m_nnp);
+    this->prod_p(X_u, X_p, B_p);
 
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_part(m, i) >= m_nnu) {
-                b(m, i) = B_p(m_part(m, i) - m_nnu);
+            if (part(m, i) >= m_nnu) {
+                b(m, i) = B_p(part(m, i) - m_nnu);
             }
         }
     }
@@ -350,13 +424,16 @@ MatrixPartitioned::reaction(const xt::xtensor<double, 1>& x, xt::xtensor<double,
     GOOSEFEM_ASSERT(x.size() == m_ndof);
     GOOSEFEM_ASSERT(b.size() == m_ndof);
 
+    const auto& iip = m_topo.iip();
+
     Eigen::VectorXd X_u = this->AsDofs_u(x);
     Eigen::VectorXd X_p = this->AsDofs_p(x);
-    Eigen::VectorXd B_p = m_Apu * X_u + m_App * X_p;
+    Eigen::VectorXd B_p(m_nnp);
+    this->prod_p(X_u, X_p, B_p);
 
     #pragma omp parallel for
     for (size_t d = 0; d < m_nnp; ++d) {
-        b(m_iip(d)) = B_p(d);
+        b(iip(d)) = B_p(d);
     }
 }
 
@@ -369,9 +446,12 @@ inline void MatrixPartitioned::reaction_p(
     GOOSEFEM_ASSERT(x_p.size() == m_nnp);
     GOOSEFEM_ASSERT(b_p.size() == m_nnp);
 
-    Eigen::Map<Eigen::VectorXd>(b_p.data(), b_p.size()).noalias() =
-        m_Apu * Eigen::Map<const Eigen::VectorXd>(x_u.data(), x_u.size()) +
-        m_App * Eigen::Map<const Eigen::VectorXd>(x_p.data(), x_p.size());
+    Eigen::Map<Eigen::VectorXd> B_p(b_p.data(), b_p.size());
+
+    this->prod_p(
+        Eigen::Map<const Eigen::VectorXd>(x_u.data(), x_u.size()),
+        Eigen::Map<const Eigen::VectorXd>(x_p.data(), x_p.size()),
+        B_p);
 }
 
 inline xt::xtensor<double, 2>
@@ -398,15 +478,74 @@ inline xt::xtensor<double, 1> MatrixPartitioned::Reaction_p(
     return b_p;
 }
 
+inline void MatrixPartitioned::push_back(
+    size_t di,
+    size_t dj,
+    double v,
+    std::vector<Eigen::Triplet<double>>& Tuu,
+    std::vector<Eigen::Triplet<double>>& Tup,
+    std::vector<Eigen::Triplet<double>>& Tpu,
+    std::vector<Eigen::Triplet<double>>& Tpp) const
+{
+    if (di < m_nnu && dj < m_nnu) {
+        if (!m_symmetric || di <= dj) {
+            Tuu.push_back(Eigen::Triplet<double>(di, dj, v));
+        }
+    }
+    else if (di < m_nnu) {
+        Tup.push_back(Eigen::Triplet<double>(di, dj - m_nnu, v));
+    }
+    else if (dj < m_nnu) {
+        if (!m_symmetric) {
+            Tpu.push_back(Eigen::Triplet<double>(di - m_nnu, dj, v));
+        }
+    }
+    else {
+        if (!m_symmetric || di <= dj) {
+            Tpp.push_back(Eigen::Triplet<double>(di - m_nnu, dj - m_nnu, v));
+        }
+    }
+}
+
+inline void MatrixPartitioned::prod_u(
+    Eigen::Ref<const Eigen::VectorXd> x_u,
+    Eigen::Ref<const Eigen::VectorXd> x_p,
+    Eigen::Ref<Eigen::VectorXd> b_u) const
+{
+    if (m_symmetric) {
+        b_u.noalias() = m_Auu.selfadjointView<Eigen::Upper>() * x_u;
+        b_u.noalias() += m_Aup * x_p;
+    }
+    else {
+        detail::spmv(m_Auu, x_u.data(), m_Aup, x_p.data(), b_u.data());
+    }
+}
+
+inline void MatrixPartitioned::prod_p(
+    Eigen::Ref<const Eigen::VectorXd> x_u,
+    Eigen::Ref<const Eigen::VectorXd> x_p,
+    Eigen::Ref<Eigen::VectorXd> b_p) const
+{
+    if (m_symmetric) {
+        b_p.noalias() = m_App.selfadjointView<Eigen::Upper>() * x_p;
+        b_p.noalias() += m_Aup.transpose() * x_u;
+    }
+    else {
+        detail::spmv(m_Apu, x_u.data(), m_App, x_p.data(), b_p.data());
+    }
+}
+
 inline Eigen::VectorXd MatrixPartitioned::AsDofs_u(const xt::xtensor<double, 1>& dofval) const
 {
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
 
+    const auto& iiu = m_topo.iiu();
+
     Eigen::VectorXd dofval_u(m_nnu, 1);
 
     #pragma omp parallel for
     for (size_t d = 0; d < m_nnu; ++d) {
-        dofval_u(d) = dofval(m_iiu(d));
+        dofval_u(d) = dofval(iiu(d));
     }
 
     return dofval_u;
@@ -416,13 +555,15 @@ inline Eigen::VectorXd MatrixPartitioned::AsDofs_u(const xt::xtensor<double, 2>&
 {
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
+    const auto& part = m_topo.part();
+
     Eigen::VectorXd dofval_u = Eigen::VectorXd::Zero(m_nnu, 1);
 
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_part(m, i) < m_nnu) {
-                dofval_u(m_part(m, i)) = nodevec(m, i);
+            if (part(m, i) < m_nnu) {
+                dofval_u(part(m, i)) = nodevec(m, i);
             }
         }
     }
@@ -434,11 +575,13 @@ inline Eigen::VectorXd MatrixPartitioned::AsDofs_p(const xt::xtensor<double, 1>&
 {
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
 
+    const auto& iip = m_topo.iip();
+
     Eigen::VectorXd dofval_p(m_nnp, 1);
 
     #pragma omp parallel for
     for (size_t d = 0; d < m_nnp; ++d) {
-        dofval_p(d) = dofval(m_iip(d));
+        dofval_p(d) = dofval(iip(d));
     }
 
     return dofval_p;
@@ -448,13 +591,15 @@ inline Eigen::VectorXd MatrixPartitioned::AsDofs_p(const xt::xtensor<double, 2>&
 {
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
+    const auto& part = m_topo.part();
+
     Eigen::VectorXd dofval_p = Eigen::VectorXd::Zero(m_nnp, 1);
 
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_part(m, i) >= m_nnu) {
-                dofval_p(m_part(m, i) - m_nnu) = nodevec(m, i);
+            if (part(m, i) >= m_nnu) {
+                dofval_p(part(m, i) - m_nnu) = nodevec(m, i);
             }
         }
     }
@@ -462,13 +607,19 @@ inline Eigen::VectorXd MatrixPartitioned::AsDofs_p(const xt::xtensor<double, 2>&
     return dofval_p;
 }
 
+template <class Solver>
+inline Solver& MatrixPartitionedSolver<Solver>::solver()
+{
+    return m_solver;
+}
+
 template <class Solver>
 inline void MatrixPartitionedSolver<Solver>::factorize(MatrixPartitioned& matrix)
 {
     if (!matrix.m_changed && !m_factor) {
         return;
     }
-    m_solver.compute(matrix.m_Auu);
+    m_solver.compute(m_colmajor.update(matrix.m_Auu));
     m_factor = false;
     matrix.m_changed = false;
 }
@@ -480,16 +631,35 @@ inline void MatrixPartitionedSolver<Solver>::solve(
     GOOSEFEM_ASSERT(xt::has_shape(b, {matrix.m_nnode, matrix.m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(x, {matrix.m_nnode, matrix.m_ndim}));
 
+    const auto& part = matrix.m_topo.part();
+    size_t nnu = matrix.m_nnu;
+
     this->factorize(matrix);
-    Eigen::VectorXd B_u = matrix.AsDofs_u(b);
-    Eigen::VectorXd X_p = matrix.AsDofs_p(x);
-    Eigen::VectorXd X_u = m_solver.solve(Eigen::VectorXd(B_u - matrix.m_Aup * X_p));
+
+    m_B_u.resize(nnu);
+    m_X_u.resize(nnu);
+    m_X_p.resize(matrix.m_nnp);
 
     #pragma omp parallel for
     for (size_t m = 0; m < matrix.m_nnode; ++m) {
         for (size_t i = 0; i < matrix.m_ndim; ++i) {
-            if (matrix.m_part(m, i) < matrix.m_nnu) {
-                x(m, i) = X_u(matrix.m_part(m, i));
+            if (part(m, i) < nnu) {
+                m_B_u(part(m, i)) = b(m, i);
+            }
+            else {
+                m_X_p(part(m, i) - nnu) = x(m, i);
+            }
+        }
+    }
+
+    m_B_u.noalias() -= matrix.m_Aup * m_X_p;
+    m_X_u = m_solver.solve(m_B_u);
+
+    #pragma omp parallel for
+    for (size_t m = 0; m < matrix.m_nnode; ++m) {
+        for (size_t i = 0; i < matrix.m_ndim; ++i) {
+            if (part(m, i) < nnu) {
+                x(m, i) = m_X_u(part(m, i));
             }
         }
     }
@@ -502,14 +672,31 @@ inline void MatrixPartitionedSolver<Solver>::solve(
     GOOSEFEM_ASSERT(b.size() == matrix.m_ndof);
     GOOSEFEM_ASSERT(x.size() == matrix.m_ndof);
 
+    const auto& iiu = matrix.m_topo.iiu();
+    const auto& iip = matrix.m_topo.iip();
+
     this->factorize(matrix);
-    Eigen::VectorXd B_u = matrix.AsDofs_u(b);
-    Eigen::VectorXd X_p = matrix.AsDofs_p(x);
-    Eigen::VectorXd X_u = m_solver.solve(Eigen::VectorXd(B_u - matrix.m_Aup * X_p));
+
+    m_B_u.resize(matrix.m_nnu);
+    m_X_u.resize(matrix.m_nnu);
+    m_X_p.resize(matrix.m_nnp);
 
     #pragma omp parallel for
     for (size_t d = 0; d < matrix.m_nnu; ++d) {
-        x(matrix.m_iiu(d)) = X_u(d);
+        m_B_u(d) = b(iiu(d));
+    }
+
+    #pragma omp parallel for
+    for (size_t d = 0; d < matrix.m_nnp; ++d) {
+        m_X_p(d) = x(iip(d));
+    }
+
+    m_B_u.noalias() -= matrix.m_Aup * m_X_p;
+    m_X_u = m_solver.solve(m_B_u);
+
+    #pragma omp parallel for
+    for (size_t d = 0; d < matrix.m_nnu; ++d) {
+        x(iiu(d)) = m_X_u(d);
     }
 }
 
@@ -526,9 +713,115 @@ inline void MatrixPartitionedSolver<Solver>::solve_u(
 
     this->factorize(matrix);
 
-    Eigen::Map<Eigen::VectorXd>(x_u.data(), x_u.size()).noalias() = m_solver.solve(Eigen::VectorXd(
-        Eigen::Map<const Eigen::VectorXd>(b_u.data(), b_u.size()) -
-        matrix.m_Aup * Eigen::Map<const Eigen::VectorXd>(x_p.data(), x_p.size())));
+    m_B_u = Eigen::Map<const Eigen::VectorXd>(b_u.data(), b_u.size());
+    m_B_u.noalias() -= matrix.m_Aup * Eigen::Map<const Eigen::VectorXd>(x_p.data(), x_p.size());
+
+    Eigen::Map<Eigen::VectorXd>(x_u.data(), x_u.size()) = m_solver.solve(m_B_u);
+}
+
+template <class Solver>
+inline void MatrixPartitionedSolver<Solver>::solve(
+    MatrixPartitioned& matrix, const xt::xtensor<double, 3>& b, xt::xtensor<double, 3>& x)
+{
+    size_t nrhs = b.shape(0);
+
+    GOOSEFEM_ASSERT(xt::has_shape(b, {nrhs, matrix.m_nnode, matrix.m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(x, {nrhs, matrix.m_nnode, matrix.m_ndim}));
+
+    const auto& part = matrix.m_topo.part();
+    size_t nnu = matrix.m_nnu;
+
+    this->factorize(matrix);
+
+    Eigen::MatrixXd B_u = Eigen::MatrixXd::Zero(nnu, nrhs);
+    Eigen::MatrixXd X_p = Eigen::MatrixXd::Zero(matrix.m_nnp, nrhs);
+
+    for (size_t r = 0; r < nrhs; ++r) {
+        for (size_t m = 0; m < matrix.m_nnode; ++m) {
+            for (size_t i = 0; i < matrix.m_ndim; ++i) {
+                if (part(m, i) < nnu) {
+                    B_u(part(m, i), r) = b(r, m, i);
+                }
+                else {
+                    X_p(part(m, i) - nnu, r) = x(r, m, i);
+                }
+            }
+        }
+    }
+
+    Eigen::MatrixXd X_u = m_solver.solve(Eigen::MatrixXd(B_u - matrix.m_Aup * X_p));
+
+    for (size_t r = 0; r < nrhs; ++r) {
+        for (size_t m = 0; m < matrix.m_nnode; ++m) {
+            for (size_t i = 0; i < matrix.m_ndim; ++i) {
+                if (part(m, i) < nnu) {
+                    x(r, m, i) = X_u(part(m, i), r);
+                }
+            }
+        }
+    }
+}
+
+template <class Solver>
+inline void MatrixPartitionedSolver<Solver>::solve_u(
+    MatrixPartitioned& matrix,
+    const xt::xtensor<double, 2>& b_u,
+    const xt::xtensor<double, 2>& x_p,
+    xt::xtensor<double, 2>& x_u)
+{
+    size_t nrhs = b_u.shape(0);
+
+    GOOSEFEM_ASSERT(xt::has_shape(b_u, {nrhs, matrix.m_nnu}));
+    GOOSEFEM_ASSERT(xt::has_shape(x_p, {nrhs, matrix.m_nnp}));
+    GOOSEFEM_ASSERT(xt::has_shape(x_u, {nrhs, matrix.m_nnu}));
+
+    this->factorize(matrix);
+
+    // row-major [nrhs, n] is column-major [n, nrhs]: no copies needed
+    using map = Eigen::Map<const Eigen::MatrixXd>;
+    Eigen::Index nnu = static_cast<Eigen::Index>(matrix.m_nnu);
+    Eigen::Index nnp = static_cast<Eigen::Index>(matrix.m_nnp);
+    Eigen::Index n = static_cast<Eigen::Index>(nrhs);
+
+    Eigen::Map<Eigen::MatrixXd>(x_u.data(), nnu, n).noalias() = m_solver.solve(
+        Eigen::MatrixXd(map(b_u.data(), nnu, n) - matrix.m_Aup * map(x_p.data(), nnp, n)));
+}
+
+template <class Solver>
+inline void MatrixPartitionedSolver<Solver>::effective_pp(
+    MatrixPartitioned& matrix, xt::xtensor<double, 2>& K_pp)
+{
+    size_t nnp = matrix.m_nnp;
+
+    GOOSEFEM_ASSERT(xt::has_shape(K_pp, {nnp, nnp}));
+
+    this->factorize(matrix);
+
+    // only the prescribed DOFs coupled to unknown DOFs (nonzero columns of "A_up") need a solve
+    std::vector<Eigen::Index> cols = detail::nonzeroCols(matrix.m_Aup);
+    Eigen::MatrixXd X = m_solver.solve(detail::denseCols(matrix.m_Aup, cols));
+    Eigen::MatrixXd Y = matrix.m_symmetric ? Eigen::MatrixXd(matrix.m_Aup.transpose() * X)
+                                           : Eigen::MatrixXd(matrix.m_Apu * X);
+
+    // "K_pp" is row-major
+    Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>> K(
+        K_pp.data(), nnp, nnp);
+
+    K.setZero();
+
+    for (int k = 0; k < matrix.m_App.outerSize(); ++k) {
+        for (Eigen::SparseMatrix<double, Eigen::RowMajor>::InnerIterator it(matrix.m_App, k); it;
+             ++it) {
+            K(it.row(), it.col()) = it.value();
+            if (matrix.m_symmetric) {
+                K(it.col(), it.row()) = it.value();
+            }
+        }
+    }
+
+    for (size_t c = 0; c < cols.size(); ++c) {
+        K.col(cols[c]) -= Y.col(c);
+    }
 }
 
 template <class Solver>
@@ -558,6 +851,33 @@ inline xt::xtensor<double, 1> MatrixPartitionedSolver<Solver>::Solve_u(
     return x_u;
 }
 
+template <class Solver>
+inline xt::xtensor<double, 3> MatrixPartitionedSolver<Solver>::Solve(
+    MatrixPartitioned& matrix, const xt::xtensor<double, 3>& b, const xt::xtensor<double, 3>& x)
+{
+    xt::xtensor<double, 3> ret = x;
+    this->solve(matrix, b, ret);
+    return ret;
+}
+
+template <class Solver>
+inline xt::xtensor<double, 2> MatrixPartitionedSolver<Solver>::Solve_u(
+    MatrixPartitioned& matrix, const xt::xtensor<double, 2>& b_u, const xt::xtensor<double, 2>& x_p)
+{
+    xt::xtensor<double, 2> x_u = xt::empty<double>({b_u.shape(0), matrix.m_nnu});
+    this->solve_u(matrix, b_u, x_p, x_u);
+    return x_u;
+}
+
+template <class Solver>
+inline xt::xtensor<double, 2>
+MatrixPartitionedSolver<Solver>::Effective_pp(MatrixPartitioned& matrix)
+{
+    xt::xtensor<double, 2> K_pp = xt::empty<double>({matrix.m_nnp, matrix.m_nnp});
+    this->effective_pp(matrix, K_pp);
+    return K_pp;
+}
+
 } // namespace GooseFEM
 
 #endif
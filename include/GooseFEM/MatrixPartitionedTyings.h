@@ -8,6 +8,8 @@
 #define GOOSEFEM_MATRIXPARTITIONEDTYINGS_H
 
 #include "config.h"
+#include "LinearSolver.h"
+#include "Topology.h"
 
 #include <Eigen/Eigen>
 #include <Eigen/Sparse>
@@ -29,6 +31,11 @@ public:
         const Eigen::SparseMatrix<double>& Cdu,
         const Eigen::SparseMatrix<double>& Cdp);
 
+    MatrixPartitionedTyings(
+        const Topology& topology,
+        const Eigen::SparseMatrix<double>& Cdu,
+        const Eigen::SparseMatrix<double>& Cdp); // shares data (no copy)
+
     // Dimensions
     size_t nelem() const; // number of elements
     size_t nne() const;   // number of nodes per element
@@ -40,28 +47,21 @@ public:
     size_t nni() const;   // number of independent DOFs
     size_t nnd() const;   // number of dependent DOFs
 
-    // DOF lists
-    xt::xtensor<size_t, 2> dofs() const; // DOFs
-    xt::xtensor<size_t, 1> iiu() const;  // independent, unknown DOFs
-    xt::xtensor<size_t, 1> iip() const;  // independent, prescribed DOFs
-    xt::xtensor<size_t, 1> iii() const;  // independent DOFs
-    xt::xtensor<size_t, 1> iid() const;  // dependent DOFs
-
-    // Assemble from matrices stored per element [nelem, nne*ndim, nne*ndim]
+    // Connectivity and DOF lists
+    const Topology& topology() const;
+    const xt::xtensor<size_t, 2>& conn() const; // connectivity
+    const xt::xtensor<size_t, 2>& dofs() const; // DOFs
+    const xt::xtensor<size_t, 1>& iiu() const;  // independent, unknown DOFs
+    const xt::xtensor<size_t, 1>& iip() const;  // independent, prescribed DOFs
+    xt::xtensor<size_t, 1> iii() const;         // independent DOFs
+    const xt::xtensor<size_t, 1>& iid() const;  // dependent DOFs
+
+    // Assemble from matrices stored per element [nelem, nne*ndim, nne*ndim].
+    // The tyings are applied directly to the element entries (no intermediate blocks are stored):
+    // A' = A_ii + A_id * C_di + C_di^T * A_di + C_di^T * A_dd * C_di
     void assemble(const xt::xtensor<double, 3>& elemmat);
 
 private:
-    // The matrix
-    Eigen::SparseMatrix<double> m_Auu;
-    Eigen::SparseMatrix<double> m_Aup;
-    Eigen::SparseMatrix<double> m_Apu;
-    Eigen::SparseMatrix<double> m_App;
-    Eigen::SparseMatrix<double> m_Aud;
-    Eigen::SparseMatrix<double> m_Apd;
-    Eigen::SparseMatrix<double> m_Adu;
-    Eigen::SparseMatrix<double> m_Adp;
-    Eigen::SparseMatrix<double> m_Add;
-
     // The matrix for which the tyings have been applied
     Eigen::SparseMatrix<double> m_ACuu;
     Eigen::SparseMatrix<double> m_ACup;
@@ -73,18 +73,19 @@ private:
     std::vector<Eigen::Triplet<double>> m_Tup;
     std::vector<Eigen::Triplet<double>> m_Tpu;
     std::vector<Eigen::Triplet<double>> m_Tpp;
-    std::vector<Eigen::Triplet<double>> m_Tud;
-    std::vector<Eigen::Triplet<double>> m_Tpd;
-    std::vector<Eigen::Triplet<double>> m_Tdu;
-    std::vector<Eigen::Triplet<double>> m_Tdp;
-    std::vector<Eigen::Triplet<double>> m_Tdd;
+
+    // Tyings per DOF in compressed form: DOF "d" depends on the independent DOFs
+    // "m_tie_dof(k)" with weights "m_tie_w(k)", for "m_tie_ptr(d) <= k < m_tie_ptr(d + 1)"
+    // (an independent DOF depends only on itself, with weight one)
+    xt::xtensor<size_t, 1> m_tie_ptr; // [ndof + 1]
+    xt::xtensor<size_t, 1> m_tie_dof; // [nnz]
+    xt::xtensor<double, 1> m_tie_w;   // [nnz]
 
     // Signal changes to data
     bool m_changed = true;
 
     // Bookkeeping
-    xt::xtensor<size_t, 2> m_conn; // connectivity          [nelem, nne ]
-    xt::xtensor<size_t, 2> m_dofs; // DOF-numbers per node  [nnode, ndim]
+    Topology m_topo; // connectivity [nelem, nne], DOF-numbers per node [nnode, ndim]
     xt::xtensor<size_t, 1> m_iiu;  // unknown     DOFs      [nnu]
     xt::xtensor<size_t, 1> m_iip;  // prescribed  DOFs      [nnp]
     xt::xtensor<size_t, 1> m_iid;  // dependent   DOFs      [nnd]
@@ -118,12 +119,17 @@ private:
     Eigen::VectorXd AsDofs_d(const xt::xtensor<double, 2>& nodevec) const;
 };
 
-template <class Solver = Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>>>
+template <class Solver = LinearSolver::Default>
 class MatrixPartitionedTyingsSolver {
 public:
     // Constructors
     MatrixPartitionedTyingsSolver() = default;
 
+    // Eliminate the (unknown) control DOFs, e.g. "Tyings::Periodic::control()", by a Schur
+    // complement: only the remaining sparse part is factorised by "Solver", the control DOFs
+    // (which couple to all dependent DOFs) are solved from a small dense system
+    MatrixPartitionedTyingsSolver(const xt::xtensor<size_t, 2>& control);
+
     // Solve:
     // A' = A_ii + K_id * C_di + C_di^T * K_di + C_di^T * K_dd * C_di
     // b' = b_i + C_di^T * b_d
@@ -147,6 +153,29 @@ public:
         const xt::xtensor<double, 1>& x_p,
         xt::xtensor<double, 1>& x_u);
 
+    // Solve for a batch of right-hand-sides, using one blocked forward/backward substitution:
+    // "b", "x": [nrhs, nnode, ndim]; "b_u", "b_d", "x_p", "x_u": [nrhs, nnu], [nrhs, nnd], ...
+    void solve(
+        MatrixPartitionedTyings& matrix,
+        const xt::xtensor<double, 3>& b,
+        xt::xtensor<double, 3>& x); // updates x_u and x_d
+
+    void solve_u(
+        MatrixPartitionedTyings& matrix,
+        const xt::xtensor<double, 2>& b_u,
+        const xt::xtensor<double, 2>& b_d,
+        const xt::xtensor<double, 2>& x_p,
+        xt::xtensor<double, 2>& x_u);
+
+    // Effective (condensed) stiffness of the prescribed DOFs [nnp, nnp]
+    // (e.g. the macroscopic tangent when the control DOFs are prescribed):
+    // K_pp = A'_pp - A'_pu * A'_uu^-1 * A'_up
+    // (solves only for the prescribed DOFs coupled to unknown DOFs: the nonzero columns of A'_up)
+    void effective_pp(MatrixPartitionedTyings& matrix, xt::xtensor<double, 2>& K_pp);
+
+    // Underlying solver, e.g. to set the parameters of an iterative solver (before the first solve)
+    Solver& solver();
+
     // Auto-allocation of the functions above
     xt::xtensor<double, 2> Solve(
         MatrixPartitionedTyings& matrix,
@@ -164,10 +193,48 @@ public:
         const xt::xtensor<double, 1>& b_d,
         const xt::xtensor<double, 1>& x_p);
 
+    xt::xtensor<double, 3> Solve(
+        MatrixPartitionedTyings& matrix,
+        const xt::xtensor<double, 3>& b,
+        const xt::xtensor<double, 3>& x);
+
+    xt::xtensor<double, 2> Solve_u(
+        MatrixPartitionedTyings& matrix,
+        const xt::xtensor<double, 2>& b_u,
+        const xt::xtensor<double, 2>& b_d,
+        const xt::xtensor<double, 2>& x_p);
+
+    xt::xtensor<double, 2> Effective_pp(MatrixPartitionedTyings& matrix);
+
 private:
     Solver m_solver; // solver
     bool m_factor = true; // signal to force factorization
     void factorize(MatrixPartitionedTyings& matrix); // compute inverse (evaluated by "solve")
+
+    // Solve: x_u = A'_uu \ b_u (for one or several right-hand-sides [nnu, nrhs])
+    Eigen::MatrixXd solve_uu(const Eigen::MatrixXd& b_u);
+    void solve_uu(Eigen::Ref<const Eigen::VectorXd> b_u, Eigen::Ref<Eigen::VectorXd> x_u);
+
+    // Bordered system: [A_ss, A_sc; A_cs, A_cc], with "c" the unknown control DOFs.
+    // "m_solver" factorises A_ss, the Schur complement S = A_cc - A_cs * A_ss^-1 * A_sc is dense.
+    xt::xtensor<size_t, 1> m_control; // control DOFs (as specified)
+    xt::xtensor<size_t, 1> m_iis; // unknown DOFs that are not control DOFs [ns]
+    xt::xtensor<size_t, 1> m_iic; // unknown control DOFs [nc]
+    Eigen::SparseMatrix<double> m_Ass; // [ns, ns] (kept: iterative solvers refer to it)
+    Eigen::SparseMatrix<double> m_Acs; // [nc, ns]
+    Eigen::MatrixXd m_W; // A_ss^-1 * A_sc [ns, nc]
+    Eigen::PartialPivLU<Eigen::MatrixXd> m_S; // Schur complement [nc, nc]
+
+    // Workspace (re-used for each solve)
+    Eigen::VectorXd m_B_u; // [nnu]
+    Eigen::VectorXd m_B_d; // [nnd]
+    Eigen::VectorXd m_X_u; // [nnu]
+    Eigen::VectorXd m_X_p; // [nnp]
+    Eigen::VectorXd m_X_d; // [nnd]
+    Eigen::VectorXd m_b_s; // [ns]
+    Eigen::VectorXd m_b_c; // [nc]
+    Eigen::VectorXd m_x_s; // [ns]
+    Eigen::VectorXd m_x_c; // [nc]
 };
 
 } // namespace GooseFEM
@@ -16,7 +16,15 @@ inline MatrixPartitionedTyings::MatrixPartitionedTyings(
     const xt::xtensor<size_t, 2>& dofs,
     const Eigen::SparseMatrix<double>& Cdu,
     const Eigen::SparseMatrix<double>& Cdp)
-    : m_conn(conn), m_dofs(dofs), m_Cdu(Cdu), m_Cdp(Cdp)
+    : MatrixPartitionedTyings(Topology(conn, dofs), Cdu, Cdp)
+{
+}
+
+inline MatrixPartitionedTyings::MatrixPartitionedTyings(
+    const Topology& topology,
+    const Eigen::SparseMatrix<double>& Cdu,
+    const Eigen::SparseMatrix<double>& Cdp)
+    : m_topo(topology), m_Cdu(Cdu), m_Cdp(Cdp)
 {
     GOOSEFEM_ASSERT(Cdu.rows() == Cdp.rows());
 
@@ -28,33 +36,116 @@ inline MatrixPartitionedTyings::MatrixPartitionedTyings(
     m_iiu = xt::arange<size_t>(m_nnu);
     m_iip = xt::arange<size_t>(m_nnu, m_nnu + m_nnp);
     m_iid = xt::arange<size_t>(m_nni, m_nni + m_nnd);
-    m_nelem = m_conn.shape(0);
-    m_nne = m_conn.shape(1);
-    m_nnode = m_dofs.shape(0);
-    m_ndim = m_dofs.shape(1);
+    m_nelem = m_topo.nelem();
+    m_nne = m_topo.nne();
+    m_nnode = m_topo.nnode();
+    m_ndim = m_topo.ndim();
     m_Cud = m_Cdu.transpose();
     m_Cpd = m_Cdp.transpose();
-    m_Tuu.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
-    m_Tup.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
-    m_Tpu.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
-    m_Tpp.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
-    m_Tud.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
-    m_Tpd.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
-    m_Tdu.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
-    m_Tdp.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
-    m_Tdd.reserve(m_nelem * m_nne * m_ndim * m_nne * m_ndim);
-    m_Auu.resize(m_nnu, m_nnu);
-    m_Aup.resize(m_nnu, m_nnp);
-    m_Apu.resize(m_nnp, m_nnu);
-    m_App.resize(m_nnp, m_nnp);
-    m_Aud.resize(m_nnu, m_nnd);
-    m_Apd.resize(m_nnp, m_nnd);
-    m_Adu.resize(m_nnd, m_nnu);
-    m_Adp.resize(m_nnd, m_nnp);
-    m_Add.resize(m_nnd, m_nnd);
+    m_ACuu.resize(m_nnu, m_nnu);
+    m_ACup.resize(m_nnu, m_nnp);
+    m_ACpu.resize(m_nnp, m_nnu);
+    m_ACpp.resize(m_nnp, m_nnp);
+
+    // tyings per DOF: independent DOFs map onto themselves, dependent DOFs onto the rows of C_di
+
+    Eigen::SparseMatrix<double, Eigen::RowMajor> Cdu_row = m_Cdu;
+    Eigen::SparseMatrix<double, Eigen::RowMajor> Cdp_row = m_Cdp;
+    using iterator = Eigen::SparseMatrix<double, Eigen::RowMajor>::InnerIterator;
+
+    m_tie_ptr = xt::empty<size_t>({m_ndof + 1});
+    m_tie_ptr(0) = 0;
+
+    for (size_t d = 0; d < m_nni; ++d) {
+        m_tie_ptr(d + 1) = m_tie_ptr(d) + 1;
+    }
+
+    for (size_t d = 0; d < m_nnd; ++d) {
+        size_t n = 0;
+        for (iterator it(Cdu_row, d); it; ++it) {
+            n += it.value() != 0.0;
+        }
+        for (iterator it(Cdp_row, d); it; ++it) {
+            n += it.value() != 0.0;
+        }
+        m_tie_ptr(m_nni + d + 1) = m_tie_ptr(m_nni + d) + n;
+    }
+
+    m_tie_dof = xt::empty<size_t>({m_tie_ptr(m_ndof)});
+    m_tie_w = xt::empty<double>({m_tie_ptr(m_ndof)});
+
+    for (size_t d = 0; d < m_nni; ++d) {
+        m_tie_dof(d) = d;
+        m_tie_w(d) = 1.0;
+    }
+
+    for (size_t d = 0; d < m_nnd; ++d) {
+        size_t k = m_tie_ptr(m_nni + d);
+        for (iterator it(Cdu_row, d); it; ++it) {
+            if (it.value() != 0.0) {
+                m_tie_dof(k) = static_cast<size_t>(it.col());
+                m_tie_w(k) = it.value();
+                ++k;
+            }
+        }
+        for (iterator it(Cdp_row, d); it; ++it) {
+            if (it.value() != 0.0) {
+                m_tie_dof(k) = m_nnu + static_cast<size_t>(it.col());
+                m_tie_w(k) = it.value();
+                ++k;
+            }
+        }
+    }
+
+    // number of triplets of each block in "assemble" (reserved once): from the number of
+    // unknown and prescribed independent DOFs that each DOF is tied to
+
+    std::vector<size_t> nu(m_ndof, 0);
+    std::vector<size_t> np(m_ndof, 0);
+
+    for (size_t d = 0; d < m_ndof; ++d) {
+        for (size_t a = m_tie_ptr(d); a < m_tie_ptr(d + 1); ++a) {
+            if (m_tie_dof(a) < m_nnu) {
+                ++nu[d];
+            }
+            else {
+                ++np[d];
+            }
+        }
+    }
+
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+    const auto& dofs = m_topo.dofs();
+    size_t nuu = 0;
+    size_t nup = 0;
+    size_t npp = 0;
+
+    for (size_t e = 0; e < m_nelem; ++e) {
+        size_t r = rows ? rows[e] : e;
+        for (size_t m = 0; m < m_nne; ++m) {
+            for (size_t i = 0; i < m_ndim; ++i) {
+                size_t di = dofs(conn(r, m), i);
+                for (size_t n = 0; n < m_nne; ++n) {
+                    for (size_t j = 0; j < m_ndim; ++j) {
+                        size_t dj = dofs(conn(r, n), j);
+                        nuu += nu[di] * nu[dj];
+                        nup += nu[di] * np[dj];
+                        npp += np[di] * np[dj];
+                    }
+                }
+            }
+        }
+    }
+
+    // the number of (p, u) pairs equals that of (u, p) pairs
+    m_Tuu.reserve(nuu);
+    m_Tup.reserve(nup);
+    m_Tpu.reserve(nup);
+    m_Tpp.reserve(npp);
 
     GOOSEFEM_ASSERT(m_ndof <= m_nnode * m_ndim);
-    GOOSEFEM_ASSERT(m_ndof == xt::amax(m_dofs)() + 1);
+    GOOSEFEM_ASSERT(m_ndof == m_topo.ndof());
 }
 
 inline size_t MatrixPartitionedTyings::nelem() const
@@ -102,17 +193,27 @@ inline size_t MatrixPartitionedTyings::nnd() const
     return m_nnd;
 }
 
-inline xt::xtensor<size_t, 2> MatrixPartitionedTyings::dofs() const
+inline const Topology& MatrixPartitionedTyings::topology() const
+{
+    return m_topo;
+}
+
+inline const xt::xtensor<size_t, 2>& MatrixPartitionedTyings::conn() const
 {
-    return m_dofs;
+    return m_topo.conn();
 }
 
-inline xt::xtensor<size_t, 1> MatrixPartitionedTyings::iiu() const
+inline const xt::xtensor<size_t, 2>& MatrixPartitionedTyings::dofs() const
+{
+    return m_topo.dofs();
+}
+
+inline const xt::xtensor<size_t, 1>& MatrixPartitionedTyings::iiu() const
 {
     return m_iiu;
 }
 
-inline xt::xtensor<size_t, 1> MatrixPartitionedTyings::iip() const
+inline const xt::xtensor<size_t, 1>& MatrixPartitionedTyings::iip() const
 {
     return m_iip;
 }
@@ -122,7 +223,7 @@ inline xt::xtensor<size_t, 1> MatrixPartitionedTyings::iii() const
     return xt::arange<size_t>(m_nni);
 }
 
-inline xt::xtensor<size_t, 1> MatrixPartitionedTyings::iid() const
+inline const xt::xtensor<size_t, 1>& MatrixPartitionedTyings::iid() const
 {
     return m_iid;
 }
@@ -131,70 +232,52 @@ inline void MatrixPartitionedTyings::assemble(const xt::xtensor<double, 3>& elem
 {
     GOOSEFEM_ASSERT(xt::has_shape(elemmat, {m_nelem, m_nne * m_ndim, m_nne * m_ndim}));
 
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+    const auto& dofs = m_topo.dofs();
+
     m_Tuu.clear();
     m_Tup.clear();
     m_Tpu.clear();
     m_Tpp.clear();
-    m_Tud.clear();
-    m_Tpd.clear();
-    m_Tdu.clear();
-    m_Tdp.clear();
-    m_Tdd.clear();
 
     for (size_t e = 0; e < m_nelem; ++e) {
+        size_t r = rows ? rows[e] : e;
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
 
-                size_t di = m_dofs(m_conn(e, m), i);
+                size_t di = dofs(conn(r, m), i);
 
                 for (size_t n = 0; n < m_nne; ++n) {
                     for (size_t j = 0; j < m_ndim; ++j) {
 
-                        size_t dj = m_dofs(m_conn(e, n), j);
-
-                        if (di < m_nnu && dj < m_nnu) {
-                            m_Tuu.push_back(Eigen::Triplet<double>(
-                                di, dj, elemmat(e, m * m_ndim + i, n * m_ndim + j)));
-                        }
-                        else if (di < m_nnu && dj < m_nni) {
-                            m_Tup.push_back(Eigen::Triplet<double>(
-                                di, dj - m_nnu, elemmat(e, m * m_ndim + i, n * m_ndim + j)));
-                        }
-                        else if (di < m_nnu) {
-                            m_Tud.push_back(Eigen::Triplet<double>(
-                                di, dj - m_nni, elemmat(e, m * m_ndim + i, n * m_ndim + j)));
-                        }
-                        else if (di < m_nni && dj < m_nnu) {
-                            m_Tpu.push_back(Eigen::Triplet<double>(
-                                di - m_nnu, dj, elemmat(e, m * m_ndim + i, n * m_ndim + j)));
-                        }
-                        else if (di < m_nni && dj < m_nni) {
-                            m_Tpp.push_back(Eigen::Triplet<double>(
-                                di - m_nnu,
-                                dj - m_nnu,
-                                elemmat(e, m * m_ndim + i, n * m_ndim + j)));
-                        }
-                        else if (di < m_nni) {
-                            m_Tpd.push_back(Eigen::Triplet<double>(
-                                di - m_nnu,
-                                dj - m_nni,
-                                elemmat(e, m * m_ndim + i, n * m_ndim + j)));
-                        }
-                        else if (dj < m_nnu) {
-                            m_Tdu.push_back(Eigen::Triplet<double>(
-                                di - m_nni, dj, elemmat(e, m * m_ndim + i, n * m_ndim + j)));
-                        }
-                        else if (dj < m_nni) {
-                            m_Tdp.push_back(Eigen::Triplet<double>(
-                                di - m_nni,
-                                dj - m_nnu,
-                                elemmat(e, m * m_ndim + i, n * m_ndim + j)));
-                        }
-                        else {
-                            m_Tdd.push_back(Eigen::Triplet<double>(
-                                di - m_nni,
-                                dj - m_nni,
-                                elemmat(e, m * m_ndim + i, n * m_ndim + j)));
+                        size_t dj = dofs(conn(r, n), j);
+                        double v = elemmat(e, m * m_ndim + i, n * m_ndim + j);
+
+                        // A'_kl += C_ik * A_ij * C_jl
+                        for (size_t a = m_tie_ptr(di); a < m_tie_ptr(di + 1); ++a) {
+
+                            size_t k = m_tie_dof(a);
+
+                            for (size_t b = m_tie_ptr(dj); b < m_tie_ptr(dj + 1); ++b) {
+
+                                size_t l = m_tie_dof(b);
+                                double w = m_tie_w(a) * v * m_tie_w(b);
+
+                                if (k < m_nnu && l < m_nnu) {
+                                    m_Tuu.push_back(Eigen::Triplet<double>(k, l, w));
+                                }
+                                else if (k < m_nnu) {
+                                    m_Tup.push_back(Eigen::Triplet<double>(k, l - m_nnu, w));
+                                }
+                                else if (l < m_nnu) {
+                                    m_Tpu.push_back(Eigen::Triplet<double>(k - m_nnu, l, w));
+                                }
+                                else {
+                                    m_Tpp.push_back(
+                                        Eigen::Triplet<double>(k - m_nnu, l - m_nnu, w));
+                                }
+                            }
                         }
                     }
                 }
@@ -202,15 +285,10 @@ inline void MatrixPartitionedTyings::assemble(const xt::xtensor<double, 3>& elem
         }
     }
 
-    m_Auu.setFromTriplets(m_Tuu.begin(), m_Tuu.end());
-    m_Aup.setFromTriplets(m_Tup.begin(), m_Tup.end());
-    m_Apu.setFromTriplets(m_Tpu.begin(), m_Tpu.end());
-    m_App.setFromTriplets(m_Tpp.begin(), m_Tpp.end());
-    m_Aud.setFromTriplets(m_Tud.begin(), m_Tud.end());
-    m_Apd.setFromTriplets(m_Tpd.begin(), m_Tpd.end());
-    m_Adu.setFromTriplets(m_Tdu.begin(), m_Tdu.end());
-    m_Adp.setFromTriplets(m_Tdp.begin(), m_Tdp.end());
-    m_Add.setFromTriplets(m_Tdd.begin(), m_Tdd.end());
+    m_ACuu.setFromTriplets(m_Tuu.begin(), m_Tuu.end());
+    m_ACup.setFromTriplets(m_Tup.begin(), m_Tup.end());
+    m_ACpu.setFromTriplets(m_Tpu.begin(), m_Tpu.end());
+    m_ACpp.setFromTriplets(m_Tpp.begin(), m_Tpp.end());
     m_changed = true;
 }
 
@@ -233,13 +311,15 @@ MatrixPartitionedTyings::AsDofs_u(const xt::xtensor<double, 2>& nodevec) const
 {
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
+    const auto& dofs = m_topo.dofs();
+
     Eigen::VectorXd dofval_u = Eigen::VectorXd::Zero(m_nnu, 1);
 
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_dofs(m, i) < m_nnu) {
-                dofval_u(m_dofs(m, i)) = nodevec(m, i);
+            if (dofs(m, i) < m_nnu) {
+                dofval_u(dofs(m, i)) = nodevec(m, i);
             }
         }
     }
@@ -266,13 +346,15 @@ MatrixPartitionedTyings::AsDofs_p(const xt::xtensor<double, 2>& nodevec) const
 {
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
+    const auto& dofs = m_topo.dofs();
+
     Eigen::VectorXd dofval_p = Eigen::VectorXd::Zero(m_nnp, 1);
 
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_dofs(m, i) >= m_nnu && m_dofs(m, i) < m_nni) {
-                dofval_p(m_dofs(m, i) - m_nnu) = nodevec(m, i);
+            if (dofs(m, i) >= m_nnu && dofs(m, i) < m_nni) {
+                dofval_p(dofs(m, i) - m_nnu) = nodevec(m, i);
             }
         }
     }
@@ -288,7 +370,7 @@ inline Eigen::VectorXd MatrixPartitionedTyings::AsDofs_d(const xt::xtensor<doubl
 
     #pragma omp parallel for
     for (size_t d = 0; d < m_nnd; ++d) {
-        dofval_d(d) = dofval(m_iip(d));
+        dofval_d(d) = dofval(m_iid(d));
     }
 
     return dofval_d;
@@ -299,13 +381,15 @@ MatrixPartitionedTyings::AsDofs_d(const xt::xtensor<double, 2>& nodevec) const
 {
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
+    const auto& dofs = m_topo.dofs();
+
     Eigen::VectorXd dofval_d = Eigen::VectorXd::Zero(m_nnd, 1);
 
     #pragma omp parallel for
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_dofs(m, i) >= m_nni) {
-                dofval_d(m_dofs(m, i) - m_nni) = nodevec(m, i);
+            if (dofs(m, i) >= m_nni) {
+                dofval_d(dofs(m, i) - m_nni) = nodevec(m, i);
             }
         }
     }
@@ -313,6 +397,19 @@ MatrixPartitionedTyings::AsDofs_d(const xt::xtensor<double, 2>& nodevec) const
     return dofval_d;
 }
 
+template <class Solver>
+inline MatrixPartitionedTyingsSolver<Solver>::MatrixPartitionedTyingsSolver(
+    const xt::xtensor<size_t, 2>& control)
+    : m_control(xt::flatten(control))
+{
+}
+
+template <class Solver>
+inline Solver& MatrixPartitionedTyingsSolver<Solver>::solver()
+{
+    return m_solver;
+}
+
 template <class Solver>
 inline void MatrixPartitionedTyingsSolver<Solver>::factorize(MatrixPartitionedTyings& matrix)
 {
@@ -320,23 +417,163 @@ inline void MatrixPartitionedTyingsSolver<Solver>::factorize(MatrixPartitionedTy
         return;
     }
 
-    matrix.m_ACuu = matrix.m_Auu + matrix.m_Aud * matrix.m_Cdu + matrix.m_Cud * matrix.m_Adu +
-                    matrix.m_Cud * matrix.m_Add * matrix.m_Cdu;
+    size_t nnu = matrix.m_nnu;
+
+    // partition the unknown DOFs in sparse and control DOFs (only on first use)
+
+    if (m_iis.size() + m_iic.size() != nnu) {
+        xt::xtensor<size_t, 1> iic = xt::filter(m_control, m_control < nnu);
+        m_iic = xt::unique(iic);
+        m_iis = xt::setdiff1d(xt::arange<size_t>(nnu), m_iic);
+    }
+
+    if (m_iic.size() == 0) {
+        m_solver.compute(matrix.m_ACuu);
+        m_factor = false;
+        matrix.m_changed = false;
+        return;
+    }
+
+    size_t ns = m_iis.size();
+    size_t nc = m_iic.size();
+
+    // local index in the sparse ("ns") or control ("nc") block
+    xt::xtensor<size_t, 1> index = xt::empty<size_t>({nnu});
+    xt::xtensor<bool, 1> isc = xt::zeros<bool>({nnu});
 
-    matrix.m_ACup = matrix.m_Aup + matrix.m_Aud * matrix.m_Cdp + matrix.m_Cud * matrix.m_Adp +
-                    matrix.m_Cud * matrix.m_Add * matrix.m_Cdp;
+    for (size_t i = 0; i < ns; ++i) {
+        index(m_iis(i)) = i;
+    }
+
+    for (size_t i = 0; i < nc; ++i) {
+        index(m_iic(i)) = i;
+        isc(m_iic(i)) = true;
+    }
 
-    // matrix.m_ACpu = matrix.m_Apu + matrix.m_Apd * matrix.m_Cdu + matrix.m_Cpd * matrix.m_Adu
-    //     + matrix.m_Cpd * matrix.m_Add * matrix.m_Cdu;
+    // split the matrix
 
-    // matrix.m_ACpp = matrix.m_App + matrix.m_Apd * matrix.m_Cdp + matrix.m_Cpd * matrix.m_Adp
-    //     + matrix.m_Cpd * matrix.m_Add * matrix.m_Cdp;
+    std::vector<Eigen::Triplet<double>> Tss;
+    std::vector<Eigen::Triplet<double>> Tsc;
+    std::vector<Eigen::Triplet<double>> Tcs;
+    Eigen::MatrixXd Acc = Eigen::MatrixXd::Zero(nc, nc);
+    Tss.reserve(matrix.m_ACuu.nonZeros());
+
+    for (int k = 0; k < matrix.m_ACuu.outerSize(); ++k) {
+        for (Eigen::SparseMatrix<double>::InnerIterator it(matrix.m_ACuu, k); it; ++it) {
+            size_t r = static_cast<size_t>(it.row());
+            size_t c = static_cast<size_t>(it.col());
+            if (!isc(r) && !isc(c)) {
+                Tss.push_back(Eigen::Triplet<double>(index(r), index(c), it.value()));
+            }
+            else if (!isc(r)) {
+                Tsc.push_back(Eigen::Triplet<double>(index(r), index(c), it.value()));
+            }
+            else if (!isc(c)) {
+                Tcs.push_back(Eigen::Triplet<double>(index(r), index(c), it.value()));
+            }
+            else {
+                Acc(index(r), index(c)) += it.value();
+            }
+        }
+    }
+
+    Eigen::SparseMatrix<double> Asc(ns, nc);
+    m_Ass.resize(ns, ns);
+    m_Acs.resize(nc, ns);
+    m_Ass.setFromTriplets(Tss.begin(), Tss.end());
+    Asc.setFromTriplets(Tsc.begin(), Tsc.end());
+    m_Acs.setFromTriplets(Tcs.begin(), Tcs.end());
+
+    // factorise the sparse part, and the (dense) Schur complement
+
+    m_solver.compute(m_Ass);
+    m_W = m_solver.solve(Eigen::MatrixXd(Asc));
+    m_S.compute(Eigen::MatrixXd(Acc - m_Acs * m_W));
 
-    m_solver.compute(matrix.m_ACuu);
     m_factor = false;
     matrix.m_changed = false;
 }
 
+template <class Solver>
+inline Eigen::MatrixXd MatrixPartitionedTyingsSolver<Solver>::solve_uu(const Eigen::MatrixXd& b_u)
+{
+    if (m_iic.size() == 0) {
+        return m_solver.solve(b_u);
+    }
+
+    size_t ns = m_iis.size();
+    size_t nc = m_iic.size();
+    auto nrhs = b_u.cols();
+
+    Eigen::MatrixXd b_s(ns, nrhs);
+    Eigen::MatrixXd b_c(nc, nrhs);
+
+    for (size_t i = 0; i < ns; ++i) {
+        b_s.row(i) = b_u.row(m_iis(i));
+    }
+
+    for (size_t i = 0; i < nc; ++i) {
+        b_c.row(i) = b_u.row(m_iic(i));
+    }
+
+    // x_c = S \ (b_c - A_cs * A_ss^-1 * b_s), x_s = A_ss^-1 * b_s - W * x_c
+
+    Eigen::MatrixXd y_s = m_solver.solve(b_s);
+    Eigen::MatrixXd x_c = m_S.solve(Eigen::MatrixXd(b_c - m_Acs * y_s));
+    y_s -= m_W * x_c;
+
+    Eigen::MatrixXd x_u(b_u.rows(), nrhs);
+
+    for (size_t i = 0; i < ns; ++i) {
+        x_u.row(m_iis(i)) = y_s.row(i);
+    }
+
+    for (size_t i = 0; i < nc; ++i) {
+        x_u.row(m_iic(i)) = x_c.row(i);
+    }
+
+    return x_u;
+}
+
+template <class Solver>
+inline void MatrixPartitionedTyingsSolver<Solver>::solve_uu(
+    Eigen::Ref<const Eigen::VectorXd> b_u, Eigen::Ref<Eigen::VectorXd> x_u)
+{
+    if (m_iic.size() == 0) {
+        x_u = m_solver.solve(b_u);
+        return;
+    }
+
+    size_t ns = m_iis.size();
+    size_t nc = m_iic.size();
+
+    m_b_s.resize(ns);
+    m_b_c.resize(nc);
+
+    for (size_t i = 0; i < ns; ++i) {
+        m_b_s(i) = b_u(m_iis(i));
+    }
+
+    for (size_t i = 0; i < nc; ++i) {
+        m_b_c(i) = b_u(m_iic(i));
+    }
+
+    // x_c = S \ (b_c - A_cs * A_ss^-1 * b_s), x_s = A_ss^-1 * b_s - W * x_c
+
+    m_x_s = m_solver.solve(m_b_s);
+    m_b_c.noalias() -= m_Acs * m_x_s;
+    m_x_c = m_S.solve(m_b_c);
+    m_x_s.noalias() -= m_W * m_x_c;
+
+    for (size_t i = 0; i < ns; ++i) {
+        x_u(m_iis(i)) = m_x_s(i);
+    }
+
+    for (size_t i = 0; i < nc; ++i) {
+        x_u(m_iic(i)) = m_x_c(i);
+    }
+}
+
 template <class Solver>
 inline void MatrixPartitionedTyingsSolver<Solver>::solve(
     MatrixPartitionedTyings& matrix, const xt::xtensor<double, 2>& b, xt::xtensor<double, 2>& x)
@@ -344,25 +581,49 @@ inline void MatrixPartitionedTyingsSolver<Solver>::solve(
     GOOSEFEM_ASSERT(xt::has_shape(b, {matrix.m_nnode, matrix.m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(x, {matrix.m_nnode, matrix.m_ndim}));
 
+    const auto& dofs = matrix.m_topo.dofs();
+    size_t nnu = matrix.m_nnu;
+    size_t nni = matrix.m_nni;
+
     this->factorize(matrix);
 
-    Eigen::VectorXd B_u = matrix.AsDofs_u(b);
-    Eigen::VectorXd B_d = matrix.AsDofs_d(b);
-    Eigen::VectorXd X_p = matrix.AsDofs_p(x);
+    m_B_u.resize(nnu);
+    m_B_d.resize(matrix.m_nnd);
+    m_X_u.resize(nnu);
+    m_X_p.resize(matrix.m_nnp);
+    m_X_d.resize(matrix.m_nnd);
 
-    B_u += matrix.m_Cud * B_d;
+    #pragma omp parallel for
+    for (size_t m = 0; m < matrix.m_nnode; ++m) {
+        for (size_t i = 0; i < matrix.m_ndim; ++i) {
+            if (dofs(m, i) < nnu) {
+                m_B_u(dofs(m, i)) = b(m, i);
+            }
+            else if (dofs(m, i) < nni) {
+                m_X_p(dofs(m, i) - nnu) = x(m, i);
+            }
+            else {
+                m_B_d(dofs(m, i) - nni) = b(m, i);
+            }
+        }
+    }
+
+    m_B_u.noalias() += matrix.m_Cud * m_B_d;
+    m_B_u.noalias() -= matrix.m_ACup * m_X_p;
 
-    Eigen::VectorXd X_u = m_solver.solve(Eigen::VectorXd(B_u - matrix.m_ACup * X_p));
-    Eigen::VectorXd X_d = matrix.m_Cdu * X_u + matrix.m_Cdp * X_p;
+    this->solve_uu(m_B_u, m_X_u);
+
+    m_X_d.noalias() = matrix.m_Cdu * m_X_u;
+    m_X_d.noalias() += matrix.m_Cdp * m_X_p;
 
     #pragma omp parallel for
     for (size_t m = 0; m < matrix.m_nnode; ++m) {
         for (size_t i = 0; i < matrix.m_ndim; ++i) {
-            if (matrix.m_dofs(m, i) < matrix.m_nnu) {
-                x(m, i) = X_u(matrix.m_dofs(m, i));
+            if (dofs(m, i) < nnu) {
+                x(m, i) = m_X_u(dofs(m, i));
             }
-            else if (matrix.m_dofs(m, i) >= matrix.m_nni) {
-                x(m, i) = X_d(matrix.m_dofs(m, i) - matrix.m_nni);
+            else if (dofs(m, i) >= nni) {
+                x(m, i) = m_X_d(dofs(m, i) - nni);
             }
         }
     }
@@ -375,24 +636,29 @@ inline void MatrixPartitionedTyingsSolver<Solver>::solve(
     GOOSEFEM_ASSERT(b.size() == matrix.m_ndof);
     GOOSEFEM_ASSERT(x.size() == matrix.m_ndof);
 
+    using map = Eigen::Map<Eigen::VectorXd>;
+    using cmap = Eigen::Map<const Eigen::VectorXd>;
+
+    size_t nnu = matrix.m_nnu;
+    size_t nnp = matrix.m_nnp;
+    size_t nni = matrix.m_nni;
+    size_t nnd = matrix.m_nnd;
+
     this->factorize(matrix);
 
-    Eigen::VectorXd B_u = matrix.AsDofs_u(b);
-    Eigen::VectorXd B_d = matrix.AsDofs_d(b);
-    Eigen::VectorXd X_p = matrix.AsDofs_p(x);
+    // the DOFs are numbered [iiu, iip, iid]: all partitions are contiguous in "dofval"
+    map X_u(x.data(), nnu);
+    map X_d(x.data() + nni, nnd);
+    cmap X_p(x.data() + nnu, nnp);
 
-    Eigen::VectorXd X_u = m_solver.solve(Eigen::VectorXd(B_u - matrix.m_ACup * X_p));
-    Eigen::VectorXd X_d = matrix.m_Cdu * X_u + matrix.m_Cdp * X_p;
+    m_B_u = cmap(b.data(), nnu);
+    m_B_u.noalias() += matrix.m_Cud * cmap(b.data() + nni, nnd);
+    m_B_u.noalias() -= matrix.m_ACup * X_p;
 
-    #pragma omp parallel for
-    for (size_t d = 0; d < matrix.m_nnu; ++d) {
-        x(matrix.m_iiu(d)) = X_u(d);
-    }
+    this->solve_uu(m_B_u, X_u);
 
-    #pragma omp parallel for
-    for (size_t d = 0; d < matrix.m_nnd; ++d) {
-        x(matrix.m_iid(d)) = X_d(d);
-    }
+    X_d.noalias() = matrix.m_Cdu * X_u;
+    X_d.noalias() += matrix.m_Cdp * X_p;
 }
 
 template <class Solver>
@@ -403,17 +669,138 @@ inline void MatrixPartitionedTyingsSolver<Solver>::solve_u(
     const xt::xtensor<double, 1>& x_p,
     xt::xtensor<double, 1>& x_u)
 {
-    UNUSED(b_d);
     GOOSEFEM_ASSERT(b_u.size() == matrix.m_nnu);
     GOOSEFEM_ASSERT(b_d.size() == matrix.m_nnd);
     GOOSEFEM_ASSERT(x_p.size() == matrix.m_nnp);
     GOOSEFEM_ASSERT(x_u.size() == matrix.m_nnu);
 
+    using cmap = Eigen::Map<const Eigen::VectorXd>;
+
     this->factorize(matrix);
 
-    Eigen::Map<Eigen::VectorXd>(x_u.data(), x_u.size()).noalias() = m_solver.solve(Eigen::VectorXd(
-        Eigen::Map<const Eigen::VectorXd>(b_u.data(), b_u.size()) -
-        matrix.m_ACup * Eigen::Map<const Eigen::VectorXd>(x_p.data(), x_p.size())));
+    m_B_u = cmap(b_u.data(), b_u.size());
+    m_B_u.noalias() += matrix.m_Cud * cmap(b_d.data(), b_d.size());
+    m_B_u.noalias() -= matrix.m_ACup * cmap(x_p.data(), x_p.size());
+
+    Eigen::Map<Eigen::VectorXd> X_u(x_u.data(), x_u.size());
+    this->solve_uu(m_B_u, X_u);
+}
+
+template <class Solver>
+inline void MatrixPartitionedTyingsSolver<Solver>::solve(
+    MatrixPartitionedTyings& matrix, const xt::xtensor<double, 3>& b, xt::xtensor<double, 3>& x)
+{
+    size_t nrhs = b.shape(0);
+
+    GOOSEFEM_ASSERT(xt::has_shape(b, {nrhs, matrix.m_nnode, matrix.m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(x, {nrhs, matrix.m_nnode, matrix.m_ndim}));
+
+    const auto& dofs = matrix.m_topo.dofs();
+    size_t nnu = matrix.m_nnu;
+    size_t nni = matrix.m_nni;
+
+    this->factorize(matrix);
+
+    Eigen::MatrixXd B_u = Eigen::MatrixXd::Zero(nnu, nrhs);
+    Eigen::MatrixXd B_d = Eigen::MatrixXd::Zero(matrix.m_nnd, nrhs);
+    Eigen::MatrixXd X_p = Eigen::MatrixXd::Zero(matrix.m_nnp, nrhs);
+
+    for (size_t r = 0; r < nrhs; ++r) {
+        for (size_t m = 0; m < matrix.m_nnode; ++m) {
+            for (size_t i = 0; i < matrix.m_ndim; ++i) {
+                size_t d = dofs(m, i);
+                if (d < nnu) {
+                    B_u(d, r) = b(r, m, i);
+                }
+                else if (d < nni) {
+                    X_p(d - nnu, r) = x(r, m, i);
+                }
+                else {
+                    B_d(d - nni, r) = b(r, m, i);
+                }
+            }
+        }
+    }
+
+    B_u += matrix.m_Cud * B_d;
+
+    Eigen::MatrixXd X_u = this->solve_uu(Eigen::MatrixXd(B_u - matrix.m_ACup * X_p));
+    Eigen::MatrixXd X_d = matrix.m_Cdu * X_u + matrix.m_Cdp * X_p;
+
+    for (size_t r = 0; r < nrhs; ++r) {
+        for (size_t m = 0; m < matrix.m_nnode; ++m) {
+            for (size_t i = 0; i < matrix.m_ndim; ++i) {
+                size_t d = dofs(m, i);
+                if (d < nnu) {
+                    x(r, m, i) = X_u(d, r);
+                }
+                else if (d >= nni) {
+                    x(r, m, i) = X_d(d - nni, r);
+                }
+            }
+        }
+    }
+}
+
+template <class Solver>
+inline void MatrixPartitionedTyingsSolver<Solver>::solve_u(
+    MatrixPartitionedTyings& matrix,
+    const xt::xtensor<double, 2>& b_u,
+    const xt::xtensor<double, 2>& b_d,
+    const xt::xtensor<double, 2>& x_p,
+    xt::xtensor<double, 2>& x_u)
+{
+    size_t nrhs = b_u.shape(0);
+
+    GOOSEFEM_ASSERT(xt::has_shape(b_u, {nrhs, matrix.m_nnu}));
+    GOOSEFEM_ASSERT(xt::has_shape(b_d, {nrhs, matrix.m_nnd}));
+    GOOSEFEM_ASSERT(xt::has_shape(x_p, {nrhs, matrix.m_nnp}));
+    GOOSEFEM_ASSERT(xt::has_shape(x_u, {nrhs, matrix.m_nnu}));
+
+    this->factorize(matrix);
+
+    // row-major [nrhs, n] is column-major [n, nrhs]: no copies needed
+    using map = Eigen::Map<const Eigen::MatrixXd>;
+    Eigen::Index nnu = static_cast<Eigen::Index>(matrix.m_nnu);
+    Eigen::Index nnd = static_cast<Eigen::Index>(matrix.m_nnd);
+    Eigen::Index nnp = static_cast<Eigen::Index>(matrix.m_nnp);
+    Eigen::Index n = static_cast<Eigen::Index>(nrhs);
+
+    Eigen::Map<Eigen::MatrixXd>(x_u.data(), nnu, n).noalias() = this->solve_uu(Eigen::MatrixXd(
+        map(b_u.data(), nnu, n) + matrix.m_Cud * map(b_d.data(), nnd, n) -
+        matrix.m_ACup * map(x_p.data(), nnp, n)));
+}
+
+template <class Solver>
+inline void MatrixPartitionedTyingsSolver<Solver>::effective_pp(
+    MatrixPartitionedTyings& matrix, xt::xtensor<double, 2>& K_pp)
+{
+    size_t nnp = matrix.m_nnp;
+
+    GOOSEFEM_ASSERT(xt::has_shape(K_pp, {nnp, nnp}));
+
+    this->factorize(matrix);
+
+    // only the prescribed DOFs coupled to unknown DOFs (nonzero columns of "A'_up") need a solve
+    std::vector<Eigen::Index> cols = detail::nonzeroCols(matrix.m_ACup);
+    Eigen::MatrixXd X = this->solve_uu(detail::denseCols(matrix.m_ACup, cols));
+    Eigen::MatrixXd Y = matrix.m_ACpu * X;
+
+    // "K_pp" is row-major
+    Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>> K(
+        K_pp.data(), nnp, nnp);
+
+    K.setZero();
+
+    for (int k = 0; k < matrix.m_ACpp.outerSize(); ++k) {
+        for (Eigen::SparseMatrix<double>::InnerIterator it(matrix.m_ACpp, k); it; ++it) {
+            K(it.row(), it.col()) = it.value();
+        }
+    }
+
+    for (size_t c = 0; c < cols.size(); ++c) {
+        K.col(cols[c]) -= Y.col(c);
+    }
 }
 
 template <class Solver>
@@ -450,6 +837,38 @@ inline xt::xtensor<double, 1> MatrixPartitionedTyingsSolver<Solver>::Solve_u(
     return x_u;
 }
 
+template <class Solver>
+inline xt::xtensor<double, 3> MatrixPartitionedTyingsSolver<Solver>::Solve(
+    MatrixPartitionedTyings& matrix,
+    const xt::xtensor<double, 3>& b,
+    const xt::xtensor<double, 3>& x)
+{
+    xt::xtensor<double, 3> ret = x;
+    this->solve(matrix, b, ret);
+    return ret;
+}
+
+template <class Solver>
+inline xt::xtensor<double, 2> MatrixPartitionedTyingsSolver<Solver>::Solve_u(
+    MatrixPartitionedTyings& matrix,
+    const xt::xtensor<double, 2>& b_u,
+    const xt::xtensor<double, 2>& b_d,
+    const xt::xtensor<double, 2>& x_p)
+{
+    xt::xtensor<double, 2> x_u = xt::empty<double>({b_u.shape(0), matrix.m_nnu});
+    this->solve_u(matrix, b_u, b_d, x_p, x_u);
+    return x_u;
+}
+
+template <class Solver>
+inline xt::xtensor<double, 2>
+MatrixPartitionedTyingsSolver<Solver>::Effective_pp(MatrixPartitionedTyings& matrix)
+{
+    xt::xtensor<double, 2> K_pp = xt::empty<double>({matrix.m_nnp, matrix.m_nnp});
+    this->effective_pp(matrix, K_pp);
+    return K_pp;
+}
+
 } // namespace GooseFEM
 
 #endif
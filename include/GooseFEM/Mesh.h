@@ -17,7 +17,9 @@ namespace Mesh {
 enum class ElementType {
     Quad4, // Quadrilateral: 4-noded element in 2-d
     Hex8, // Hexahedron: 8-noded element in 3-d
-    Tri3 }; // Triangle: 3-noded element in 2-d
+    Tri3, // Triangle: 3-noded element in 2-d
+    Quad9, // Quadrilateral: 9-noded (quadratic) element in 2-d
+    Hex27 }; // Hexahedron: 27-noded (quadratic) element in 3-d
 
 // Extract the element type based on the connectivity
 
@@ -128,6 +130,7 @@ public:
     // constructors
     Reorder() = default;
     Reorder(const std::initializer_list<xt::xtensor<size_t, 1>> args);
+    Reorder(const std::vector<xt::xtensor<size_t, 1>>& args);
 
     // get reordered DOFs (same as "Reorder::apply(dofs)")
     xt::xtensor<size_t, 2> get(const xt::xtensor<size_t, 2>& dofs) const;
@@ -158,6 +161,9 @@ inline std::vector<std::vector<size_t>> elem2node(
     const xt::xtensor<size_t, 2>& conn,
     bool sorted=true); // ensure the output to be sorted
 
+// elements connected to each element (sharing at least one node)
+inline std::vector<std::vector<size_t>> elem2elem(const xt::xtensor<size_t, 2>& conn);
+
 // return size of each element edge
 inline xt::xtensor<double, 2> edgesize(
     const xt::xtensor<double, 2>& coor,
@@ -192,6 +198,88 @@ inline xt::xtensor<size_t, 1> elemmap2nodemap(
     const xt::xtensor<size_t, 2>& conn,
     ElementType type);
 
+// Partition the elements in "nparts" parts of (almost) equal size, by recursive coordinate
+// bisection of the element centers (bisecting each time the direction of largest extent).
+// Return: part of each element [nelem]
+inline xt::xtensor<size_t, 1> partitionRCB(
+    const xt::xtensor<double, 2>& coor,
+    const xt::xtensor<size_t, 2>& conn,
+    size_t nparts);
+
+// Partition the elements in "nparts" parts, minimising the number of interface nodes, with a
+// multilevel graph partitioner on the element adjacency: the graph is coarsened by heavy-edge
+// matching, partitioned by graph growing, and refined at each level while uncoarsening.
+// The weight of the parts is at most "(1 + imbalance) * nelem / nparts".
+// Return: part of each element [nelem]
+inline xt::xtensor<size_t, 1> partitionGraph(
+    const xt::xtensor<size_t, 2>& conn,
+    size_t nparts,
+    double imbalance = 0.03);
+
+// Bookkeeping of a partition of the elements (e.g. from "partitionRCB" or "partitionGraph").
+// Nodes connected to elements of more than one part are "interface" nodes, all other nodes are
+// "interior" nodes of a part. Each node is assigned to the lowest part it is connected to.
+//
+// Renumbering such that elements and interior nodes are contiguous per part (interface last):
+//
+//   new_conn = Partition::reorder().apply(xt::view(conn, xt::keep(Partition::elemmap())))
+//   new_coor = xt::view(coor, xt::keep(Partition::nodemap()))
+//
+// after which the elements of part "p" are "xt::arange(elemOffset()(p), elemOffset()(p + 1))".
+// Any part can be used directly (without renumbering) through "Topology::Subset(elements(p))".
+
+class Partition {
+public:
+    // constructors
+    Partition() = default;
+
+    Partition(
+        const xt::xtensor<size_t, 2>& conn,       // connectivity [nelem, nne]
+        const xt::xtensor<size_t, 1>& elem_part); // part of each element [nelem]
+
+    // number of parts
+    size_t nparts() const;
+
+    // part of each element [nelem] / node [nnode] (lowest part connected to the node)
+    const xt::xtensor<size_t, 1>& elemPart() const;
+    const xt::xtensor<size_t, 1>& nodePart() const;
+
+    // elements / nodes of a part (sorted)
+    const xt::xtensor<size_t, 1>& elements(size_t part) const;
+    const xt::xtensor<size_t, 1>& nodes(size_t part) const;
+
+    // interior nodes (only connected to one part) / interface nodes of a part (sorted),
+    // by node connectivity only (see below for shared DOFs)
+    const xt::xtensor<size_t, 1>& nodesInterior(size_t part) const;
+    const xt::xtensor<size_t, 1>& nodesInterface(size_t part) const;
+
+    // all interface nodes (sorted)
+    const xt::xtensor<size_t, 1>& nodesInterface() const;
+
+    // nodes of a part with a DOF that is also a DOF of another part (sorted), given the DOFs per
+    // node "dofs" [nnode, ndim]: includes the interface nodes, and the nodes that share DOFs with
+    // nodes of other parts without sharing an element (e.g. periodicity).
+    // Use this list (not "nodesInterface(part)") as the halo of Distributed::Topology.
+    xt::xtensor<size_t, 1> nodesInterface(size_t part, const xt::xtensor<size_t, 2>& dofs) const;
+
+    // renumbering (see above):
+    // new_elemvar = elemvar[elemmap], new_nodevar = nodevar[nodemap]
+    xt::xtensor<size_t, 1> elemmap() const;
+    xt::xtensor<size_t, 1> nodemap() const;
+    xt::xtensor<size_t, 1> elemOffset() const; // [nparts + 1]
+    Reorder reorder() const;
+
+private:
+    size_t m_nparts = 0;
+    xt::xtensor<size_t, 1> m_elem_part;
+    xt::xtensor<size_t, 1> m_node_part;
+    std::vector<xt::xtensor<size_t, 1>> m_elem;
+    std::vector<xt::xtensor<size_t, 1>> m_node;
+    std::vector<xt::xtensor<size_t, 1>> m_interior;
+    std::vector<xt::xtensor<size_t, 1>> m_interface;
+    xt::xtensor<size_t, 1> m_interface_all;
+};
+
 // Find overlapping nodes
 // Return: [[nodes_from_mesh_a],
 //          [nodes_from_mesh_b]]
@@ -25,6 +25,12 @@ inline ElementType defaultElementType(
     if (coor.shape(1) == 3ul && conn.shape(1) == 8ul) {
         return ElementType::Hex8;
     }
+    if (coor.shape(1) == 2ul && conn.shape(1) == 9ul) {
+        return ElementType::Quad9;
+    }
+    if (coor.shape(1) == 3ul && conn.shape(1) == 27ul) {
+        return ElementType::Hex27;
+    }
 
     throw std::runtime_error("Element-type not implemented");
 }
@@ -307,6 +313,11 @@ inline xt::xtensor<size_t, 1> Renumber::index() const
 }
 
 inline Reorder::Reorder(const std::initializer_list<xt::xtensor<size_t, 1>> args)
+    : Reorder(std::vector<xt::xtensor<size_t, 1>>(args))
+{
+}
+
+inline Reorder::Reorder(const std::vector<xt::xtensor<size_t, 1>>& args)
 {
     size_t n = 0;
     size_t i = 0;
@@ -410,6 +421,28 @@ inline std::vector<std::vector<size_t>> elem2node(const xt::xtensor<size_t, 2>&
     return ret;
 }
 
+inline std::vector<std::vector<size_t>> elem2elem(const xt::xtensor<size_t, 2>& conn)
+{
+    auto elems = elem2node(conn, false);
+    size_t nelem = conn.shape(0);
+
+    std::vector<std::vector<size_t>> ret(nelem);
+
+    for (size_t e = 0; e < nelem; ++e) {
+        for (size_t m = 0; m < conn.shape(1); ++m) {
+            for (auto& f : elems[conn(e, m)]) {
+                if (f != e) {
+                    ret[e].push_back(f);
+                }
+            }
+        }
+        std::sort(ret[e].begin(), ret[e].end());
+        ret[e].erase(std::unique(ret[e].begin(), ret[e].end()), ret[e].end());
+    }
+
+    return ret;
+}
+
 inline xt::xtensor<double, 2> edgesize(
     const xt::xtensor<double, 2>& coor, const xt::xtensor<size_t, 2>& conn, ElementType type)
 {
@@ -467,6 +500,28 @@ inline xt::xtensor<double, 2> centers(
         return ret;
     }
 
+    if (type == ElementType::Tri3) {
+        GOOSEFEM_ASSERT(coor.shape(1) == 2);
+        GOOSEFEM_ASSERT(conn.shape(1) == 3);
+        for (size_t i = 0; i < 3; ++i) {
+            auto n = xt::view(conn, xt::all(), i);
+            ret += xt::view(coor, xt::keep(n), xt::all());
+        }
+        ret /= 3.0;
+        return ret;
+    }
+
+    if (type == ElementType::Hex8) {
+        GOOSEFEM_ASSERT(coor.shape(1) == 3);
+        GOOSEFEM_ASSERT(conn.shape(1) == 8);
+        for (size_t i = 0; i < 8; ++i) {
+            auto n = xt::view(conn, xt::all(), i);
+            ret += xt::view(coor, xt::keep(n), xt::all());
+        }
+        ret /= 8.0;
+        return ret;
+    }
+
     throw std::runtime_error("Element-type not implemented");
 }
 
@@ -546,6 +601,597 @@ inline xt::xtensor<size_t, 2> overlapping(
     return ret;
 }
 
+namespace detail {
+
+    // Weighted graph in compressed-row format: the neighbours of vertex "i" are
+    // "adj[ptr[i]: ptr[i + 1]]", with edge weights "ew[ptr[i]: ptr[i + 1]]"
+    struct Graph {
+        std::vector<size_t> ptr;
+        std::vector<size_t> adj;
+        std::vector<size_t> ew;
+        std::vector<size_t> vw;
+
+        size_t size() const
+        {
+            return vw.size();
+        }
+    };
+
+    // Element adjacency, weighted with the number of shared nodes
+    inline Graph elementGraph(const xt::xtensor<size_t, 2>& conn)
+    {
+        size_t nelem = conn.shape(0);
+        size_t nne = conn.shape(1);
+        auto elems = elem2node(conn, false);
+
+        Graph g;
+        g.vw.assign(nelem, 1);
+        g.ptr.assign(1, 0);
+
+        std::vector<size_t> weight(nelem, 0);
+        std::vector<size_t> touched;
+
+        for (size_t e = 0; e < nelem; ++e) {
+            touched.clear();
+            for (size_t m = 0; m < nne; ++m) {
+                for (auto& f : elems[conn(e, m)]) {
+                    if (f == e) {
+                        continue;
+                    }
+                    if (weight[f] == 0) {
+                        touched.push_back(f);
+                    }
+                    weight[f] += 1;
+                }
+            }
+            std::sort(touched.begin(), touched.end());
+            for (auto& f : touched) {
+                g.adj.push_back(f);
+                g.ew.push_back(weight[f]);
+                weight[f] = 0;
+            }
+            g.ptr.push_back(g.adj.size());
+        }
+
+        return g;
+    }
+
+    // Coarsen by heavy-edge matching, "cmap" maps each vertex to its coarse vertex
+    inline Graph coarsen(const Graph& g, std::vector<size_t>& cmap)
+    {
+        size_t n = g.size();
+        std::vector<size_t> match(n, n);
+        std::vector<size_t> first;
+
+        cmap.assign(n, n);
+
+        for (size_t v = 0; v < n; ++v) {
+            if (match[v] != n) {
+                continue;
+            }
+            size_t best = v;
+            size_t w = 0;
+            for (size_t k = g.ptr[v]; k < g.ptr[v + 1]; ++k) {
+                size_t u = g.adj[k];
+                if (match[u] == n && g.ew[k] > w) {
+                    best = u;
+                    w = g.ew[k];
+                }
+            }
+            match[v] = best;
+            match[best] = v;
+            cmap[v] = first.size();
+            cmap[best] = first.size();
+            first.push_back(v);
+        }
+
+        size_t nc = first.size();
+
+        Graph c;
+        c.vw.assign(nc, 0);
+        c.ptr.assign(1, 0);
+
+        std::vector<size_t> weight(nc, 0);
+        std::vector<size_t> touched;
+
+        for (size_t cv = 0; cv < nc; ++cv) {
+            touched.clear();
+            size_t v = first[cv];
+            for (size_t i = 0; i < (match[v] == v ? 1 : 2); ++i) {
+                size_t w = i == 0 ? v : match[v];
+                c.vw[cv] += g.vw[w];
+                for (size_t k = g.ptr[w]; k < g.ptr[w + 1]; ++k) {
+                    size_t cu = cmap[g.adj[k]];
+                    if (cu == cv) {
+                        continue;
+                    }
+                    if (weight[cu] == 0) {
+                        touched.push_back(cu);
+                    }
+                    weight[cu] += g.ew[k];
+                }
+            }
+            std::sort(touched.begin(), touched.end());
+            for (auto& cu : touched) {
+                c.adj.push_back(cu);
+                c.ew.push_back(weight[cu]);
+                weight[cu] = 0;
+            }
+            c.ptr.push_back(c.adj.size());
+        }
+
+        return c;
+    }
+
+    // Initial partition by graph growing (breadth-first from the lowest unassigned vertex)
+    inline std::vector<size_t> grow(const Graph& g, size_t nparts)
+    {
+        size_t n = g.size();
+        size_t total = std::accumulate(g.vw.begin(), g.vw.end(), size_t(0));
+        size_t assigned = 0;
+        size_t seed = 0;
+        std::vector<size_t> part(n, nparts);
+
+        for (size_t p = 0; p + 1 < nparts; ++p) {
+
+            size_t target = (total * (p + 1)) / nparts;
+            size_t count = 0;
+            std::vector<size_t> queue;
+            size_t front = 0;
+
+            while (assigned < target || count == 0) {
+
+                if (front == queue.size()) {
+                    while (seed < n && part[seed] != nparts) {
+                        ++seed;
+                    }
+                    if (seed == n) {
+                        break;
+                    }
+                    part[seed] = p;
+                    assigned += g.vw[seed];
+                    ++count;
+                    queue.push_back(seed);
+                    continue;
+                }
+
+                size_t v = queue[front];
+                ++front;
+
+                for (size_t k = g.ptr[v]; k < g.ptr[v + 1]; ++k) {
+                    size_t u = g.adj[k];
+                    if (assigned < target && part[u] == nparts) {
+                        part[u] = p;
+                        assigned += g.vw[u];
+                        ++count;
+                        queue.push_back(u);
+                    }
+                }
+            }
+        }
+
+        for (auto& p : part) {
+            if (p == nparts) {
+                p = nparts - 1;
+            }
+        }
+
+        return part;
+    }
+
+    // Greedy boundary refinement: move vertices to the neighbouring part to which they are most
+    // strongly connected, as long as that reduces the cut (or the overweight) and respects "maxw"
+    inline void refine(const Graph& g, size_t nparts, double imbalance, std::vector<size_t>& part)
+    {
+        size_t n = g.size();
+        size_t total = std::accumulate(g.vw.begin(), g.vw.end(), size_t(0));
+        size_t maxw = static_cast<size_t>(
+            std::ceil((1.0 + imbalance) * static_cast<double>(total) / static_cast<double>(nparts)));
+
+        std::vector<size_t> pw(nparts, 0);
+        std::vector<size_t> con(nparts, 0);
+        std::vector<size_t> touched;
+
+        for (size_t v = 0; v < n; ++v) {
+            pw[part[v]] += g.vw[v];
+        }
+
+        for (size_t pass = 0; pass < 10; ++pass) {
+
+            size_t moves = 0;
+
+            for (size_t v = 0; v < n; ++v) {
+
+                size_t p = part[v];
+
+                if (pw[p] <= g.vw[v]) {
+                    continue;
+                }
+
+                touched.clear();
+
+                for (size_t k = g.ptr[v]; k < g.ptr[v + 1]; ++k) {
+                    size_t q = part[g.adj[k]];
+                    if (con[q] == 0) {
+                        touched.push_back(q);
+                    }
+                    con[q] += g.ew[k];
+                }
+
+                bool over = pw[p] > maxw;
+                size_t best = p;
+
+                for (auto& q : touched) {
+                    if (q == p || pw[q] + g.vw[v] > maxw) {
+                        continue;
+                    }
+                    if (!over && con[q] < con[p]) {
+                        continue;
+                    }
+                    if (!over && con[q] == con[p] && pw[q] + g.vw[v] >= pw[p]) {
+                        continue;
+                    }
+                    if (best == p || con[q] > con[best] || (con[q] == con[best] && pw[q] < pw[best])) {
+                        best = q;
+                    }
+                }
+
+                for (auto& q : touched) {
+                    con[q] = 0;
+                }
+
+                if (best != p) {
+                    pw[p] -= g.vw[v];
+                    pw[best] += g.vw[v];
+                    part[v] = best;
+                    ++moves;
+                }
+            }
+
+            if (moves == 0) {
+                break;
+            }
+        }
+    }
+
+    // Recursive coordinate bisection of the elements in "[begin, end)" over parts "offset + i"
+    inline void rcb(
+        const xt::xtensor<double, 2>& x,
+        std::vector<size_t>::iterator begin,
+        std::vector<size_t>::iterator end,
+        size_t offset,
+        size_t nparts,
+        xt::xtensor<size_t, 1>& part)
+    {
+        if (nparts == 1) {
+            for (auto it = begin; it != end; ++it) {
+                part(*it) = offset;
+            }
+            return;
+        }
+
+        size_t ndim = x.shape(1);
+        size_t axis = 0;
+        double extent = -1.0;
+
+        for (size_t d = 0; d < ndim; ++d) {
+            auto mm = std::minmax_element(begin, end, [&](size_t a, size_t b) {
+                return x(a, d) < x(b, d);
+            });
+            double l = x(*mm.second, d) - x(*mm.first, d);
+            if (l > extent) {
+                extent = l;
+                axis = d;
+            }
+        }
+
+        size_t nleft = nparts / 2;
+        size_t n = static_cast<size_t>(end - begin);
+        auto mid = begin + (n * nleft) / nparts;
+
+        std::nth_element(begin, mid, end, [&](size_t a, size_t b) {
+            return x(a, axis) < x(b, axis) || (x(a, axis) == x(b, axis) && a < b);
+        });
+
+        rcb(x, begin, mid, offset, nleft, part);
+        rcb(x, mid, end, offset + nleft, nparts - nleft, part);
+    }
+
+} // namespace detail
+
+inline xt::xtensor<size_t, 1> partitionRCB(
+    const xt::xtensor<double, 2>& coor,
+    const xt::xtensor<size_t, 2>& conn,
+    size_t nparts)
+{
+    GOOSEFEM_ASSERT(nparts > 0);
+    GOOSEFEM_ASSERT(nparts <= conn.shape(0));
+
+    size_t nelem = conn.shape(0);
+    xt::xtensor<double, 2> x = centers(coor, conn);
+    xt::xtensor<size_t, 1> ret = xt::empty<size_t>({nelem});
+
+    std::vector<size_t> elem(nelem);
+    std::iota(elem.begin(), elem.end(), 0);
+
+    detail::rcb(x, elem.begin(), elem.end(), 0, nparts, ret);
+
+    return ret;
+}
+
+inline xt::xtensor<size_t, 1>
+partitionGraph(const xt::xtensor<size_t, 2>& conn, size_t nparts, double imbalance)
+{
+    GOOSEFEM_ASSERT(nparts > 0);
+    GOOSEFEM_ASSERT(nparts <= conn.shape(0));
+    GOOSEFEM_ASSERT(imbalance >= 0.0);
+
+    size_t nelem = conn.shape(0);
+    xt::xtensor<size_t, 1> ret = xt::zeros<size_t>({nelem});
+
+    if (nparts == 1) {
+        return ret;
+    }
+
+    // coarsen (until the graph is small, or coarsening stagnates)
+
+    std::vector<detail::Graph> graphs;
+    std::vector<std::vector<size_t>> cmaps;
+    graphs.push_back(detail::elementGraph(conn));
+
+    while (graphs.back().size() > 20 * nparts) {
+        std::vector<size_t> cmap;
+        detail::Graph c = detail::coarsen(graphs.back(), cmap);
+        if (10 * c.size() > 9 * graphs.back().size()) {
+            break;
+        }
+        cmaps.push_back(std::move(cmap));
+        graphs.push_back(std::move(c));
+    }
+
+    // partition the coarsest graph
+
+    std::vector<size_t> part = detail::grow(graphs.back(), nparts);
+    detail::refine(graphs.back(), nparts, imbalance, part);
+
+    // project on the finer graphs, and refine
+
+    for (size_t l = cmaps.size(); l > 0; --l) {
+        const auto& cmap = cmaps[l - 1];
+        std::vector<size_t> fine(cmap.size());
+        for (size_t v = 0; v < cmap.size(); ++v) {
+            fine[v] = part[cmap[v]];
+        }
+        part = std::move(fine);
+        detail::refine(graphs[l - 1], nparts, imbalance, part);
+    }
+
+    std::copy(part.begin(), part.end(), ret.begin());
+
+    return ret;
+}
+
+inline Partition::Partition(
+    const xt::xtensor<size_t, 2>& conn, const xt::xtensor<size_t, 1>& elem_part)
+    : m_elem_part(elem_part)
+{
+    GOOSEFEM_ASSERT(elem_part.size() == conn.shape(0));
+
+    size_t nelem = conn.shape(0);
+    size_t nne = conn.shape(1);
+    size_t nnode = xt::amax(conn)() + 1;
+    m_nparts = xt::amax(elem_part)() + 1;
+
+    // elements per part
+
+    std::vector<std::vector<size_t>> elem(m_nparts);
+
+    for (size_t e = 0; e < nelem; ++e) {
+        elem[elem_part(e)].push_back(e);
+    }
+
+    // lowest part connected to each node ("nparts" signals "not connected"),
+    // and number of parts connected to each node
+
+    m_node_part = xt::empty<size_t>({nnode});
+    m_node_part.fill(m_nparts);
+    std::vector<size_t> nconnected(nnode, 0);
+    std::vector<size_t> last(nnode, m_nparts);
+
+    for (size_t p = 0; p < m_nparts; ++p) {
+        for (auto& e : elem[p]) {
+            for (size_t m = 0; m < nne; ++m) {
+                size_t n = conn(e, m);
+                if (last[n] != p) {
+                    last[n] = p;
+                    nconnected[n] += 1;
+                    m_node_part(n) = std::min(m_node_part(n), p);
+                }
+            }
+        }
+    }
+
+    GOOSEFEM_ASSERT(std::find(nconnected.begin(), nconnected.end(), 0) == nconnected.end());
+
+    // nodes per part
+
+    std::vector<std::vector<size_t>> node(m_nparts);
+    std::vector<std::vector<size_t>> interior(m_nparts);
+    std::vector<std::vector<size_t>> interface(m_nparts);
+    std::vector<size_t> interface_all;
+
+    for (size_t p = 0; p < m_nparts; ++p) {
+        for (auto& e : elem[p]) {
+            for (size_t m = 0; m < nne; ++m) {
+                node[p].push_back(conn(e, m));
+            }
+        }
+        std::sort(node[p].begin(), node[p].end());
+        node[p].erase(std::unique(node[p].begin(), node[p].end()), node[p].end());
+        for (auto& n : node[p]) {
+            if (nconnected[n] > 1) {
+                interface[p].push_back(n);
+            }
+            else {
+                interior[p].push_back(n);
+            }
+        }
+    }
+
+    for (size_t n = 0; n < nnode; ++n) {
+        if (nconnected[n] > 1) {
+            interface_all.push_back(n);
+        }
+    }
+
+    // store
+
+    auto as_tensor = [](const std::vector<size_t>& list) {
+        xt::xtensor<size_t, 1> ret = xt::empty<size_t>({list.size()});
+        std::copy(list.begin(), list.end(), ret.begin());
+        return ret;
+    };
+
+    for (size_t p = 0; p < m_nparts; ++p) {
+        m_elem.push_back(as_tensor(elem[p]));
+        m_node.push_back(as_tensor(node[p]));
+        m_interior.push_back(as_tensor(interior[p]));
+        m_interface.push_back(as_tensor(interface[p]));
+    }
+
+    m_interface_all = as_tensor(interface_all);
+}
+
+inline size_t Partition::nparts() const
+{
+    return m_nparts;
+}
+
+inline const xt::xtensor<size_t, 1>& Partition::elemPart() const
+{
+    return m_elem_part;
+}
+
+inline const xt::xtensor<size_t, 1>& Partition::nodePart() const
+{
+    return m_node_part;
+}
+
+inline const xt::xtensor<size_t, 1>& Partition::elements(size_t part) const
+{
+    GOOSEFEM_ASSERT(part < m_nparts);
+    return m_elem[part];
+}
+
+inline const xt::xtensor<size_t, 1>& Partition::nodes(size_t part) const
+{
+    GOOSEFEM_ASSERT(part < m_nparts);
+    return m_node[part];
+}
+
+inline const xt::xtensor<size_t, 1>& Partition::nodesInterior(size_t part) const
+{
+    GOOSEFEM_ASSERT(part < m_nparts);
+    return m_interior[part];
+}
+
+inline const xt::xtensor<size_t, 1>& Partition::nodesInterface(size_t part) const
+{
+    GOOSEFEM_ASSERT(part < m_nparts);
+    return m_interface[part];
+}
+
+inline const xt::xtensor<size_t, 1>& Partition::nodesInterface() const
+{
+    return m_interface_all;
+}
+
+inline xt::xtensor<size_t, 1>
+Partition::nodesInterface(size_t part, const xt::xtensor<size_t, 2>& dofs) const
+{
+    GOOSEFEM_ASSERT(part < m_nparts);
+    GOOSEFEM_ASSERT(dofs.shape(0) >= m_node_part.size());
+
+    size_t ndim = dofs.shape(1);
+    std::vector<char> remote(xt::amax(dofs)() + 1, 0);
+
+    for (size_t p = 0; p < m_nparts; ++p) {
+        if (p != part) {
+            for (auto& n : m_node[p]) {
+                for (size_t i = 0; i < ndim; ++i) {
+                    remote[dofs(n, i)] = 1;
+                }
+            }
+        }
+    }
+
+    std::vector<size_t> ret;
+
+    for (auto& n : m_node[part]) {
+        for (size_t i = 0; i < ndim; ++i) {
+            if (remote[dofs(n, i)]) {
+                ret.push_back(n);
+                break;
+            }
+        }
+    }
+
+    return xt::adapt(ret);
+}
+
+inline xt::xtensor<size_t, 1> Partition::elemmap() const
+{
+    xt::xtensor<size_t, 1> ret = xt::empty<size_t>({m_elem_part.size()});
+    size_t i = 0;
+
+    for (auto& elem : m_elem) {
+        for (auto& e : elem) {
+            ret(i) = e;
+            ++i;
+        }
+    }
+
+    return ret;
+}
+
+inline xt::xtensor<size_t, 1> Partition::nodemap() const
+{
+    xt::xtensor<size_t, 1> ret = xt::empty<size_t>({m_node_part.size()});
+    size_t i = 0;
+
+    for (auto& interior : m_interior) {
+        for (auto& n : interior) {
+            ret(i) = n;
+            ++i;
+        }
+    }
+
+    for (auto& n : m_interface_all) {
+        ret(i) = n;
+        ++i;
+    }
+
+    return ret;
+}
+
+inline xt::xtensor<size_t, 1> Partition::elemOffset() const
+{
+    xt::xtensor<size_t, 1> ret = xt::zeros<size_t>({m_nparts + 1});
+
+    for (size_t p = 0; p < m_nparts; ++p) {
+        ret(p + 1) = ret(p) + m_elem[p].size();
+    }
+
+    return ret;
+}
+
+inline Reorder Partition::reorder() const
+{
+    std::vector<xt::xtensor<size_t, 1>> args = m_interior;
+    args.push_back(m_interface_all);
+    return Reorder(args);
+}
+
 } // namespace Mesh
 } // namespace GooseFEM
 
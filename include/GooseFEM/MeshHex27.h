@@ -0,0 +1,84 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_MESHHEX27_H
+#define GOOSEFEM_MESHHEX27_H
+
+#include "config.h"
+#include "MeshHex8.h"
+
+namespace GooseFEM {
+namespace Mesh {
+namespace Hex27 {
+
+// Regular mesh: equi-sized quadratic elements.
+// The nodes coincide with those of "Hex8::Regular(2 * nelx, 2 * nely, 2 * nelz, h / 2)" (same
+// numbering), the element connectivity follows "Element::Hex27" (lexicographic, x fastest).
+
+class Regular {
+public:
+    Regular(size_t nelx, size_t nely, size_t nelz, double h = 1.);
+
+    // size
+    size_t nelem() const; // number of elements
+    size_t nnode() const; // number of nodes
+    size_t nne() const;   // number of nodes-per-element
+    size_t ndim() const;  // number of dimensions
+
+    // type
+    ElementType getElementType() const;
+
+    // mesh
+    xt::xtensor<double, 2> coor() const; // nodal positions [nnode, ndim]
+    xt::xtensor<size_t, 2> conn() const; // connectivity [nelem, nne]
+
+    // boundary nodes: planes
+    xt::xtensor<size_t, 1> nodesFront() const;
+    xt::xtensor<size_t, 1> nodesBack() const;
+    xt::xtensor<size_t, 1> nodesLeft() const;
+    xt::xtensor<size_t, 1> nodesRight() const;
+    xt::xtensor<size_t, 1> nodesBottom() const;
+    xt::xtensor<size_t, 1> nodesTop() const;
+
+    // boundary nodes: faces
+    xt::xtensor<size_t, 1> nodesFrontFace() const;
+    xt::xtensor<size_t, 1> nodesBackFace() const;
+    xt::xtensor<size_t, 1> nodesLeftFace() const;
+    xt::xtensor<size_t, 1> nodesRightFace() const;
+    xt::xtensor<size_t, 1> nodesBottomFace() const;
+    xt::xtensor<size_t, 1> nodesTopFace() const;
+
+    // DOF-numbers for each component of each node (sequential)
+    xt::xtensor<size_t, 2> dofs() const;
+
+    // DOF-numbers for the case that the periodicity if fully eliminated
+    xt::xtensor<size_t, 2> dofsPeriodic() const;
+
+    // periodic node pairs [:,2]: (independent, dependent)
+    xt::xtensor<size_t, 2> nodesPeriodic() const;
+
+    // front-bottom-left node, used as reference for periodicity
+    size_t nodesOrigin() const;
+
+private:
+    Hex8::Regular m_grid;           // linear mesh with the same nodes
+    double m_h;                     // elementary element edge-size (in all directions)
+    size_t m_nelx;                  // number of elements in x-direction (length == "m_nelx * m_h")
+    size_t m_nely;                  // number of elements in y-direction (length == "m_nely * m_h")
+    size_t m_nelz;                  // number of elements in z-direction (length == "m_nelz * m_h")
+    size_t m_nelem;                 // number of elements
+    size_t m_nnode;                 // number of nodes
+    static const size_t m_nne = 27; // number of nodes-per-element
+    static const size_t m_ndim = 3; // number of dimensions
+};
+
+} // namespace Hex27
+} // namespace Mesh
+} // namespace GooseFEM
+
+#include "MeshHex27.hpp"
+
+#endif
@@ -0,0 +1,172 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_MESHHEX27_HPP
+#define GOOSEFEM_MESHHEX27_HPP
+
+#include "MeshHex27.h"
+
+namespace GooseFEM {
+namespace Mesh {
+namespace Hex27 {
+
+inline Regular::Regular(size_t nelx, size_t nely, size_t nelz, double h)
+    : m_grid(2 * nelx, 2 * nely, 2 * nelz, 0.5 * h),
+      m_h(h),
+      m_nelx(nelx),
+      m_nely(nely),
+      m_nelz(nelz)
+{
+    GOOSEFEM_ASSERT(m_nelx >= 1ul);
+    GOOSEFEM_ASSERT(m_nely >= 1ul);
+    GOOSEFEM_ASSERT(m_nelz >= 1ul);
+
+    m_nnode = m_grid.nnode();
+    m_nelem = m_nelx * m_nely * m_nelz;
+}
+
+inline size_t Regular::nelem() const
+{
+    return m_nelem;
+}
+
+inline size_t Regular::nnode() const
+{
+    return m_nnode;
+}
+
+inline size_t Regular::nne() const
+{
+    return m_nne;
+}
+
+inline size_t Regular::ndim() const
+{
+    return m_ndim;
+}
+
+inline ElementType Regular::getElementType() const
+{
+    return ElementType::Hex27;
+}
+
+inline xt::xtensor<double, 2> Regular::coor() const
+{
+    return m_grid.coor();
+}
+
+inline xt::xtensor<size_t, 2> Regular::conn() const
+{
+    xt::xtensor<size_t, 2> ret = xt::empty<size_t>({m_nelem, m_nne});
+
+    size_t nx = 2 * m_nelx + 1;
+    size_t nxy = nx * (2 * m_nely + 1);
+    size_t ielem = 0;
+
+    for (size_t iz = 0; iz < m_nelz; ++iz) {
+        for (size_t iy = 0; iy < m_nely; ++iy) {
+            for (size_t ix = 0; ix < m_nelx; ++ix) {
+                for (size_t a2 = 0; a2 < 3; ++a2) {
+                    for (size_t a1 = 0; a1 < 3; ++a1) {
+                        for (size_t a0 = 0; a0 < 3; ++a0) {
+                            ret(ielem, a0 + 3 * a1 + 9 * a2) =
+                                (2 * iz + a2) * nxy + (2 * iy + a1) * nx + 2 * ix + a0;
+                        }
+                    }
+                }
+                ++ielem;
+            }
+        }
+    }
+
+    return ret;
+}
+
+inline xt::xtensor<size_t, 1> Regular::nodesFront() const
+{
+    return m_grid.nodesFront();
+}
+
+inline xt::xtensor<size_t, 1> Regular::nodesBack() const
+{
+    return m_grid.nodesBack();
+}
+
+inline xt::xtensor<size_t, 1> Regular::nodesLeft() const
+{
+    return m_grid.nodesLeft();
+}
+
+inline xt::xtensor<size_t, 1> Regular::nodesRight() const
+{
+    return m_grid.nodesRight();
+}
+
+inline xt::xtensor<size_t, 1> Regular::nodesBottom() const
+{
+    return m_grid.nodesBottom();
+}
+
+inline xt::xtensor<size_t, 1> Regular::nodesTop() const
+{
+    return m_grid.nodesTop();
+}
+
+inline xt::xtensor<size_t, 1> Regular::nodesFrontFace() const
+{
+    return m_grid.nodesFrontFace();
+}
+
+inline xt::xtensor<size_t, 1> Regular::nodesBackFace() const
+{
+    return m_grid.nodesBackFace();
+}
+
+inline xt::xtensor<size_t, 1> Regular::nodesLeftFace() const
+{
+    return m_grid.nodesLeftFace();
+}
+
+inline xt::xtensor<size_t, 1> Regular::nodesRightFace() const
+{
+    return m_grid.nodesRightFace();
+}
+
+inline xt::xtensor<size_t, 1> Regular::nodesBottomFace() const
+{
+    return m_grid.nodesBottomFace();
+}
+
+inline xt::xtensor<size_t, 1> Regular::nodesTopFace() const
+{
+    return m_grid.nodesTopFace();
+}
+
+inline xt::xtensor<size_t, 2> Regular::dofs() const
+{
+    return m_grid.dofs();
+}
+
+inline xt::xtensor<size_t, 2> Regular::dofsPeriodic() const
+{
+    return m_grid.dofsPeriodic();
+}
+
+inline xt::xtensor<size_t, 2> Regular::nodesPeriodic() const
+{
+    return m_grid.nodesPeriodic();
+}
+
+inline size_t Regular::nodesOrigin() const
+{
+    return m_grid.nodesOrigin();
+}
+
+} // namespace Hex27
+} // namespace Mesh
+} // namespace GooseFEM
+
+#endif
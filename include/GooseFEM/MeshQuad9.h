@@ -0,0 +1,92 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_MESHQUAD9_H
+#define GOOSEFEM_MESHQUAD9_H
+
+#include "config.h"
+#include "MeshQuad4.h"
+
+namespace GooseFEM {
+namespace Mesh {
+namespace Quad9 {
+
+// Regular mesh: equi-sized quadratic elements.
+// The nodes coincide with those of "Quad4::Regular(2 * nelx, 2 * nely, h / 2)" (same numbering),
+// the element connectivity follows "Element::Quad9" (lexicographic, x fastest).
+
+class Regular {
+public:
+    Regular() = default;
+    Regular(size_t nelx, size_t nely, double h = 1.0);
+
+    // size
+    size_t nelem() const; // number of elements
+    size_t nnode() const; // number of nodes
+    size_t nne() const;   // number of nodes-per-element
+    size_t ndim() const;  // number of dimensions
+    size_t nelx() const;  // number of elements in x-direction
+    size_t nely() const;  // number of elements in y-direction
+    double h() const;     // edge size
+
+    // type
+    ElementType getElementType() const;
+
+    // mesh
+    xt::xtensor<double, 2> coor() const; // nodal positions [nnode, ndim]
+    xt::xtensor<size_t, 2> conn() const; // connectivity [nelem, nne]
+
+    // boundary nodes: edges
+    xt::xtensor<size_t, 1> nodesBottomEdge() const;
+    xt::xtensor<size_t, 1> nodesTopEdge() const;
+    xt::xtensor<size_t, 1> nodesLeftEdge() const;
+    xt::xtensor<size_t, 1> nodesRightEdge() const;
+
+    // boundary nodes: edges, without corners
+    xt::xtensor<size_t, 1> nodesBottomOpenEdge() const;
+    xt::xtensor<size_t, 1> nodesTopOpenEdge() const;
+    xt::xtensor<size_t, 1> nodesLeftOpenEdge() const;
+    xt::xtensor<size_t, 1> nodesRightOpenEdge() const;
+
+    // boundary nodes: corners
+    size_t nodesBottomLeftCorner() const;
+    size_t nodesBottomRightCorner() const;
+    size_t nodesTopLeftCorner() const;
+    size_t nodesTopRightCorner() const;
+
+    // DOF-numbers for each component of each node (sequential)
+    xt::xtensor<size_t, 2> dofs() const;
+
+    // DOF-numbers for the case that the periodicity if fully eliminated
+    xt::xtensor<size_t, 2> dofsPeriodic() const;
+
+    // periodic node pairs [:,2]: (independent, dependent)
+    xt::xtensor<size_t, 2> nodesPeriodic() const;
+
+    // front-bottom-left node, used as reference for periodicity
+    size_t nodesOrigin() const;
+
+    // element numbers as matrix
+    xt::xtensor<size_t, 2> elementgrid() const;
+
+private:
+    Quad4::Regular m_grid;          // linear mesh with the same nodes
+    double m_h;                     // elementary element edge-size (in all directions)
+    size_t m_nelx;                  // number of elements in x-direction (length == "m_nelx * m_h")
+    size_t m_nely;                  // number of elements in y-direction (length == "m_nely * m_h")
+    size_t m_nelem;                 // number of elements
+    size_t m_nnode;                 // number of nodes
+    static const size_t m_nne = 9;  // number of nodes-per-element
+    static const size_t m_ndim = 2; // number of dimensions
+};
+
+} // namespace Quad9
+} // namespace Mesh
+} // namespace GooseFEM
+
+#include "MeshQuad9.hpp"
+
+#endif
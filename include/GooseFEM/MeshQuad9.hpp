@@ -0,0 +1,181 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_MESHQUAD9_HPP
+#define GOOSEFEM_MESHQUAD9_HPP
+
+#include "MeshQuad9.h"
+
+namespace GooseFEM {
+namespace Mesh {
+namespace Quad9 {
+
+inline Regular::Regular(size_t nelx, size_t nely, double h)
+    : m_grid(2 * nelx, 2 * nely, 0.5 * h), m_h(h), m_nelx(nelx), m_nely(nely)
+{
+    GOOSEFEM_ASSERT(m_nelx >= 1ul);
+    GOOSEFEM_ASSERT(m_nely >= 1ul);
+
+    m_nnode = m_grid.nnode();
+    m_nelem = m_nelx * m_nely;
+}
+
+inline size_t Regular::nelem() const
+{
+    return m_nelem;
+}
+
+inline size_t Regular::nnode() const
+{
+    return m_nnode;
+}
+
+inline size_t Regular::nne() const
+{
+    return m_nne;
+}
+
+inline size_t Regular::ndim() const
+{
+    return m_ndim;
+}
+
+inline size_t Regular::nelx() const
+{
+    return m_nelx;
+}
+
+inline size_t Regular::nely() const
+{
+    return m_nely;
+}
+
+inline double Regular::h() const
+{
+    return m_h;
+}
+
+inline ElementType Regular::getElementType() const
+{
+    return ElementType::Quad9;
+}
+
+inline xt::xtensor<double, 2> Regular::coor() const
+{
+    return m_grid.coor();
+}
+
+inline xt::xtensor<size_t, 2> Regular::conn() const
+{
+    xt::xtensor<size_t, 2> ret = xt::empty<size_t>({m_nelem, m_nne});
+
+    size_t nx = 2 * m_nelx + 1;
+    size_t ielem = 0;
+
+    for (size_t iy = 0; iy < m_nely; ++iy) {
+        for (size_t ix = 0; ix < m_nelx; ++ix) {
+            for (size_t a1 = 0; a1 < 3; ++a1) {
+                for (size_t a0 = 0; a0 < 3; ++a0) {
+                    ret(ielem, a0 + 3 * a1) = (2 * iy + a1) * nx + 2 * ix + a0;
+                }
+            }
+            ++ielem;
+        }
+    }
+
+    return ret;
+}
+
+inline xt::xtensor<size_t, 1> Regular::nodesBottomEdge() const
+{
+    return m_grid.nodesBottomEdge();
+}
+
+inline xt::xtensor<size_t, 1> Regular::nodesTopEdge() const
+{
+    return m_grid.nodesTopEdge();
+}
+
+inline xt::xtensor<size_t, 1> Regular::nodesLeftEdge() const
+{
+    return m_grid.nodesLeftEdge();
+}
+
+inline xt::xtensor<size_t, 1> Regular::nodesRightEdge() const
+{
+    return m_grid.nodesRightEdge();
+}
+
+inline xt::xtensor<size_t, 1> Regular::nodesBottomOpenEdge() const
+{
+    return m_grid.nodesBottomOpenEdge();
+}
+
+inline xt::xtensor<size_t, 1> Regular::nodesTopOpenEdge() const
+{
+    return m_grid.nodesTopOpenEdge();
+}
+
+inline xt::xtensor<size_t, 1> Regular::nodesLeftOpenEdge() const
+{
+    return m_grid.nodesLeftOpenEdge();
+}
+
+inline xt::xtensor<size_t, 1> Regular::nodesRightOpenEdge() const
+{
+    return m_grid.nodesRightOpenEdge();
+}
+
+inline size_t Regular::nodesBottomLeftCorner() const
+{
+    return m_grid.nodesBottomLeftCorner();
+}
+
+inline size_t Regular::nodesBottomRightCorner() const
+{
+    return m_grid.nodesBottomRightCorner();
+}
+
+inline size_t Regular::nodesTopLeftCorner() const
+{
+    return m_grid.nodesTopLeftCorner();
+}
+
+inline size_t Regular::nodesTopRightCorner() const
+{
+    return m_grid.nodesTopRightCorner();
+}
+
+inline xt::xtensor<size_t, 2> Regular::dofs() const
+{
+    return m_grid.dofs();
+}
+
+inline xt::xtensor<size_t, 2> Regular::dofsPeriodic() const
+{
+    return m_grid.dofsPeriodic();
+}
+
+inline xt::xtensor<size_t, 2> Regular::nodesPeriodic() const
+{
+    return m_grid.nodesPeriodic();
+}
+
+inline size_t Regular::nodesOrigin() const
+{
+    return m_grid.nodesOrigin();
+}
+
+inline xt::xtensor<size_t, 2> Regular::elementgrid() const
+{
+    return xt::arange<size_t>(m_nelem).reshape({m_nely, m_nelx});
+}
+
+} // namespace Quad9
+} // namespace Mesh
+} // namespace GooseFEM
+
+#endif
@@ -0,0 +1,129 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_MULTIGRID_H
+#define GOOSEFEM_MULTIGRID_H
+
+#include "config.h"
+#include "Mesh.h"
+#include "MeshQuad4.h"
+#include "SparseMatrix.h"
+
+#include <Eigen/Eigen>
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+
+namespace GooseFEM {
+namespace detail {
+
+/*
+  Multigrid hierarchy (shared by "GeometricMultigrid" and "AMG"): Galerkin coarse matrices
+  "A_c = P^T * A * P", applied as a symmetric V-cycle with damped Jacobi smoothing (such that it
+  can be used with conjugate gradients). The coarsest level is factorised directly.
+*/
+
+class Multigrid {
+public:
+    // Parameters
+    void setSmoothing(size_t n); // number of pre- and post-smoothing iterations (default: 2)
+
+    // Hierarchy
+    size_t levels() const; // number of levels (including the coarsest)
+    size_t rows(size_t level) const; // number of rows on a level
+
+    // Eigen's preconditioner concept
+    template <class Rhs>
+    Eigen::VectorXd solve(const Eigen::MatrixBase<Rhs>& b) const;
+
+    Eigen::ComputationInfo info() const;
+
+protected:
+    // One level of the hierarchy (all matrices row-major, for the parallel products)
+    struct Level {
+        Eigen::SparseMatrix<double, Eigen::RowMajor> A; // matrix [n, n]
+        Eigen::SparseMatrix<double, Eigen::RowMajor> P; // prolongator [n, n_coarse]
+        Eigen::SparseMatrix<double, Eigen::RowMajor> R; // restriction (P^T) [n_coarse, n]
+        Eigen::VectorXd D; // weighted inverse of the diagonal (Jacobi) [n]
+        mutable Eigen::VectorXd b; // workspace: right-hand-side [n]
+        mutable Eigen::VectorXd x; // workspace: solution [n]
+        mutable Eigen::VectorXd r; // workspace: residual [n]
+    };
+
+    // Full matrix (from its upper triangle)
+    template <class MatrixType>
+    Eigen::SparseMatrix<double, Eigen::RowMajor> full(const MatrixType& A) const;
+
+    // Weighted inverse of the diagonal: 4 / (3 * rho(D^-1 A)) / diag(A)
+    Eigen::VectorXd jacobi(const Eigen::SparseMatrix<double, Eigen::RowMajor>& A) const;
+
+    // Add the next level, given the prolongator of the current (last) level:
+    // set "R = P^T", the smoother of the current level, and "A_c = R * A * P"
+    void coarsen();
+
+    // Allocate the workspace, and factorise the coarsest level
+    void finalize();
+
+    // V-cycle on a level, solution in "m_levels[level].x"
+    void vcycle(size_t level) const;
+
+    // Hierarchy
+    std::vector<Level> m_levels;
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> m_coarse;
+
+    // Parameters
+    size_t m_nsmooth = 2;
+
+    // Status
+    Eigen::ComputationInfo m_info = Eigen::Success;
+};
+
+} // namespace detail
+
+/*
+  Geometric multigrid preconditioner for "Mesh::Quad4::Regular" meshes, following Eigen's
+  preconditioner concept (e.g. "LinearSolver::ConjugateGradientMultigrid").
+
+  The hierarchy of meshes is constructed by "Mesh::Quad4::Map::RefineRegular" (2 x 2 fine elements
+  per coarse element), as long as the number of elements in both directions is even. The nodal
+  prolongation is the bilinear interpolation of the coarse element, the restriction is its
+  transpose, and the coarse matrices are Galerkin products. The DOFs of a coarse node are those of
+  the coinciding fine node, such that periodicity (and any other DOF sharing) is inherited.
+*/
+
+class GeometricMultigrid : public detail::Multigrid {
+public:
+    // Constructors
+    GeometricMultigrid() = default;
+
+    // Hierarchy, from the (finest) mesh and its DOFs [nnode, ndim], for the rows "iiu" of the
+    // system (e.g. "MatrixPartitioned::iiu()"): row "k" corresponds to DOF "iiu(k)".
+    // "nlevels = 0": coarsen as far as possible (otherwise: at most "nlevels" levels)
+    void setMesh(
+        const Mesh::Quad4::Regular& mesh,
+        const xt::xtensor<size_t, 2>& dofs,
+        const xt::xtensor<size_t, 1>& iiu,
+        size_t nlevels = 0);
+
+    // Eigen's preconditioner concept
+    template <class MatrixType>
+    GeometricMultigrid& analyzePattern(const MatrixType& A);
+
+    template <class MatrixType>
+    GeometricMultigrid& factorize(const MatrixType& A);
+
+    template <class MatrixType>
+    GeometricMultigrid& compute(const MatrixType& A);
+
+private:
+    // Prolongator of each level, except the coarsest
+    std::vector<Eigen::SparseMatrix<double, Eigen::RowMajor>> m_P;
+};
+
+} // namespace GooseFEM
+
+#include "Multigrid.hpp"
+
+#endif
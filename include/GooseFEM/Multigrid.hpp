@@ -0,0 +1,316 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_MULTIGRID_HPP
+#define GOOSEFEM_MULTIGRID_HPP
+
+#include "Multigrid.h"
+
+namespace GooseFEM {
+namespace detail {
+
+inline void Multigrid::setSmoothing(size_t n)
+{
+    m_nsmooth = n;
+}
+
+inline size_t Multigrid::levels() const
+{
+    return m_levels.size();
+}
+
+inline size_t Multigrid::rows(size_t level) const
+{
+    GOOSEFEM_ASSERT(level < m_levels.size());
+    return static_cast<size_t>(m_levels[level].A.rows());
+}
+
+template <class Rhs>
+inline Eigen::VectorXd Multigrid::solve(const Eigen::MatrixBase<Rhs>& b) const
+{
+    GOOSEFEM_ASSERT(m_levels.size() > 0);
+    GOOSEFEM_ASSERT(b.rows() == m_levels[0].A.rows());
+
+    m_levels[0].b = b;
+    this->vcycle(0);
+    return m_levels[0].x;
+}
+
+inline Eigen::ComputationInfo Multigrid::info() const
+{
+    return m_info;
+}
+
+template <class MatrixType>
+inline Eigen::SparseMatrix<double, Eigen::RowMajor> Multigrid::full(const MatrixType& A) const
+{
+    Eigen::SparseMatrix<double, Eigen::RowMajor> ret = A.template selfadjointView<Eigen::Upper>();
+    return ret;
+}
+
+inline Eigen::VectorXd
+Multigrid::jacobi(const Eigen::SparseMatrix<double, Eigen::RowMajor>& A) const
+{
+    Eigen::Index n = A.rows();
+    Eigen::VectorXd D = A.diagonal();
+
+    for (Eigen::Index i = 0; i < n; ++i) {
+        D(i) = D(i) != 0.0 ? 1.0 / D(i) : 0.0;
+    }
+
+    // spectral radius of D^-1 * A (power iteration)
+
+    Eigen::VectorXd v = Eigen::VectorXd::LinSpaced(n, 1.0, 2.0);
+    Eigen::VectorXd w(n);
+    double rho = 1.0;
+    v /= v.norm();
+
+    for (size_t i = 0; i < 15; ++i) {
+        detail::spmv(A, v.data(), w.data());
+        w = w.cwiseProduct(D);
+        double norm = w.norm();
+        if (norm == 0.0) {
+            break;
+        }
+        rho = norm;
+        v = w / norm;
+    }
+
+    return (4.0 / (3.0 * rho)) * D;
+}
+
+inline void Multigrid::coarsen()
+{
+    Eigen::SparseMatrix<double, Eigen::RowMajor> Ac;
+
+    {
+        Level& lev = m_levels.back();
+
+        if (lev.D.size() != lev.A.rows()) {
+            lev.D = this->jacobi(lev.A);
+        }
+
+        lev.R = lev.P.transpose();
+        Eigen::SparseMatrix<double, Eigen::RowMajor> AP = lev.A * lev.P;
+        Ac = lev.R * AP;
+    }
+
+    m_levels.emplace_back();
+    m_levels.back().A = std::move(Ac);
+}
+
+inline void Multigrid::finalize()
+{
+    for (auto& lev : m_levels) {
+        lev.b.resize(lev.A.rows());
+        lev.x.resize(lev.A.rows());
+        lev.r.resize(lev.A.rows());
+    }
+
+    Eigen::SparseMatrix<double> Ac = m_levels.back().A;
+    m_coarse.compute(Ac);
+    m_info = m_coarse.info();
+}
+
+inline void Multigrid::vcycle(size_t level) const
+{
+    const Level& lev = m_levels[level];
+
+    if (level + 1 == m_levels.size()) {
+        lev.x = m_coarse.solve(lev.b);
+        return;
+    }
+
+    const Level& coarse = m_levels[level + 1];
+
+    // pre-smoothing (damped Jacobi, starting from zero)
+
+    if (m_nsmooth > 0) {
+        lev.x = lev.D.cwiseProduct(lev.b);
+    }
+    else {
+        lev.x.setZero();
+    }
+
+    for (size_t i = 1; i < m_nsmooth; ++i) {
+        detail::residual(lev.A, lev.x.data(), lev.b.data(), lev.r.data());
+        lev.x += lev.D.cwiseProduct(lev.r);
+    }
+
+    // coarse grid correction
+
+    detail::residual(lev.A, lev.x.data(), lev.b.data(), lev.r.data());
+    detail::spmv(lev.R, lev.r.data(), coarse.b.data());
+    this->vcycle(level + 1);
+    detail::spmv(lev.P, coarse.x.data(), lev.r.data());
+    lev.x += lev.r;
+
+    // post-smoothing
+
+    for (size_t i = 0; i < m_nsmooth; ++i) {
+        detail::residual(lev.A, lev.x.data(), lev.b.data(), lev.r.data());
+        lev.x += lev.D.cwiseProduct(lev.r);
+    }
+}
+
+} // namespace detail
+
+inline void GeometricMultigrid::setMesh(
+    const Mesh::Quad4::Regular& mesh,
+    const xt::xtensor<size_t, 2>& dofs,
+    const xt::xtensor<size_t, 1>& iiu,
+    size_t nlevels)
+{
+    size_t ndim = mesh.ndim();
+    size_t nne = mesh.nne();
+    size_t ndof = xt::amax(dofs)() + 1;
+    const size_t none = std::numeric_limits<size_t>::max();
+
+    GOOSEFEM_ASSERT(xt::has_shape(dofs, {mesh.nnode(), ndim}));
+    GOOSEFEM_ASSERT(xt::amax(iiu)() < ndof);
+
+    // row of each DOF on the current level
+
+    std::vector<size_t> row(ndof, none);
+    size_t nrow = iiu.size();
+
+    for (size_t k = 0; k < nrow; ++k) {
+        row[iiu(k)] = k;
+    }
+
+    Mesh::Quad4::Regular fine = mesh;
+    xt::xtensor<size_t, 2> fdofs = dofs;
+    m_P.clear();
+
+    while (fine.nelx() % 2 == 0 && fine.nely() % 2 == 0 &&
+           (nlevels == 0 || m_P.size() + 1 < nlevels)) {
+
+        Mesh::Quad4::Regular coarse(fine.nelx() / 2, fine.nely() / 2, fine.h());
+        Mesh::Quad4::Map::RefineRegular refine(coarse, 2, 2);
+        GOOSEFEM_ASSERT(refine.getFineMesh().nnode() == fine.nnode());
+
+        xt::xtensor<size_t, 2> map = refine.getMap(); // fine elements per coarse element
+        xt::xtensor<size_t, 2> cconn = coarse.conn();
+        xt::xtensor<size_t, 2> fconn = fine.conn();
+        size_t cnx = coarse.nelx();
+        size_t fnx = fine.nelx();
+
+        // DOFs of the coarse nodes: those of the coinciding fine nodes
+
+        xt::xtensor<size_t, 2> cdofs = xt::empty<size_t>({coarse.nnode(), ndim});
+
+        for (size_t iy = 0; iy < coarse.nely() + 1; ++iy) {
+            for (size_t ix = 0; ix < cnx + 1; ++ix) {
+                size_t c = iy * (cnx + 1) + ix;
+                size_t f = 2 * iy * (fnx + 1) + 2 * ix;
+                for (size_t i = 0; i < ndim; ++i) {
+                    cdofs(c, i) = fdofs(f, i);
+                }
+            }
+        }
+
+        std::vector<size_t> crow(ndof, none);
+        size_t ncrow = 0;
+
+        for (size_t c = 0; c < coarse.nnode(); ++c) {
+            for (size_t i = 0; i < ndim; ++i) {
+                size_t d = cdofs(c, i);
+                if (row[d] != none && crow[d] == none) {
+                    crow[d] = ncrow++;
+                }
+            }
+        }
+
+        if (ncrow == 0) {
+            break;
+        }
+
+        // prolongator: bilinear interpolation in the coarse element,
+        // with the local coordinates of the fine nodes in {-1, 0, +1}
+
+        std::vector<bool> done(nrow, false);
+        std::vector<Eigen::Triplet<double>> T;
+        T.reserve(nrow * nne);
+
+        for (size_t e = 0; e < coarse.nelem(); ++e) {
+
+            double ex = static_cast<double>(e % cnx);
+            double ey = static_cast<double>(e / cnx);
+
+            for (size_t f : xt::view(map, e, xt::all())) {
+                for (size_t m = 0; m < nne; ++m) {
+
+                    size_t node = fconn(f, m);
+                    double xi = static_cast<double>(node % (fnx + 1)) - 2.0 * ex - 1.0;
+                    double eta = static_cast<double>(node / (fnx + 1)) - 2.0 * ey - 1.0;
+
+                    std::array<double, 4> N = {
+                        0.25 * (1.0 - xi) * (1.0 - eta),
+                        0.25 * (1.0 + xi) * (1.0 - eta),
+                        0.25 * (1.0 + xi) * (1.0 + eta),
+                        0.25 * (1.0 - xi) * (1.0 + eta)};
+
+                    for (size_t i = 0; i < ndim; ++i) {
+                        size_t r = row[fdofs(node, i)];
+                        if (r == none || done[r]) {
+                            continue;
+                        }
+                        done[r] = true;
+                        for (size_t a = 0; a < nne; ++a) {
+                            size_t c = crow[cdofs(cconn(e, a), i)];
+                            if (N[a] != 0.0 && c != none) {
+                                T.push_back(Eigen::Triplet<double>(r, c, N[a]));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        Eigen::SparseMatrix<double, Eigen::RowMajor> P(nrow, ncrow);
+        P.setFromTriplets(T.begin(), T.end());
+        m_P.push_back(std::move(P));
+
+        fine = coarse;
+        fdofs = cdofs;
+        row = std::move(crow);
+        nrow = ncrow;
+    }
+}
+
+template <class MatrixType>
+inline GeometricMultigrid& GeometricMultigrid::analyzePattern(const MatrixType&)
+{
+    return *this;
+}
+
+template <class MatrixType>
+inline GeometricMultigrid& GeometricMultigrid::factorize(const MatrixType& A)
+{
+    GOOSEFEM_CHECK(m_P.size() == 0 || m_P[0].rows() == A.rows());
+
+    m_levels.clear();
+    m_levels.emplace_back();
+    m_levels.back().A = this->full(A);
+
+    for (auto& P : m_P) {
+        m_levels.back().P = P;
+        this->coarsen();
+    }
+
+    this->finalize();
+    return *this;
+}
+
+template <class MatrixType>
+inline GeometricMultigrid& GeometricMultigrid::compute(const MatrixType& A)
+{
+    return this->factorize(A);
+}
+
+} // namespace GooseFEM
+
+#endif
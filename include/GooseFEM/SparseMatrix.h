@@ -0,0 +1,88 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_SPARSEMATRIX_H
+#define GOOSEFEM_SPARSEMATRIX_H
+
+#include "config.h"
+
+#include <Eigen/Eigen>
+#include <Eigen/Sparse>
+
+/*
+  Sparse matrix-vector products for the row-major (CSR) storage of "Matrix" and
+  "MatrixPartitioned": parallel over rows (OpenMP), vectorised within each row (OpenMP SIMD).
+  Each row is written by exactly one thread, such that no atomics or reductions are needed.
+  All matrices should be compressed (as they are after "setFromTriplets").
+*/
+
+namespace GooseFEM {
+namespace detail {
+
+// b = A * x
+inline void spmv(
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& A, const double* x, double* b);
+
+// b = A * x + B * y
+inline void spmv(
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& A,
+    const double* x,
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& B,
+    const double* y,
+    double* b);
+
+// r = b - A * x (fused: no temporary for "A * x")
+inline void residual(
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& A,
+    const double* x,
+    const double* b,
+    double* r);
+
+// r = b - A * x - B * y (fused)
+inline void residual(
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& A,
+    const double* x,
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& B,
+    const double* y,
+    const double* b,
+    double* r);
+
+// Columns of "A" that have at least one stored entry (sorted)
+template <class T>
+inline std::vector<Eigen::Index> nonzeroCols(const Eigen::SparseMatrixBase<T>& A);
+
+// Dense copy of the columns "cols" (sorted) of "A" [A.rows(), cols.size()]
+template <class T>
+inline Eigen::MatrixXd denseCols(
+    const Eigen::SparseMatrixBase<T>& A, const std::vector<Eigen::Index>& cols);
+
+// Column-major copy of a row-major matrix, as input for the solver policies (which require
+// column-major storage). The column-major pattern, and the position of each row-major value in it,
+// are computed only if the pattern of the input changes. Otherwise "update" only copies the values
+// (O(nnz), without allocation), instead of Eigen's conversion (that allocates and reorders all
+// indices on each factorisation).
+class ColumnMajor {
+public:
+    ColumnMajor() = default;
+
+    // Copy "A" (compressed), return a reference to the (stored) column-major matrix
+    const Eigen::SparseMatrix<double>&
+    update(const Eigen::SparseMatrix<double, Eigen::RowMajor>& A);
+
+private:
+    using StorageIndex = Eigen::SparseMatrix<double, Eigen::RowMajor>::StorageIndex;
+    Eigen::SparseMatrix<double> m_A; // column-major copy
+    std::vector<StorageIndex> m_outer; // row-major pattern of the last input
+    std::vector<StorageIndex> m_inner; // row-major pattern of the last input
+    std::vector<StorageIndex> m_index; // position in "m_A" of each row-major value
+};
+
+} // namespace detail
+} // namespace GooseFEM
+
+#include "SparseMatrix.hpp"
+
+#endif
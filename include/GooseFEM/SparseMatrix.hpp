@@ -0,0 +1,185 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_SPARSEMATRIX_HPP
+#define GOOSEFEM_SPARSEMATRIX_HPP
+
+#include "SparseMatrix.h"
+
+namespace GooseFEM {
+namespace detail {
+
+// A(i, :) * x
+inline double spmv_row(
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& A, Eigen::Index i, const double* x)
+{
+    using index = Eigen::SparseMatrix<double, Eigen::RowMajor>::StorageIndex;
+
+    const index* ptr = A.outerIndexPtr();
+    const index* col = A.innerIndexPtr();
+    const double* val = A.valuePtr();
+
+    double ret = 0.0;
+
+    #pragma omp simd reduction(+ : ret)
+    for (index k = ptr[i]; k < ptr[i + 1]; ++k) {
+        ret += val[k] * x[col[k]];
+    }
+
+    return ret;
+}
+
+inline void spmv(
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& A, const double* x, double* b)
+{
+    GOOSEFEM_ASSERT(A.isCompressed());
+
+    #pragma omp parallel for schedule(static)
+    for (Eigen::Index i = 0; i < A.rows(); ++i) {
+        b[i] = spmv_row(A, i, x);
+    }
+}
+
+inline void spmv(
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& A,
+    const double* x,
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& B,
+    const double* y,
+    double* b)
+{
+    GOOSEFEM_ASSERT(A.isCompressed());
+    GOOSEFEM_ASSERT(B.isCompressed());
+    GOOSEFEM_ASSERT(A.rows() == B.rows());
+
+    #pragma omp parallel for schedule(static)
+    for (Eigen::Index i = 0; i < A.rows(); ++i) {
+        b[i] = spmv_row(A, i, x) + spmv_row(B, i, y);
+    }
+}
+
+inline void residual(
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& A,
+    const double* x,
+    const double* b,
+    double* r)
+{
+    GOOSEFEM_ASSERT(A.isCompressed());
+
+    #pragma omp parallel for schedule(static)
+    for (Eigen::Index i = 0; i < A.rows(); ++i) {
+        r[i] = b[i] - spmv_row(A, i, x);
+    }
+}
+
+inline void residual(
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& A,
+    const double* x,
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& B,
+    const double* y,
+    const double* b,
+    double* r)
+{
+    GOOSEFEM_ASSERT(A.isCompressed());
+    GOOSEFEM_ASSERT(B.isCompressed());
+    GOOSEFEM_ASSERT(A.rows() == B.rows());
+
+    #pragma omp parallel for schedule(static)
+    for (Eigen::Index i = 0; i < A.rows(); ++i) {
+        r[i] = b[i] - spmv_row(A, i, x) - spmv_row(B, i, y);
+    }
+}
+
+template <class T>
+inline std::vector<Eigen::Index> nonzeroCols(const Eigen::SparseMatrixBase<T>& A)
+{
+    const T& a = A.derived();
+    std::vector<bool> mark(static_cast<size_t>(a.cols()), false);
+
+    for (Eigen::Index k = 0; k < a.outerSize(); ++k) {
+        for (typename T::InnerIterator it(a, k); it; ++it) {
+            mark[static_cast<size_t>(it.col())] = true;
+        }
+    }
+
+    std::vector<Eigen::Index> ret;
+
+    for (size_t j = 0; j < mark.size(); ++j) {
+        if (mark[j]) {
+            ret.push_back(static_cast<Eigen::Index>(j));
+        }
+    }
+
+    return ret;
+}
+
+template <class T>
+inline Eigen::MatrixXd
+denseCols(const Eigen::SparseMatrixBase<T>& A, const std::vector<Eigen::Index>& cols)
+{
+    const T& a = A.derived();
+    Eigen::MatrixXd ret = Eigen::MatrixXd::Zero(a.rows(), static_cast<Eigen::Index>(cols.size()));
+
+    for (Eigen::Index k = 0; k < a.outerSize(); ++k) {
+        for (typename T::InnerIterator it(a, k); it; ++it) {
+            auto c = std::lower_bound(cols.begin(), cols.end(), it.col());
+            if (c != cols.end() && *c == it.col()) {
+                ret(it.row(), c - cols.begin()) = it.value();
+            }
+        }
+    }
+
+    return ret;
+}
+
+inline const Eigen::SparseMatrix<double>&
+ColumnMajor::update(const Eigen::SparseMatrix<double, Eigen::RowMajor>& A)
+{
+    GOOSEFEM_ASSERT(A.isCompressed());
+
+    const StorageIndex* outer = A.outerIndexPtr();
+    const StorageIndex* inner = A.innerIndexPtr();
+    const double* val = A.valuePtr();
+    size_t nrow = static_cast<size_t>(A.rows());
+    size_t nnz = static_cast<size_t>(A.nonZeros());
+
+    bool changed = m_A.rows() != A.rows() || m_A.cols() != A.cols() || m_inner.size() != nnz ||
+                   !std::equal(m_outer.begin(), m_outer.end(), outer) ||
+                   !std::equal(m_inner.begin(), m_inner.end(), inner);
+
+    if (changed) {
+
+        m_A = A;
+        m_A.makeCompressed();
+        m_outer.assign(outer, outer + nrow + 1);
+        m_inner.assign(inner, inner + nnz);
+        m_index.resize(nnz);
+
+        // rows are visited in increasing order, as are the rows within each column
+        std::vector<StorageIndex> pos(m_A.outerIndexPtr(), m_A.outerIndexPtr() + m_A.cols());
+
+        for (size_t i = 0; i < nrow; ++i) {
+            for (StorageIndex k = outer[i]; k < outer[i + 1]; ++k) {
+                m_index[k] = pos[inner[k]]++;
+            }
+        }
+
+        return m_A;
+    }
+
+    double* ret = m_A.valuePtr();
+
+    #pragma omp parallel for schedule(static)
+    for (size_t k = 0; k < nnz; ++k) {
+        ret[m_index[k]] = val[k];
+    }
+
+    return m_A;
+}
+
+} // namespace detail
+} // namespace GooseFEM
+
+#endif
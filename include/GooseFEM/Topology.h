@@ -0,0 +1,101 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_TOPOLOGY_H
+#define GOOSEFEM_TOPOLOGY_H
+
+#include "config.h"
+
+namespace GooseFEM {
+
+/*
+  Immutable connectivity, DOF-numbers, and (optionally) partitioning in unknown and prescribed DOFs.
+  The data is reference counted: copying a Topology (or constructing Vector, Matrix, ... from it)
+  does not copy the underlying arrays.
+
+  A Topology can be restricted to a subset of elements (without copying the connectivity).
+  All element-based arrays ("elemvec", "elemmat") then refer to the elements in "elem()",
+  while all nodal and DOF-based arrays ("nodevec", "dofval") remain those of the full mesh.
+*/
+
+class Topology {
+public:
+    // Constructors
+    Topology() = default;
+
+    Topology(const xt::xtensor<size_t, 2>& conn, const xt::xtensor<size_t, 2>& dofs);
+
+    Topology(
+        const xt::xtensor<size_t, 2>& conn,
+        const xt::xtensor<size_t, 2>& dofs,
+        const xt::xtensor<size_t, 1>& iip);
+
+    // Take shared ownership of existing data (no copy)
+    Topology(
+        std::shared_ptr<const xt::xtensor<size_t, 2>> conn,
+        std::shared_ptr<const xt::xtensor<size_t, 2>> dofs);
+
+    // Share connectivity and DOFs, (re)define the prescribed DOFs
+    Topology Partition(const xt::xtensor<size_t, 1>& iip) const;
+
+    // Share all data, restrict to a subset of elements (indices refer to the current elements)
+    Topology Subset(const xt::xtensor<size_t, 1>& elem) const;
+
+    // Dimensions
+    size_t nelem() const; // number of elements (of the subset)
+    size_t nne() const;   // number of nodes per element
+    size_t nnode() const; // number of nodes
+    size_t ndim() const;  // number of dimensions
+    size_t ndof() const;  // number of DOFs
+    size_t nnu() const;   // number of unknown DOFs
+    size_t nnp() const;   // number of prescribed DOFs
+
+    // Check if the DOFs are partitioned
+    bool isPartitioned() const;
+
+    // Check if the Topology is restricted to a subset of elements
+    bool isSubset() const;
+
+    // Data (references are valid as long as a Topology sharing the data exists)
+    const xt::xtensor<size_t, 2>& conn() const; // connectivity (full mesh)        [N, nne]
+    xt::xtensor<size_t, 1> elem() const;        // element-numbers (rows of conn)  [nelem]
+    const xt::xtensor<size_t, 2>& dofs() const; // DOF-numbers per node            [nnode, ndim]
+    const xt::xtensor<size_t, 1>& iiu() const;  // DOF-numbers that are unknown    [nnu]
+    const xt::xtensor<size_t, 1>& iip() const;  // DOF-numbers that are prescribed [nnp]
+    const xt::xtensor<size_t, 2>& part() const; // DOFs per node, such that iiu = arange(nnu), ...
+
+    // Rows of "conn" of the elements of a subset, "nullptr" for the full mesh (whose rows are the
+    // element-numbers): use as "rows ? rows[e] : e" in element loops
+    const size_t* rows() const;
+
+private:
+    // Data
+    std::shared_ptr<const xt::xtensor<size_t, 2>> m_conn;
+    std::shared_ptr<const xt::xtensor<size_t, 2>> m_dofs;
+    std::shared_ptr<const xt::xtensor<size_t, 1>> m_elem; // only for a subset
+    std::shared_ptr<const xt::xtensor<size_t, 1>> m_iiu;
+    std::shared_ptr<const xt::xtensor<size_t, 1>> m_iip;
+    std::shared_ptr<const xt::xtensor<size_t, 2>> m_part;
+
+    // Dimensions
+    size_t m_nelem = 0; // number of elements
+    size_t m_nne = 0;   // number of nodes per element
+    size_t m_nnode = 0; // number of nodes
+    size_t m_ndim = 0;  // number of dimensions
+    size_t m_ndof = 0;  // number of DOFs
+    size_t m_nnu = 0;   // number of unknown DOFs
+    size_t m_nnp = 0;   // number of prescribed DOFs
+    bool m_subset = false;
+
+    // Compute dimensions and check
+    void init();
+};
+
+} // namespace GooseFEM
+
+#include "Topology.hpp"
+
+#endif
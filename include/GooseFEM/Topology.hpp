@@ -0,0 +1,183 @@
+/*
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+*/
+
+#ifndef GOOSEFEM_TOPOLOGY_HPP
+#define GOOSEFEM_TOPOLOGY_HPP
+
+#include "Mesh.h"
+#include "Topology.h"
+
+namespace GooseFEM {
+
+inline Topology::Topology(const xt::xtensor<size_t, 2>& conn, const xt::xtensor<size_t, 2>& dofs)
+    : m_conn(std::make_shared<const xt::xtensor<size_t, 2>>(conn))
+    , m_dofs(std::make_shared<const xt::xtensor<size_t, 2>>(dofs))
+{
+    this->init();
+}
+
+inline Topology::Topology(
+    const xt::xtensor<size_t, 2>& conn,
+    const xt::xtensor<size_t, 2>& dofs,
+    const xt::xtensor<size_t, 1>& iip)
+    : Topology(conn, dofs)
+{
+    *this = this->Partition(iip);
+}
+
+inline Topology::Topology(
+    std::shared_ptr<const xt::xtensor<size_t, 2>> conn,
+    std::shared_ptr<const xt::xtensor<size_t, 2>> dofs)
+    : m_conn(std::move(conn)), m_dofs(std::move(dofs))
+{
+    GOOSEFEM_ASSERT(m_conn);
+    GOOSEFEM_ASSERT(m_dofs);
+    this->init();
+}
+
+inline void Topology::init()
+{
+    m_nelem = m_conn->shape(0);
+    m_nne = m_conn->shape(1);
+    m_nnode = m_dofs->shape(0);
+    m_ndim = m_dofs->shape(1);
+    m_ndof = xt::amax(*m_dofs)() + 1;
+
+    GOOSEFEM_ASSERT(xt::amax(*m_conn)() + 1 <= m_nnode);
+    GOOSEFEM_ASSERT(m_ndof <= m_nnode * m_ndim);
+}
+
+inline Topology Topology::Partition(const xt::xtensor<size_t, 1>& iip) const
+{
+    GOOSEFEM_ASSERT(m_dofs);
+    GOOSEFEM_ASSERT(iip.size() == 0 || xt::amax(iip)() < m_ndof);
+
+    Topology ret = *this;
+
+    xt::xtensor<size_t, 1> iiu = xt::setdiff1d(*m_dofs, iip);
+    ret.m_part = std::make_shared<const xt::xtensor<size_t, 2>>(
+        Mesh::Reorder({iiu, iip}).get(*m_dofs));
+    ret.m_nnu = iiu.size();
+    ret.m_nnp = iip.size();
+    ret.m_iiu = std::make_shared<const xt::xtensor<size_t, 1>>(std::move(iiu));
+    ret.m_iip = std::make_shared<const xt::xtensor<size_t, 1>>(iip);
+
+    return ret;
+}
+
+inline Topology Topology::Subset(const xt::xtensor<size_t, 1>& elem) const
+{
+    GOOSEFEM_ASSERT(m_conn);
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+
+    Topology ret = *this;
+
+    const size_t* rows = this->rows();
+    xt::xtensor<size_t, 1> map = xt::empty<size_t>({elem.size()});
+
+    for (size_t e = 0; e < elem.size(); ++e) {
+        map(e) = rows ? rows[elem(e)] : elem(e);
+    }
+
+    ret.m_elem = std::make_shared<const xt::xtensor<size_t, 1>>(std::move(map));
+    ret.m_nelem = elem.size();
+    ret.m_subset = true;
+
+    return ret;
+}
+
+inline size_t Topology::nelem() const
+{
+    return m_nelem;
+}
+
+inline size_t Topology::nne() const
+{
+    return m_nne;
+}
+
+inline size_t Topology::nnode() const
+{
+    return m_nnode;
+}
+
+inline size_t Topology::ndim() const
+{
+    return m_ndim;
+}
+
+inline size_t Topology::ndof() const
+{
+    return m_ndof;
+}
+
+inline size_t Topology::nnu() const
+{
+    return m_nnu;
+}
+
+inline size_t Topology::nnp() const
+{
+    return m_nnp;
+}
+
+inline bool Topology::isPartitioned() const
+{
+    return static_cast<bool>(m_part);
+}
+
+inline const xt::xtensor<size_t, 2>& Topology::conn() const
+{
+    GOOSEFEM_ASSERT(m_conn);
+    return *m_conn;
+}
+
+inline bool Topology::isSubset() const
+{
+    return m_subset;
+}
+
+inline xt::xtensor<size_t, 1> Topology::elem() const
+{
+    if (m_subset) {
+        return *m_elem;
+    }
+
+    return xt::arange<size_t>(m_nelem);
+}
+
+inline const size_t* Topology::rows() const
+{
+    return m_subset ? m_elem->data() : nullptr;
+}
+
+inline const xt::xtensor<size_t, 2>& Topology::dofs() const
+{
+    GOOSEFEM_ASSERT(m_dofs);
+    return *m_dofs;
+}
+
+inline const xt::xtensor<size_t, 1>& Topology::iiu() const
+{
+    GOOSEFEM_ASSERT(this->isPartitioned());
+    return *m_iiu;
+}
+
+inline const xt::xtensor<size_t, 1>& Topology::iip() const
+{
+    GOOSEFEM_ASSERT(this->isPartitioned());
+    return *m_iip;
+}
+
+inline const xt::xtensor<size_t, 2>& Topology::part() const
+{
+    GOOSEFEM_ASSERT(this->isPartitioned());
+    return *m_part;
+}
+
+} // namespace GooseFEM
+
+#endif
@@ -8,6 +8,7 @@
 #define GOOSEFEM_VECTOR_H
 
 #include "config.h"
+#include "Topology.h"
 
 namespace GooseFEM {
 
@@ -22,6 +23,7 @@ public:
     // Constructor
     Vector() = default;
     Vector(const xt::xtensor<size_t, 2>& conn, const xt::xtensor<size_t, 2>& dofs);
+    Vector(const Topology& topology); // shares data (no copy)
 
     // Dimensions
     size_t nelem() const; // number of elements
@@ -30,8 +32,10 @@ public:
     size_t ndim() const;  // number of dimensions
     size_t ndof() const;  // number of DOFs
 
-    // DOF lists
-    xt::xtensor<size_t, 2> dofs() const; // DOFs
+    // Connectivity and DOF lists
+    const Topology& topology() const;
+    const xt::xtensor<size_t, 2>& conn() const; // connectivity
+    const xt::xtensor<size_t, 2>& dofs() const; // DOFs
 
     // Copy nodevec to another nodevec
     void copy(const xt::xtensor<double, 2>& nodevec_src, xt::xtensor<double, 2>& nodevec_dest) const;
@@ -55,6 +59,44 @@ public:
     // Assemble "nodevec" (adds entries that occur more that once) -- (auto allocation below)
     void assembleNode(const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 2>& nodevec) const;
 
+    // "asElement" for the elements "elem" only ("elemvec" is of full size: all elements,
+    // only its rows "elem" are (over)written)
+    void asElement(
+        const xt::xtensor<size_t, 1>& elem,
+        const xt::xtensor<double, 1>& dofval,
+        xt::xtensor<double, 3>& elemvec) const;
+
+    void asElement(
+        const xt::xtensor<size_t, 1>& elem,
+        const xt::xtensor<double, 2>& nodevec,
+        xt::xtensor<double, 3>& elemvec) const;
+
+    // Accumulate variants of the assembly above: "dofval += alpha * ..." and
+    // "nodevec += alpha * ..." (without zeroing the output), e.g. to combine several
+    // contributions (internal and external forces, material subsets) without temporaries.
+    // With a list of elements "elem", only the rows "elem" of "elemvec" (of full size) are added,
+    // e.g. to patch an assembled internal force with the change of the elements of an event.
+    void assembleDofs(
+        const xt::xtensor<double, 2>& nodevec, xt::xtensor<double, 1>& dofval, double alpha) const;
+
+    void assembleDofs(
+        const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 1>& dofval, double alpha) const;
+
+    void assembleNode(
+        const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 2>& nodevec, double alpha) const;
+
+    void assembleDofs(
+        const xt::xtensor<size_t, 1>& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 1>& dofval,
+        double alpha) const;
+
+    void assembleNode(
+        const xt::xtensor<size_t, 1>& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 2>& nodevec,
+        double alpha) const;
+
     // Auto-allocation of the functions above
     xt::xtensor<double, 1> AsDofs(const xt::xtensor<double, 2>& nodevec) const;
     xt::xtensor<double, 1> AsDofs(const xt::xtensor<double, 3>& elemvec) const;
@@ -66,7 +108,7 @@ public:
     xt::xtensor<double, 1> AssembleDofs(const xt::xtensor<double, 3>& elemvec) const;
     xt::xtensor<double, 2> AssembleNode(const xt::xtensor<double, 3>& elemvec) const;
 
-    // Get zero-allocated dofval, nodevec, elemvec
+    // Get zero-allocated dofval, nodevec, elemvec (initialised in parallel: "first-touch")
     xt::xtensor<double, 1> AllocateDofval() const;
     xt::xtensor<double, 2> AllocateNodevec() const;
     xt::xtensor<double, 3> AllocateElemvec() const;
@@ -77,9 +119,24 @@ public:
     xt::xtensor<double, 3> AllocateElemmat(double val) const;
 
 private:
-    // Bookkeeping
-    xt::xtensor<size_t, 2> m_conn; // connectivity         [nelem, nne ]
-    xt::xtensor<size_t, 2> m_dofs; // DOF-numbers per node [nnode, ndim]
+    // Implementation of the assembly, on the list of elements "elem" (e.g. "xt::arange")
+    template <class E>
+    void assembleDofs_impl(
+        const E& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 1>& dofval,
+        double alpha) const;
+
+    template <class E>
+    void assembleNode_impl(
+        const E& elem,
+        const xt::xtensor<double, 3>& elemvec,
+        xt::xtensor<double, 2>& nodevec,
+        double alpha) const;
+
+private:
+    // Bookkeeping: connectivity [nelem, nne] and DOF-numbers per node [nnode, ndim]
+    Topology m_topo;
 
     // Dimensions
     size_t m_nelem; // number of elements
@@ -87,6 +144,11 @@ private:
     size_t m_nnode; // number of nodes
     size_t m_ndim;  // number of dimensions
     size_t m_ndof;  // number of DOFs
+
+    // Nodal entries "m * ndim + i" of each DOF, only if DOFs are shared by nodes (e.g. periodic):
+    // the entries of DOF "d" are "m_dofnode(k)" for "m_dofnode_index(d) <= k < m_dofnode_index(d+1)"
+    xt::xtensor<size_t, 1> m_dofnode_index;
+    xt::xtensor<size_t, 1> m_dofnode;
 };
 
 } // namespace GooseFEM
@@ -12,16 +12,44 @@
 namespace GooseFEM {
 
 inline Vector::Vector(const xt::xtensor<size_t, 2>& conn, const xt::xtensor<size_t, 2>& dofs)
-    : m_conn(conn), m_dofs(dofs)
+    : Vector(Topology(conn, dofs))
 {
-    m_nelem = m_conn.shape(0);
-    m_nne = m_conn.shape(1);
-    m_nnode = m_dofs.shape(0);
-    m_ndim = m_dofs.shape(1);
-    m_ndof = xt::amax(m_dofs)() + 1;
+}
+
+inline Vector::Vector(const Topology& topology) : m_topo(topology)
+{
+    m_nelem = m_topo.nelem();
+    m_nne = m_topo.nne();
+    m_nnode = m_topo.nnode();
+    m_ndim = m_topo.ndim();
+    m_ndof = m_topo.ndof();
+
+    if (m_ndof == m_nnode * m_ndim) {
+        return;
+    }
+
+    const auto& dofs = m_topo.dofs();
+
+    m_dofnode_index = xt::zeros<size_t>({m_ndof + 1});
+    m_dofnode = xt::empty<size_t>({m_nnode * m_ndim});
+
+    for (size_t m = 0; m < m_nnode; ++m) {
+        for (size_t i = 0; i < m_ndim; ++i) {
+            m_dofnode_index(dofs(m, i) + 1)++;
+        }
+    }
+
+    for (size_t d = 0; d < m_ndof; ++d) {
+        m_dofnode_index(d + 1) += m_dofnode_index(d);
+    }
+
+    xt::xtensor<size_t, 1> k = xt::view(m_dofnode_index, xt::range(0, m_ndof));
 
-    GOOSEFEM_ASSERT(xt::amax(m_conn)() + 1 <= m_nnode);
-    GOOSEFEM_ASSERT(m_ndof <= m_nnode * m_ndim);
+    for (size_t m = 0; m < m_nnode; ++m) {
+        for (size_t i = 0; i < m_ndim; ++i) {
+            m_dofnode(k(dofs(m, i))++) = m * m_ndim + i;
+        }
+    }
 }
 
 inline size_t Vector::nelem() const
@@ -49,9 +77,19 @@ inline size_t Vector::ndof() const
     return m_ndof;
 }
 
-inline xt::xtensor<size_t, 2> Vector::dofs() const
+inline const Topology& Vector::topology() const
 {
-    return m_dofs;
+    return m_topo;
+}
+
+inline const xt::xtensor<size_t, 2>& Vector::conn() const
+{
+    return m_topo.conn();
+}
+
+inline const xt::xtensor<size_t, 2>& Vector::dofs() const
+{
+    return m_topo.dofs();
 }
 
 inline void
@@ -69,12 +107,14 @@ Vector::asDofs(const xt::xtensor<double, 2>& nodevec, xt::xtensor<double, 1>& do
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
 
+    const auto& dofs = m_topo.dofs();
+
     dofval.fill(0.0);
 
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            dofval(m_dofs(m, i)) = nodevec(m, i);
+            dofval(dofs(m, i)) = nodevec(m, i);
         }
     }
 }
@@ -85,13 +125,18 @@ Vector::asDofs(const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 1>& do
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
 
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+    const auto& dofs = m_topo.dofs();
+
     dofval.fill(0.0);
 
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (size_t e = 0; e < m_nelem; ++e) {
+        size_t r = rows ? rows[e] : e;
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                dofval(m_dofs(m_conn(e, m), i)) = elemvec(e, m, i);
+                dofval(dofs(conn(r, m), i)) = elemvec(e, m, i);
             }
         }
     }
@@ -103,10 +148,12 @@ Vector::asNode(const xt::xtensor<double, 1>& dofval, xt::xtensor<double, 2>& nod
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
-    #pragma omp parallel for
+    const auto& dofs = m_topo.dofs();
+
+    #pragma omp parallel for schedule(static)
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            nodevec(m, i) = dofval(m_dofs(m, i));
+            nodevec(m, i) = dofval(dofs(m, i));
         }
     }
 }
@@ -117,13 +164,17 @@ Vector::asNode(const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 2>& no
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+
     nodevec.fill(0.0);
 
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (size_t e = 0; e < m_nelem; ++e) {
+        size_t r = rows ? rows[e] : e;
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                nodevec(m_conn(e, m), i) = elemvec(e, m, i);
+                nodevec(conn(r, m), i) = elemvec(e, m, i);
             }
         }
     }
@@ -135,11 +186,16 @@ Vector::asElement(const xt::xtensor<double, 1>& dofval, xt::xtensor<double, 3>&
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
 
-    #pragma omp parallel for
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+    const auto& dofs = m_topo.dofs();
+
+    #pragma omp parallel for schedule(static)
     for (size_t e = 0; e < m_nelem; ++e) {
+        size_t r = rows ? rows[e] : e;
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                elemvec(e, m, i) = dofval(m_dofs(m_conn(e, m), i));
+                elemvec(e, m, i) = dofval(dofs(conn(r, m), i));
             }
         }
     }
@@ -151,11 +207,15 @@ Vector::asElement(const xt::xtensor<double, 2>& nodevec, xt::xtensor<double, 3>&
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
 
-    #pragma omp parallel for
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+
+    #pragma omp parallel for schedule(static)
     for (size_t e = 0; e < m_nelem; ++e) {
+        size_t r = rows ? rows[e] : e;
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                elemvec(e, m, i) = nodevec(m_conn(e, m), i);
+                elemvec(e, m, i) = nodevec(conn(r, m), i);
             }
         }
     }
@@ -168,10 +228,20 @@ Vector::assembleDofs(const xt::xtensor<double, 2>& nodevec, xt::xtensor<double,
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
 
     dofval.fill(0.0);
+    this->assembleDofs(nodevec, dofval, 1.0);
+}
+
+inline void Vector::assembleDofs(
+    const xt::xtensor<double, 2>& nodevec, xt::xtensor<double, 1>& dofval, double alpha) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
+    GOOSEFEM_ASSERT(dofval.size() == m_ndof);
+
+    const auto& dofs = m_topo.dofs();
 
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            dofval(m_dofs(m, i)) += nodevec(m, i);
+            dofval(dofs(m, i)) += alpha * nodevec(m, i);
         }
     }
 }
@@ -183,24 +253,174 @@ Vector::assembleDofs(const xt::xtensor<double, 3>& elemvec, xt::xtensor<double,
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
 
     dofval.fill(0.0);
+    this->assembleDofs_impl(xt::arange<size_t>(m_nelem), elemvec, dofval, 1.0);
+}
 
-    for (size_t e = 0; e < m_nelem; ++e) {
+inline void Vector::assembleDofs(
+    const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 1>& dofval, double alpha) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(dofval.size() == m_ndof);
+
+    this->assembleDofs_impl(xt::arange<size_t>(m_nelem), elemvec, dofval, alpha);
+}
+
+inline void
+Vector::assembleNode(const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 2>& nodevec) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
+
+    xt::xtensor<double, 1> dofval = this->AssembleDofs(elemvec);
+    this->asNode(dofval, nodevec);
+}
+
+inline void Vector::assembleNode(
+    const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 2>& nodevec, double alpha) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
+
+    this->assembleNode_impl(xt::arange<size_t>(m_nelem), elemvec, nodevec, alpha);
+}
+
+inline void Vector::asElement(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 1>& dofval,
+    xt::xtensor<double, 3>& elemvec) const
+{
+    GOOSEFEM_ASSERT(dofval.size() == m_ndof);
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+    const auto& dofs = m_topo.dofs();
+
+    #pragma omp parallel for schedule(static)
+    for (size_t ie = 0; ie < elem.size(); ++ie) {
+        size_t e = elem(ie);
+        size_t r = rows ? rows[e] : e;
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                dofval(m_dofs(m_conn(e, m), i)) += elemvec(e, m, i);
+                elemvec(e, m, i) = dofval(dofs(conn(r, m), i));
             }
         }
     }
 }
 
-inline void
-Vector::assembleNode(const xt::xtensor<double, 3>& elemvec, xt::xtensor<double, 2>& nodevec) const
+inline void Vector::asElement(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 2>& nodevec,
+    xt::xtensor<double, 3>& elemvec) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+
+    #pragma omp parallel for schedule(static)
+    for (size_t ie = 0; ie < elem.size(); ++ie) {
+        size_t e = elem(ie);
+        size_t r = rows ? rows[e] : e;
+        for (size_t m = 0; m < m_nne; ++m) {
+            for (size_t i = 0; i < m_ndim; ++i) {
+                elemvec(e, m, i) = nodevec(conn(r, m), i);
+            }
+        }
+    }
+}
+
+inline void Vector::assembleDofs(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 3>& elemvec,
+    xt::xtensor<double, 1>& dofval,
+    double alpha) const
+{
+    GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
+    GOOSEFEM_ASSERT(dofval.size() == m_ndof);
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
+
+    this->assembleDofs_impl(elem, elemvec, dofval, alpha);
+}
+
+inline void Vector::assembleNode(
+    const xt::xtensor<size_t, 1>& elem,
+    const xt::xtensor<double, 3>& elemvec,
+    xt::xtensor<double, 2>& nodevec,
+    double alpha) const
 {
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
+    GOOSEFEM_ASSERT(elem.size() == 0 || xt::amax(elem)() < m_nelem);
 
-    xt::xtensor<double, 1> dofval = this->AssembleDofs(elemvec);
-    this->asNode(dofval, nodevec);
+    this->assembleNode_impl(elem, elemvec, nodevec, alpha);
+}
+
+template <class E>
+inline void Vector::assembleDofs_impl(
+    const E& elem,
+    const xt::xtensor<double, 3>& elemvec,
+    xt::xtensor<double, 1>& dofval,
+    double alpha) const
+{
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+    const auto& dofs = m_topo.dofs();
+
+    for (size_t ie = 0; ie < elem.size(); ++ie) {
+        size_t e = elem(ie);
+        size_t r = rows ? rows[e] : e;
+        for (size_t m = 0; m < m_nne; ++m) {
+            for (size_t i = 0; i < m_ndim; ++i) {
+                dofval(dofs(conn(r, m), i)) += alpha * elemvec(e, m, i);
+            }
+        }
+    }
+}
+
+template <class E>
+inline void Vector::assembleNode_impl(
+    const E& elem,
+    const xt::xtensor<double, 3>& elemvec,
+    xt::xtensor<double, 2>& nodevec,
+    double alpha) const
+{
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+    const auto& dofs = m_topo.dofs();
+
+    // each DOF belongs to one node
+    if (m_dofnode.size() == 0) {
+        for (size_t ie = 0; ie < elem.size(); ++ie) {
+            size_t e = elem(ie);
+            size_t r = rows ? rows[e] : e;
+            for (size_t m = 0; m < m_nne; ++m) {
+                for (size_t i = 0; i < m_ndim; ++i) {
+                    nodevec(conn(r, m), i) += alpha * elemvec(e, m, i);
+                }
+            }
+        }
+        return;
+    }
+
+    // add to all nodes that share the DOF
+    double* n = nodevec.data();
+
+    for (size_t ie = 0; ie < elem.size(); ++ie) {
+        size_t e = elem(ie);
+        size_t r = rows ? rows[e] : e;
+        for (size_t m = 0; m < m_nne; ++m) {
+            for (size_t i = 0; i < m_ndim; ++i) {
+                size_t d = dofs(conn(r, m), i);
+                for (size_t k = m_dofnode_index(d); k < m_dofnode_index(d + 1); ++k) {
+                    n[m_dofnode(k)] += alpha * elemvec(e, m, i);
+                }
+            }
+        }
+    }
 }
 
 inline xt::xtensor<double, 1> Vector::AsDofs(const xt::xtensor<double, 2>& nodevec) const
@@ -268,53 +488,49 @@ inline xt::xtensor<double, 2> Vector::AssembleNode(const xt::xtensor<double, 3>&
 
 inline xt::xtensor<double, 1> Vector::AllocateDofval() const
 {
-    xt::xtensor<double, 1> dofval = xt::empty<double>({m_ndof});
-    return dofval;
+    return this->AllocateDofval(0.0);
 }
 
 inline xt::xtensor<double, 2> Vector::AllocateNodevec() const
 {
-    xt::xtensor<double, 2> nodevec = xt::empty<double>({m_nnode, m_ndim});
-    return nodevec;
+    return this->AllocateNodevec(0.0);
 }
 
 inline xt::xtensor<double, 3> Vector::AllocateElemvec() const
 {
-    xt::xtensor<double, 3> elemvec = xt::empty<double>({m_nelem, m_nne, m_ndim});
-    return elemvec;
+    return this->AllocateElemvec(0.0);
 }
 
 inline xt::xtensor<double, 3> Vector::AllocateElemmat() const
 {
-    xt::xtensor<double, 3> elemmat = xt::empty<double>({m_nelem, m_nne * m_ndim, m_nne * m_ndim});
-    return elemmat;
+    return this->AllocateElemmat(0.0);
 }
 
 inline xt::xtensor<double, 1> Vector::AllocateDofval(double val) const
 {
     xt::xtensor<double, 1> dofval = xt::empty<double>({m_ndof});
-    dofval.fill(val);
+    GooseFEM::firstTouch(dofval, val);
     return dofval;
 }
 
 inline xt::xtensor<double, 2> Vector::AllocateNodevec(double val) const
 {
     xt::xtensor<double, 2> nodevec = xt::empty<double>({m_nnode, m_ndim});
-    nodevec.fill(val);
+    GooseFEM::firstTouch(nodevec, val);
     return nodevec;
 }
 
 inline xt::xtensor<double, 3> Vector::AllocateElemvec(double val) const
 {
     xt::xtensor<double, 3> elemvec = xt::empty<double>({m_nelem, m_nne, m_ndim});
-    elemvec.fill(val);
+    GooseFEM::firstTouch(elemvec, val);
     return elemvec;
 }
 
 inline xt::xtensor<double, 3> Vector::AllocateElemmat(double val) const
 {
     xt::xtensor<double, 3> elemmat = xt::empty<double>({m_nelem, m_nne * m_ndim, m_nne * m_ndim});
-    elemmat.fill(val);
+    GooseFEM::firstTouch(elemmat, val);
     return elemmat;
 }
 
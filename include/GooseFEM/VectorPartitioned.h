@@ -8,6 +8,7 @@
 #define GOOSEFEM_VECTORPARTITIONED_H
 
 #include "config.h"
+#include "Topology.h"
 
 namespace GooseFEM {
 
@@ -29,6 +30,8 @@ public:
         const xt::xtensor<size_t, 2>& dofs,
         const xt::xtensor<size_t, 1>& iip);
 
+    VectorPartitioned(const Topology& topology); // shares data (no copy)
+
     // Dimensions
     size_t nelem() const; // number of elements
     size_t nne() const;   // number of nodes per element
@@ -38,10 +41,12 @@ public:
     size_t nnu() const;   // number of unknown DOFs
     size_t nnp() const;   // number of prescribed DOFs
 
-    // DOF lists
-    xt::xtensor<size_t, 2> dofs() const; // DOFs
-    xt::xtensor<size_t, 1> iiu() const;  // unknown    DOFs
-    xt::xtensor<size_t, 1> iip() const;  // prescribed DOFs
+    // Connectivity and DOF lists
+    const Topology& topology() const;
+    const xt::xtensor<size_t, 2>& conn() const; // connectivity
+    const xt::xtensor<size_t, 2>& dofs() const; // DOFs
+    const xt::xtensor<size_t, 1>& iiu() const; // unknown DOFs
+    const xt::xtensor<size_t, 1>& iip() const; // prescribed DOFs
 
     // Copy (part of) nodevec/dofval to another nodevec/dofval
     void copy(
@@ -142,7 +147,7 @@ public:
         const xt::xtensor<double, 2>& nodevec_src,
         const xt::xtensor<double, 2>& nodevec_dest) const;
 
-    // Get zero-allocated dofval, nodevec, elemvec
+    // Get zero-allocated dofval, nodevec, elemvec (initialised in parallel: "first-touch")
     xt::xtensor<double, 1> AllocateDofval() const;
     xt::xtensor<double, 2> AllocateNodevec() const;
     xt::xtensor<double, 3> AllocateElemvec() const;
@@ -153,14 +158,8 @@ public:
     xt::xtensor<double, 3> AllocateElemmat(double val) const;
 
 private:
-    // Bookkeeping
-    xt::xtensor<size_t, 2> m_conn; // connectivity                    [nelem, nne ]
-    xt::xtensor<size_t, 2> m_dofs; // DOF-numbers per node            [nnode, ndim]
-    xt::xtensor<size_t, 1> m_iiu;  // DOF-numbers that are unknown    [nnu]
-    xt::xtensor<size_t, 1> m_iip;  // DOF-numbers that are prescribed [nnp]
-
-    // DOFs per node, such that iiu = arange(nnu), iip = nnu + arange(nnp)
-    xt::xtensor<size_t, 2> m_part;
+    // Bookkeeping: connectivity, DOF-numbers per node, partitioning in unknown/prescribed DOFs
+    Topology m_topo;
 
     // Dimensions
     size_t m_nelem; // number of elements
@@ -7,7 +7,6 @@
 #ifndef GOOSEFEM_VECTORPARTITIONED_HPP
 #define GOOSEFEM_VECTORPARTITIONED_HPP
 
-#include "Mesh.h"
 #include "VectorPartitioned.h"
 
 namespace GooseFEM {
@@ -16,21 +15,21 @@ inline VectorPartitioned::VectorPartitioned(
     const xt::xtensor<size_t, 2>& conn,
     const xt::xtensor<size_t, 2>& dofs,
     const xt::xtensor<size_t, 1>& iip)
-    : m_conn(conn), m_dofs(dofs), m_iip(iip)
+    : VectorPartitioned(Topology(conn, dofs, iip))
 {
-    m_nelem = m_conn.shape(0);
-    m_nne = m_conn.shape(1);
-    m_nnode = m_dofs.shape(0);
-    m_ndim = m_dofs.shape(1);
-    m_iiu = xt::setdiff1d(m_dofs, m_iip);
-    m_ndof = xt::amax(m_dofs)() + 1;
-    m_nnp = m_iip.size();
-    m_nnu = m_iiu.size();
-    m_part = Mesh::Reorder({m_iiu, m_iip}).get(m_dofs);
+}
+
+inline VectorPartitioned::VectorPartitioned(const Topology& topology) : m_topo(topology)
+{
+    GOOSEFEM_ASSERT(m_topo.isPartitioned());
 
-    GOOSEFEM_ASSERT(xt::amax(m_conn)() + 1 <= m_nnode);
-    GOOSEFEM_ASSERT(xt::amax(m_iip)() <= xt::amax(m_dofs)());
-    GOOSEFEM_ASSERT(m_ndof <= m_nnode * m_ndim);
+    m_nelem = m_topo.nelem();
+    m_nne = m_topo.nne();
+    m_nnode = m_topo.nnode();
+    m_ndim = m_topo.ndim();
+    m_ndof = m_topo.ndof();
+    m_nnu = m_topo.nnu();
+    m_nnp = m_topo.nnp();
 }
 
 inline size_t VectorPartitioned::nelem() const
@@ -68,19 +67,29 @@ inline size_t VectorPartitioned::nnp() const
     return m_nnp;
 }
 
-inline xt::xtensor<size_t, 2> VectorPartitioned::dofs() const
+inline const Topology& VectorPartitioned::topology() const
+{
+    return m_topo;
+}
+
+inline const xt::xtensor<size_t, 2>& VectorPartitioned::conn() const
 {
-    return m_dofs;
+    return m_topo.conn();
 }
 
-inline xt::xtensor<size_t, 1> VectorPartitioned::iiu() const
+inline const xt::xtensor<size_t, 2>& VectorPartitioned::dofs() const
 {
-    return m_iiu;
+    return m_topo.dofs();
 }
 
-inline xt::xtensor<size_t, 1> VectorPartitioned::iip() const
+inline const xt::xtensor<size_t, 1>& VectorPartitioned::iiu() const
 {
-    return m_iip;
+    return m_topo.iiu();
+}
+
+inline const xt::xtensor<size_t, 1>& VectorPartitioned::iip() const
+{
+    return m_topo.iip();
 }
 
 inline void VectorPartitioned::copy(
@@ -98,10 +107,12 @@ inline void VectorPartitioned::copy_u(
     GOOSEFEM_ASSERT(xt::has_shape(nodevec_src, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(nodevec_dest, {m_nnode, m_ndim}));
 
-    #pragma omp parallel for
+    const auto& part = m_topo.part();
+
+    #pragma omp parallel for schedule(static)
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_part(m, i) < m_nnu) {
+            if (part(m, i) < m_nnu) {
                 nodevec_dest(m, i) = nodevec_src(m, i);
             }
         }
@@ -114,10 +125,12 @@ inline void VectorPartitioned::copy_p(
     GOOSEFEM_ASSERT(xt::has_shape(nodevec_src, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(nodevec_dest, {m_nnode, m_ndim}));
 
-    #pragma omp parallel for
+    const auto& part = m_topo.part();
+
+    #pragma omp parallel for schedule(static)
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_part(m, i) >= m_nnu) {
+            if (part(m, i) >= m_nnu) {
                 nodevec_dest(m, i) = nodevec_src(m, i);
             }
         }
@@ -133,16 +146,19 @@ inline void VectorPartitioned::asDofs(
     GOOSEFEM_ASSERT(dofval_p.size() == m_nnp);
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
 
+    const auto& iiu = m_topo.iiu();
+    const auto& iip = m_topo.iip();
+
     dofval.fill(0.0);
 
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (size_t d = 0; d < m_nnu; ++d) {
-        dofval(m_iiu(d)) = dofval_u(d);
+        dofval(iiu(d)) = dofval_u(d);
     }
 
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (size_t d = 0; d < m_nnp; ++d) {
-        dofval(m_iip(d)) = dofval_p(d);
+        dofval(iip(d)) = dofval_p(d);
     }
 }
 
@@ -152,12 +168,14 @@ inline void VectorPartitioned::asDofs(
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
 
+    const auto& dofs = m_topo.dofs();
+
     dofval.fill(0.0);
 
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            dofval(m_dofs(m, i)) = nodevec(m, i);
+            dofval(dofs(m, i)) = nodevec(m, i);
         }
     }
 }
@@ -168,9 +186,11 @@ inline void VectorPartitioned::asDofs_u(
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
     GOOSEFEM_ASSERT(dofval_u.size() == m_nnu);
 
-    #pragma omp parallel for
+    const auto& iiu = m_topo.iiu();
+
+    #pragma omp parallel for schedule(static)
     for (size_t d = 0; d < m_nnu; ++d) {
-        dofval_u(d) = dofval(m_iiu(d));
+        dofval_u(d) = dofval(iiu(d));
     }
 }
 
@@ -180,13 +200,15 @@ inline void VectorPartitioned::asDofs_u(
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(dofval_u.size() == m_nnu);
 
+    const auto& part = m_topo.part();
+
     dofval_u.fill(0.0);
 
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_part(m, i) < m_nnu) {
-                dofval_u(m_part(m, i)) = nodevec(m, i);
+            if (part(m, i) < m_nnu) {
+                dofval_u(part(m, i)) = nodevec(m, i);
             }
         }
     }
@@ -198,9 +220,11 @@ inline void VectorPartitioned::asDofs_p(
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
     GOOSEFEM_ASSERT(dofval_p.size() == m_nnp);
 
-    #pragma omp parallel for
+    const auto& iip = m_topo.iip();
+
+    #pragma omp parallel for schedule(static)
     for (size_t d = 0; d < m_nnp; ++d) {
-        dofval_p(d) = dofval(m_iip(d));
+        dofval_p(d) = dofval(iip(d));
     }
 }
 
@@ -210,13 +234,15 @@ inline void VectorPartitioned::asDofs_p(
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(dofval_p.size() == m_nnp);
 
+    const auto& part = m_topo.part();
+
     dofval_p.fill(0.0);
 
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_part(m, i) >= m_nnu) {
-                dofval_p(m_part(m, i) - m_nnu) = nodevec(m, i);
+            if (part(m, i) >= m_nnu) {
+                dofval_p(part(m, i) - m_nnu) = nodevec(m, i);
             }
         }
     }
@@ -228,13 +254,18 @@ inline void VectorPartitioned::asDofs(
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
 
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+    const auto& dofs = m_topo.dofs();
+
     dofval.fill(0.0);
 
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (size_t e = 0; e < m_nelem; ++e) {
+        size_t r = rows ? rows[e] : e;
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                dofval(m_dofs(m_conn(e, m), i)) = elemvec(e, m, i);
+                dofval(dofs(conn(r, m), i)) = elemvec(e, m, i);
             }
         }
     }
@@ -246,14 +277,19 @@ inline void VectorPartitioned::asDofs_u(
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(dofval_u.size() == m_nnu);
 
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+    const auto& part = m_topo.part();
+
     dofval_u.fill(0.0);
 
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (size_t e = 0; e < m_nelem; ++e) {
+        size_t r = rows ? rows[e] : e;
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                if (m_part(m_conn(e, m), i) < m_nnu) {
-                    dofval_u(m_part(m_conn(e, m), i)) = elemvec(e, m, i);
+                if (part(conn(r, m), i) < m_nnu) {
+                    dofval_u(part(conn(r, m), i)) = elemvec(e, m, i);
                 }
             }
         }
@@ -266,14 +302,19 @@ inline void VectorPartitioned::asDofs_p(
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(dofval_p.size() == m_nnp);
 
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+    const auto& part = m_topo.part();
+
     dofval_p.fill(0.0);
 
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (size_t e = 0; e < m_nelem; ++e) {
+        size_t r = rows ? rows[e] : e;
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                if (m_part(m_conn(e, m), i) >= m_nnu) {
-                    dofval_p(m_part(m_conn(e, m), i) - m_nnu) = elemvec(e, m, i);
+                if (part(conn(r, m), i) >= m_nnu) {
+                    dofval_p(part(conn(r, m), i) - m_nnu) = elemvec(e, m, i);
                 }
             }
         }
@@ -286,10 +327,12 @@ inline void VectorPartitioned::asNode(
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
-    #pragma omp parallel for
+    const auto& dofs = m_topo.dofs();
+
+    #pragma omp parallel for schedule(static)
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            nodevec(m, i) = dofval(m_dofs(m, i));
+            nodevec(m, i) = dofval(dofs(m, i));
         }
     }
 }
@@ -303,14 +346,16 @@ inline void VectorPartitioned::asNode(
     GOOSEFEM_ASSERT(dofval_p.size() == m_nnp);
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
-    #pragma omp parallel for
+    const auto& part = m_topo.part();
+
+    #pragma omp parallel for schedule(static)
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_part(m, i) < m_nnu) {
-                nodevec(m, i) = dofval_u(m_part(m, i));
+            if (part(m, i) < m_nnu) {
+                nodevec(m, i) = dofval_u(part(m, i));
             }
             else {
-                nodevec(m, i) = dofval_p(m_part(m, i) - m_nnu);
+                nodevec(m, i) = dofval_p(part(m, i) - m_nnu);
             }
         }
     }
@@ -322,13 +367,17 @@ inline void VectorPartitioned::asNode(
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+
     nodevec.fill(0.0);
 
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (size_t e = 0; e < m_nelem; ++e) {
+        size_t r = rows ? rows[e] : e;
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                nodevec(m_conn(e, m), i) = elemvec(e, m, i);
+                nodevec(conn(r, m), i) = elemvec(e, m, i);
             }
         }
     }
@@ -340,11 +389,16 @@ inline void VectorPartitioned::asElement(
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
 
-    #pragma omp parallel for
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+    const auto& dofs = m_topo.dofs();
+
+    #pragma omp parallel for schedule(static)
     for (size_t e = 0; e < m_nelem; ++e) {
+        size_t r = rows ? rows[e] : e;
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                elemvec(e, m, i) = dofval(m_dofs(m_conn(e, m), i));
+                elemvec(e, m, i) = dofval(dofs(conn(r, m), i));
             }
         }
     }
@@ -359,15 +413,20 @@ inline void VectorPartitioned::asElement(
     GOOSEFEM_ASSERT(dofval_p.size() == m_nnp);
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
 
-    #pragma omp parallel for
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+    const auto& part = m_topo.part();
+
+    #pragma omp parallel for schedule(static)
     for (size_t e = 0; e < m_nelem; ++e) {
+        size_t r = rows ? rows[e] : e;
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                if (m_part(m_conn(e, m), i) < m_nnu) {
-                    elemvec(e, m, i) = dofval_u(m_part(m_conn(e, m), i));
+                if (part(conn(r, m), i) < m_nnu) {
+                    elemvec(e, m, i) = dofval_u(part(conn(r, m), i));
                 }
                 else {
-                    elemvec(e, m, i) = dofval_p(m_part(m_conn(e, m), i) - m_nnu);
+                    elemvec(e, m, i) = dofval_p(part(conn(r, m), i) - m_nnu);
                 }
             }
         }
@@ -380,11 +439,15 @@ inline void VectorPartitioned::asElement(
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
 
-    #pragma omp parallel for
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+
+    #pragma omp parallel for schedule(static)
     for (size_t e = 0; e < m_nelem; ++e) {
+        size_t r = rows ? rows[e] : e;
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                elemvec(e, m, i) = nodevec(m_conn(e, m), i);
+                elemvec(e, m, i) = nodevec(conn(r, m), i);
             }
         }
     }
@@ -396,11 +459,13 @@ inline void VectorPartitioned::assembleDofs(
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
 
+    const auto& dofs = m_topo.dofs();
+
     dofval.fill(0.0);
 
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            dofval(m_dofs(m, i)) += nodevec(m, i);
+            dofval(dofs(m, i)) += nodevec(m, i);
         }
     }
 }
@@ -411,12 +476,14 @@ inline void VectorPartitioned::assembleDofs_u(
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(dofval_u.size() == m_nnu);
 
+    const auto& part = m_topo.part();
+
     dofval_u.fill(0.0);
 
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_part(m, i) < m_nnu) {
-                dofval_u(m_part(m, i)) += nodevec(m, i);
+            if (part(m, i) < m_nnu) {
+                dofval_u(part(m, i)) += nodevec(m, i);
             }
         }
     }
@@ -428,12 +495,14 @@ inline void VectorPartitioned::assembleDofs_p(
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(dofval_p.size() == m_nnp);
 
+    const auto& part = m_topo.part();
+
     dofval_p.fill(0.0);
 
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_part(m, i) >= m_nnu) {
-                dofval_p(m_part(m, i) - m_nnu) += nodevec(m, i);
+            if (part(m, i) >= m_nnu) {
+                dofval_p(part(m, i) - m_nnu) += nodevec(m, i);
             }
         }
     }
@@ -445,12 +514,17 @@ inline void VectorPartitioned::assembleDofs(
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
 
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+    const auto& dofs = m_topo.dofs();
+
     dofval.fill(0.0);
 
     for (size_t e = 0; e < m_nelem; ++e) {
+        size_t r = rows ? rows[e] : e;
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                dofval(m_dofs(m_conn(e, m), i)) += elemvec(e, m, i);
+                dofval(dofs(conn(r, m), i)) += elemvec(e, m, i);
             }
         }
     }
@@ -462,13 +536,18 @@ inline void VectorPartitioned::assembleDofs_u(
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(dofval_u.size() == m_nnu);
 
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+    const auto& part = m_topo.part();
+
     dofval_u.fill(0.0);
 
     for (size_t e = 0; e < m_nelem; ++e) {
+        size_t r = rows ? rows[e] : e;
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                if (m_part(m_conn(e, m), i) < m_nnu) {
-                    dofval_u(m_part(m_conn(e, m), i)) += elemvec(e, m, i);
+                if (part(conn(r, m), i) < m_nnu) {
+                    dofval_u(part(conn(r, m), i)) += elemvec(e, m, i);
                 }
             }
         }
@@ -481,13 +560,18 @@ inline void VectorPartitioned::assembleDofs_p(
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(dofval_p.size() == m_nnp);
 
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+    const auto& part = m_topo.part();
+
     dofval_p.fill(0.0);
 
     for (size_t e = 0; e < m_nelem; ++e) {
+        size_t r = rows ? rows[e] : e;
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                if (m_part(m_conn(e, m), i) >= m_nnu) {
-                    dofval_p(m_part(m_conn(e, m), i) - m_nnu) += elemvec(e, m, i);
+                if (part(conn(r, m), i) >= m_nnu) {
+                    dofval_p(part(conn(r, m), i) - m_nnu) += elemvec(e, m, i);
                 }
             }
         }
@@ -702,53 +786,49 @@ inline xt::xtensor<double, 2> VectorPartitioned::Copy_p(
 
 inline xt::xtensor<double, 1> VectorPartitioned::AllocateDofval() const
 {
-    xt::xtensor<double, 1> dofval = xt::empty<double>({m_ndof});
-    return dofval;
+    return this->AllocateDofval(0.0);
 }
 
 inline xt::xtensor<double, 2> VectorPartitioned::AllocateNodevec() const
 {
-    xt::xtensor<double, 2> nodevec = xt::empty<double>({m_nnode, m_ndim});
-    return nodevec;
+    return this->AllocateNodevec(0.0);
 }
 
 inline xt::xtensor<double, 3> VectorPartitioned::AllocateElemvec() const
 {
-    xt::xtensor<double, 3> elemvec = xt::empty<double>({m_nelem, m_nne, m_ndim});
-    return elemvec;
+    return this->AllocateElemvec(0.0);
 }
 
 inline xt::xtensor<double, 3> VectorPartitioned::AllocateElemmat() const
 {
-    xt::xtensor<double, 3> elemmat = xt::empty<double>({m_nelem, m_nne * m_ndim, m_nne * m_ndim});
-    return elemmat;
+    return this->AllocateElemmat(0.0);
 }
 
 inline xt::xtensor<double, 1> VectorPartitioned::AllocateDofval(double val) const
 {
-    xt::xtensor<double, 1> dofval = xt::zeros<double>({m_ndof});
-    dofval.fill(val);
+    xt::xtensor<double, 1> dofval = xt::empty<double>({m_ndof});
+    GooseFEM::firstTouch(dofval, val);
     return dofval;
 }
 
 inline xt::xtensor<double, 2> VectorPartitioned::AllocateNodevec(double val) const
 {
-    xt::xtensor<double, 2> nodevec = xt::zeros<double>({m_nnode, m_ndim});
-    nodevec.fill(val);
+    xt::xtensor<double, 2> nodevec = xt::empty<double>({m_nnode, m_ndim});
+    GooseFEM::firstTouch(nodevec, val);
     return nodevec;
 }
 
 inline xt::xtensor<double, 3> VectorPartitioned::AllocateElemvec(double val) const
 {
-    xt::xtensor<double, 3> elemvec = xt::zeros<double>({m_nelem, m_nne, m_ndim});
-    elemvec.fill(val);
+    xt::xtensor<double, 3> elemvec = xt::empty<double>({m_nelem, m_nne, m_ndim});
+    GooseFEM::firstTouch(elemvec, val);
     return elemvec;
 }
 
 inline xt::xtensor<double, 3> VectorPartitioned::AllocateElemmat(double val) const
 {
     xt::xtensor<double, 3> elemmat = xt::empty<double>({m_nelem, m_nne * m_ndim, m_nne * m_ndim});
-    elemmat.fill(val);
+    GooseFEM::firstTouch(elemmat, val);
     return elemmat;
 }
 
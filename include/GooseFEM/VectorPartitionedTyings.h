@@ -8,6 +8,7 @@
 #define GOOSEFEM_VECTORPARTITIONEDTYINGS_H
 
 #include "config.h"
+#include "Topology.h"
 
 #include <Eigen/Eigen>
 #include <Eigen/Sparse>
@@ -34,6 +35,12 @@ public:
         const Eigen::SparseMatrix<double>& Cdp,
         const Eigen::SparseMatrix<double>& Cdi);
 
+    VectorPartitionedTyings(
+        const Topology& topology,
+        const Eigen::SparseMatrix<double>& Cdu,
+        const Eigen::SparseMatrix<double>& Cdp,
+        const Eigen::SparseMatrix<double>& Cdi); // shares data (no copy)
+
     // Dimensions
     size_t nelem() const; // number of elements
     size_t nne() const;   // number of nodes per element
@@ -45,12 +52,14 @@ public:
     size_t nni() const;   // number of independent DOFs
     size_t nnd() const;   // number of dependent DOFs
 
-    // DOF lists
-    xt::xtensor<size_t, 2> dofs() const; // DOFs
-    xt::xtensor<size_t, 1> iiu() const;  // independent, unknown DOFs
-    xt::xtensor<size_t, 1> iip() const;  // independent, prescribed DOFs
-    xt::xtensor<size_t, 1> iii() const;  // independent DOFs
-    xt::xtensor<size_t, 1> iid() const;  // dependent DOFs
+    // Connectivity and DOF lists
+    const Topology& topology() const;
+    const xt::xtensor<size_t, 2>& conn() const; // connectivity
+    const xt::xtensor<size_t, 2>& dofs() const; // DOFs
+    const xt::xtensor<size_t, 1>& iiu() const;  // independent, unknown DOFs
+    const xt::xtensor<size_t, 1>& iip() const;  // independent, prescribed DOFs
+    xt::xtensor<size_t, 1> iii() const;         // independent DOFs
+    const xt::xtensor<size_t, 1>& iid() const;  // dependent DOFs
 
     // Copy (part of) nodevec/dofval to another nodevec/dofval
     void copy_p(
@@ -81,7 +90,7 @@ public:
     xt::xtensor<double, 1> AssembleDofs(const xt::xtensor<double, 3>& elemvec) const;
     xt::xtensor<double, 2> AssembleNode(const xt::xtensor<double, 3>& elemvec) const;
 
-    // Get zero-allocated dofval, nodevec, elemvec
+    // Get zero-allocated dofval, nodevec, elemvec (initialised in parallel: "first-touch")
     xt::xtensor<double, 1> AllocateDofval() const;
     xt::xtensor<double, 2> AllocateNodevec() const;
     xt::xtensor<double, 3> AllocateElemvec() const;
@@ -93,8 +102,7 @@ public:
 
 private:
     // Bookkeeping
-    xt::xtensor<size_t, 2> m_conn; // connectivity [nelem, nne]
-    xt::xtensor<size_t, 2> m_dofs; // DOF-numbers per node  [nnode, ndim]
+    Topology m_topo; // connectivity [nelem, nne], DOF-numbers per node [nnode, ndim]
     xt::xtensor<size_t, 1> m_iiu;  // unknown DOFs [nnu]
     xt::xtensor<size_t, 1> m_iip;  // prescribed DOFs [nnp]
     xt::xtensor<size_t, 1> m_iid;  // dependent DOFs [nnd]
@@ -17,7 +17,16 @@ inline VectorPartitionedTyings::VectorPartitionedTyings(
     const Eigen::SparseMatrix<double>& Cdu,
     const Eigen::SparseMatrix<double>& Cdp,
     const Eigen::SparseMatrix<double>& Cdi)
-    : m_conn(conn), m_dofs(dofs), m_Cdu(Cdu), m_Cdp(Cdp), m_Cdi(Cdi)
+    : VectorPartitionedTyings(Topology(conn, dofs), Cdu, Cdp, Cdi)
+{
+}
+
+inline VectorPartitionedTyings::VectorPartitionedTyings(
+    const Topology& topology,
+    const Eigen::SparseMatrix<double>& Cdu,
+    const Eigen::SparseMatrix<double>& Cdp,
+    const Eigen::SparseMatrix<double>& Cdi)
+    : m_topo(topology), m_Cdu(Cdu), m_Cdp(Cdp), m_Cdi(Cdi)
 {
     GOOSEFEM_ASSERT(Cdu.rows() == Cdp.rows());
     GOOSEFEM_ASSERT(Cdi.rows() == Cdp.rows());
@@ -30,17 +39,17 @@ inline VectorPartitionedTyings::VectorPartitionedTyings(
     m_iiu = xt::arange<size_t>(m_nnu);
     m_iip = xt::arange<size_t>(m_nnu, m_nnu + m_nnp);
     m_iid = xt::arange<size_t>(m_nni, m_nni + m_nnd);
-    m_nelem = m_conn.shape(0);
-    m_nne = m_conn.shape(1);
-    m_nnode = m_dofs.shape(0);
-    m_ndim = m_dofs.shape(1);
+    m_nelem = m_topo.nelem();
+    m_nne = m_topo.nne();
+    m_nnode = m_topo.nnode();
+    m_ndim = m_topo.ndim();
     m_Cud = m_Cdu.transpose();
     m_Cpd = m_Cdp.transpose();
     m_Cid = m_Cdi.transpose();
 
     GOOSEFEM_ASSERT(static_cast<size_t>(m_Cdi.cols()) == m_nni);
     GOOSEFEM_ASSERT(m_ndof <= m_nnode * m_ndim);
-    GOOSEFEM_ASSERT(m_ndof == xt::amax(m_dofs)() + 1);
+    GOOSEFEM_ASSERT(m_ndof == m_topo.ndof());
 }
 
 inline size_t VectorPartitionedTyings::nelem() const
@@ -88,17 +97,27 @@ inline size_t VectorPartitionedTyings::nnd() const
     return m_nnd;
 }
 
-inline xt::xtensor<size_t, 2> VectorPartitionedTyings::dofs() const
+inline const Topology& VectorPartitionedTyings::topology() const
 {
-    return m_dofs;
+    return m_topo;
 }
 
-inline xt::xtensor<size_t, 1> VectorPartitionedTyings::iiu() const
+inline const xt::xtensor<size_t, 2>& VectorPartitionedTyings::conn() const
+{
+    return m_topo.conn();
+}
+
+inline const xt::xtensor<size_t, 2>& VectorPartitionedTyings::dofs() const
+{
+    return m_topo.dofs();
+}
+
+inline const xt::xtensor<size_t, 1>& VectorPartitionedTyings::iiu() const
 {
     return m_iiu;
 }
 
-inline xt::xtensor<size_t, 1> VectorPartitionedTyings::iip() const
+inline const xt::xtensor<size_t, 1>& VectorPartitionedTyings::iip() const
 {
     return m_iip;
 }
@@ -108,7 +127,7 @@ inline xt::xtensor<size_t, 1> VectorPartitionedTyings::iii() const
     return xt::arange<size_t>(m_nni);
 }
 
-inline xt::xtensor<size_t, 1> VectorPartitionedTyings::iid() const
+inline const xt::xtensor<size_t, 1>& VectorPartitionedTyings::iid() const
 {
     return m_iid;
 }
@@ -119,7 +138,7 @@ inline void VectorPartitionedTyings::copy_p(
     GOOSEFEM_ASSERT(dofval_src.size() == m_ndof || dofval_src.size() == m_nni);
     GOOSEFEM_ASSERT(dofval_dest.size() == m_ndof || dofval_dest.size() == m_nni);
 
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (size_t i = m_nnu; i < m_nni; ++i) {
         dofval_dest(i) = dofval_src(i);
     }
@@ -133,13 +152,15 @@ inline void VectorPartitionedTyings::asDofs_i(
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(dofval_i.size() == m_nni);
 
+    const auto& dofs = m_topo.dofs();
+
     dofval_i.fill(0.0);
 
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_dofs(m, i) < m_nni) {
-                dofval_i(m_dofs(m, i)) = nodevec(m, i);
+            if (dofs(m, i) < m_nni) {
+                dofval_i(dofs(m, i)) = nodevec(m, i);
             }
         }
     }
@@ -151,7 +172,7 @@ inline void VectorPartitionedTyings::asDofs_i(
     Eigen::VectorXd Dofval_d = this->Eigen_asDofs_d(nodevec);
     Eigen::VectorXd Dofval_i = m_Cid * Dofval_d;
 
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (size_t i = 0; i < m_nni; ++i) {
         dofval_i(i) += Dofval_i(i);
     }
@@ -163,10 +184,12 @@ inline void VectorPartitionedTyings::asNode(
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
-    #pragma omp parallel for
+    const auto& dofs = m_topo.dofs();
+
+    #pragma omp parallel for schedule(static)
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            nodevec(m, i) = dofval(m_dofs(m, i));
+            nodevec(m, i) = dofval(dofs(m, i));
         }
     }
 }
@@ -177,11 +200,15 @@ inline void VectorPartitionedTyings::asElement(
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
 
-    #pragma omp parallel for
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+
+    #pragma omp parallel for schedule(static)
     for (size_t e = 0; e < m_nelem; ++e) {
+        size_t r = rows ? rows[e] : e;
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                elemvec(e, m, i) = nodevec(m_conn(e, m), i);
+                elemvec(e, m, i) = nodevec(conn(r, m), i);
             }
         }
     }
@@ -193,12 +220,17 @@ inline void VectorPartitionedTyings::assembleDofs(
     GOOSEFEM_ASSERT(xt::has_shape(elemvec, {m_nelem, m_nne, m_ndim}));
     GOOSEFEM_ASSERT(dofval.size() == m_ndof);
 
+    const auto& conn = m_topo.conn();
+    const size_t* rows = m_topo.rows();
+    const auto& dofs = m_topo.dofs();
+
     dofval.fill(0.0);
 
     for (size_t e = 0; e < m_nelem; ++e) {
+        size_t r = rows ? rows[e] : e;
         for (size_t m = 0; m < m_nne; ++m) {
             for (size_t i = 0; i < m_ndim; ++i) {
-                dofval(m_dofs(m_conn(e, m), i)) += elemvec(e, m, i);
+                dofval(dofs(conn(r, m), i)) += elemvec(e, m, i);
             }
         }
     }
@@ -259,13 +291,15 @@ VectorPartitionedTyings::Eigen_asDofs_d(const xt::xtensor<double, 2>& nodevec) c
 {
     GOOSEFEM_ASSERT(xt::has_shape(nodevec, {m_nnode, m_ndim}));
 
+    const auto& dofs = m_topo.dofs();
+
     Eigen::VectorXd dofval_d(m_nnd, 1);
 
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (size_t m = 0; m < m_nnode; ++m) {
         for (size_t i = 0; i < m_ndim; ++i) {
-            if (m_dofs(m, i) >= m_nni) {
-                dofval_d(m_dofs(m, i) - m_nni) = nodevec(m, i);
+            if (dofs(m, i) >= m_nni) {
+                dofval_d(dofs(m, i) - m_nni) = nodevec(m, i);
             }
         }
     }
@@ -275,53 +309,49 @@ VectorPartitionedTyings::Eigen_asDofs_d(const xt::xtensor<double, 2>& nodevec) c
 
 inline xt::xtensor<double, 1> VectorPartitionedTyings::AllocateDofval() const
 {
-    xt::xtensor<double, 1> dofval = xt::empty<double>({m_ndof});
-    return dofval;
+    return this->AllocateDofval(0.0);
 }
 
 inline xt::xtensor<double, 2> VectorPartitionedTyings::AllocateNodevec() const
 {
-    xt::xtensor<double, 2> nodevec = xt::empty<double>({m_nnode, m_ndim});
-    return nodevec;
+    return this->AllocateNodevec(0.0);
 }
 
 inline xt::xtensor<double, 3> VectorPartitionedTyings::AllocateElemvec() const
 {
-    xt::xtensor<double, 3> elemvec = xt::empty<double>({m_nelem, m_nne, m_ndim});
-    return elemvec;
+    return this->AllocateElemvec(0.0);
 }
 
 inline xt::xtensor<double, 3> VectorPartitionedTyings::AllocateElemmat() const
 {
-    xt::xtensor<double, 3> elemmat = xt::empty<double>({m_nelem, m_nne * m_ndim, m_nne * m_ndim});
-    return elemmat;
+    return this->AllocateElemmat(0.0);
 }
 
 inline xt::xtensor<double, 1> VectorPartitionedTyings::AllocateDofval(double val) const
 {
-    xt::xtensor<double, 1> dofval = xt::zeros<double>({m_ndof});
-    dofval.fill(val);
+    xt::xtensor<double, 1> dofval = xt::empty<double>({m_ndof});
+    GooseFEM::firstTouch(dofval, val);
     return dofval;
 }
 
 inline xt::xtensor<double, 2> VectorPartitionedTyings::AllocateNodevec(double val) const
 {
-    xt::xtensor<double, 2> nodevec = xt::zeros<double>({m_nnode, m_ndim});
-    nodevec.fill(val);
+    xt::xtensor<double, 2> nodevec = xt::empty<double>({m_nnode, m_ndim});
+    GooseFEM::firstTouch(nodevec, val);
     return nodevec;
 }
 
 inline xt::xtensor<double, 3> VectorPartitionedTyings::AllocateElemvec(double val) const
 {
-    xt::xtensor<double, 3> elemvec = xt::zeros<double>({m_nelem, m_nne, m_ndim});
-    elemvec.fill(val);
+    xt::xtensor<double, 3> elemvec = xt::empty<double>({m_nelem, m_nne, m_ndim});
+    GooseFEM::firstTouch(elemvec, val);
     return elemvec;
 }
 
 inline xt::xtensor<double, 3> VectorPartitionedTyings::AllocateElemmat(double val) const
 {
     xt::xtensor<double, 3> elemmat = xt::empty<double>({m_nelem, m_nne * m_ndim, m_nne * m_ndim});
-    elemmat.fill(val);
+    GooseFEM::firstTouch(elemmat, val);
     return elemmat;
 }
 
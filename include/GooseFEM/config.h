@@ -10,6 +10,7 @@
 #define _USE_MATH_DEFINES // to use "M_PI" from "math.h"
 
 #include <algorithm>
+#include <array>
 #include <assert.h>
 #include <cstdlib>
 #include <iomanip>
@@ -26,4 +26,10 @@ void init_Element(py::module& m)
         "Assemble nodal vector stored per element [nelem, nne, ndim] to nodal vector [nnode, ndim]",
         py::arg("conn"),
         py::arg("elemvec"));
+
+    m.def(
+        "AsMandel",
+        &GooseFEM::Element::AsMandel,
+        "Mandel representation [nelem, nip, n, n] of a fourth-order 'qtensor'",
+        py::arg("qtensor"));
 }
@@ -0,0 +1,153 @@
+/* =================================================================================================
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+================================================================================================= */
+
+#include <GooseFEM/GooseFEM.h>
+#include <pybind11/pybind11.h>
+#include <pyxtensor/pyxtensor.hpp>
+
+namespace py = pybind11;
+
+void init_ElementHex27(py::module& m)
+{
+
+    py::class_<GooseFEM::Element::Hex27::Quadrature>(m, "Quadrature")
+
+        .def(py::init<const xt::xtensor<double, 3>&>(), "Quadrature", py::arg("x"))
+
+        .def(
+            py::init<
+                const xt::xtensor<double, 3>&,
+                const xt::xtensor<double, 2>&,
+                const xt::xtensor<double, 1>&>(),
+            "Quadrature",
+            py::arg("x"),
+            py::arg("xi"),
+            py::arg("w"))
+
+        .def(
+            "update_x",
+            &GooseFEM::Element::Hex27::Quadrature::update_x,
+            "Update the nodal positions")
+
+        .def("nelem", &GooseFEM::Element::Hex27::Quadrature::nelem, "Number of elements")
+
+        .def("nne", &GooseFEM::Element::Hex27::Quadrature::nne, "Number of nodes per element")
+
+        .def("ndim", &GooseFEM::Element::Hex27::Quadrature::ndim, "Number of dimensions")
+
+        .def("nip", &GooseFEM::Element::Hex27::Quadrature::nip, "Number of integration points")
+
+        .def("dV", &GooseFEM::Element::Hex27::Quadrature::dV, "Integration point volume (qscalar)")
+
+        .def(
+            "degenerate",
+            &GooseFEM::Element::Hex27::Quadrature::degenerate,
+            "Elements with a non-positive Jacobian determinant")
+
+        .def(
+            "GradN_vector",
+            py::overload_cast<const xt::xtensor<double, 3>&>(
+                &GooseFEM::Element::Hex27::Quadrature::GradN_vector, py::const_),
+            "Dyadic product, returns 'qtensor'",
+            py::arg("elemvec"))
+
+        .def(
+            "GradN_vector_T",
+            py::overload_cast<const xt::xtensor<double, 3>&>(
+                &GooseFEM::Element::Hex27::Quadrature::GradN_vector_T, py::const_),
+            "Dyadic product, returns 'qtensor'",
+            py::arg("elemvec"))
+
+        .def(
+            "SymGradN_vector",
+            py::overload_cast<const xt::xtensor<double, 3>&>(
+                &GooseFEM::Element::Hex27::Quadrature::SymGradN_vector, py::const_),
+            "Dyadic product, returns 'qtensor'",
+            py::arg("elemvec"))
+
+        .def(
+            "Int_N_scalar_NT_dV",
+            py::overload_cast<const xt::xtensor<double, 2>&>(
+                &GooseFEM::Element::Hex27::Quadrature::Int_N_scalar_NT_dV, py::const_),
+            "Integration, returns 'elemmat'",
+            py::arg("qscalar"))
+
+        .def(
+            "Int_gradN_dot_tensor2_dV",
+            py::overload_cast<const xt::xtensor<double, 4>&>(
+                &GooseFEM::Element::Hex27::Quadrature::Int_gradN_dot_tensor2_dV, py::const_),
+            "Integration, returns 'elemvec'",
+            py::arg("qtensor"))
+
+        .def(
+            "Int_gradN_dot_tensor4_dot_gradNT_dV",
+            py::overload_cast<const xt::xtensor<double, 6>&>(
+                &GooseFEM::Element::Hex27::Quadrature::Int_gradN_dot_tensor4_dot_gradNT_dV,
+                py::const_),
+            "Integration, returns 'elemvec'",
+            py::arg("qtensor"))
+
+        .def(
+            "AsTensor",
+            (xt::xarray<double>(GooseFEM::Element::Hex27::Quadrature::*)(
+                size_t, const xt::xtensor<double, 2>&) const) &
+                GooseFEM::Element::Hex27::Quadrature::AsTensor,
+            "Convert 'qscalar' to 'qtensor' of certain rank")
+
+        .def(
+            "AllocateQtensor",
+            (xt::xarray<double>(GooseFEM::Element::Hex27::Quadrature::*)(
+                size_t) const) &
+                GooseFEM::Element::Hex27::Quadrature::AllocateQtensor,
+            "Allocate 'qtensor'",
+            py::arg("rank"))
+
+        .def(
+            "AllocateQtensor",
+            (xt::xarray<double>(GooseFEM::Element::Hex27::Quadrature::*)(
+                size_t, double) const) &
+                GooseFEM::Element::Hex27::Quadrature::AllocateQtensor,
+            "Allocate 'qtensor'",
+            py::arg("rank"),
+            py::arg("val"))
+
+        .def(
+            "AllocateQscalar",
+            py::overload_cast<>(
+                &GooseFEM::Element::Hex27::Quadrature::AllocateQscalar, py::const_),
+            "Allocate 'qscalar'")
+
+        .def(
+            "AllocateQscalar",
+            py::overload_cast<double>(
+                &GooseFEM::Element::Hex27::Quadrature::AllocateQscalar, py::const_),
+            "Allocate 'qscalar'",
+            py::arg("val"))
+
+        .def("__repr__", [](const GooseFEM::Element::Hex27::Quadrature&) {
+            return "<GooseFEM.Element.Hex27.Quadrature>";
+        });
+}
+
+void init_ElementHex27Gauss(py::module& m)
+{
+
+    m.def("nip", &GooseFEM::Element::Hex27::Gauss::nip, "Return number of integration point");
+
+    m.def("xi", &GooseFEM::Element::Hex27::Gauss::xi, "Return integration point coordinates");
+
+    m.def("w", &GooseFEM::Element::Hex27::Gauss::w, "Return integration point weights");
+}
+
+void init_ElementHex27Nodal(py::module& m)
+{
+
+    m.def("nip", &GooseFEM::Element::Hex27::Nodal::nip, "Return number of integration point");
+
+    m.def("xi", &GooseFEM::Element::Hex27::Nodal::xi, "Return integration point coordinates");
+
+    m.def("w", &GooseFEM::Element::Hex27::Nodal::w, "Return integration point weights");
+}
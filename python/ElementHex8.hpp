@@ -42,6 +42,11 @@ void init_ElementHex8(py::module& m)
 
         .def("dV", &GooseFEM::Element::Hex8::Quadrature::dV, "Integration point volume (qscalar)")
 
+        .def(
+            "degenerate",
+            &GooseFEM::Element::Hex8::Quadrature::degenerate,
+            "Elements with a non-positive Jacobian determinant")
+
         .def(
             "GradN_vector",
             py::overload_cast<const xt::xtensor<double, 3>&>(
@@ -85,6 +90,20 @@ void init_ElementHex8(py::module& m)
             "Integration, returns 'elemvec'",
             py::arg("qtensor"))
 
+        .def(
+            "Int_gradN_dot_mandel_dot_gradNT_dV",
+            &GooseFEM::Element::Hex8::Quadrature::Int_gradN_dot_mandel_dot_gradNT_dV,
+            "Integration (tangent in Mandel representation), returns 'elemmat'",
+            py::arg("qmandel"))
+
+        .def(
+            "Int_gradN_dot_tensor2_dV_hourglass",
+            &GooseFEM::Element::Hex8::Quadrature::Int_gradN_dot_tensor2_dV_hourglass,
+            "Integration with hourglass control (one-point integration), returns 'elemvec'",
+            py::arg("qtensor"),
+            py::arg("elemvec_u"),
+            py::arg("stiffness"))
+
         .def(
             "AsTensor",
             (xt::xarray<double>(GooseFEM::Element::Hex8::Quadrature::*)(
@@ -146,3 +165,13 @@ void init_ElementHex8Nodal(py::module& m)
 
     m.def("w", &GooseFEM::Element::Hex8::Nodal::w, "Return integration point weights");
 }
+
+void init_ElementHex8MidPoint(py::module& m)
+{
+
+    m.def("nip", &GooseFEM::Element::Hex8::MidPoint::nip, "Return number of integration point");
+
+    m.def("xi", &GooseFEM::Element::Hex8::MidPoint::xi, "Return integration point coordinates");
+
+    m.def("w", &GooseFEM::Element::Hex8::MidPoint::w, "Return integration point weights");
+}
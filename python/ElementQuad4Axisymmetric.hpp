@@ -53,6 +53,11 @@ void init_ElementQuad4Axisymmetric(py::module& m)
             &GooseFEM::Element::Quad4::QuadratureAxisymmetric::dV,
             "Integration point volume (qscalar)")
 
+        .def(
+            "degenerate",
+            &GooseFEM::Element::Quad4::QuadratureAxisymmetric::degenerate,
+            "Elements with a non-positive Jacobian determinant")
+
         .def(
             "GradN_vector",
             py::overload_cast<const xt::xtensor<double, 3>&>(
@@ -46,6 +46,11 @@ void init_ElementQuad4Planar(py::module& m)
             &GooseFEM::Element::Quad4::QuadraturePlanar::dV,
             "Integration point volume (qscalar)")
 
+        .def(
+            "degenerate",
+            &GooseFEM::Element::Quad4::QuadraturePlanar::degenerate,
+            "Elements with a non-positive Jacobian determinant")
+
         .def(
             "GradN_vector",
             py::overload_cast<const xt::xtensor<double, 3>&>(
@@ -89,6 +94,12 @@ void init_ElementQuad4Planar(py::module& m)
             "Integration, returns 'elemvec'",
             py::arg("qtensor"))
 
+        .def(
+            "Int_gradN_dot_mandel_dot_gradNT_dV",
+            &GooseFEM::Element::Quad4::QuadraturePlanar::Int_gradN_dot_mandel_dot_gradNT_dV,
+            "Integration (tangent in Mandel representation), returns 'elemmat'",
+            py::arg("qmandel"))
+
         .def(
             "AsTensor",
             (xt::xarray<double>(GooseFEM::Element::Quad4::QuadraturePlanar::*)(
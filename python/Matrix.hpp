@@ -37,10 +37,27 @@ void init_Matrix(py::module& m)
 
         .def(
             "assemble",
-            &GooseFEM::Matrix::assemble,
+            py::overload_cast<const xt::xtensor<double, 3>&>(&GooseFEM::Matrix::assemble),
             "Assemble matrix from 'elemmat",
             py::arg("elemmat"))
 
+        .def(
+            "assemble",
+            py::overload_cast<const xt::xtensor<size_t, 1>&, const xt::xtensor<double, 3>&>(
+                &GooseFEM::Matrix::assemble),
+            "Assemble matrix: frozen part plus 'elemmat' of the elements 'elem'",
+            py::arg("elem"),
+            py::arg("elemmat"))
+
+        .def(
+            "freeze",
+            &GooseFEM::Matrix::freeze,
+            "Add 'elemmat' of the elements 'elem' to the frozen (constant) part",
+            py::arg("elem"),
+            py::arg("elemmat"))
+
+        .def("unfreeze", &GooseFEM::Matrix::unfreeze, "Clear the frozen part")
+
         .def(
             "set",
             &GooseFEM::Matrix::set,
@@ -71,6 +88,13 @@ void init_Matrix(py::module& m)
             "Dot",
             py::arg("x"))
 
+        .def(
+            "Residual",
+            &GooseFEM::Matrix::Residual,
+            "Residual: b - A * x",
+            py::arg("x"),
+            py::arg("b"))
+
         .def("__repr__", [](const GooseFEM::Matrix&) { return "<GooseFEM.Matrix>"; });
 
     py::class_<GooseFEM::MatrixSolver<>>(m, "MatrixSolver")
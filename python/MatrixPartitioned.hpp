@@ -107,6 +107,14 @@ void init_MatrixPartitioned(py::module& m)
             py::arg("x_u"),
             py::arg("x_p"))
 
+        .def(
+            "Residual_u",
+            &GooseFEM::MatrixPartitioned::Residual_u,
+            "Residual_u: b_u - A_uu * x_u - A_up * x_p",
+            py::arg("x_u"),
+            py::arg("x_p"),
+            py::arg("b_u"))
+
         .def("__repr__", [](const GooseFEM::MatrixPartitioned&) {
             return "<GooseFEM.MatrixPartitioned>";
         });
@@ -17,6 +17,8 @@ void init_Mesh(py::module& m)
         .value("Tri3", GooseFEM::Mesh::ElementType::Tri3)
         .value("Quad4", GooseFEM::Mesh::ElementType::Quad4)
         .value("Hex8", GooseFEM::Mesh::ElementType::Hex8)
+        .value("Quad9", GooseFEM::Mesh::ElementType::Quad9)
+        .value("Hex27", GooseFEM::Mesh::ElementType::Hex27)
         .export_values();
 
     py::class_<GooseFEM::Mesh::ManualStitch>(m, "ManualStitch")
@@ -0,0 +1,76 @@
+/* =================================================================================================
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+================================================================================================= */
+
+#include <GooseFEM/GooseFEM.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pyxtensor/pyxtensor.hpp>
+
+namespace py = pybind11;
+
+void init_MeshHex27(py::module& m)
+{
+
+    py::class_<GooseFEM::Mesh::Hex27::Regular>(m, "Regular")
+
+        .def(
+            py::init<size_t, size_t, size_t, double>(),
+            "Mesh with nx*ny*nz 'pixels' and edge size h",
+            py::arg("nx"),
+            py::arg("ny"),
+            py::arg("nz"),
+            py::arg("h") = 1.)
+
+        .def("nelem", &GooseFEM::Mesh::Hex27::Regular::nelem)
+
+        .def("nnode", &GooseFEM::Mesh::Hex27::Regular::nnode)
+
+        .def("nne", &GooseFEM::Mesh::Hex27::Regular::nne)
+
+        .def("ndim", &GooseFEM::Mesh::Hex27::Regular::ndim)
+
+        .def("coor", &GooseFEM::Mesh::Hex27::Regular::coor)
+
+        .def("conn", &GooseFEM::Mesh::Hex27::Regular::conn)
+
+        .def("getElementType", &GooseFEM::Mesh::Hex27::Regular::getElementType)
+
+        .def("nodesFront", &GooseFEM::Mesh::Hex27::Regular::nodesFront)
+
+        .def("nodesBack", &GooseFEM::Mesh::Hex27::Regular::nodesBack)
+
+        .def("nodesLeft", &GooseFEM::Mesh::Hex27::Regular::nodesLeft)
+
+        .def("nodesRight", &GooseFEM::Mesh::Hex27::Regular::nodesRight)
+
+        .def("nodesBottom", &GooseFEM::Mesh::Hex27::Regular::nodesBottom)
+
+        .def("nodesTop", &GooseFEM::Mesh::Hex27::Regular::nodesTop)
+
+        .def("nodesFrontFace", &GooseFEM::Mesh::Hex27::Regular::nodesFrontFace)
+
+        .def("nodesBackFace", &GooseFEM::Mesh::Hex27::Regular::nodesBackFace)
+
+        .def("nodesLeftFace", &GooseFEM::Mesh::Hex27::Regular::nodesLeftFace)
+
+        .def("nodesRightFace", &GooseFEM::Mesh::Hex27::Regular::nodesRightFace)
+
+        .def("nodesBottomFace", &GooseFEM::Mesh::Hex27::Regular::nodesBottomFace)
+
+        .def("nodesTopFace", &GooseFEM::Mesh::Hex27::Regular::nodesTopFace)
+
+        .def("dofs", &GooseFEM::Mesh::Hex27::Regular::dofs)
+
+        .def("dofsPeriodic", &GooseFEM::Mesh::Hex27::Regular::dofsPeriodic)
+
+        .def("nodesPeriodic", &GooseFEM::Mesh::Hex27::Regular::nodesPeriodic)
+
+        .def("nodesOrigin", &GooseFEM::Mesh::Hex27::Regular::nodesOrigin)
+
+        .def("__repr__", [](const GooseFEM::Mesh::Hex27::Regular&) {
+            return "<GooseFEM.Mesh.Hex27.Regular>";
+        });
+}
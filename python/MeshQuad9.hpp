@@ -0,0 +1,58 @@
+/* =================================================================================================
+
+(c - GPLv3) T.W.J. de Geus (Tom) | tom@geus.me | www.geus.me | github.com/tdegeus/GooseFEM
+
+================================================================================================= */
+
+#include <GooseFEM/GooseFEM.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pyxtensor/pyxtensor.hpp>
+
+namespace py = pybind11;
+
+void init_MeshQuad9(py::module& m)
+{
+
+    py::class_<GooseFEM::Mesh::Quad9::Regular>(m, "Regular")
+
+        .def(
+            py::init<size_t, size_t, double>(),
+            "Regular mesh: 'nx' pixels in horizontal direction, 'ny' in vertical direction, edge "
+            "size 'h'",
+            py::arg("nx"),
+            py::arg("ny"),
+            py::arg("h") = 1.)
+
+        .def("coor", &GooseFEM::Mesh::Quad9::Regular::coor)
+        .def("conn", &GooseFEM::Mesh::Quad9::Regular::conn)
+        .def("nelem", &GooseFEM::Mesh::Quad9::Regular::nelem)
+        .def("nnode", &GooseFEM::Mesh::Quad9::Regular::nnode)
+        .def("nne", &GooseFEM::Mesh::Quad9::Regular::nne)
+        .def("ndim", &GooseFEM::Mesh::Quad9::Regular::ndim)
+        .def("nelx", &GooseFEM::Mesh::Quad9::Regular::nelx)
+        .def("nely", &GooseFEM::Mesh::Quad9::Regular::nely)
+        .def("h", &GooseFEM::Mesh::Quad9::Regular::h)
+        .def("getElementType", &GooseFEM::Mesh::Quad9::Regular::getElementType)
+        .def("nodesBottomEdge", &GooseFEM::Mesh::Quad9::Regular::nodesBottomEdge)
+        .def("nodesTopEdge", &GooseFEM::Mesh::Quad9::Regular::nodesTopEdge)
+        .def("nodesLeftEdge", &GooseFEM::Mesh::Quad9::Regular::nodesLeftEdge)
+        .def("nodesRightEdge", &GooseFEM::Mesh::Quad9::Regular::nodesRightEdge)
+        .def("nodesBottomOpenEdge", &GooseFEM::Mesh::Quad9::Regular::nodesBottomOpenEdge)
+        .def("nodesTopOpenEdge", &GooseFEM::Mesh::Quad9::Regular::nodesTopOpenEdge)
+        .def("nodesLeftOpenEdge", &GooseFEM::Mesh::Quad9::Regular::nodesLeftOpenEdge)
+        .def("nodesRightOpenEdge", &GooseFEM::Mesh::Quad9::Regular::nodesRightOpenEdge)
+        .def("nodesBottomLeftCorner", &GooseFEM::Mesh::Quad9::Regular::nodesBottomLeftCorner)
+        .def("nodesBottomRightCorner", &GooseFEM::Mesh::Quad9::Regular::nodesBottomRightCorner)
+        .def("nodesTopLeftCorner", &GooseFEM::Mesh::Quad9::Regular::nodesTopLeftCorner)
+        .def("nodesTopRightCorner", &GooseFEM::Mesh::Quad9::Regular::nodesTopRightCorner)
+        .def("dofs", &GooseFEM::Mesh::Quad9::Regular::dofs)
+        .def("dofsPeriodic", &GooseFEM::Mesh::Quad9::Regular::dofsPeriodic)
+        .def("nodesPeriodic", &GooseFEM::Mesh::Quad9::Regular::nodesPeriodic)
+        .def("nodesOrigin", &GooseFEM::Mesh::Quad9::Regular::nodesOrigin)
+        .def("elementgrid", &GooseFEM::Mesh::Quad9::Regular::elementgrid)
+
+        .def("__repr__", [](const GooseFEM::Mesh::Quad9::Regular&) {
+            return "<GooseFEM.Mesh.Quad9.Regular>";
+        });
+}
@@ -25,14 +25,19 @@ namespace py = pybind11;
 #include "MatrixDiagonal.hpp"
 #include "MatrixDiagonalPartitioned.hpp"
 #include "Element.hpp"
+#include "ElementTri3.hpp"
 #include "ElementQuad4.hpp"
 #include "ElementQuad4Planar.hpp"
 #include "ElementQuad4Axisymmetric.hpp"
+#include "ElementQuad9.hpp"
 #include "ElementHex8.hpp"
+#include "ElementHex27.hpp"
 #include "Mesh.hpp"
 #include "MeshTri3.hpp"
 #include "MeshQuad4.hpp"
+#include "MeshQuad9.hpp"
 #include "MeshHex8.hpp"
+#include "MeshHex27.hpp"
 
 PYBIND11_MODULE(GooseFEM, m) {
 
@@ -59,6 +64,18 @@ py::module mElement = m.def_submodule("Element", "Generic element routines");
 
 init_Element(mElement);
 
+// ---------------------
+// GooseFEM.Element.Tri3
+// ---------------------
+
+py::module mElementTri3 = mElement.def_submodule("Tri3", "Linear triangular elements (2D)");
+py::module mElementTri3Gauss = mElementTri3.def_submodule("Gauss", "Gauss quadrature");
+py::module mElementTri3Nodal = mElementTri3.def_submodule("Nodal", "Nodal quadrature");
+
+init_ElementTri3(mElementTri3);
+init_ElementTri3Gauss(mElementTri3Gauss);
+init_ElementTri3Nodal(mElementTri3Nodal);
+
 // ----------------------
 // GooseFEM.Element.Quad4
 // ----------------------
@@ -66,12 +83,14 @@ init_Element(mElement);
 py::module mElementQuad4 = mElement.def_submodule("Quad4", "Linear quadrilateral elements (2D)");
 py::module mElementQuad4Gauss = mElementQuad4.def_submodule("Gauss", "Gauss quadrature");
 py::module mElementQuad4Nodal = mElementQuad4.def_submodule("Nodal", "Nodal quadrature");
+py::module mElementQuad4MidPoint = mElementQuad4.def_submodule("MidPoint", "Midpoint quadrature");
 
 init_ElementQuad4(mElementQuad4);
 init_ElementQuad4Planar(mElementQuad4);
 init_ElementQuad4Axisymmetric(mElementQuad4);
 init_ElementQuad4Gauss(mElementQuad4Gauss);
 init_ElementQuad4Nodal(mElementQuad4Nodal);
+init_ElementQuad4MidPoint(mElementQuad4MidPoint);
 
 // ---------------------
 // GooseFEM.Element.Hex8
@@ -80,10 +99,36 @@ init_ElementQuad4Nodal(mElementQuad4Nodal);
 py::module mElementHex8 = mElement.def_submodule("Hex8", "Linear hexahedron (brick) elements (3D)");
 py::module mElementHex8Gauss = mElementHex8.def_submodule("Gauss", "Gauss quadrature");
 py::module mElementHex8Nodal = mElementHex8.def_submodule("Nodal", "Nodal quadrature");
+py::module mElementHex8MidPoint = mElementHex8.def_submodule("MidPoint", "Midpoint quadrature");
 
 init_ElementHex8(mElementHex8);
 init_ElementHex8Gauss(mElementHex8Gauss);
 init_ElementHex8Nodal(mElementHex8Nodal);
+init_ElementHex8MidPoint(mElementHex8MidPoint);
+
+// ----------------------
+// GooseFEM.Element.Quad9
+// ----------------------
+
+py::module mElementQuad9 = mElement.def_submodule("Quad9", "Quadratic quadrilateral elements (2D)");
+py::module mElementQuad9Gauss = mElementQuad9.def_submodule("Gauss", "Gauss quadrature");
+py::module mElementQuad9Nodal = mElementQuad9.def_submodule("Nodal", "Nodal quadrature");
+
+init_ElementQuad9(mElementQuad9);
+init_ElementQuad9Gauss(mElementQuad9Gauss);
+init_ElementQuad9Nodal(mElementQuad9Nodal);
+
+// ----------------------
+// GooseFEM.Element.Hex27
+// ----------------------
+
+py::module mElementHex27 = mElement.def_submodule("Hex27", "Quadratic hexahedron elements (3D)");
+py::module mElementHex27Gauss = mElementHex27.def_submodule("Gauss", "Gauss quadrature");
+py::module mElementHex27Nodal = mElementHex27.def_submodule("Nodal", "Nodal quadrature");
+
+init_ElementHex27(mElementHex27);
+init_ElementHex27Gauss(mElementHex27Gauss);
+init_ElementHex27Nodal(mElementHex27Nodal);
 
 // -------------
 // GooseFEM.Mesh
@@ -121,5 +166,21 @@ py::module mMeshHex8 = mMesh.def_submodule("Hex8", "Linear hexahedron (brick) el
 
 init_MeshHex8(mMeshHex8);
 
+// -------------------
+// GooseFEM.Mesh.Quad9
+// -------------------
+
+py::module mMeshQuad9 = mMesh.def_submodule("Quad9", "Quadratic quadrilateral elements (2D)");
+
+init_MeshQuad9(mMeshQuad9);
+
+// -------------------
+// GooseFEM.Mesh.Hex27
+// -------------------
+
+py::module mMeshHex27 = mMesh.def_submodule("Hex27", "Quadratic hexahedron elements (3D)");
+
+init_MeshHex27(mMeshHex27);
+
 }
 
@@ -0,0 +1,142 @@
+#include <catch2/catch.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xmath.hpp>
+#include <Eigen/Eigen>
+#include <GooseFEM/GooseFEM.h>
+
+using AMGSolver = GooseFEM::LinearSolver::ConjugateGradientAMG;
+
+// isotropic linear elastic stiffness (bulk modulus 1, shear modulus 1/2), per element
+inline xt::xtensor<double, 3> elastic_stiffness(
+    const xt::xtensor<double, 2>& coor,
+    const xt::xtensor<size_t, 2>& conn,
+    const xt::xtensor<size_t, 2>& dofs)
+{
+    size_t nd = 2;
+    double K = 1.0;
+    double G = 0.5;
+
+    GooseFEM::Vector vector(conn, dofs);
+    GooseFEM::Element::Quad4::Quadrature quad(vector.AsElement(coor));
+    xt::xtensor<double, 6> C = xt::empty<double>({conn.shape(0), quad.nip(), nd, nd, nd, nd});
+
+    for (size_t e = 0; e < conn.shape(0); ++e) {
+        for (size_t q = 0; q < quad.nip(); ++q) {
+            for (size_t i = 0; i < nd; ++i) {
+                for (size_t j = 0; j < nd; ++j) {
+                    for (size_t k = 0; k < nd; ++k) {
+                        for (size_t l = 0; l < nd; ++l) {
+                            C(e, q, i, j, k, l) = (K - G) * (i == j) * (k == l) +
+                                                  G * ((i == k) * (j == l) + (i == l) * (j == k));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return quad.Int_gradN_dot_tensor4_dot_gradNT_dV(C);
+}
+
+// solve with the bottom edge fixed: compare to the direct solver, return the number of iterations
+template <class Mesh>
+inline size_t solve_clamped(const Mesh& mesh)
+{
+    auto coor = mesh.coor();
+    auto conn = mesh.conn();
+    auto dofs = mesh.dofs();
+    xt::xtensor<size_t, 1> iip = xt::flatten(xt::view(dofs, xt::keep(mesh.nodesBottomEdge())));
+
+    GooseFEM::MatrixPartitioned A(conn, dofs, iip);
+    A.assemble(elastic_stiffness(coor, conn, dofs));
+
+    xt::random::seed(0);
+    xt::xtensor<double, 2> b = xt::random::rand<double>(coor.shape());
+    xt::xtensor<double, 2> x = xt::zeros<double>(coor.shape());
+
+    GooseFEM::MatrixPartitionedSolver<> direct;
+    GooseFEM::MatrixPartitionedSolver<AMGSolver> solver;
+    solver.solver().setTolerance(1e-12);
+    solver.solver().preconditioner().setRigidBodyModes(coor, dofs, A.iiu());
+    solver.solver().preconditioner().setCoarseSize(50);
+
+    REQUIRE(xt::allclose(solver.Solve(A, b, x), direct.Solve(A, b, x)));
+    REQUIRE(solver.solver().preconditioner().levels() > 1);
+
+    return static_cast<size_t>(solver.solver().iterations());
+}
+
+TEST_CASE("GooseFEM::AMG", "AMG.h")
+{
+    SECTION("MatrixPartitioned - FineLayer")
+    {
+        GooseFEM::Mesh::Quad4::FineLayer mesh(27, 27);
+        REQUIRE(solve_clamped(mesh) < 50);
+    }
+
+    SECTION("MatrixPartitioned - mesh-size independent iterations")
+    {
+        size_t coarse = solve_clamped(GooseFEM::Mesh::Quad4::Regular(10, 10));
+        size_t fine = solve_clamped(GooseFEM::Mesh::Quad4::Regular(40, 40));
+        REQUIRE(fine <= coarse + 10);
+    }
+
+    SECTION("MatrixPartitioned - symmetric storage")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(20, 20);
+        auto coor = mesh.coor();
+        auto conn = mesh.conn();
+        auto dofs = mesh.dofs();
+        xt::xtensor<size_t, 1> iip = xt::flatten(xt::view(dofs, xt::keep(mesh.nodesLeftEdge())));
+
+        GooseFEM::MatrixPartitioned A(conn, dofs, iip);
+        GooseFEM::MatrixPartitioned S(conn, dofs, iip, true);
+        A.assemble(elastic_stiffness(coor, conn, dofs));
+        S.assemble(elastic_stiffness(coor, conn, dofs));
+
+        xt::xtensor<double, 2> b = xt::random::rand<double>(coor.shape());
+        xt::xtensor<double, 2> x = xt::random::rand<double>(coor.shape());
+
+        GooseFEM::MatrixPartitionedSolver<> direct;
+        GooseFEM::MatrixPartitionedSolver<AMGSolver> solver;
+        solver.solver().setTolerance(1e-12);
+        solver.solver().preconditioner().setRigidBodyModes(coor, dofs, S.iiu());
+
+        REQUIRE(xt::allclose(solver.Solve(S, b, x), direct.Solve(A, b, x)));
+    }
+
+    SECTION("MatrixPartitionedTyings - periodic")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(12, 12);
+
+        GooseFEM::Tyings::Control control(mesh.coor(), mesh.dofs());
+        xt::xtensor<double, 2> coor = control.coor();
+        xt::xtensor<size_t, 2> control_dofs = control.controlDofs();
+
+        // prescribe the control DOFs and the origin (to suppress the rigid body translation)
+        xt::xtensor<size_t, 1> iip = xt::concatenate(xt::xtuple(
+            xt::flatten(control_dofs),
+            xt::flatten(xt::view(control.dofs(), mesh.nodesOrigin(), xt::all()))));
+
+        GooseFEM::Tyings::Periodic tyings(
+            coor, control.dofs(), control_dofs, mesh.nodesPeriodic(), iip);
+
+        xt::xtensor<size_t, 2> dofs = tyings.dofs();
+
+        GooseFEM::MatrixPartitionedTyings A(mesh.conn(), dofs, tyings.Cdu(), tyings.Cdp());
+        A.assemble(elastic_stiffness(mesh.coor(), mesh.conn(), mesh.dofs()));
+
+        xt::xtensor<double, 2> b = xt::zeros<double>(coor.shape());
+        xt::xtensor<double, 2> x = xt::zeros<double>(coor.shape());
+        xt::view(x, xt::keep(control.controlNodes()), xt::all()) = 0.1;
+
+        GooseFEM::MatrixPartitionedTyingsSolver<> direct;
+        GooseFEM::MatrixPartitionedTyingsSolver<AMGSolver> solver;
+        solver.solver().setTolerance(1e-12);
+        solver.solver().preconditioner().setRigidBodyModes(coor, dofs, A.iiu());
+        solver.solver().preconditioner().setCoarseSize(50);
+
+        REQUIRE(xt::allclose(solver.Solve(A, b, x), direct.Solve(A, b, x)));
+        REQUIRE(solver.solver().iterations() < 50);
+    }
+}
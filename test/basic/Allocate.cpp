@@ -117,4 +117,13 @@ TEST_CASE("GooseFEM::Allocate", "Allocate.h")
         REQUIRE(xt::allclose(a2, b2));
     }
 
+    SECTION("firstTouch")
+    {
+        xt::xtensor<double, 3> a = xt::empty<double>({7, 3, 2});
+        GooseFEM::firstTouch(a, 2.0);
+        REQUIRE(xt::all(xt::equal(a, 2.0)));
+
+        xt::xarray<double> b = xt::random::rand<double>({7, 3, 2});
+        REQUIRE(xt::all(xt::equal(GooseFEM::FirstTouchCopy(b), b)));
+    }
 }
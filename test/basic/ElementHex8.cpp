@@ -177,4 +177,105 @@ TEST_CASE("GooseFEM::ElementHex8", "ElementHex8.h")
         REQUIRE(Fi.size() == vec.ndof());
         REQUIRE(xt::allclose(Fi, 0.));
     }
+
+    SECTION("int_gradN_dot_mandel_dot_gradNT_dV")
+    {
+        GooseFEM::Mesh::Hex8::Regular mesh(3, 3, 3);
+        GooseFEM::Vector vec(mesh.conn(), mesh.dofs());
+
+        auto coor = mesh.coor();
+        coor += 0.1 * xt::random::rand<double>(coor.shape());
+
+        GooseFEM::Element::Hex8::Quadrature quad(vec.AsElement(coor));
+
+        // random tangent with minor symmetries
+        xt::xtensor<double, 6> X = xt::random::rand<double>(quad.AllocateQtensor<4>().shape());
+        xt::xtensor<double, 6> C = X + xt::transpose(X, {0, 1, 3, 2, 4, 5}) +
+                                   xt::transpose(X, {0, 1, 2, 3, 5, 4}) +
+                                   xt::transpose(X, {0, 1, 3, 2, 5, 4});
+
+        auto K = quad.Int_gradN_dot_tensor4_dot_gradNT_dV(C);
+        auto Km = quad.Int_gradN_dot_mandel_dot_gradNT_dV(GooseFEM::Element::AsMandel(C));
+
+        REQUIRE(xt::allclose(K, Km));
+    }
+
+    SECTION("int_gradN_dot_tensor2_dV_hourglass")
+    {
+        namespace E = GooseFEM::Element::Hex8;
+
+        GooseFEM::Mesh::Hex8::Regular mesh(3, 3, 3);
+        GooseFEM::Vector vec(mesh.conn(), mesh.dofs());
+
+        auto coor = mesh.coor();
+        coor += 0.1 * xt::random::rand<double>(coor.shape());
+        xt::xtensor<double, 3> x = vec.AsElement(coor);
+
+        E::Quadrature gauss(x);
+        E::Quadrature quad(x, E::MidPoint::xi(), E::MidPoint::w());
+
+        REQUIRE(xt::allclose(xt::sum(quad.dV())(), xt::sum(gauss.dV())()));
+
+        xt::xtensor<double, 1> stiffness = xt::ones<double>({mesh.nelem()});
+        xt::xtensor<double, 4> sig = xt::random::rand<double>(quad.AllocateQtensor<2>().shape());
+        xt::xtensor<double, 4> zero = xt::zeros<double>(sig.shape());
+
+        // linear displacement field: no hourglass forces
+
+        xt::xtensor<double, 2> F = xt::zeros<double>({3, 3});
+        F(0, 1) = 0.1;
+        F(1, 0) = 0.2;
+
+        xt::xtensor<double, 2> disp = xt::zeros<double>(coor.shape());
+
+        for (size_t n = 0; n < mesh.nnode(); ++n) {
+            for (size_t i = 0; i < F.shape()[0]; ++i) {
+                for (size_t j = 0; j < F.shape()[1]; ++j) {
+                    disp(n, i) += F(i, j) * coor(n, j) + 0.1;
+                }
+            }
+        }
+
+        auto f = quad.Int_gradN_dot_tensor2_dV_hourglass(sig, vec.AsElement(disp), stiffness);
+        REQUIRE(xt::allclose(f, quad.Int_gradN_dot_tensor2_dV(sig)));
+
+        // hourglass mode: self-equilibrated resisting forces
+
+        xt::xtensor<double, 3> h = xt::zeros<double>(x.shape());
+
+        for (size_t e = 0; e < mesh.nelem(); ++e) {
+            h(e, 0, 0) = 1.0;
+            h(e, 1, 0) = -1.0;
+            h(e, 2, 0) = 1.0;
+            h(e, 3, 0) = -1.0;
+            h(e, 4, 0) = 1.0;
+            h(e, 5, 0) = -1.0;
+            h(e, 6, 0) = 1.0;
+            h(e, 7, 0) = -1.0;
+        }
+
+        f = quad.Int_gradN_dot_tensor2_dV_hourglass(zero, h, stiffness);
+
+        REQUIRE(xt::allclose(xt::sum(f, {1}), 0.0));
+        REQUIRE(xt::all(xt::sum(f * h, {1, 2}) > 0.0));
+    }
+
+    SECTION("degenerate")
+    {
+        GooseFEM::Mesh::Hex8::Regular mesh(3, 1, 1);
+
+        // invert element 1 (mirrored numbering)
+        auto conn = mesh.conn();
+        std::swap(conn(1, 1), conn(1, 3));
+        std::swap(conn(1, 5), conn(1, 7));
+
+        GooseFEM::Vector vec(conn, mesh.dofs());
+        GooseFEM::Element::Hex8::Quadrature quad(vec.AsElement(mesh.coor()));
+
+        xt::xtensor<size_t, 1> elem = {1, 2};
+
+        REQUIRE(xt::all(xt::equal(quad.degenerate(), xt::xtensor<size_t, 1>{1})));
+        REQUIRE(xt::all(xt::equal(quad.Subset(elem).degenerate(), xt::xtensor<size_t, 1>{0})));
+        REQUIRE(xt::all(xt::view(quad.dV(), 1) < 0.0));
+    }
 }
@@ -77,6 +77,24 @@ TEST_CASE("GooseFEM::ElementQuad4", "ElementQuad4.h")
         }
     }
 
+    SECTION("dV - MidPoint")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(3, 3);
+        GooseFEM::Vector vec(mesh.conn(), mesh.dofs());
+
+        auto coor = mesh.coor();
+        coor += 0.1 * xt::random::rand<double>(coor.shape());
+        xt::xtensor<double, 3> x = vec.AsElement(coor);
+
+        GooseFEM::Element::Quad4::Quadrature gauss(x);
+        GooseFEM::Element::Quad4::Quadrature quad(
+            x,
+            GooseFEM::Element::Quad4::MidPoint::xi(),
+            GooseFEM::Element::Quad4::MidPoint::w());
+
+        REQUIRE(xt::allclose(xt::sum(quad.dV(), {1}), xt::sum(gauss.dV(), {1})));
+    }
+
     SECTION("int_N_scalar_NT_dV")
     {
         GooseFEM::Mesh::Quad4::Regular mesh(3, 3);
@@ -165,4 +183,368 @@ TEST_CASE("GooseFEM::ElementQuad4", "ElementQuad4.h")
         REQUIRE(Fi.size() == vec.ndof());
         REQUIRE(xt::allclose(Fi, 0.));
     }
+
+    SECTION("int_gradN_dot_mandel_dot_gradNT_dV")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(3, 3);
+        GooseFEM::Vector vec(mesh.conn(), mesh.dofs());
+
+        auto coor = mesh.coor();
+        coor += 0.1 * xt::random::rand<double>(coor.shape());
+
+        GooseFEM::Element::Quad4::Quadrature quad(vec.AsElement(coor));
+
+        // random tangent with minor symmetries
+        xt::xtensor<double, 6> X = xt::random::rand<double>(quad.AllocateQtensor<4>().shape());
+        xt::xtensor<double, 6> C = X + xt::transpose(X, {0, 1, 3, 2, 4, 5}) +
+                                   xt::transpose(X, {0, 1, 2, 3, 5, 4}) +
+                                   xt::transpose(X, {0, 1, 3, 2, 5, 4});
+
+        auto K = quad.Int_gradN_dot_tensor4_dot_gradNT_dV(C);
+        auto Km = quad.Int_gradN_dot_mandel_dot_gradNT_dV(GooseFEM::Element::AsMandel(C));
+
+        REQUIRE(xt::allclose(K, Km));
+    }
+
+    SECTION("accumulate - elemvec += alpha * ..., elemmat += alpha * ...")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(3, 3);
+        GooseFEM::Vector vec(mesh.conn(), mesh.dofs());
+        GooseFEM::Element::Quad4::Quadrature quad(vec.AsElement(mesh.coor()));
+
+        xt::xtensor<double, 2> rho = xt::random::rand<double>(quad.AllocateQscalar().shape());
+        xt::xtensor<double, 4> sig = xt::random::rand<double>(quad.AllocateQtensor<2>().shape());
+        xt::xtensor<double, 6> C = xt::random::rand<double>(quad.AllocateQtensor<4>().shape());
+
+        xt::xtensor<double, 3> fe = xt::random::rand<double>(vec.AllocateElemvec().shape());
+        xt::xtensor<double, 3> Fe = fe + 2.0 * quad.Int_gradN_dot_tensor2_dV(sig);
+        quad.int_gradN_dot_tensor2_dV(sig, fe, 2.0);
+
+        REQUIRE(xt::allclose(fe, Fe));
+
+        xt::xtensor<double, 3> Ke = 0.5 * quad.Int_N_scalar_NT_dV(rho);
+        xt::xtensor<double, 3> KE = Ke + 3.0 * quad.Int_gradN_dot_tensor4_dot_gradNT_dV(C);
+        quad.int_gradN_dot_tensor4_dot_gradNT_dV(C, Ke, 3.0);
+
+        REQUIRE(xt::allclose(Ke, KE));
+    }
+
+    SECTION("int_gradN_dot_tensor2_dV_hourglass")
+    {
+        namespace E = GooseFEM::Element::Quad4;
+
+        GooseFEM::Mesh::Quad4::Regular mesh(3, 3);
+        GooseFEM::Vector vec(mesh.conn(), mesh.dofs());
+
+        auto coor = mesh.coor();
+        coor += 0.1 * xt::random::rand<double>(coor.shape());
+        xt::xtensor<double, 3> x = vec.AsElement(coor);
+
+        E::Quadrature quad(x, E::MidPoint::xi(), E::MidPoint::w());
+
+        xt::xtensor<double, 1> stiffness = xt::ones<double>({mesh.nelem()});
+        xt::xtensor<double, 4> sig = xt::random::rand<double>(quad.AllocateQtensor<2>().shape());
+        xt::xtensor<double, 4> zero = xt::zeros<double>(sig.shape());
+
+        // linear displacement field: no hourglass forces
+
+        xt::xtensor<double, 2> F = xt::zeros<double>({2, 2});
+        F(0, 1) = 0.1;
+        F(1, 0) = 0.2;
+
+        xt::xtensor<double, 2> disp = xt::zeros<double>(coor.shape());
+
+        for (size_t n = 0; n < mesh.nnode(); ++n) {
+            for (size_t i = 0; i < F.shape()[0]; ++i) {
+                for (size_t j = 0; j < F.shape()[1]; ++j) {
+                    disp(n, i) += F(i, j) * coor(n, j) + 0.1;
+                }
+            }
+        }
+
+        auto f = quad.Int_gradN_dot_tensor2_dV_hourglass(sig, vec.AsElement(disp), stiffness);
+        REQUIRE(xt::allclose(f, quad.Int_gradN_dot_tensor2_dV(sig)));
+
+        // hourglass mode: self-equilibrated resisting forces
+
+        xt::xtensor<double, 3> h = xt::zeros<double>(x.shape());
+
+        for (size_t e = 0; e < mesh.nelem(); ++e) {
+            h(e, 0, 0) = 1.0;
+            h(e, 1, 0) = -1.0;
+            h(e, 2, 0) = 1.0;
+            h(e, 3, 0) = -1.0;
+        }
+
+        f = quad.Int_gradN_dot_tensor2_dV_hourglass(zero, h, stiffness);
+
+        REQUIRE(xt::allclose(xt::sum(f, {1}), 0.0));
+        REQUIRE(xt::all(xt::sum(f * h, {1, 2}) > 0.0));
+    }
+
+    SECTION("QuadraturePlanar - int_gradN_dot_mandel_dot_gradNT_dV")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(3, 3);
+        GooseFEM::Vector vec(mesh.conn(), mesh.dofs());
+
+        auto coor = mesh.coor();
+        coor += 0.1 * xt::random::rand<double>(coor.shape());
+
+        GooseFEM::Element::Quad4::QuadraturePlanar quad(vec.AsElement(coor));
+
+        // random tangent with minor symmetries
+        xt::xtensor<double, 6> X = xt::random::rand<double>(quad.AllocateQtensor<4>().shape());
+        xt::xtensor<double, 6> C = X + xt::transpose(X, {0, 1, 3, 2, 4, 5}) +
+                                   xt::transpose(X, {0, 1, 2, 3, 5, 4}) +
+                                   xt::transpose(X, {0, 1, 3, 2, 5, 4});
+
+        auto K = quad.Int_gradN_dot_tensor4_dot_gradNT_dV(C);
+        auto Km = quad.Int_gradN_dot_mandel_dot_gradNT_dV(GooseFEM::Element::AsMandel(C));
+
+        REQUIRE(xt::allclose(K, Km));
+    }
+
+    SECTION("QuadratureAxisymmetric - symGradN_vector, int_gradN_dot_tensor4_dot_gradNT_dV")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(3, 3);
+        GooseFEM::Vector vec(mesh.conn(), mesh.dofs());
+
+        // "x(m,0) = z", "x(m,1) = r": keep the radius positive
+        auto coor = mesh.coor();
+        xt::view(coor, xt::all(), 1) += 1.0;
+        coor += 0.1 * xt::random::rand<double>(coor.shape());
+
+        GooseFEM::Element::Quad4::QuadratureAxisymmetric quad(vec.AsElement(coor));
+
+        // homogeneous deformation: u_z = 0.2 * z, u_r = 0.1 * r
+        xt::xtensor<double, 2> disp = xt::zeros<double>(coor.shape());
+        xt::view(disp, xt::all(), 0) = 0.2 * xt::view(coor, xt::all(), 0);
+        xt::view(disp, xt::all(), 1) = 0.1 * xt::view(coor, xt::all(), 1);
+
+        xt::xtensor<double, 2> EPS = {{0.1, 0.0, 0.0}, {0.0, 0.1, 0.0}, {0.0, 0.0, 0.2}};
+        auto eps = quad.SymGradN_vector(vec.AsElement(disp));
+
+        for (size_t e = 0; e < mesh.nelem(); ++e) {
+            for (size_t q = 0; q < quad.nip(); ++q) {
+                REQUIRE(xt::allclose(xt::view(eps, e, q), EPS));
+            }
+        }
+
+        // linear elasticity: K * u = f(C : eps(u))
+        xt::xtensor<double, 2> u = xt::random::rand<double>(coor.shape());
+        xt::xtensor<double, 3> ue = vec.AsElement(u);
+        xt::xtensor<double, 6> C = quad.AllocateQtensor<4>(0.0);
+        xt::xtensor<double, 4> sig = quad.AllocateQtensor<2>(0.0);
+        eps = quad.SymGradN_vector(ue);
+
+        for (size_t e = 0; e < mesh.nelem(); ++e) {
+            for (size_t q = 0; q < quad.nip(); ++q) {
+                for (size_t i = 0; i < 3; ++i) {
+                    for (size_t j = 0; j < 3; ++j) {
+                        for (size_t k = 0; k < 3; ++k) {
+                            for (size_t l = 0; l < 3; ++l) {
+                                C(e, q, i, j, k, l) =
+                                    0.5 * (i == j) * (k == l) +
+                                    0.5 * ((i == k) * (j == l) + (i == l) * (j == k));
+                                sig(e, q, i, j) += C(e, q, i, j, k, l) * eps(e, q, l, k);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        auto K = quad.Int_gradN_dot_tensor4_dot_gradNT_dV(C);
+        auto f = quad.Int_gradN_dot_tensor2_dV(sig);
+        xt::xtensor<double, 3> Ku = xt::zeros<double>(f.shape());
+
+        for (size_t e = 0; e < mesh.nelem(); ++e) {
+            for (size_t m = 0; m < 4; ++m) {
+                for (size_t i = 0; i < 2; ++i) {
+                    for (size_t n = 0; n < 4; ++n) {
+                        for (size_t j = 0; j < 2; ++j) {
+                            Ku(e, m, i) += K(e, m * 2 + i, n * 2 + j) * ue(e, n, j);
+                        }
+                    }
+                }
+            }
+        }
+
+        REQUIRE(xt::allclose(Ku, f));
+    }
+
+    SECTION("degenerate")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(3, 1);
+
+        // invert element 1 (clockwise numbering)
+        auto conn = mesh.conn();
+        std::swap(conn(1, 1), conn(1, 3));
+
+        GooseFEM::Vector vec(conn, mesh.dofs());
+        GooseFEM::Element::Quad4::Quadrature quad(vec.AsElement(mesh.coor()));
+
+        xt::xtensor<size_t, 1> elem = {1, 2};
+
+        REQUIRE(xt::all(xt::equal(quad.degenerate(), xt::xtensor<size_t, 1>{1})));
+        REQUIRE(xt::all(xt::equal(quad.Subset(elem).degenerate(), xt::xtensor<size_t, 1>{0})));
+        REQUIRE(xt::all(xt::view(quad.dV(), 1) < 0.0));
+
+        // restore
+        GooseFEM::Vector restored(mesh.conn(), mesh.dofs());
+        quad.update_x(restored.AsElement(mesh.coor()));
+
+        REQUIRE(quad.degenerate().size() == 0);
+    }
+
+    SECTION("degenerate - many integration points")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(20, 1);
+
+        // invert the last element, such that it is not in the first batch
+        auto conn = mesh.conn();
+        std::swap(conn(19, 1), conn(19, 3));
+
+        GooseFEM::Vector vec(conn, mesh.dofs());
+        xt::xtensor<double, 3> x = vec.AsElement(mesh.coor());
+
+        // the Gauss points repeated, such that the Jacobians of one element span several chunks
+        size_t n = 2 * GooseFEM::Element::detail::nip_batch / 4 + 1;
+        auto xi_gauss = GooseFEM::Element::Quad4::Gauss::xi();
+        auto w_gauss = GooseFEM::Element::Quad4::Gauss::w();
+        xt::xtensor<double, 2> xi = xt::empty<double>({4 * n, size_t(2)});
+        xt::xtensor<double, 1> w = xt::empty<double>({4 * n});
+
+        for (size_t q = 0; q < 4 * n; ++q) {
+            xt::view(xi, q) = xt::view(xi_gauss, q % 4);
+            w(q) = w_gauss(q % 4) / static_cast<double>(n);
+        }
+
+        GooseFEM::Element::Quad4::Quadrature gauss(x);
+        GooseFEM::Element::Quad4::Quadrature quad(x, xi, w);
+
+        REQUIRE(xt::all(xt::equal(quad.degenerate(), xt::xtensor<size_t, 1>{19})));
+        REQUIRE(xt::allclose(xt::sum(quad.dV(), {1}), xt::sum(gauss.dV(), {1})));
+
+        auto dNx = quad.GradN();
+        auto dNx_gauss = gauss.GradN();
+
+        for (size_t q = 0; q < quad.nip(); ++q) {
+            REQUIRE(xt::allclose(
+                xt::view(dNx, xt::all(), q), xt::view(dNx_gauss, xt::all(), q % 4)));
+        }
+    }
+
+    SECTION("Subset")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(3, 3);
+
+        auto coor = mesh.coor();
+        coor += 0.1 * xt::random::rand<double>(coor.shape());
+
+        xt::xtensor<size_t, 1> elem_a = {0, 2, 4, 6, 8};
+        xt::xtensor<size_t, 1> elem_b = {1, 3, 5, 7};
+
+        GooseFEM::Topology topology(mesh.conn(), mesh.dofsPeriodic());
+        GooseFEM::Vector vector(topology);
+        GooseFEM::Vector vector_a(topology.Subset(elem_a));
+        GooseFEM::Vector vector_b(topology.Subset(elem_b));
+        GooseFEM::Element::Quad4::Quadrature quad(vector.AsElement(coor));
+        GooseFEM::Element::Quad4::Quadrature quad_a = quad.Subset(elem_a);
+        GooseFEM::Element::Quad4::Quadrature quad_b = quad.Subset(elem_b);
+
+        xt::xtensor<double, 2> u = xt::random::rand<double>(coor.shape());
+
+        auto Eps = quad.SymGradN_vector(vector.AsElement(u));
+        auto Eps_a = quad_a.SymGradN_vector(vector_a.AsElement(u));
+        auto Eps_b = quad_b.SymGradN_vector(vector_b.AsElement(u));
+
+        REQUIRE(quad_a.nelem() == elem_a.size());
+        REQUIRE(xt::allclose(Eps_a, xt::view(Eps, xt::keep(elem_a))));
+        REQUIRE(xt::allclose(Eps_b, xt::view(Eps, xt::keep(elem_b))));
+        REQUIRE(xt::allclose(quad_a.dV(), xt::view(quad.dV(), xt::keep(elem_a))));
+
+        auto f = vector.AssembleNode(quad.Int_gradN_dot_tensor2_dV(Eps));
+        auto f_a = vector_a.AssembleNode(quad_a.Int_gradN_dot_tensor2_dV(Eps_a));
+        auto f_b = vector_b.AssembleNode(quad_b.Int_gradN_dot_tensor2_dV(Eps_b));
+
+        REQUIRE(xt::allclose(f, f_a + f_b));
+
+        // the full mesh has no row map, a subset of a subset refers to the rows of the full mesh
+        xt::xtensor<size_t, 1> sub = {1, 3};
+        xt::xtensor<size_t, 1> elem_c = {2, 6};
+
+        REQUIRE(topology.rows() == nullptr);
+        REQUIRE(xt::all(xt::equal(topology.elem(), xt::arange<size_t>(mesh.nelem()))));
+        REQUIRE(xt::all(xt::equal(topology.Subset(elem_a).Subset(sub).elem(), elem_c)));
+    }
+
+    SECTION("Subset - QuadraturePlanar, QuadratureAxisymmetric")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(3, 3);
+        GooseFEM::Vector vector(mesh.conn(), mesh.dofs());
+
+        auto coor = mesh.coor();
+        coor += 0.1 * xt::random::rand<double>(coor.shape());
+        xt::xtensor<double, 3> x = vector.AsElement(coor);
+
+        xt::xtensor<size_t, 1> elem = {1, 4, 5};
+        xt::xtensor<double, 3> ue = xt::random::rand<double>(x.shape());
+        xt::xtensor<double, 3> ue_a = xt::view(ue, xt::keep(elem));
+
+        GooseFEM::Element::Quad4::QuadraturePlanar planar(x);
+        auto planar_a = planar.Subset(elem);
+
+        REQUIRE(planar_a.nelem() == elem.size());
+        REQUIRE(xt::allclose(planar_a.dV(), xt::view(planar.dV(), xt::keep(elem))));
+        REQUIRE(xt::allclose(
+            planar_a.SymGradN_vector(ue_a),
+            xt::view(planar.SymGradN_vector(ue), xt::keep(elem))));
+
+        GooseFEM::Element::Quad4::QuadratureAxisymmetric axi(x);
+        auto axi_a = axi.Subset(elem);
+
+        REQUIRE(axi_a.nelem() == elem.size());
+        REQUIRE(xt::allclose(axi_a.dV(), xt::view(axi.dV(), xt::keep(elem))));
+        REQUIRE(xt::allclose(
+            axi_a.SymGradN_vector(ue_a), xt::view(axi.SymGradN_vector(ue), xt::keep(elem))));
+    }
+
+    SECTION("element list - incremental update")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(4, 4);
+
+        auto coor = mesh.coor();
+        coor += 0.1 * xt::random::rand<double>(coor.shape());
+
+        GooseFEM::Vector vector(mesh.conn(), mesh.dofsPeriodic());
+        GooseFEM::Element::Quad4::Quadrature quad(vector.AsElement(coor));
+
+        xt::xtensor<size_t, 1> elem = {1, 5, 6, 15};
+        xt::xtensor<size_t, 1> other = {0, 2, 3, 4, 7, 8, 9, 10, 11, 12, 13, 14};
+
+        xt::xtensor<double, 2> u = xt::random::rand<double>(coor.shape());
+        xt::xtensor<double, 3> ue = vector.AsElement(u);
+        xt::xtensor<double, 4> eps = quad.SymGradN_vector(ue);
+        xt::xtensor<double, 4> sig = 2.0 * eps;
+        xt::xtensor<double, 2> fint = vector.AssembleNode(quad.Int_gradN_dot_tensor2_dV(sig));
+
+        // strain: only the rows "elem" are updated
+        xt::xtensor<double, 2> v = xt::random::rand<double>(coor.shape());
+        xt::xtensor<double, 4> eps_v = quad.SymGradN_vector(vector.AsElement(v));
+        vector.asElement(elem, v, ue);
+        quad.symGradN_vector(elem, ue, eps);
+
+        REQUIRE(xt::allclose(xt::view(eps, xt::keep(elem)), xt::view(eps_v, xt::keep(elem))));
+        REQUIRE(xt::allclose(xt::view(eps, xt::keep(other)), 0.5 * xt::view(sig, xt::keep(other))));
+
+        // internal force: patch with the change of stress in the elements "elem"
+        xt::xtensor<double, 4> dsig = xt::zeros<double>(sig.shape());
+        xt::view(dsig, xt::keep(elem)) = xt::random::rand<double>({elem.size(), 4ul, 2ul, 2ul});
+        xt::xtensor<double, 3> dfe = xt::empty<double>(ue.shape());
+        quad.int_gradN_dot_tensor2_dV(elem, dsig, dfe);
+        vector.assembleNode(elem, dfe, fint, 1.0);
+
+        REQUIRE(xt::allclose(fint, vector.AssembleNode(quad.Int_gradN_dot_tensor2_dV(sig + dsig))));
+    }
 }
@@ -0,0 +1,164 @@
+
+#include <catch2/catch.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xmath.hpp>
+#include <GooseFEM/GooseFEM.h>
+
+TEST_CASE("GooseFEM::ElementQuad9", "ElementQuad9.h")
+{
+
+    SECTION("dV - Gauss, Nodal")
+    {
+        GooseFEM::Mesh::Quad9::Regular mesh(3, 4, 2.0);
+        GooseFEM::Vector vec(mesh.conn(), mesh.dofs());
+        xt::xtensor<double, 3> x = vec.AsElement(mesh.coor());
+
+        GooseFEM::Element::Quad9::Quadrature gauss(x);
+        GooseFEM::Element::Quad9::Quadrature nodal(
+            x, GooseFEM::Element::Quad9::Nodal::xi(), GooseFEM::Element::Quad9::Nodal::w());
+
+        REQUIRE(gauss.nip() == GooseFEM::Element::Quad9::Gauss::nip());
+        REQUIRE(nodal.nip() == GooseFEM::Element::Quad9::Nodal::nip());
+        REQUIRE(xt::allclose(xt::sum(gauss.dV())(), 6.0 * 8.0));
+        REQUIRE(xt::allclose(xt::sum(nodal.dV())(), 6.0 * 8.0));
+    }
+
+    SECTION("int_N_scalar_NT_dV")
+    {
+        GooseFEM::Mesh::Quad9::Regular mesh(2, 2);
+        GooseFEM::Vector vec(mesh.conn(), mesh.dofs());
+        xt::xtensor<double, 3> x = vec.AsElement(mesh.coor());
+
+        GooseFEM::Element::Quad9::Quadrature gauss(x);
+        GooseFEM::Element::Quad9::Quadrature nodal(
+            x, GooseFEM::Element::Quad9::Nodal::xi(), GooseFEM::Element::Quad9::Nodal::w());
+
+        auto Mg = gauss.Int_N_scalar_NT_dV(gauss.AllocateQscalar(1.0));
+        auto Mn = nodal.Int_N_scalar_NT_dV(nodal.AllocateQscalar(1.0));
+
+        // partition of unity: sum of all entries equals "ndim" times the volume
+        REQUIRE(xt::allclose(xt::sum(Mg)(), 2.0 * xt::sum(gauss.dV())()));
+        REQUIRE(xt::allclose(xt::sum(Mn)(), 2.0 * xt::sum(nodal.dV())()));
+
+        // integration points coinciding with the nodes: diagonal (lumped) mass matrix
+        for (size_t e = 0; e < mesh.nelem(); ++e) {
+            for (size_t i = 0; i < Mn.shape(1); ++i) {
+                for (size_t j = 0; j < Mn.shape(2); ++j) {
+                    if (i != j) {
+                        REQUIRE(std::abs(Mn(e, i, j)) < 1e-12);
+                    }
+                }
+            }
+        }
+    }
+
+    SECTION("symGradN_vector, int_gradN_dot_tensor2_dV")
+    {
+        GooseFEM::Mesh::Quad9::Regular mesh(3, 4);
+        GooseFEM::Vector vec(mesh.conn(), mesh.dofsPeriodic());
+        GooseFEM::Element::Quad9::Quadrature quad(vec.AsElement(mesh.coor()));
+
+        xt::xtensor<double, 2> F = xt::zeros<double>({2, 2});
+
+        F(0, 1) = 0.1;
+
+        auto coor = mesh.coor();
+        xt::xtensor<double, 2> disp = xt::zeros<double>(coor.shape());
+
+        for (size_t n = 0; n < mesh.nnode(); ++n) {
+            for (size_t i = 0; i < F.shape()[0]; ++i) {
+                for (size_t j = 0; j < F.shape()[1]; ++j) {
+                    disp(n, i) += F(i, j) * coor(n, j);
+                }
+            }
+        }
+
+        xt::xtensor<double, 2> EPS = 0.5 * (F + xt::transpose(F));
+        auto eps = quad.SymGradN_vector(vec.AsElement(disp));
+
+        for (size_t e = 0; e < mesh.nelem(); ++e) {
+            for (size_t q = 0; q < quad.nip(); ++q) {
+                REQUIRE(xt::allclose(xt::view(eps, e, q), EPS));
+            }
+        }
+
+        auto Fi = vec.AssembleDofs(quad.Int_gradN_dot_tensor2_dV(eps));
+
+        REQUIRE(Fi.size() == vec.ndof());
+        REQUIRE(xt::allclose(Fi, 0.));
+    }
+
+    SECTION("int_gradN_dot_tensor4_dot_gradNT_dV")
+    {
+        GooseFEM::Mesh::Quad9::Regular mesh(2, 2);
+        GooseFEM::Vector vec(mesh.conn(), mesh.dofs());
+
+        auto coor = mesh.coor();
+        coor += 0.05 * xt::random::rand<double>(coor.shape());
+        xt::xtensor<double, 3> x = vec.AsElement(coor);
+
+        GooseFEM::Element::Quad9::Quadrature quad(x);
+
+        REQUIRE(xt::allclose(xt::sum(quad.GradN(), {2}), 0.0));
+
+        // random tangent
+        xt::xtensor<double, 6> C = xt::random::rand<double>(quad.AllocateQtensor<4>().shape());
+        auto K = quad.Int_gradN_dot_tensor4_dot_gradNT_dV(C);
+
+        // K * u = f(C : grad(u))
+        xt::xtensor<double, 2> u = xt::random::rand<double>(coor.shape());
+        xt::xtensor<double, 3> ue = vec.AsElement(u);
+        auto gradu = quad.GradN_vector(ue);
+        xt::xtensor<double, 4> sig = quad.AllocateQtensor<2>(0.0);
+
+        for (size_t e = 0; e < mesh.nelem(); ++e) {
+            for (size_t q = 0; q < quad.nip(); ++q) {
+                for (size_t i = 0; i < 2; ++i) {
+                    for (size_t j = 0; j < 2; ++j) {
+                        for (size_t k = 0; k < 2; ++k) {
+                            for (size_t l = 0; l < 2; ++l) {
+                                sig(e, q, i, j) += C(e, q, i, j, k, l) * gradu(e, q, l, k);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        auto f = quad.Int_gradN_dot_tensor2_dV(sig);
+        xt::xtensor<double, 3> Ku = xt::zeros<double>(f.shape());
+
+        for (size_t e = 0; e < mesh.nelem(); ++e) {
+            for (size_t m = 0; m < 9; ++m) {
+                for (size_t i = 0; i < 2; ++i) {
+                    for (size_t n = 0; n < 9; ++n) {
+                        for (size_t j = 0; j < 2; ++j) {
+                            Ku(e, m, i) += K(e, m * 2 + i, n * 2 + j) * ue(e, n, j);
+                        }
+                    }
+                }
+            }
+        }
+
+        REQUIRE(xt::allclose(Ku, f));
+    }
+
+    SECTION("Subset")
+    {
+        GooseFEM::Mesh::Quad9::Regular mesh(3, 4);
+        GooseFEM::Vector vec(mesh.conn(), mesh.dofs());
+        GooseFEM::Element::Quad9::Quadrature quad(vec.AsElement(mesh.coor()));
+
+        xt::xtensor<size_t, 1> elem = {0, 2, 3};
+        auto sub = quad.Subset(elem);
+
+        xt::xtensor<double, 3> ue = xt::random::rand<double>({elem.size(), 9ul, 2ul});
+        xt::xtensor<double, 3> ue_all = xt::zeros<double>({mesh.nelem(), 9ul, 2ul});
+        xt::view(ue_all, xt::keep(elem)) = ue;
+
+        REQUIRE(xt::allclose(sub.dV(), xt::view(quad.dV(), xt::keep(elem))));
+        REQUIRE(xt::allclose(sub.GradN(), xt::view(quad.GradN(), xt::keep(elem))));
+        REQUIRE(xt::allclose(
+            sub.SymGradN_vector(ue), xt::view(quad.SymGradN_vector(ue_all), xt::keep(elem))));
+    }
+}
@@ -0,0 +1,140 @@
+
+#include <catch2/catch.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xmath.hpp>
+#include <GooseFEM/GooseFEM.h>
+
+TEST_CASE("GooseFEM::ElementTri3", "ElementTri3.h")
+{
+
+    SECTION("dV - Gauss, Nodal")
+    {
+        GooseFEM::Mesh::Tri3::Regular mesh(3, 4, 2.0);
+        GooseFEM::Vector vec(mesh.conn(), mesh.dofs());
+        xt::xtensor<double, 3> x = vec.AsElement(mesh.coor());
+
+        GooseFEM::Element::Tri3::Quadrature gauss(x);
+        GooseFEM::Element::Tri3::Quadrature nodal(
+            x, GooseFEM::Element::Tri3::Nodal::xi(), GooseFEM::Element::Tri3::Nodal::w());
+
+        REQUIRE(gauss.nip() == 1);
+        REQUIRE(nodal.nip() == 3);
+        REQUIRE(xt::allclose(gauss.dV(), 2.0));
+        REQUIRE(xt::allclose(nodal.dV(), 2.0 / 3.0));
+        REQUIRE(xt::allclose(xt::sum(nodal.dV())(), 3.0 * 4.0 * 4.0));
+    }
+
+    SECTION("symGradN_vector, int_gradN_dot_tensor2_dV")
+    {
+        GooseFEM::Mesh::Tri3::Regular mesh(9, 11);
+        GooseFEM::Vector vec(mesh.conn(), mesh.dofsPeriodic());
+        GooseFEM::Element::Tri3::Quadrature quad(vec.AsElement(mesh.coor()));
+
+        xt::xtensor<double, 2> F = xt::zeros<double>({2, 2});
+
+        F(0, 1) = 0.1;
+
+        auto coor = mesh.coor();
+        xt::xtensor<double, 2> disp = xt::zeros<double>(coor.shape());
+
+        for (size_t n = 0; n < mesh.nnode(); ++n) {
+            for (size_t i = 0; i < F.shape()[0]; ++i) {
+                for (size_t j = 0; j < F.shape()[1]; ++j) {
+                    disp(n, i) += F(i, j) * coor(n, j);
+                }
+            }
+        }
+
+        xt::xtensor<double, 2> EPS = 0.5 * (F + xt::transpose(F));
+        auto eps = quad.SymGradN_vector(vec.AsElement(disp));
+
+        for (size_t e = 0; e < mesh.nelem(); ++e) {
+            REQUIRE(xt::allclose(xt::view(eps, e, 0), EPS));
+        }
+
+        auto Fi = vec.AssembleDofs(quad.Int_gradN_dot_tensor2_dV(eps));
+
+        REQUIRE(Fi.size() == vec.ndof());
+        REQUIRE(xt::allclose(Fi, 0.));
+    }
+
+    SECTION("int_gradN_dot_tensor4_dot_gradNT_dV, int_gradN_dot_mandel_dot_gradNT_dV")
+    {
+        GooseFEM::Mesh::Tri3::Regular mesh(3, 3);
+        GooseFEM::Vector vec(mesh.conn(), mesh.dofs());
+
+        auto coor = mesh.coor();
+        coor += 0.1 * xt::random::rand<double>(coor.shape());
+        xt::xtensor<double, 3> x = vec.AsElement(coor);
+
+        GooseFEM::Element::Tri3::Quadrature quad(
+            x, GooseFEM::Element::Tri3::Nodal::xi(), GooseFEM::Element::Tri3::Nodal::w());
+
+        // random tangent with minor symmetries
+        xt::xtensor<double, 6> X = xt::random::rand<double>(quad.AllocateQtensor<4>().shape());
+        xt::xtensor<double, 6> C = X + xt::transpose(X, {0, 1, 3, 2, 4, 5}) +
+                                   xt::transpose(X, {0, 1, 2, 3, 5, 4}) +
+                                   xt::transpose(X, {0, 1, 3, 2, 5, 4});
+
+        auto K = quad.Int_gradN_dot_tensor4_dot_gradNT_dV(C);
+        auto Km = quad.Int_gradN_dot_mandel_dot_gradNT_dV(GooseFEM::Element::AsMandel(C));
+
+        REQUIRE(xt::allclose(K, Km));
+
+        // K * u = f(C : grad(u))
+        xt::xtensor<double, 2> u = xt::random::rand<double>(coor.shape());
+        xt::xtensor<double, 3> ue = vec.AsElement(u);
+        auto gradu = quad.GradN_vector(ue);
+        xt::xtensor<double, 4> sig = quad.AllocateQtensor<2>(0.0);
+
+        for (size_t e = 0; e < mesh.nelem(); ++e) {
+            for (size_t q = 0; q < quad.nip(); ++q) {
+                for (size_t i = 0; i < 2; ++i) {
+                    for (size_t j = 0; j < 2; ++j) {
+                        for (size_t k = 0; k < 2; ++k) {
+                            for (size_t l = 0; l < 2; ++l) {
+                                sig(e, q, i, j) += C(e, q, i, j, k, l) * gradu(e, q, l, k);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        auto f = quad.Int_gradN_dot_tensor2_dV(sig);
+        xt::xtensor<double, 3> Ku = xt::zeros<double>(f.shape());
+
+        for (size_t e = 0; e < mesh.nelem(); ++e) {
+            for (size_t m = 0; m < 3; ++m) {
+                for (size_t i = 0; i < 2; ++i) {
+                    for (size_t n = 0; n < 3; ++n) {
+                        for (size_t j = 0; j < 2; ++j) {
+                            Ku(e, m, i) += K(e, m * 2 + i, n * 2 + j) * ue(e, n, j);
+                        }
+                    }
+                }
+            }
+        }
+
+        REQUIRE(xt::allclose(Ku, f));
+    }
+
+    SECTION("Subset")
+    {
+        GooseFEM::Mesh::Tri3::Regular mesh(3, 3);
+        GooseFEM::Vector vec(mesh.conn(), mesh.dofs());
+        GooseFEM::Element::Tri3::Quadrature quad(vec.AsElement(mesh.coor()));
+
+        xt::xtensor<size_t, 1> elem = {1, 4, 5, 10};
+        auto sub = quad.Subset(elem);
+
+        xt::xtensor<double, 3> ue = xt::random::rand<double>({elem.size(), 3ul, 2ul});
+        xt::xtensor<double, 3> ue_all = xt::zeros<double>({mesh.nelem(), 3ul, 2ul});
+        xt::view(ue_all, xt::keep(elem)) = ue;
+
+        REQUIRE(xt::allclose(sub.dV(), xt::view(quad.dV(), xt::keep(elem))));
+        REQUIRE(xt::allclose(sub.GradN(), xt::view(quad.GradN(), xt::keep(elem))));
+        REQUIRE(xt::allclose(
+            sub.SymGradN_vector(ue), xt::view(quad.SymGradN_vector(ue_all), xt::keep(elem))));
+    }
+}
@@ -0,0 +1,63 @@
+#include <catch2/catch.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xmath.hpp>
+#include <Eigen/Eigen>
+#include <GooseFEM/GooseFEM.h>
+#include "support.h"
+
+template <class Solver>
+xt::xtensor<double, 2> solve_partitioned()
+{
+    GooseFEM::Mesh::Quad4::Regular mesh(5, 5);
+
+    size_t nelem = mesh.nelem();
+    size_t n = mesh.nne() * mesh.ndim();
+    auto dofs = mesh.dofs();
+    auto bottom = mesh.nodesBottomEdge();
+    xt::xtensor<size_t, 1> iip = xt::flatten(xt::view(dofs, xt::keep(bottom), xt::all()));
+
+    // symmetric positive definite element matrices
+
+    xt::random::seed(0);
+    xt::xtensor<double, 3> a = support::random_spd(nelem, n);
+
+    xt::xtensor<double, 2> b = xt::random::rand<double>({mesh.nnode(), mesh.ndim()});
+    xt::xtensor<double, 2> x = xt::zeros<double>({mesh.nnode(), mesh.ndim()});
+    xt::view(x, xt::keep(bottom), xt::all()) = 0.1;
+
+    GooseFEM::MatrixPartitioned A(mesh.conn(), dofs, iip);
+    GooseFEM::MatrixPartitionedSolver<Solver> solver;
+    A.assemble(a);
+    return solver.Solve(A, b, x);
+}
+
+TEST_CASE("GooseFEM::LinearSolver", "LinearSolver.h")
+{
+    auto x = solve_partitioned<GooseFEM::LinearSolver::SimplicialLDLT>();
+
+    SECTION("Default")
+    {
+        REQUIRE(xt::allclose(solve_partitioned<GooseFEM::LinearSolver::Default>(), x));
+    }
+
+#ifdef GOOSEFEM_USE_CHOLMOD
+    SECTION("CholmodSupernodalLLT")
+    {
+        REQUIRE(xt::allclose(solve_partitioned<GooseFEM::LinearSolver::CholmodSupernodalLLT>(), x));
+    }
+#endif
+
+#ifdef GOOSEFEM_USE_PARDISO
+    SECTION("PardisoLDLT")
+    {
+        REQUIRE(xt::allclose(solve_partitioned<GooseFEM::LinearSolver::PardisoLDLT>(), x));
+    }
+#endif
+
+#ifdef GOOSEFEM_USE_PASTIX
+    SECTION("PastixLDLT")
+    {
+        REQUIRE(xt::allclose(solve_partitioned<GooseFEM::LinearSolver::PastixLDLT>(), x));
+    }
+#endif
+}
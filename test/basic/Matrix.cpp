@@ -4,6 +4,7 @@
 #include <xtensor/xmath.hpp>
 #include <Eigen/Eigen>
 #include <GooseFEM/GooseFEM.h>
+#include "support.h"
 
 #define ISCLOSE(a,b) REQUIRE_THAT((a), Catch::WithinAbs((b), 1.e-12));
 
@@ -37,6 +38,102 @@ TEST_CASE("GooseFEM::Matrix", "Matrix.h")
         REQUIRE(xt::allclose(B, b));
     }
 
+    SECTION("symmetric storage")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(3, 3);
+
+        size_t nne = mesh.nne();
+        size_t ndim = mesh.ndim();
+        size_t nelem = mesh.nelem();
+        size_t nnode = mesh.nnode();
+        size_t n = nne * ndim;
+
+        xt::xtensor<double, 3> a = support::random_spd(nelem, n);
+
+        GooseFEM::Matrix A(mesh.conn(), mesh.dofs());
+        GooseFEM::Matrix S(mesh.conn(), mesh.dofs(), true);
+        GooseFEM::MatrixSolver<> Solver;
+        GooseFEM::MatrixSolver<> SSolver;
+        A.assemble(a);
+        S.assemble(a);
+
+        xt::xtensor<double, 1> x = xt::random::rand<double>({nnode * ndim});
+        xt::xtensor<double, 2> X = xt::random::rand<double>({nnode, ndim});
+
+        REQUIRE(S.symmetric());
+        REQUIRE(xt::allclose(A.Todense(), S.Todense()));
+        REQUIRE(xt::allclose(A.Dot(x), S.Dot(x)));
+        REQUIRE(xt::allclose(A.Dot(X), S.Dot(X)));
+        REQUIRE(xt::allclose(Solver.Solve(A, x), SSolver.Solve(S, x)));
+    }
+
+    SECTION("dot/residual - parallel over rows")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(5, 4);
+
+        size_t nelem = mesh.nelem();
+        size_t ndof = mesh.nnode() * mesh.ndim();
+        size_t n = mesh.nne() * mesh.ndim();
+
+        xt::xtensor<double, 3> a = xt::empty<double>({nelem, n, n});
+
+        for (size_t e = 0; e < nelem; ++e) {
+            xt::xtensor<double, 2> ae = xt::random::rand<double>({n, n});
+            ae = (ae + xt::transpose(ae)) / 2.0;
+            xt::view(a, e, xt::all(), xt::all()) = ae;
+        }
+
+        GooseFEM::Matrix A(mesh.conn(), mesh.dofs());
+        GooseFEM::Matrix S(mesh.conn(), mesh.dofs(), true);
+        A.assemble(a);
+        S.assemble(a);
+
+        xt::xtensor<double, 1> x = xt::random::rand<double>({ndof});
+        xt::xtensor<double, 1> b = xt::random::rand<double>({ndof});
+        xt::xtensor<double, 2> dense = A.Todense();
+        xt::xtensor<double, 1> ref = xt::zeros<double>({ndof});
+
+        for (size_t i = 0; i < ndof; ++i) {
+            for (size_t j = 0; j < ndof; ++j) {
+                ref(i) += dense(i, j) * x(j);
+            }
+        }
+
+        REQUIRE(xt::allclose(A.Dot(x), ref));
+        REQUIRE(xt::allclose(A.Residual(x, b), b - ref));
+        REQUIRE(xt::allclose(S.Residual(x, b), b - ref));
+    }
+
+    SECTION("solve - batch of right-hand-sides")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(2, 2);
+
+        size_t nne = mesh.nne();
+        size_t ndim = mesh.ndim();
+        size_t nelem = mesh.nelem();
+        size_t nnode = mesh.nnode();
+        size_t nrhs = 3;
+
+        xt::xtensor<double, 3> a = xt::empty<double>({nelem, nne * ndim, nne * ndim});
+        xt::xtensor<double, 3> b = xt::random::rand<double>({nrhs, nnode, ndim});
+
+        for (size_t e = 0; e < nelem; ++e) {
+            xt::xtensor<double, 2> ae = xt::random::rand<double>({nne * ndim, nne * ndim});
+            ae = (ae + xt::transpose(ae)) / 2.0;
+            xt::view(a, e, xt::all(), xt::all()) = ae;
+        }
+
+        GooseFEM::Matrix A(mesh.conn(), mesh.dofs());
+        GooseFEM::MatrixSolver<> Solver;
+        A.assemble(a);
+        xt::xtensor<double, 3> X = Solver.Solve(A, b);
+
+        for (size_t r = 0; r < nrhs; ++r) {
+            xt::xtensor<double, 2> br = xt::view(b, r, xt::all(), xt::all());
+            REQUIRE(xt::allclose(xt::view(X, r, xt::all(), xt::all()), Solver.Solve(A, br)));
+        }
+    }
+
     SECTION("set/add/dot/solve - dofval")
     {
         xt::xtensor<double, 2> a = xt::random::rand<double>({10, 10});
@@ -94,4 +191,53 @@ TEST_CASE("GooseFEM::Matrix", "Matrix.h")
         REQUIRE(xt::allclose(b, K.Dot(x)));
         REQUIRE(xt::allclose(x, Solver.Solve(K, b)));
     }
+
+    SECTION("freeze")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(3, 3);
+
+        size_t nne = mesh.nne();
+        size_t ndim = mesh.ndim();
+        size_t nelem = mesh.nelem();
+        size_t n = nne * ndim;
+
+        xt::xtensor<size_t, 1> elem_a = xt::arange<size_t>(3, 6);
+        xt::xtensor<size_t, 1> elem_b = {0, 1, 2, 6, 7, 8};
+        xt::xtensor<double, 3> a = xt::zeros<double>({nelem, n, n});
+        xt::view(a, xt::keep(elem_a)) = xt::random::rand<double>({elem_a.size(), n, n});
+        xt::xtensor<double, 3> a_a = xt::view(a, xt::keep(elem_a));
+
+        GooseFEM::Matrix A(mesh.conn(), mesh.dofs());
+        GooseFEM::Matrix K(mesh.conn(), mesh.dofs());
+        GooseFEM::Matrix S(mesh.conn(), mesh.dofs(), true);
+        K.freeze(elem_a, a_a);
+
+        for (size_t iter = 0; iter < 3; ++iter) {
+            xt::xtensor<double, 3> a_b = xt::random::rand<double>({elem_b.size(), n, n});
+            a_b = a_b + xt::transpose(a_b, {0, 2, 1});
+            xt::view(a, xt::keep(elem_b)) = a_b;
+            A.assemble(a);
+            K.assemble(elem_b, a_b);
+            REQUIRE(xt::allclose(A.Todense(), K.Todense()));
+        }
+
+        xt::xtensor<double, 3> s = a + xt::transpose(a, {0, 2, 1});
+        xt::xtensor<double, 3> s_a = xt::view(s, xt::keep(elem_a));
+        xt::xtensor<double, 3> s_b = xt::view(s, xt::keep(elem_b));
+        A.assemble(s);
+        S.freeze(elem_a, s_a);
+        S.assemble(elem_b, s_b);
+        REQUIRE(xt::allclose(A.Todense(), S.Todense()));
+
+        K.unfreeze();
+        K.assemble(elem_b, s_b);
+        xt::view(s, xt::keep(elem_a)) = 0.0;
+        A.assemble(s);
+        REQUIRE(xt::allclose(A.Todense(), K.Todense()));
+
+        // the frozen part is restored after a full assembly
+        K.assemble(s);
+        K.assemble(elem_b, s_b);
+        REQUIRE(xt::allclose(A.Todense(), K.Todense()));
+    }
 }
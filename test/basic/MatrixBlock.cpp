@@ -0,0 +1,56 @@
+#include <catch2/catch.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xmath.hpp>
+#include <Eigen/Eigen>
+#include <GooseFEM/GooseFEM.h>
+
+TEST_CASE("GooseFEM::MatrixBlock", "MatrixBlock.h")
+{
+    SECTION("assemble/dot - compare to Matrix, Quad4")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(3, 4);
+
+        size_t n = mesh.nne() * mesh.ndim();
+        xt::xtensor<double, 3> a = xt::random::rand<double>({mesh.nelem(), n, n});
+
+        GooseFEM::Matrix A(mesh.conn(), mesh.dofs());
+        GooseFEM::MatrixBlock<2> B(mesh.conn(), mesh.dofs());
+        A.assemble(a);
+        B.assemble(a);
+
+        xt::xtensor<double, 1> x = xt::random::rand<double>({mesh.nnode() * mesh.ndim()});
+        xt::xtensor<double, 2> X = xt::random::rand<double>({mesh.nnode(), mesh.ndim()});
+        xt::xtensor<double, 2> dense = A.Todense();
+        xt::xtensor<double, 3> diag = B.Todiagonal();
+
+        REQUIRE(xt::allclose(dense, B.Todense()));
+        REQUIRE(xt::allclose(A.Dot(x), B.Dot(x)));
+        REQUIRE(xt::allclose(A.Dot(X), B.Dot(X)));
+
+        for (size_t m = 0; m < mesh.nnode(); ++m) {
+            for (size_t i = 0; i < mesh.ndim(); ++i) {
+                for (size_t j = 0; j < mesh.ndim(); ++j) {
+                    REQUIRE(diag(m, i, j) == Approx(dense(m * 2 + i, m * 2 + j)));
+                }
+            }
+        }
+    }
+
+    SECTION("assemble/dot - compare to Matrix, Hex8")
+    {
+        GooseFEM::Mesh::Hex8::Regular mesh(2, 3, 2);
+
+        size_t n = mesh.nne() * mesh.ndim();
+        xt::xtensor<double, 3> a = xt::random::rand<double>({mesh.nelem(), n, n});
+
+        GooseFEM::Matrix A(mesh.conn(), mesh.dofs());
+        GooseFEM::MatrixBlock<3> B(mesh.conn(), mesh.dofs());
+        A.assemble(a);
+        B.assemble(a);
+
+        xt::xtensor<double, 2> X = xt::random::rand<double>({mesh.nnode(), mesh.ndim()});
+
+        REQUIRE(xt::allclose(A.Todense(), B.Todense()));
+        REQUIRE(xt::allclose(A.Dot(X), B.Dot(X)));
+    }
+}
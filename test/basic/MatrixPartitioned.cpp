@@ -0,0 +1,210 @@
+
+#include <catch2/catch.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xmath.hpp>
+#include <Eigen/Eigen>
+#include <GooseFEM/GooseFEM.h>
+#include "support.h"
+
+#define ISCLOSE(a,b) REQUIRE_THAT((a), Catch::WithinAbs((b), 1.e-12));
+
+TEST_CASE("GooseFEM::MatrixPartitioned", "MatrixPartitioned.h")
+{
+    SECTION("solve")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(2, 2);
+
+        size_t nne = mesh.nne();
+        size_t ndim = mesh.ndim();
+        size_t nelem = mesh.nelem();
+        size_t nnode = mesh.nnode();
+        auto dofs = mesh.dofs();
+        size_t npp = xt::amax(dofs)();
+        npp = (npp - npp % 2) / 2;
+        xt::xtensor<size_t, 1> iip = xt::arange<size_t>(npp);
+
+        xt::xtensor<double, 3> a = xt::empty<double>({nelem, nne * ndim, nne * ndim});
+        xt::xtensor<double, 1> b = xt::random::rand<double>({nnode * ndim});
+
+        for (size_t e = 0; e < nelem; ++e) {
+            xt::xtensor<double, 2> ae = xt::random::rand<double>({nne * ndim, nne * ndim});
+            ae = (ae + xt::transpose(ae)) / 2.0;
+            xt::view(a, e, xt::all(), xt::all()) = ae;
+        }
+
+        GooseFEM::MatrixPartitioned A(mesh.conn(), dofs, iip);
+        GooseFEM::MatrixPartitionedSolver<> Solver;
+        A.assemble(a);
+        xt::xtensor<double, 1> C = A.Dot(b);
+        xt::xtensor<double, 1> B = Solver.Solve(A, C, b);
+
+        REQUIRE(B.size() == b.size());
+        REQUIRE(xt::allclose(B, b));
+
+        // check that allocating a different Solver instance still works
+        GooseFEM::MatrixPartitionedSolver<> NewSolver;
+        xt::xtensor<double, 1> NB = NewSolver.Solve(A, C, b);
+
+        REQUIRE(NB.size() == b.size());
+        REQUIRE(xt::allclose(NB, b));
+    }
+
+    SECTION("set/add/dot/solve - dofval")
+    {
+        xt::xtensor<double, 2> a = xt::random::rand<double>({10, 10});
+        xt::xtensor<double, 1> x = xt::random::rand<double>({10});
+        xt::xtensor<double, 1> b = xt::zeros<double>({10});
+
+        xt::xtensor<double, 2> A = a + xt::transpose(a);
+
+        for (size_t i = 0; i < A.shape(0); ++i) {
+            for (size_t j = 0; j < A.shape(1); ++j) {
+                b(i) += A(i, j) * x(j);
+            }
+        }
+
+        xt::xtensor<size_t, 2> conn = xt::zeros<size_t>({1, 5});
+        xt::xtensor<size_t, 2> dofs = xt::arange<size_t>(10).reshape({5, 2});
+        xt::xtensor<size_t, 1> iip = xt::arange<size_t>(5);
+
+        GooseFEM::MatrixPartitioned K(conn, dofs, iip);
+        GooseFEM::MatrixPartitionedSolver<> Solver;
+        K.set(xt::arange<size_t>(10), xt::arange<size_t>(10), a);
+        K.add(xt::arange<size_t>(10), xt::arange<size_t>(10), xt::transpose(a));
+
+        REQUIRE(xt::allclose(A, K.Todense()));
+        REQUIRE(xt::allclose(b, K.Dot(x)));
+        REQUIRE(xt::allclose(x, Solver.Solve(K, b, x)));
+    }
+
+    SECTION("set/add/dot/solve - nodevec")
+    {
+        xt::xtensor<double, 2> a = xt::random::rand<double>({10, 10});
+        xt::xtensor<double, 2> x = xt::random::rand<double>({5, 2});
+        xt::xtensor<double, 2> b = xt::zeros<double>({5, 2});
+
+        xt::xtensor<double, 2> A = a + xt::transpose(a);
+
+        for (size_t m = 0; m < x.shape(0); ++m) {
+            for (size_t n = 0; n < x.shape(0); ++n) {
+                for (size_t i = 0; i < x.shape(1); ++i) {
+                    for (size_t j = 0; j < x.shape(1); ++j) {
+                        b(m, i) += A(m * x.shape(1) + i, n * x.shape(1) + j) * x(n, j);
+                    }
+                }
+            }
+        }
+
+        xt::xtensor<size_t, 2> conn = xt::zeros<size_t>({1, 5});
+        xt::xtensor<size_t, 2> dofs = xt::arange<size_t>(10).reshape({5, 2});
+        xt::xtensor<size_t, 1> iip = xt::arange<size_t>(5);
+
+        GooseFEM::MatrixPartitioned K(conn, dofs, iip);
+        GooseFEM::MatrixPartitionedSolver<> Solver;
+        K.set(xt::arange<size_t>(10), xt::arange<size_t>(10), a);
+        K.add(xt::arange<size_t>(10), xt::arange<size_t>(10), xt::transpose(a));
+
+        REQUIRE(xt::allclose(A, K.Todense()));
+        REQUIRE(xt::allclose(b, K.Dot(x)));
+        REQUIRE(xt::allclose(x, Solver.Solve(K, b, x)));
+    }
+
+    SECTION("symmetric storage")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(3, 3);
+
+        size_t nelem = mesh.nelem();
+        size_t n = mesh.nne() * mesh.ndim();
+        auto dofs = mesh.dofs();
+        auto bottom = mesh.nodesBottomEdge();
+        xt::xtensor<size_t, 1> iip = xt::flatten(xt::view(dofs, xt::keep(bottom), xt::all()));
+
+        xt::xtensor<double, 3> a = support::random_spd(nelem, n);
+
+        GooseFEM::MatrixPartitioned A(mesh.conn(), dofs, iip);
+        GooseFEM::MatrixPartitioned S(mesh.conn(), dofs, iip, true);
+        GooseFEM::MatrixPartitionedSolver<> Solver;
+        GooseFEM::MatrixPartitionedSolver<> SSolver;
+        A.assemble(a);
+        S.assemble(a);
+
+        xt::xtensor<double, 1> x = xt::random::rand<double>({mesh.nnode() * mesh.ndim()});
+        xt::xtensor<double, 2> X = xt::random::rand<double>({mesh.nnode(), mesh.ndim()});
+        xt::xtensor<double, 2> B = xt::random::rand<double>({mesh.nnode(), mesh.ndim()});
+        xt::xtensor<double, 1> x_u = xt::random::rand<double>({A.nnu()});
+        xt::xtensor<double, 1> x_p = xt::random::rand<double>({A.nnp()});
+        xt::xtensor<double, 1> b_u = xt::random::rand<double>({A.nnu()});
+
+        REQUIRE(S.symmetric());
+        REQUIRE(xt::allclose(A.Todense(), S.Todense()));
+        REQUIRE(xt::allclose(A.Dot(x), S.Dot(x)));
+        REQUIRE(xt::allclose(A.Dot(X), S.Dot(X)));
+        REQUIRE(xt::allclose(A.Dot_u(x_u, x_p), S.Dot_u(x_u, x_p)));
+        REQUIRE(xt::allclose(A.Reaction(X, B), S.Reaction(X, B)));
+        REQUIRE(xt::allclose(A.Reaction_p(x_u, x_p), S.Reaction_p(x_u, x_p)));
+        REQUIRE(xt::allclose(A.Residual_u(x_u, x_p, b_u), b_u - A.Dot_u(x_u, x_p)));
+        REQUIRE(xt::allclose(S.Residual_u(x_u, x_p, b_u), b_u - A.Dot_u(x_u, x_p)));
+        REQUIRE(xt::allclose(Solver.Solve(A, B, X), SSolver.Solve(S, B, X)));
+        REQUIRE(xt::allclose(Solver.Effective_pp(A), SSolver.Effective_pp(S)));
+    }
+
+    SECTION("Effective_pp - prescribed DOFs not coupled to unknown DOFs")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(3, 3);
+
+        size_t nelem = mesh.nelem();
+        size_t n = mesh.nne() * mesh.ndim();
+        size_t ndof = mesh.nnode() * mesh.ndim();
+        auto dofs = mesh.dofs();
+
+        // the lowest two rows of nodes: the lowest row only couples to prescribed DOFs
+        xt::xtensor<size_t, 1> iip = xt::flatten(xt::view(dofs, xt::range(0, 8), xt::all()));
+
+        xt::xtensor<double, 3> a = support::random_spd(nelem, n);
+
+        GooseFEM::MatrixPartitioned A(mesh.conn(), dofs, iip);
+        GooseFEM::MatrixPartitioned S(mesh.conn(), dofs, iip, true);
+        GooseFEM::MatrixPartitionedSolver<> Solver;
+        GooseFEM::MatrixPartitionedSolver<> SSolver;
+        A.assemble(a);
+        S.assemble(a);
+
+        // reference: dense K_pp = A_pp - A_pu * A_uu^-1 * A_up
+
+        xt::xtensor<double, 2> k = A.Todense();
+        Eigen::MatrixXd K = Eigen::Map<Eigen::Matrix<double, -1, -1, Eigen::RowMajor>>(
+            k.data(), ndof, ndof);
+
+        auto iiu = A.iiu();
+        size_t nnu = iiu.size();
+        size_t nnp = iip.size();
+        Eigen::MatrixXd Kuu(nnu, nnu), Kup(nnu, nnp), Kpu(nnp, nnu), Kpp(nnp, nnp);
+
+        for (size_t i = 0; i < nnu; ++i) {
+            for (size_t j = 0; j < nnu; ++j) {
+                Kuu(i, j) = K(iiu(i), iiu(j));
+            }
+            for (size_t j = 0; j < nnp; ++j) {
+                Kup(i, j) = K(iiu(i), iip(j));
+                Kpu(j, i) = K(iip(j), iiu(i));
+            }
+        }
+
+        for (size_t i = 0; i < nnp; ++i) {
+            for (size_t j = 0; j < nnp; ++j) {
+                Kpp(i, j) = K(iip(i), iip(j));
+            }
+        }
+
+        Eigen::MatrixXd Keff = Kpp - Kpu * Kuu.ldlt().solve(Kup);
+        xt::xtensor<double, 2> K_pp = Solver.Effective_pp(A);
+        xt::xtensor<double, 2> S_pp = SSolver.Effective_pp(S);
+
+        for (size_t i = 0; i < nnp; ++i) {
+            for (size_t j = 0; j < nnp; ++j) {
+                REQUIRE_THAT(K_pp(i, j), Catch::WithinAbs(Keff(i, j), 1.e-10));
+                REQUIRE_THAT(S_pp(i, j), Catch::WithinAbs(Keff(i, j), 1.e-10));
+            }
+        }
+    }
+}
@@ -0,0 +1,323 @@
+#include <catch2/catch.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xmath.hpp>
+#include <Eigen/Eigen>
+#include <GooseFEM/GooseFEM.h>
+#include "support.h"
+
+#define ISCLOSE(a,b) REQUIRE_THAT((a), Catch::WithinAbs((b), 1.e-12));
+
+TEST_CASE("GooseFEM::MatrixPartitionedTyings", "MatrixPartitionedTyings.h")
+{
+    SECTION("solve - periodic, compare to C^T * A * C")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(3, 3);
+
+        size_t nne = mesh.nne();
+        size_t ndim = mesh.ndim();
+        size_t nelem = mesh.nelem();
+        size_t n = nne * ndim;
+
+        GooseFEM::Tyings::Control control(mesh.coor(), mesh.dofs());
+        xt::xtensor<double, 2> coor = control.coor();
+        xt::xtensor<size_t, 2> control_dofs = control.controlDofs();
+        xt::xtensor<size_t, 1> iip = xt::flatten(control_dofs);
+
+        GooseFEM::Tyings::Periodic tyings(
+            coor, control.dofs(), control_dofs, mesh.nodesPeriodic(), iip);
+
+        xt::xtensor<size_t, 2> dofs = tyings.dofs();
+        size_t ndof = tyings.nni() + tyings.nnd();
+        size_t nnu = tyings.nnu();
+        size_t nnp = tyings.nnp();
+        size_t nni = tyings.nni();
+
+        // symmetric positive definite element matrices
+
+        xt::random::seed(0);
+        xt::xtensor<double, 3> a = support::random_spd(nelem, n);
+
+        xt::xtensor<double, 2> b = xt::random::rand<double>({coor.shape(0), ndim});
+        xt::xtensor<double, 2> x = xt::zeros<double>({coor.shape(0), ndim});
+        xt::view(x, xt::keep(control.controlNodes()), xt::all()) = 0.1;
+
+        GooseFEM::MatrixPartitionedTyings A(mesh.conn(), dofs, tyings.Cdu(), tyings.Cdp());
+        GooseFEM::MatrixPartitionedTyingsSolver<> solver;
+        A.assemble(a);
+        xt::xtensor<double, 2> X = solver.Solve(A, b, x);
+
+        // reference: A' = C^T * A * C, with C = [I; C_di]
+
+        GooseFEM::Matrix K(mesh.conn(), dofs);
+        K.assemble(a);
+        xt::xtensor<double, 2> k = K.Todense();
+        Eigen::MatrixXd Kd = Eigen::Map<Eigen::Matrix<double, -1, -1, Eigen::RowMajor>>(
+            k.data(), ndof, ndof);
+
+        Eigen::MatrixXd C = Eigen::MatrixXd::Zero(ndof, nni);
+        C.topRows(nni).setIdentity();
+        C.bottomRows(ndof - nni) = Eigen::MatrixXd(tyings.Cdi());
+
+        xt::xtensor<double, 1> bd = xt::zeros<double>({ndof});
+        xt::xtensor<double, 1> xd = xt::zeros<double>({ndof});
+        for (size_t m = 0; m < coor.shape(0); ++m) {
+            for (size_t i = 0; i < ndim; ++i) {
+                bd(dofs(m, i)) = b(m, i);
+                xd(dofs(m, i)) = x(m, i);
+            }
+        }
+
+        Eigen::MatrixXd Kc = C.transpose() * Kd * C;
+        Eigen::VectorXd bc = C.transpose() * Eigen::Map<Eigen::VectorXd>(bd.data(), ndof);
+        Eigen::VectorXd xp = Eigen::Map<Eigen::VectorXd>(xd.data() + nnu, nnp);
+
+        Eigen::VectorXd xu = Kc.topLeftCorner(nnu, nnu).ldlt().solve(
+            bc.head(nnu) - Kc.topRightCorner(nnu, nnp) * xp);
+
+        Eigen::VectorXd xi(nni);
+        xi << xu, xp;
+        Eigen::VectorXd xall = C * xi;
+
+        for (size_t m = 0; m < coor.shape(0); ++m) {
+            for (size_t i = 0; i < ndim; ++i) {
+                ISCLOSE(X(m, i), xall(dofs(m, i)));
+            }
+        }
+
+        // "dofval" solve (re-using the solver's workspace)
+
+        xt::xtensor<double, 1> Xd = solver.Solve(A, bd, xd);
+
+        for (size_t m = 0; m < coor.shape(0); ++m) {
+            for (size_t i = 0; i < ndim; ++i) {
+                ISCLOSE(Xd(dofs(m, i)), xall(dofs(m, i)));
+            }
+        }
+
+        // effective stiffness: K_pp = Kc_pp - Kc_pu * Kc_uu^-1 * Kc_up
+
+        Eigen::MatrixXd Kpp = Kc.bottomRightCorner(nnp, nnp) - Kc.bottomLeftCorner(nnp, nnu) *
+            Kc.topLeftCorner(nnu, nnu).ldlt().solve(Kc.topRightCorner(nnu, nnp));
+
+        xt::xtensor<double, 2> K_pp = solver.Effective_pp(A);
+
+        for (size_t i = 0; i < nnp; ++i) {
+            for (size_t j = 0; j < nnp; ++j) {
+                REQUIRE_THAT(K_pp(i, j), Catch::WithinAbs(Kpp(i, j), 1.e-10));
+            }
+        }
+    }
+
+    SECTION("solve - dofval and solve_u condense the dependent right-hand-side")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(3, 3);
+
+        size_t ndim = mesh.ndim();
+        size_t nelem = mesh.nelem();
+        size_t n = mesh.nne() * ndim;
+
+        GooseFEM::Tyings::Control control(mesh.coor(), mesh.dofs());
+        xt::xtensor<double, 2> coor = control.coor();
+        xt::xtensor<size_t, 2> control_dofs = control.controlDofs();
+        xt::xtensor<size_t, 1> iip = xt::flatten(control_dofs);
+
+        GooseFEM::Tyings::Periodic tyings(
+            coor, control.dofs(), control_dofs, mesh.nodesPeriodic(), iip);
+
+        xt::xtensor<size_t, 2> dofs = tyings.dofs();
+        size_t nnode = coor.shape(0);
+        size_t ndof = tyings.nni() + tyings.nnd();
+        size_t nnu = tyings.nnu();
+        size_t nni = tyings.nni();
+
+        xt::random::seed(0);
+        xt::xtensor<double, 3> a = support::random_spd(nelem, n);
+
+        GooseFEM::MatrixPartitionedTyings A(mesh.conn(), dofs, tyings.Cdu(), tyings.Cdp());
+        GooseFEM::MatrixPartitionedTyingsSolver<> solver;
+        A.assemble(a);
+
+        // reference: the "nodevec" solve, which has always included "b_d"
+
+        xt::xtensor<double, 2> b = xt::random::rand<double>({nnode, ndim});
+        xt::xtensor<double, 2> x = xt::random::rand<double>({nnode, ndim});
+        xt::xtensor<double, 2> X = solver.Solve(A, b, x);
+
+        xt::xtensor<double, 1> bd = xt::zeros<double>({ndof});
+        xt::xtensor<double, 1> xd = xt::zeros<double>({ndof});
+
+        for (size_t m = 0; m < nnode; ++m) {
+            for (size_t i = 0; i < ndim; ++i) {
+                bd(dofs(m, i)) = b(m, i);
+                xd(dofs(m, i)) = x(m, i);
+            }
+        }
+
+        xt::xtensor<double, 1> b_u = xt::view(bd, xt::range(0, nnu));
+        xt::xtensor<double, 1> x_p = xt::view(xd, xt::range(nnu, nni));
+        xt::xtensor<double, 1> b_d = xt::view(bd, xt::range(nni, ndof));
+        xt::xtensor<double, 1> zero_d = xt::zeros<double>({tyings.nnd()});
+
+        xt::xtensor<double, 1> Xd = solver.Solve(A, bd, xd);
+        xt::xtensor<double, 1> x_u = solver.Solve_u(A, b_u, b_d, x_p);
+
+        for (size_t m = 0; m < nnode; ++m) {
+            for (size_t i = 0; i < ndim; ++i) {
+                ISCLOSE(Xd(dofs(m, i)), X(m, i));
+                if (dofs(m, i) < nnu) {
+                    ISCLOSE(x_u(dofs(m, i)), X(m, i));
+                }
+            }
+        }
+
+        // "b_d" contributes to the solution
+        REQUIRE(!xt::allclose(x_u, solver.Solve_u(A, b_u, zero_d, x_p)));
+    }
+
+    SECTION("solve - dofval reads the dependent DOFs of the right-hand-side")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(3, 3);
+
+        size_t ndim = mesh.ndim();
+        size_t n = mesh.nne() * ndim;
+
+        GooseFEM::Tyings::Control control(mesh.coor(), mesh.dofs());
+        xt::xtensor<double, 2> coor = control.coor();
+        xt::xtensor<size_t, 2> control_dofs = control.controlDofs();
+        xt::xtensor<size_t, 1> iip = xt::flatten(control_dofs);
+
+        GooseFEM::Tyings::Periodic tyings(
+            coor, control.dofs(), control_dofs, mesh.nodesPeriodic(), iip);
+
+        xt::xtensor<size_t, 2> dofs = tyings.dofs();
+        size_t nnode = coor.shape(0);
+        size_t ndof = tyings.nni() + tyings.nnd();
+        size_t nnu = tyings.nnu();
+        size_t nni = tyings.nni();
+
+        xt::random::seed(0);
+        xt::xtensor<double, 3> a = support::random_spd(mesh.nelem(), n);
+
+        GooseFEM::MatrixPartitionedTyings A(mesh.conn(), dofs, tyings.Cdu(), tyings.Cdp());
+        GooseFEM::MatrixPartitionedTyingsSolver<> solver;
+        A.assemble(a);
+
+        // "b" only on the dependent DOFs, entries of "b" on the prescribed DOFs are never used
+
+        xt::xtensor<double, 1> bd = xt::zeros<double>({ndof});
+        xt::xtensor<double, 1> xd = xt::zeros<double>({ndof});
+        xt::view(bd, xt::range(nni, ndof)) = xt::random::rand<double>({ndof - nni});
+        xt::view(bd, xt::range(nnu, nni)) = 1e3;
+        xt::view(xd, xt::range(nnu, nni)) = xt::random::rand<double>({nni - nnu});
+
+        xt::xtensor<double, 2> b = xt::empty<double>({nnode, ndim});
+        xt::xtensor<double, 2> x = xt::empty<double>({nnode, ndim});
+
+        for (size_t m = 0; m < nnode; ++m) {
+            for (size_t i = 0; i < ndim; ++i) {
+                b(m, i) = bd(dofs(m, i));
+                x(m, i) = xd(dofs(m, i));
+            }
+        }
+
+        xt::xtensor<double, 1> Xd = solver.Solve(A, bd, xd);
+        xt::xtensor<double, 2> X = solver.Solve(A, b, x);
+
+        for (size_t m = 0; m < nnode; ++m) {
+            for (size_t i = 0; i < ndim; ++i) {
+                ISCLOSE(Xd(dofs(m, i)), X(m, i));
+            }
+        }
+    }
+
+    SECTION("solve - batch of right-hand-sides")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(3, 3);
+
+        size_t nne = mesh.nne();
+        size_t ndim = mesh.ndim();
+        size_t nelem = mesh.nelem();
+        size_t n = nne * ndim;
+        size_t nrhs = 3;
+
+        GooseFEM::Tyings::Control control(mesh.coor(), mesh.dofs());
+        xt::xtensor<double, 2> coor = control.coor();
+        xt::xtensor<size_t, 2> control_dofs = control.controlDofs();
+        xt::xtensor<size_t, 1> iip = xt::flatten(control_dofs);
+
+        GooseFEM::Tyings::Periodic tyings(
+            coor, control.dofs(), control_dofs, mesh.nodesPeriodic(), iip);
+
+        xt::xtensor<size_t, 2> dofs = tyings.dofs();
+        size_t nnode = coor.shape(0);
+
+        xt::random::seed(0);
+        xt::xtensor<double, 3> a = support::random_spd(nelem, n);
+
+        GooseFEM::MatrixPartitionedTyings A(mesh.conn(), dofs, tyings.Cdu(), tyings.Cdp());
+        GooseFEM::MatrixPartitionedTyingsSolver<> solver;
+        A.assemble(a);
+
+        xt::xtensor<double, 3> b = xt::random::rand<double>({nrhs, nnode, ndim});
+        xt::xtensor<double, 3> x = xt::random::rand<double>({nrhs, nnode, ndim});
+        xt::xtensor<double, 3> X = solver.Solve(A, b, x);
+
+        xt::xtensor<double, 2> b_u = xt::random::rand<double>({nrhs, tyings.nnu()});
+        xt::xtensor<double, 2> b_d = xt::random::rand<double>({nrhs, tyings.nnd()});
+        xt::xtensor<double, 2> x_p = xt::random::rand<double>({nrhs, tyings.nnp()});
+        xt::xtensor<double, 2> x_u = solver.Solve_u(A, b_u, b_d, x_p);
+
+        for (size_t r = 0; r < nrhs; ++r) {
+            xt::xtensor<double, 2> br = xt::view(b, r, xt::all(), xt::all());
+            xt::xtensor<double, 2> xr = xt::view(x, r, xt::all(), xt::all());
+            xt::xtensor<double, 1> bu = xt::view(b_u, r, xt::all());
+            xt::xtensor<double, 1> bd = xt::view(b_d, r, xt::all());
+            xt::xtensor<double, 1> xp = xt::view(x_p, r, xt::all());
+            REQUIRE(xt::allclose(xt::view(X, r, xt::all(), xt::all()), solver.Solve(A, br, xr)));
+            REQUIRE(xt::allclose(xt::view(x_u, r, xt::all()), solver.Solve_u(A, bu, bd, xp)));
+        }
+    }
+
+    SECTION("solve - Schur complement of control DOFs")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(4, 4);
+
+        size_t nne = mesh.nne();
+        size_t ndim = mesh.ndim();
+        size_t nelem = mesh.nelem();
+        size_t n = nne * ndim;
+
+        // control DOFs are unknown: they couple to all dependent DOFs
+
+        GooseFEM::Tyings::Control control(mesh.coor(), mesh.dofs());
+        xt::xtensor<double, 2> coor = control.coor();
+        xt::xtensor<size_t, 2> control_dofs = control.controlDofs();
+        xt::xtensor<size_t, 1> iip = xt::flatten(xt::view(control_dofs, xt::range(0, 1), xt::all()));
+
+        GooseFEM::Tyings::Periodic tyings(
+            coor, control.dofs(), control_dofs, mesh.nodesPeriodic(), iip);
+
+        xt::xtensor<size_t, 2> dofs = tyings.dofs();
+
+        xt::random::seed(0);
+        xt::xtensor<double, 3> a = support::random_spd(nelem, n);
+
+        xt::xtensor<double, 2> b = xt::random::rand<double>({coor.shape(0), ndim});
+        xt::xtensor<double, 2> x = xt::zeros<double>({coor.shape(0), ndim});
+        xt::view(x, xt::keep(control.controlNodes()), xt::all()) = 0.1;
+
+        GooseFEM::MatrixPartitionedTyings A(mesh.conn(), dofs, tyings.Cdu(), tyings.Cdp());
+        A.assemble(a);
+
+        GooseFEM::MatrixPartitionedTyingsSolver<> solver;
+        GooseFEM::MatrixPartitionedTyingsSolver<> schur(tyings.control());
+
+        REQUIRE(xt::allclose(solver.Solve(A, b, x), schur.Solve(A, b, x)));
+
+        xt::xtensor<double, 1> b_u = xt::random::rand<double>({tyings.nnu()});
+        xt::xtensor<double, 1> b_d = xt::zeros<double>({tyings.nnd()});
+        xt::xtensor<double, 1> x_p = xt::random::rand<double>({tyings.nnp()});
+
+        REQUIRE(xt::allclose(solver.Solve_u(A, b_u, b_d, x_p), schur.Solve_u(A, b_u, b_d, x_p)));
+    }
+}
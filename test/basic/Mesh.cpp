@@ -127,6 +127,109 @@ TEST_CASE("GooseFEM::Mesh", "Mesh.h")
         REQUIRE(xt::allclose(GooseFEM::Mesh::centers(mesh.coor(), mesh.conn()), c));
     }
 
+    SECTION("partitionRCB")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(8, 8);
+        auto part = GooseFEM::Mesh::partitionRCB(mesh.coor(), mesh.conn(), 4);
+        GooseFEM::Mesh::Partition partition(mesh.conn(), part);
+
+        REQUIRE(partition.nparts() == 4);
+
+        for (size_t p = 0; p < 4; ++p) {
+            REQUIRE(partition.elements(p).size() == 16);
+        }
+
+        REQUIRE(partition.nodesInterface().size() == 17);
+    }
+
+    SECTION("partitionGraph")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(20, 20);
+        auto part = GooseFEM::Mesh::partitionGraph(mesh.conn(), 4, 0.03);
+        GooseFEM::Mesh::Partition partition(mesh.conn(), part);
+
+        REQUIRE(partition.nparts() == 4);
+
+        for (size_t p = 0; p < 4; ++p) {
+            REQUIRE(partition.elements(p).size() > 0);
+            REQUIRE(partition.elements(p).size() <= 103);
+        }
+
+        REQUIRE(partition.nodesInterface().size() < mesh.nnode() / 4);
+    }
+
+    SECTION("Partition - nodesInterface with shared DOFs")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(4, 4);
+        auto conn = mesh.conn();
+
+        // left and right half
+        xt::xtensor<size_t, 1> part = xt::zeros<size_t>({mesh.nelem()});
+        for (size_t e = 0; e < mesh.nelem(); ++e) {
+            part(e) = e % 4 < 2 ? 0 : 1;
+        }
+
+        GooseFEM::Mesh::Partition partition(conn, part);
+
+        // without shared DOFs: the interface nodes
+        for (size_t p = 0; p < 2; ++p) {
+            REQUIRE(xt::all(xt::equal(
+                partition.nodesInterface(p, mesh.dofs()), partition.nodesInterface(p))));
+        }
+
+        // periodic: also the left edge (part 0) / the right edge (part 1)
+        auto dofs = mesh.dofsPeriodic();
+        auto left = mesh.nodesLeftEdge();
+        auto right = mesh.nodesRightEdge();
+        auto halo0 = partition.nodesInterface(0, dofs);
+        auto halo1 = partition.nodesInterface(1, dofs);
+
+        for (size_t i = 0; i < left.size(); ++i) {
+            REQUIRE(std::binary_search(halo0.begin(), halo0.end(), left(i)));
+            REQUIRE(std::binary_search(halo1.begin(), halo1.end(), right(i)));
+        }
+
+        REQUIRE(halo0.size() == partition.nodesInterface(0).size() + left.size());
+        REQUIRE(halo1.size() == partition.nodesInterface(1).size() + right.size());
+    }
+
+    SECTION("Partition - renumber")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(9, 7);
+        auto conn = mesh.conn();
+        auto part = GooseFEM::Mesh::partitionGraph(conn, 3);
+        GooseFEM::Mesh::Partition partition(conn, part);
+
+        auto elemmap = partition.elemmap();
+        auto nodemap = partition.nodemap();
+        auto offset = partition.elemOffset();
+        auto index = partition.reorder().index();
+
+        REQUIRE(xt::all(xt::equal(xt::sort(elemmap), xt::arange<size_t>(mesh.nelem()))));
+        REQUIRE(xt::all(xt::equal(xt::sort(nodemap), xt::arange<size_t>(mesh.nnode()))));
+        REQUIRE(xt::all(xt::equal(xt::view(index, xt::keep(nodemap)), xt::arange<size_t>(mesh.nnode()))));
+        REQUIRE(offset(3) == mesh.nelem());
+
+        // after renumbering: elements of a part only use its interior nodes, or interface nodes
+        xt::xtensor<size_t, 2> renum = partition.reorder().apply(conn);
+        renum = xt::view(renum, xt::keep(elemmap), xt::all());
+        size_t ninterface = partition.nodesInterface().size();
+        size_t n0 = 0;
+
+        for (size_t p = 0; p < 3; ++p) {
+            size_t n1 = n0 + partition.nodesInterior(p).size();
+            for (size_t e = offset(p); e < offset(p + 1); ++e) {
+                for (size_t m = 0; m < mesh.nne(); ++m) {
+                    size_t n = renum(e, m);
+                    REQUIRE(((n >= n0 && n < n1) || n >= mesh.nnode() - ninterface));
+                }
+            }
+            REQUIRE(xt::all(xt::equal(
+                xt::view(elemmap, xt::range(offset(p), offset(p + 1))), partition.elements(p))));
+            n0 = n1;
+        }
+    }
+
     SECTION("elem2node")
     {
         GooseFEM::Mesh::Quad4::Regular mesh(3, 3);
@@ -0,0 +1,101 @@
+#include <catch2/catch.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xmath.hpp>
+#include <Eigen/Eigen>
+#include <GooseFEM/GooseFEM.h>
+
+using MultigridSolver = GooseFEM::LinearSolver::ConjugateGradientMultigrid;
+
+// isotropic linear elastic stiffness (bulk modulus 1, shear modulus 1/2), per element
+inline xt::xtensor<double, 3> quad4_elasticity(
+    const xt::xtensor<double, 2>& coor,
+    const xt::xtensor<size_t, 2>& conn,
+    const xt::xtensor<size_t, 2>& dofs)
+{
+    size_t nd = 2;
+    double K = 1.0;
+    double G = 0.5;
+
+    GooseFEM::Vector vector(conn, dofs);
+    GooseFEM::Element::Quad4::Quadrature quad(vector.AsElement(coor));
+    xt::xtensor<double, 6> C = xt::empty<double>({conn.shape(0), quad.nip(), nd, nd, nd, nd});
+
+    for (size_t e = 0; e < conn.shape(0); ++e) {
+        for (size_t q = 0; q < quad.nip(); ++q) {
+            for (size_t i = 0; i < nd; ++i) {
+                for (size_t j = 0; j < nd; ++j) {
+                    for (size_t k = 0; k < nd; ++k) {
+                        for (size_t l = 0; l < nd; ++l) {
+                            C(e, q, i, j, k, l) = (K - G) * (i == j) * (k == l) +
+                                                  G * ((i == k) * (j == l) + (i == l) * (j == k));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return quad.Int_gradN_dot_tensor4_dot_gradNT_dV(C);
+}
+
+// periodic square, origin fixed: compare to the direct solver, return the number of iterations
+inline size_t solve_periodic(size_t n)
+{
+    GooseFEM::Mesh::Quad4::Regular mesh(n, n);
+    auto coor = mesh.coor();
+    auto conn = mesh.conn();
+    auto dofs = mesh.dofsPeriodic();
+    xt::xtensor<size_t, 1> iip = xt::view(dofs, mesh.nodesOrigin(), xt::all());
+
+    GooseFEM::MatrixPartitioned A(conn, dofs, iip);
+    A.assemble(quad4_elasticity(coor, conn, dofs));
+
+    xt::random::seed(0);
+    xt::xtensor<double, 2> b = xt::random::rand<double>(coor.shape());
+    xt::xtensor<double, 2> x = xt::zeros<double>(coor.shape());
+
+    GooseFEM::MatrixPartitionedSolver<> direct;
+    GooseFEM::MatrixPartitionedSolver<MultigridSolver> solver;
+    solver.solver().setTolerance(1e-12);
+    solver.solver().preconditioner().setMesh(mesh, dofs, A.iiu());
+
+    REQUIRE(xt::allclose(solver.Solve(A, b, x), direct.Solve(A, b, x)));
+    REQUIRE(solver.solver().preconditioner().levels() > 2);
+
+    return static_cast<size_t>(solver.solver().iterations());
+}
+
+TEST_CASE("GooseFEM::GeometricMultigrid", "Multigrid.h")
+{
+    SECTION("MatrixPartitioned - periodic, mesh-size independent iterations")
+    {
+        size_t coarse = solve_periodic(8);
+        size_t fine = solve_periodic(64);
+        REQUIRE(fine < 30);
+        REQUIRE(fine <= coarse + 5);
+    }
+
+    SECTION("MatrixPartitioned - clamped, limited number of levels")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(12, 6);
+        auto coor = mesh.coor();
+        auto conn = mesh.conn();
+        auto dofs = mesh.dofs();
+        xt::xtensor<size_t, 1> iip = xt::flatten(xt::view(dofs, xt::keep(mesh.nodesLeftEdge())));
+
+        GooseFEM::MatrixPartitioned A(conn, dofs, iip, true);
+        A.assemble(quad4_elasticity(coor, conn, dofs));
+
+        xt::xtensor<double, 2> b = xt::random::rand<double>(coor.shape());
+        xt::xtensor<double, 2> x = xt::random::rand<double>(coor.shape());
+
+        GooseFEM::MatrixPartitionedSolver<> direct;
+        GooseFEM::MatrixPartitionedSolver<MultigridSolver> solver;
+        solver.solver().setTolerance(1e-12);
+        solver.solver().preconditioner().setMesh(mesh, dofs, A.iiu(), 2);
+
+        REQUIRE(xt::allclose(solver.Solve(A, b, x), direct.Solve(A, b, x)));
+        REQUIRE(solver.solver().preconditioner().levels() == 2);
+        REQUIRE(solver.solver().preconditioner().rows(1) < A.iiu().size() / 3);
+    }
+}
@@ -166,4 +166,44 @@ TEST_CASE("GooseFEM::Vector", "Vector.h")
         ISCLOSE(F(6), 0);
         ISCLOSE(F(7), 0);
     }
+
+    SECTION("element list - asElement, assembleDofs")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(3, 3);
+        GooseFEM::Vector vector(mesh.conn(), mesh.dofsPeriodic());
+
+        xt::xtensor<size_t, 1> elem = {0, 4, 8};
+        xt::xtensor<double, 1> u = xt::random::rand<double>({vector.ndof()});
+        xt::xtensor<double, 3> ue = vector.AllocateElemvec(0.0);
+        vector.asElement(elem, u, ue);
+
+        xt::xtensor<double, 3> ue_elem = xt::zeros<double>(ue.shape());
+        xt::view(ue_elem, xt::keep(elem)) = xt::view(vector.AsElement(u), xt::keep(elem));
+
+        REQUIRE(xt::allclose(ue, ue_elem));
+
+        xt::xtensor<double, 1> f = xt::random::rand<double>({vector.ndof()});
+        xt::xtensor<double, 1> F = f + vector.AssembleDofs(ue_elem);
+        vector.assembleDofs(elem, ue, f, 1.0);
+
+        REQUIRE(xt::allclose(f, F));
+    }
+
+    SECTION("accumulate - assembleDofs, assembleNode")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(3, 3);
+        GooseFEM::Vector vector(mesh.conn(), mesh.dofsPeriodic());
+
+        xt::xtensor<double, 3> fe = xt::random::rand<double>(vector.AllocateElemvec().shape());
+        xt::xtensor<double, 1> f = xt::random::rand<double>({vector.ndof()});
+        xt::xtensor<double, 2> fn = vector.AsNode(f);
+
+        xt::xtensor<double, 1> F = f - 2.0 * vector.AssembleDofs(fe);
+        xt::xtensor<double, 2> Fn = fn - 2.0 * vector.AssembleNode(fe);
+        vector.assembleDofs(fe, f, -2.0);
+        vector.assembleNode(fe, fn, -2.0);
+
+        REQUIRE(xt::allclose(f, F));
+        REQUIRE(xt::allclose(fn, Fn));
+    }
 }
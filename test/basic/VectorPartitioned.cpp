@@ -65,4 +65,33 @@ TEST_CASE("GooseFEM::VectorPartitioned", "VectorPartitioned.h")
         vector.copy_p(u, v);
         REQUIRE(xt::allclose(u, v));
     }
+
+    SECTION("shared topology")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(9, 9);
+
+        auto dofs = mesh.dofs();
+        auto nodesTop = mesh.nodesTopEdge();
+        auto nodesBottom = mesh.nodesBottomEdge();
+
+        size_t ni = nodesBottom.size();
+        xt::xtensor<size_t, 1> iip = xt::empty<size_t>({2 * ni});
+        xt::view(iip, xt::range(0 * ni, 1 * ni)) = xt::view(dofs, xt::keep(nodesTop), 1);
+        xt::view(iip, xt::range(1 * ni, 2 * ni)) = xt::view(dofs, xt::keep(nodesBottom), 1);
+
+        GooseFEM::Topology topology(mesh.conn(), dofs);
+        GooseFEM::Vector vector(topology);
+        GooseFEM::VectorPartitioned partitioned(topology.Partition(iip));
+        GooseFEM::VectorPartitioned copy(mesh.conn(), dofs, iip);
+
+        REQUIRE(&vector.conn() == &topology.conn());
+        REQUIRE(&vector.dofs() == &partitioned.dofs());
+        REQUIRE(xt::all(xt::equal(partitioned.iiu(), copy.iiu())));
+        REQUIRE(xt::all(xt::equal(partitioned.iip(), copy.iip())));
+
+        xt::xtensor<double, 2> u = xt::random::randn<double>({mesh.nnode(), mesh.ndim()});
+        REQUIRE(xt::allclose(partitioned.AsDofs_u(u), copy.AsDofs_u(u)));
+        REQUIRE(xt::allclose(partitioned.AsDofs_p(u), copy.AsDofs_p(u)));
+        REQUIRE(xt::allclose(vector.AsElement(u), copy.AsElement(u)));
+    }
 }
@@ -0,0 +1,32 @@
+#ifndef GOOSEFEM_TEST_SUPPORT_H
+#define GOOSEFEM_TEST_SUPPORT_H
+
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xtensor.hpp>
+
+namespace support {
+
+// Random symmetric positive definite element matrices [nelem, n, n]:
+// a(e) = n * I + r * r^T, with "r" random [n, n] (seed with "xt::random::seed" for reproducibility)
+inline xt::xtensor<double, 3> random_spd(size_t nelem, size_t n)
+{
+    xt::xtensor<double, 3> a = xt::zeros<double>({nelem, n, n});
+
+    for (size_t e = 0; e < nelem; ++e) {
+        xt::xtensor<double, 2> r = xt::random::rand<double>({n, n});
+        for (size_t i = 0; i < n; ++i) {
+            a(e, i, i) += static_cast<double>(n);
+            for (size_t j = 0; j < n; ++j) {
+                for (size_t k = 0; k < n; ++k) {
+                    a(e, i, j) += r(i, k) * r(j, k);
+                }
+            }
+        }
+    }
+
+    return a;
+}
+
+} // namespace support
+
+#endif
@@ -0,0 +1,87 @@
+/*
+
+Compare the bandwidth of typical element kernels on arrays that are allocated (and thus placed in
+memory) by the main thread, with arrays that are initialised in parallel ("first-touch").
+The difference is only visible on multi-socket (NUMA) systems, with threads pinned to cores:
+
+    OMP_PROC_BIND=close OMP_PLACES=cores ./first-touch 1000
+
+*/
+
+#include <GooseFEM/GooseFEM.h>
+#include <chrono>
+#include <omp.h>
+
+template <class F>
+double timeit(F func, size_t nrepeat)
+{
+    func(); // warm-up
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    for (size_t i = 0; i < nrepeat; ++i) {
+        func();
+    }
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(t1 - t0).count() / static_cast<double>(nrepeat);
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? std::stoul(argv[1]) : 1000;
+    size_t nrepeat = 20;
+
+    GooseFEM::Mesh::Quad4::Regular mesh(n, n);
+    GooseFEM::Vector vector(mesh.conn(), mesh.dofs());
+    GooseFEM::Element::Quad4::Quadrature quad(vector.AsElement(mesh.coor()));
+
+    size_t nelem = mesh.nelem();
+    size_t nne = mesh.nne();
+    size_t ndim = mesh.ndim();
+    size_t nip = quad.nip();
+
+    xt::xtensor<double, 2> u = xt::ones<double>({mesh.nnode(), ndim});
+
+    // bytes moved per call (read + write), dominated by the per-element arrays
+    double bytes_grad = 8.0 * nelem * (nne * ndim + nip * nne * ndim + nip * ndim * ndim);
+    double bytes_int = 8.0 * nelem * (nip * ndim * ndim + nip * nne * ndim + 2 * nne * ndim);
+
+    std::cout << "nelem = " << nelem << ", threads = " << omp_get_max_threads() << std::endl;
+
+    // allocated and initialised on the main thread
+
+    {
+        xt::xtensor<double, 3> ue = xt::zeros<double>({nelem, nne, ndim});
+        xt::xtensor<double, 3> fe = xt::zeros<double>({nelem, nne, ndim});
+        xt::xtensor<double, 4> eps = xt::zeros<double>({nelem, nip, ndim, ndim});
+
+        vector.asElement(u, ue);
+        double t_grad = timeit([&]() { quad.symGradN_vector(ue, eps); }, nrepeat);
+        double t_int = timeit([&]() { quad.int_gradN_dot_tensor2_dV(eps, fe); }, nrepeat);
+
+        std::cout << "main thread : "
+                  << "symGradN_vector " << bytes_grad / t_grad * 1e-9 << " GB/s, "
+                  << "int_gradN_dot_tensor2_dV " << bytes_int / t_int * 1e-9 << " GB/s"
+                  << std::endl;
+    }
+
+    // first-touch
+
+    {
+        xt::xtensor<double, 3> ue = vector.AllocateElemvec();
+        xt::xtensor<double, 3> fe = vector.AllocateElemvec();
+        xt::xtensor<double, 4> eps = quad.AllocateQtensor<2>();
+
+        vector.asElement(u, ue);
+        double t_grad = timeit([&]() { quad.symGradN_vector(ue, eps); }, nrepeat);
+        double t_int = timeit([&]() { quad.int_gradN_dot_tensor2_dV(eps, fe); }, nrepeat);
+
+        std::cout << "first-touch : "
+                  << "symGradN_vector " << bytes_grad / t_grad * 1e-9 << " GB/s, "
+                  << "int_gradN_dot_tensor2_dV " << bytes_int / t_int * 1e-9 << " GB/s"
+                  << std::endl;
+    }
+
+    return 0;
+}
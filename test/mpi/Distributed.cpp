@@ -0,0 +1,224 @@
+#include <catch2/catch.hpp>
+#include <mpi.h>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xmath.hpp>
+#include <Eigen/Eigen>
+#include <GooseFEM/GooseFEM.h>
+#include "../basic/support.h"
+
+#define ISCLOSE(a,b) REQUIRE_THAT((a), Catch::WithinAbs((b), 1.e-12));
+
+TEST_CASE("GooseFEM::Distributed", "Distributed*.h")
+{
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    SECTION("partition")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(9, 9);
+
+        auto part = GooseFEM::Mesh::partitionGraph(mesh.conn(), size);
+
+        // each rank has elements, as required by Distributed::Topology
+        for (int p = 0; p < size; ++p) {
+            REQUIRE(xt::any(xt::equal(part, static_cast<size_t>(p))));
+        }
+    }
+
+    SECTION("Topology - rank-local construction")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(9, 9);
+        auto part = GooseFEM::Mesh::partitionGraph(mesh.conn(), size);
+        auto conn = mesh.conn();
+        auto dofs = mesh.dofs();
+        xt::xtensor<size_t, 1> iip = xt::view(dofs, xt::keep(mesh.nodesBottomEdge()), 1);
+
+        GooseFEM::Distributed::Topology dist(conn, dofs, iip, part);
+
+        // the local part of the mesh, as each rank would read it
+
+        GooseFEM::Mesh::Partition partition(conn, part);
+        size_t rank = static_cast<size_t>(dist.rank());
+        auto elem = partition.elements(rank);
+        auto node = partition.nodes(rank);
+        auto halo = partition.nodesInterface(rank, dofs);
+        xt::xtensor<size_t, 2> lconn = xt::view(conn, xt::keep(elem), xt::all());
+        xt::xtensor<size_t, 2> ldofs = xt::view(dofs, xt::keep(node), xt::all());
+
+        GooseFEM::Distributed::Topology local(elem, lconn, node, ldofs, halo, iip);
+
+        REQUIRE(local.ndofGlobal() == dist.ndofGlobal());
+        REQUIRE(xt::all(xt::equal(local.elem(), dist.elem())));
+        REQUIRE(xt::all(xt::equal(local.node(), dist.node())));
+        REQUIRE(xt::all(xt::equal(local.dof(), dist.dof())));
+        REQUIRE(xt::all(xt::equal(local.iio(), dist.iio())));
+        REQUIRE(xt::all(xt::equal(local.local().conn(), dist.local().conn())));
+        REQUIRE(xt::all(xt::equal(local.local().iip(), dist.local().iip())));
+        REQUIRE(local.neighbours() == dist.neighbours());
+
+        for (size_t i = 0; i < dist.neighbours().size(); ++i) {
+            REQUIRE(xt::all(xt::equal(local.shared()[i], dist.shared()[i])));
+        }
+    }
+
+    SECTION("assembleDofs, dot")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(9, 9);
+        auto part = GooseFEM::Mesh::partitionGraph(mesh.conn(), size);
+
+        xt::random::seed(0);
+        xt::xtensor<double, 3> f = xt::random::rand<double>({mesh.nelem(), mesh.nne(), mesh.ndim()});
+
+        GooseFEM::Vector vector(mesh.conn(), mesh.dofs());
+        xt::xtensor<double, 1> F = vector.AssembleDofs(f);
+
+        GooseFEM::Distributed::Topology dist(mesh.conn(), mesh.dofs(), part);
+        GooseFEM::Distributed::Vector dvector(dist);
+        xt::xtensor<double, 3> f_local = xt::view(f, xt::keep(dist.elem()), xt::all(), xt::all());
+        xt::xtensor<double, 1> F_local = dvector.AssembleDofs(f_local);
+
+        REQUIRE(xt::allclose(F_local, dist.AsLocal(F)));
+        REQUIRE(xt::allclose(dist.Gather(F_local), F));
+        ISCLOSE(dist.dot(F_local, F_local), xt::sum(F * F)());
+    }
+
+    SECTION("MatrixDiagonal")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(9, 9);
+        auto part = GooseFEM::Mesh::partitionGraph(mesh.conn(), size);
+        size_t n = mesh.nne() * mesh.ndim();
+
+        xt::random::seed(0);
+        xt::xtensor<double, 3> M = xt::zeros<double>({mesh.nelem(), n, n});
+        for (size_t e = 0; e < mesh.nelem(); ++e) {
+            for (size_t i = 0; i < n; ++i) {
+                M(e, i, i) = 1.0 + xt::random::rand<double>({1})(0);
+            }
+        }
+
+        GooseFEM::MatrixDiagonal mass(mesh.conn(), mesh.dofs());
+        mass.assemble(M);
+
+        GooseFEM::Distributed::Topology dist(mesh.conn(), mesh.dofs(), part);
+        GooseFEM::Distributed::MatrixDiagonal dmass(dist);
+        dmass.assemble(xt::view(M, xt::keep(dist.elem()), xt::all(), xt::all()));
+
+        REQUIRE(xt::allclose(dmass.Todiagonal(), dist.AsLocal(mass.Todiagonal())));
+    }
+
+    SECTION("MatrixPartitioned, CG")
+    {
+        GooseFEM::Mesh::Quad4::Regular mesh(9, 9);
+        auto part = GooseFEM::Mesh::partitionGraph(mesh.conn(), size);
+        auto dofs = mesh.dofs();
+        auto top = mesh.nodesTopEdge();
+        auto bottom = mesh.nodesBottomEdge();
+        size_t n = mesh.nne() * mesh.ndim();
+        size_t ni = top.size();
+
+        xt::xtensor<size_t, 1> iip = xt::empty<size_t>({3 * ni});
+        xt::view(iip, xt::range(0 * ni, 1 * ni)) = xt::view(dofs, xt::keep(bottom), 0);
+        xt::view(iip, xt::range(1 * ni, 2 * ni)) = xt::view(dofs, xt::keep(bottom), 1);
+        xt::view(iip, xt::range(2 * ni, 3 * ni)) = xt::view(dofs, xt::keep(top), 0);
+
+        // symmetric positive definite element matrices
+
+        xt::random::seed(0);
+        xt::xtensor<double, 3> K = support::random_spd(mesh.nelem(), n);
+
+        xt::xtensor<double, 2> x0 = xt::zeros<double>({mesh.nnode(), mesh.ndim()});
+        xt::xtensor<double, 2> b = xt::zeros<double>({mesh.nnode(), mesh.ndim()});
+        xt::view(x0, xt::keep(top), 0) = 0.1;
+
+        GooseFEM::MatrixPartitioned A(mesh.conn(), dofs, iip);
+        GooseFEM::MatrixPartitionedSolver<> solver;
+        A.assemble(K);
+        xt::xtensor<double, 2> x = solver.Solve(A, b, x0);
+
+        GooseFEM::Distributed::Topology dist(mesh.conn(), dofs, iip, part);
+        GooseFEM::Distributed::MatrixPartitioned dA(dist);
+        GooseFEM::Distributed::MatrixPartitionedSolver dsolver(1e-12);
+        xt::xtensor<double, 2> dx = xt::view(x0, xt::keep(dist.node()), xt::all());
+        xt::xtensor<double, 2> db = xt::zeros<double>({dist.nnode(), mesh.ndim()});
+
+        dA.assemble(xt::view(K, xt::keep(dist.elem()), xt::all(), xt::all()));
+        dsolver.solve(dA, db, dx);
+
+        REQUIRE(dsolver.iterations() > 0);
+        REQUIRE(xt::allclose(dx, xt::view(x, xt::keep(dist.node()), xt::all())));
+    }
+
+    SECTION("dofsPeriodic - assembleDofs, dot, MatrixPartitioned, CG")
+    {
+        // DOFs shared by nodes on different ranks (the left and the right edge, ...)
+
+        GooseFEM::Mesh::Quad4::Regular mesh(9, 9);
+        auto part = GooseFEM::Mesh::partitionGraph(mesh.conn(), size);
+        auto conn = mesh.conn();
+        auto dofs = mesh.dofsPeriodic();
+        size_t ndim = mesh.ndim();
+        size_t n = mesh.nne() * ndim;
+
+        GooseFEM::Vector vector(conn, dofs);
+        size_t ndof = vector.ndof();
+
+        xt::random::seed(0);
+        xt::xtensor<double, 3> f = xt::random::rand<double>({mesh.nelem(), mesh.nne(), ndim});
+        xt::xtensor<double, 3> K = support::random_spd(mesh.nelem(), n);
+        xt::xtensor<double, 1> bd = xt::random::rand<double>({ndof});
+        xt::xtensor<double, 1> F = vector.AssembleDofs(f);
+
+        // prescribe the DOFs of the corners (shared by all four corner nodes)
+
+        xt::xtensor<size_t, 1> iip = xt::view(dofs, mesh.nodesLeftBottomCorner(), xt::all());
+        xt::xtensor<double, 1> x0d = xt::zeros<double>({ndof});
+        x0d(iip(0)) = 0.1;
+        xt::xtensor<double, 2> x0 = vector.AsNode(x0d);
+        xt::xtensor<double, 2> b = vector.AsNode(bd);
+
+        GooseFEM::MatrixPartitioned A(conn, dofs, iip);
+        GooseFEM::MatrixPartitionedSolver<> solver;
+        A.assemble(K);
+        xt::xtensor<double, 2> x = solver.Solve(A, b, x0);
+
+        GooseFEM::Distributed::Topology dist(conn, dofs, iip, part);
+        GooseFEM::Distributed::Vector dvector(dist);
+        GooseFEM::Distributed::MatrixPartitioned dA(dist);
+        GooseFEM::Distributed::MatrixPartitionedSolver dsolver(1e-12);
+
+        xt::xtensor<double, 3> f_local = xt::view(f, xt::keep(dist.elem()), xt::all(), xt::all());
+        xt::xtensor<double, 1> F_local = dvector.AssembleDofs(f_local);
+
+        REQUIRE(xt::allclose(F_local, dist.AsLocal(F)));
+        REQUIRE(xt::allclose(dist.Gather(F_local), F));
+        ISCLOSE(dist.dot(F_local, F_local), xt::sum(F * F)());
+
+        xt::xtensor<double, 2> dx = xt::view(x0, xt::keep(dist.node()), xt::all());
+        xt::xtensor<double, 2> db = xt::view(b, xt::keep(dist.node()), xt::all());
+
+        dA.assemble(xt::view(K, xt::keep(dist.elem()), xt::all(), xt::all()));
+        dsolver.solve(dA, db, dx);
+
+        REQUIRE(xt::allclose(dx, xt::view(x, xt::keep(dist.node()), xt::all())));
+
+        // the same decomposition from the local part of the mesh
+
+        GooseFEM::Mesh::Partition partition(conn, part);
+        size_t rank = static_cast<size_t>(dist.rank());
+        auto elem = partition.elements(rank);
+        auto node = partition.nodes(rank);
+        auto halo = partition.nodesInterface(rank, dofs);
+        xt::xtensor<size_t, 2> lconn = xt::view(conn, xt::keep(elem), xt::all());
+        xt::xtensor<size_t, 2> ldofs = xt::view(dofs, xt::keep(node), xt::all());
+
+        GooseFEM::Distributed::Topology local(elem, lconn, node, ldofs, halo, iip);
+
+        REQUIRE(xt::all(xt::equal(local.dof(), dist.dof())));
+        REQUIRE(xt::all(xt::equal(local.iio(), dist.iio())));
+        REQUIRE(local.neighbours() == dist.neighbours());
+
+        for (size_t i = 0; i < dist.neighbours().size(); ++i) {
+            REQUIRE(xt::all(xt::equal(local.shared()[i], dist.shared()[i])));
+        }
+    }
+}
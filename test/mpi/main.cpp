@@ -0,0 +1,11 @@
+#define CATCH_CONFIG_RUNNER // tells Catch that main() is provided here (to initialise MPI)
+#include <catch2/catch.hpp>
+#include <mpi.h>
+
+int main(int argc, char* argv[])
+{
+    MPI_Init(&argc, &argv);
+    int result = Catch::Session().run(argc, argv);
+    MPI_Finalize();
+    return result;
+}